@@ -0,0 +1,456 @@
+#ifndef AREA_PLAN_H
+#define AREA_PLAN_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+
+#include "./MapProjectionStructures.h"
+#include "./ParallelUtils.h"
+#include "./ValidSpans.h"
+#include "./Reprojection.h"
+
+namespace Projections
+{
+
+	/// <summary>
+	/// Summed-area table (integral image) of input data
+	/// sums[(y * (w + 1) + x) * ChannelsCount + c] is sum of channel c
+	/// of input pixels [0, x) x [0, y)
+	///
+	/// Integral data are summed in unsigned integers with wrap-around
+	/// arithmetic, box sums are exact as long as they fit to Sum type
+	/// (boxes are limited by AreaPlan::MAX_BOX_SIZE). 8-bit data use 32-bit sums.
+	/// Floating point data are summed in double.
+	///
+	/// Build reuses allocated memory, so one table can be used
+	/// for many inputs with the same size.
+	/// </summary>
+	template <typename DataType, size_t ChannelsCount = 1>
+	struct SummedAreaTable
+	{
+		using Sum = typename std::conditional<std::is_floating_point<DataType>::value, double,
+			typename std::conditional<sizeof(DataType) == 1, uint32_t, uint64_t>::type>::type;
+
+		int w;
+		int h;
+		std::vector<Sum> sums;
+
+		SummedAreaTable() :
+			w(0),
+			h(0)
+		{
+		}
+
+		/// <summary>
+		/// Build table from inputData with inW * inH pixels
+		/// Rows are summed in parallel by threadsCount threads
+		/// and then columns are accumulated in parallel
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="inW"></param>
+		/// <param name="inH"></param>
+		/// <param name="threadsCount"></param>
+		void Build(const DataType* inputData, int inW, int inH, size_t threadsCount = 1)
+		{
+			this->w = inW;
+			this->h = inH;
+
+			const size_t rowSize = this->GetRowSize();
+			this->sums.resize(rowSize * (static_cast<size_t>(inH) + 1));
+
+			std::fill(this->sums.begin(), this->sums.begin() + rowSize, Sum(0));
+
+			//prefix sums of rows
+			int bandSize = ParallelUtils::GetCacheRowBandSize(rowSize * sizeof(Sum));
+
+			ParallelUtils::RunRowBands(inH, bandSize, threadsCount, [&](int startRow, int endRow) {
+				for (int y = startRow; y < endRow; y++)
+				{
+					const DataType* in = inputData + static_cast<size_t>(y) * inW * ChannelsCount;
+					Sum* row = &this->sums[(static_cast<size_t>(y) + 1) * rowSize];
+
+					Sum acc[ChannelsCount] = {};
+					for (size_t c = 0; c < ChannelsCount; c++)
+					{
+						row[c] = 0;
+					}
+
+					for (int x = 0; x < inW; x++)
+					{
+						for (size_t c = 0; c < ChannelsCount; c++)
+						{
+							acc[c] += static_cast<Sum>(in[x * ChannelsCount + c]);
+							row[(x + 1) * ChannelsCount + c] = acc[c];
+						}
+					}
+				}
+			});
+
+			//accumulate rows - every thread processes continuous range of columns
+			const int COLUMNS_BLOCK = 1024;
+			int columnBlocks = static_cast<int>((rowSize + COLUMNS_BLOCK - 1) / COLUMNS_BLOCK);
+
+			ParallelUtils::RunRowBands(columnBlocks, 1, threadsCount, [&](int startBlock, int endBlock) {
+				size_t begin = static_cast<size_t>(startBlock) * COLUMNS_BLOCK;
+				size_t end = std::min(static_cast<size_t>(endBlock) * COLUMNS_BLOCK, rowSize);
+
+				for (int y = 1; y < inH; y++)
+				{
+					const Sum* prev = &this->sums[static_cast<size_t>(y) * rowSize];
+					Sum* row = &this->sums[(static_cast<size_t>(y) + 1) * rowSize];
+
+					for (size_t i = begin; i < end; i++)
+					{
+						row[i] += prev[i];
+					}
+				}
+			});
+		}
+
+		/// <summary>
+		/// Get sum of channel c of input pixels [x0, x1) x [y0, y1)
+		/// </summary>
+		/// <param name="x0"></param>
+		/// <param name="y0"></param>
+		/// <param name="x1"></param>
+		/// <param name="y1"></param>
+		/// <param name="c"></param>
+		/// <returns></returns>
+		Sum GetSum(int x0, int y0, int x1, int y1, size_t c) const
+		{
+			const size_t rowSize = this->GetRowSize();
+
+			const Sum* r0 = &this->sums[static_cast<size_t>(y0) * rowSize + c];
+			const Sum* r1 = &this->sums[static_cast<size_t>(y1) * rowSize + c];
+
+			return r1[x1 * ChannelsCount] - r1[x0 * ChannelsCount] - r0[x1 * ChannelsCount] + r0[x0 * ChannelsCount];
+		}
+
+		size_t GetRowSize() const
+		{
+			return (static_cast<size_t>(this->w) + 1) * ChannelsCount;
+		}
+	};
+
+	/// <summary>
+	/// Area-weighted (box filter) resampling plan for outputs,
+	/// that are much coarser than input (eg. overview of full disk image),
+	/// where nearest neighbor, bilinear and bicubic alias.
+	///
+	/// Footprint of every valid output pixel in input is estimated
+	/// from local Jacobian of the mapping - differences of mapped positions
+	/// of neighbouring output pixels. It is stored as input box
+	/// [x0, x1) x [y0, y1) with at least one pixel (input pixel centers
+	/// are at integer positions, same as in bilinear interpolation).
+	/// Apply averages input over the boxes with summed-area table,
+	/// so every output pixel costs 4 lookups per channel
+	/// regardless of the box size.
+	///
+	/// Plan is created once from reprojection and it can be applied
+	/// to many inputs (table can be reused, see SummedAreaTable).
+	/// </summary>
+	struct AreaPlan
+	{
+		//maximal box side in input pixels
+		//(8-bit box sums fit to 32 bits)
+		static const int MAX_BOX_SIZE = 4096;
+
+		struct Box
+		{
+			int32_t x0;
+			int32_t y0;
+			int32_t x1;
+			int32_t y1;
+		};
+
+		int inW;
+		int inH;
+		int outW;
+		int outH;
+
+		//valid output pixels, boxes are stored only for them (in row-major order)
+		ValidSpans validSpans;
+		std::vector<Box> boxes;
+
+		//index of first box of every row (outH + 1 values)
+		std::vector<size_t> rowBoxes;
+
+		AreaPlan() :
+			inW(0),
+			inH(0),
+			outW(0),
+			outH(0)
+		{
+		}
+
+		/// <summary>
+		/// Create plan from reprojection
+		/// Positions can be integral, but footprints of sub-pixel
+		/// positions (float, Fixed24_8) are more precise
+		/// </summary>
+		/// <param name="reprojection"></param>
+		/// <returns></returns>
+		template <typename T>
+		static AreaPlan Create(const Reprojection<T>& reprojection)
+		{
+			AreaPlan plan;
+			plan.inW = reprojection.inW;
+			plan.inH = reprojection.inH;
+			plan.outW = reprojection.outW;
+			plan.outH = reprojection.outH;
+
+			if (reprojection.validSpans.IsEmpty())
+			{
+				plan.validSpans.Build(reprojection.pixels.data(), plan.outW, plan.outH);
+			}
+			else
+			{
+				plan.validSpans = reprojection.validSpans;
+			}
+
+			plan.boxes.reserve(plan.validSpans.GetPixelsCount());
+			plan.rowBoxes.reserve(static_cast<size_t>(plan.outH) + 1);
+
+			for (int y = 0; y < plan.outH; y++)
+			{
+				plan.rowBoxes.push_back(plan.boxes.size());
+
+				plan.validSpans.ForEachSpan(y, plan.outW,
+					[](int, int) {},
+					[&](int begin, int end) {
+						for (int x = begin; x < end; x++)
+						{
+							plan.boxes.push_back(plan.CreateBox(reprojection.pixels.data(), x, y));
+						}
+					});
+			}
+			plan.rowBoxes.push_back(plan.boxes.size());
+
+			return plan;
+		}
+
+		bool IsEmpty() const
+		{
+			return this->validSpans.IsEmpty();
+		}
+
+		/// <summary>
+		/// Get size of plan in memory
+		/// </summary>
+		/// <returns></returns>
+		size_t GetBytes() const
+		{
+			return this->boxes.size() * sizeof(Box) +
+				this->rowBoxes.size() * sizeof(size_t) +
+				this->validSpans.spans.size() * sizeof(ValidSpans::Span) +
+				this->validSpans.rowOffsets.size() * sizeof(uint32_t);
+		}
+
+		/// <summary>
+		/// Reproject inputData with the plan
+		/// Summed-area table is built for the input
+		/// Output array has size outW * outH
+		/// Output array must be released with delete[]
+		///
+		/// Template parameters:
+		/// DataType - type of input data
+		/// Out - output structure - can be raw array of std::vector
+		/// ChannelsCount - number of channels in input / output data
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out = DataType*, size_t ChannelsCount = 1>
+		Out Apply(const DataType* inputData, const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			SummedAreaTable<DataType, ChannelsCount> table;
+			table.Build(inputData, this->inW, this->inH, threadsCount);
+
+			size_t count = static_cast<size_t>(this->outW) * this->outH;
+
+			Out output = Reprojection<int>::template AllocateOutput<DataType, Out, ChannelsCount>(count);
+
+			this->Apply<DataType, ChannelsCount>(table, Reprojection<int>::template GetOutputData<DataType>(output),
+				static_cast<size_t>(this->outW) * ChannelsCount, NO_VALUE, threadsCount);
+
+			return output;
+		}
+
+		/// <summary>
+		/// Reproject input with the plan, table must be built from the input
+		/// Output is written to caller-provided memory,
+		/// output row y starts at outputData + y * outputRowPitch
+		/// </summary>
+		/// <param name="table"></param>
+		/// <param name="outputData"></param>
+		/// <param name="outputRowPitch">distance of output rows in DataType elements</param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, size_t ChannelsCount = 1>
+		void Apply(const SummedAreaTable<DataType, ChannelsCount>& table, DataType* outputData, size_t outputRowPitch,
+			const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			int bandSize = ParallelUtils::GetCacheRowBandSize(static_cast<size_t>(this->outW) * (sizeof(Box) + ChannelsCount * sizeof(DataType)));
+
+			ParallelUtils::RunRowBands(this->outH, bandSize, threadsCount, [&](int startRow, int endRow) {
+				for (int y = startRow; y < endRow; y++)
+				{
+					DataType* rowOut = outputData + static_cast<size_t>(y) * outputRowPitch;
+					const Box* b = this->boxes.data() + this->rowBoxes[y];
+
+					this->validSpans.ForEachSpan(y, this->outW,
+						[&](int begin, int end) {
+							//outside of the model - no data - put there NO_VALUE
+							std::fill(rowOut + begin * ChannelsCount, rowOut + end * ChannelsCount, NO_VALUE);
+						},
+						[&](int begin, int end) {
+							for (int x = begin; x < end; x++, b++)
+							{
+								int64_t area = static_cast<int64_t>(b->x1 - b->x0) * (b->y1 - b->y0);
+
+								for (size_t c = 0; c < ChannelsCount; c++)
+								{
+									rowOut[x * ChannelsCount + c] = GetAverage<DataType>(table.GetSum(b->x0, b->y0, b->x1, b->y1, c), area);
+								}
+							}
+						});
+				}
+			});
+		}
+
+	protected:
+
+		/// <summary>
+		/// Get average from sum of area pixels
+		/// Integral values are rounded
+		/// </summary>
+		/// <param name="sum"></param>
+		/// <param name="area"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Sum>
+		static DataType GetAverage(Sum sum, int64_t area)
+		{
+			if constexpr (std::is_floating_point<DataType>::value)
+			{
+				return static_cast<DataType>(sum / static_cast<double>(area));
+			}
+			else if constexpr (std::is_unsigned<DataType>::value)
+			{
+				return static_cast<DataType>((sum + static_cast<Sum>(area / 2)) / static_cast<Sum>(area));
+			}
+			else
+			{
+				//wrap-around sum of signed data
+				using Signed = typename std::make_signed<Sum>::type;
+				int64_t s = static_cast<Signed>(sum);
+				s = (s >= 0) ? s + area / 2 : s - area / 2;
+				return static_cast<DataType>(s / area);
+			}
+		}
+
+		/// <summary>
+		/// Get change of mapped position between output pixel [x, y]
+		/// and its neighbour in direction [dx, dy] or [-dx, -dy].
+		/// Neighbour with smaller change is used, so differences
+		/// across wrap-around seam are not used.
+		/// Invalid neighbours are skipped, if both are invalid, change is 0.
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="x"></param>
+		/// <param name="y"></param>
+		/// <param name="dx"></param>
+		/// <param name="dy"></param>
+		/// <param name="d"></param>
+		template <typename T>
+		void GetDerivative(const Pixel<T>* pixels, int x, int y, int dx, int dy, double* d) const
+		{
+			const Pixel<T>& p = pixels[x + static_cast<size_t>(y) * this->outW];
+
+			d[0] = 0;
+			d[1] = 0;
+			double minChange = std::numeric_limits<double>::max();
+
+			for (int dir = -1; dir <= 1; dir += 2)
+			{
+				int nx = x + dir * dx;
+				int ny = y + dir * dy;
+				if ((nx < 0) || (ny < 0) || (nx >= this->outW) || (ny >= this->outH))
+				{
+					continue;
+				}
+
+				const Pixel<T>& n = pixels[nx + static_cast<size_t>(ny) * this->outW];
+				if ((n.x == -1) || (n.y == -1))
+				{
+					continue;
+				}
+
+				double cx = static_cast<double>(n.x) - static_cast<double>(p.x);
+				double cy = static_cast<double>(n.y) - static_cast<double>(p.y);
+
+				double change = std::abs(cx) + std::abs(cy);
+				if (change < minChange)
+				{
+					minChange = change;
+					d[0] = cx;
+					d[1] = cy;
+				}
+			}
+		}
+
+		/// <summary>
+		/// Get input range [p0, p1) of pixels with centers inside
+		/// [center - half, center + half), range has at least one pixel
+		/// </summary>
+		/// <param name="center"></param>
+		/// <param name="half"></param>
+		/// <param name="size"></param>
+		/// <param name="p0"></param>
+		/// <param name="p1"></param>
+		static void GetRange(double center, double half, int size, int32_t& p0, int32_t& p1)
+		{
+			half = std::min(std::max(half, 0.5), 0.5 * MAX_BOX_SIZE);
+
+			double start = std::ceil(center - half);
+			double end = std::ceil(center + half);
+
+			p0 = static_cast<int32_t>(std::min(std::max(start, 0.0), static_cast<double>(size - 1)));
+			p1 = static_cast<int32_t>(std::min(std::max(end, 0.0), static_cast<double>(size)));
+			if (p1 <= p0)
+			{
+				p1 = p0 + 1;
+			}
+		}
+
+		template <typename T>
+		Box CreateBox(const Pixel<T>* pixels, int x, int y) const
+		{
+			const Pixel<T>& p = pixels[x + static_cast<size_t>(y) * this->outW];
+
+			//columns of Jacobian
+			double jx[2];
+			double jy[2];
+			this->GetDerivative(pixels, x, y, 1, 0, jx);
+			this->GetDerivative(pixels, x, y, 0, 1, jy);
+
+			//half size of bounding box of the pixel footprint
+			double hx = 0.5 * (std::abs(jx[0]) + std::abs(jy[0]));
+			double hy = 0.5 * (std::abs(jx[1]) + std::abs(jy[1]));
+
+			Box b;
+			GetRange(static_cast<double>(p.x), hx, this->inW, b.x0, b.x1);
+			GetRange(static_cast<double>(p.y), hy, this->inH, b.y0, b.y1);
+
+			return b;
+		}
+	};
+
+};
+
+#endif
@@ -0,0 +1,249 @@
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+namespace Projections
+{
+
+	/// <summary>
+	/// Thread-safe pool of reusable data buffers
+	///
+	/// Used with ReprojectData* methods that write to caller-provided
+	/// memory. Acquire returns buffer that is returned back to the pool
+	/// when it is destroyed (or Release is called). Next Acquire reuses
+	/// the smallest free buffer that is large enough, so processing loop
+	/// with the same sizes in every iteration does not allocate after
+	/// the first iteration.
+	///
+	/// Buffers are not initialized. At most maxFreeBuffers free buffers
+	/// are kept, others are released.
+	/// Pool must outlive all its buffers.
+	/// </summary>
+	template <typename DataType>
+	class BufferPool
+	{
+	public:
+
+		/// <summary>
+		/// Buffer borrowed from the pool
+		/// It is only movable and it is returned to the pool in destructor
+		/// </summary>
+		class Buffer
+		{
+		public:
+			Buffer() :
+				pool(nullptr),
+				capacity(0),
+				count(0)
+			{
+			}
+
+			Buffer(Buffer&& other) noexcept :
+				pool(other.pool),
+				data(std::move(other.data)),
+				capacity(other.capacity),
+				count(other.count)
+			{
+				other.pool = nullptr;
+				other.capacity = 0;
+				other.count = 0;
+			}
+
+			Buffer& operator=(Buffer&& other) noexcept
+			{
+				if (this != &other)
+				{
+					this->Release();
+
+					this->pool = other.pool;
+					this->data = std::move(other.data);
+					this->capacity = other.capacity;
+					this->count = other.count;
+
+					other.pool = nullptr;
+					other.capacity = 0;
+					other.count = 0;
+				}
+				return *this;
+			}
+
+			Buffer(const Buffer&) = delete;
+			Buffer& operator=(const Buffer&) = delete;
+
+			~Buffer()
+			{
+				this->Release();
+			}
+
+			DataType* Get()
+			{
+				return this->data.get();
+			}
+
+			const DataType* Get() const
+			{
+				return this->data.get();
+			}
+
+			/// <summary>
+			/// Number of elements requested by Acquire
+			/// </summary>
+			/// <returns></returns>
+			size_t GetCount() const
+			{
+				return this->count;
+			}
+
+			bool IsEmpty() const
+			{
+				return this->data == nullptr;
+			}
+
+			/// <summary>
+			/// Return buffer to the pool
+			/// </summary>
+			void Release()
+			{
+				if ((this->pool != nullptr) && (this->data != nullptr))
+				{
+					this->pool->Return(std::move(this->data), this->capacity);
+				}
+
+				this->pool = nullptr;
+				this->data = nullptr;
+				this->capacity = 0;
+				this->count = 0;
+			}
+
+		protected:
+			friend class BufferPool<DataType>;
+
+			BufferPool<DataType>* pool;
+			std::unique_ptr<DataType[]> data;
+			size_t capacity;
+			size_t count;
+		};
+
+		explicit BufferPool(size_t maxFreeBuffers = 16) :
+			maxFreeBuffers(maxFreeBuffers),
+			allocationsCount(0)
+		{
+		}
+
+		BufferPool(const BufferPool&) = delete;
+		BufferPool& operator=(const BufferPool&) = delete;
+
+		/// <summary>
+		/// Get buffer with at least count elements
+		/// Free buffer is reused if possible, otherwise new one is allocated
+		/// </summary>
+		/// <param name="count"></param>
+		/// <returns></returns>
+		Buffer Acquire(size_t count)
+		{
+			Buffer b;
+			b.pool = this;
+			b.count = count;
+
+			{
+				std::lock_guard<std::mutex> lock(this->m);
+
+				//smallest free buffer that is large enough
+				auto best = this->freeBuffers.end();
+				for (auto it = this->freeBuffers.begin(); it != this->freeBuffers.end(); it++)
+				{
+					if ((it->capacity >= count) &&
+						((best == this->freeBuffers.end()) || (it->capacity < best->capacity)))
+					{
+						best = it;
+					}
+				}
+
+				if (best != this->freeBuffers.end())
+				{
+					b.data = std::move(best->data);
+					b.capacity = best->capacity;
+					this->freeBuffers.erase(best);
+					return b;
+				}
+
+				this->allocationsCount++;
+			}
+
+			b.data.reset(new DataType[count]);
+			b.capacity = count;
+			return b;
+		}
+
+		/// <summary>
+		/// Release all free buffers
+		/// </summary>
+		void Clear()
+		{
+			std::lock_guard<std::mutex> lock(this->m);
+			this->freeBuffers.clear();
+		}
+
+		size_t GetFreeBuffersCount() const
+		{
+			std::lock_guard<std::mutex> lock(this->m);
+			return this->freeBuffers.size();
+		}
+
+		/// <summary>
+		/// Number of buffers allocated by Acquire so far
+		/// (it does not grow in steady state)
+		/// </summary>
+		/// <returns></returns>
+		size_t GetAllocationsCount() const
+		{
+			std::lock_guard<std::mutex> lock(this->m);
+			return this->allocationsCount;
+		}
+
+	protected:
+		struct FreeBuffer
+		{
+			std::unique_ptr<DataType[]> data;
+			size_t capacity;
+		};
+
+		mutable std::mutex m;
+		size_t maxFreeBuffers;
+		size_t allocationsCount;
+
+		//reserved on first return, so returning buffers does not allocate later
+		std::vector<FreeBuffer> freeBuffers;
+
+		void Return(std::unique_ptr<DataType[]>&& data, size_t capacity)
+		{
+			std::lock_guard<std::mutex> lock(this->m);
+
+			if (this->freeBuffers.size() >= this->maxFreeBuffers)
+			{
+				//drop the smallest buffer
+				auto smallest = std::min_element(this->freeBuffers.begin(), this->freeBuffers.end(),
+					[](const FreeBuffer& a, const FreeBuffer& b) {
+					return a.capacity < b.capacity;
+				});
+
+				if ((smallest == this->freeBuffers.end()) || (smallest->capacity >= capacity))
+				{
+					return;
+				}
+				this->freeBuffers.erase(smallest);
+			}
+
+			this->freeBuffers.reserve(this->maxFreeBuffers);
+			this->freeBuffers.push_back({ std::move(data), capacity });
+		}
+	};
+}
+
+#endif
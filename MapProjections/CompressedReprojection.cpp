@@ -0,0 +1,109 @@
+#include "./CompressedReprojection.h"
+
+#ifndef MY_LOG_ERROR
+#	define MY_LOG_ERROR(...) printf(__VA_ARGS__)
+#endif
+
+#include <string.h>
+
+using namespace Projections;
+
+/// <summary>
+/// Load reprojection info from file
+/// File contains inW, inH, outW, outH, size of data, 
+/// outH + 1 row offsets and compressed data
+/// 
+/// Row offsets are checked before they are used by DecodeRow:
+/// the first one is 0, every row has at least one operation (offsets only increase)
+/// and the last one is size of data
+/// </summary>
+/// <param name="fileName"></param>
+/// <returns></returns>
+template <typename T>
+CompressedReprojection<T> CompressedReprojection<T>::CreateFromFile(const std::string& fileName)
+{
+	CompressedReprojection r;
+
+	FILE* f = nullptr;  //pointer to file we will read in
+	my_fopen(&f, fileName.c_str(), "rb");
+	if (f == nullptr)
+	{
+		MY_LOG_ERROR("Failed to open file: \"%s\"\n", fileName.c_str());
+		return r;
+	}
+
+	fseek(f, 0L, SEEK_END);
+	long size = ftell(f);
+	fseek(f, 0L, SEEK_SET);
+
+	uint64_t dataSize = 0;
+
+	fread(&(r.inW), sizeof(int), 1, f);
+	fread(&(r.inH), sizeof(int), 1, f);
+	fread(&(r.outW), sizeof(int), 1, f);
+	fread(&(r.outH), sizeof(int), 1, f);
+	fread(&dataSize, sizeof(uint64_t), 1, f);
+
+	uint64_t expectedSize = 4 * sizeof(int) + sizeof(uint64_t) + 
+		(static_cast<uint64_t>(r.outH) + 1) * sizeof(uint64_t) + dataSize;
+
+	if ((r.outW <= 0) || (r.outH <= 0) || (static_cast<uint64_t>(size) != expectedSize))
+	{
+		MY_LOG_ERROR("Corrupted compressed reprojection file: \"%s\"\n", fileName.c_str());
+		fclose(f);
+		return CompressedReprojection();
+	}
+
+	r.rowOffsets.resize(r.outH + 1);
+	r.data.resize(dataSize);
+	fread(r.rowOffsets.data(), sizeof(uint64_t), r.rowOffsets.size(), f);
+	fread(r.data.data(), sizeof(uint8_t), r.data.size(), f);
+
+	fclose(f);
+
+	bool validOffsets = (r.rowOffsets[0] == 0) && (r.rowOffsets[r.outH] == dataSize);
+	for (int y = 0; (y < r.outH) && (validOffsets); y++)
+	{
+		validOffsets = (r.rowOffsets[y] < r.rowOffsets[y + 1]);
+	}
+
+	if (validOffsets == false)
+	{
+		MY_LOG_ERROR("Corrupted row offsets in compressed reprojection file: \"%s\"\n", fileName.c_str());
+		return CompressedReprojection();
+	}
+
+	return r;
+}
+
+/// <summary>
+/// Save reprojection info to file
+/// </summary>
+/// <param name="fileName"></param>
+template <typename T>
+void CompressedReprojection<T>::SaveToFile(const std::string& fileName)
+{
+	FILE* f = nullptr;
+	my_fopen(&f, fileName.c_str(), "wb");
+
+	if (f == nullptr)
+	{
+		MY_LOG_ERROR("Failed to open file %s (%s)", fileName.c_str(), strerror(errno));
+		return;
+	}
+
+	uint64_t dataSize = this->data.size();
+
+	fwrite(&this->inW, sizeof(int), 1, f);
+	fwrite(&this->inH, sizeof(int), 1, f);
+	fwrite(&this->outW, sizeof(int), 1, f);
+	fwrite(&this->outH, sizeof(int), 1, f);
+	fwrite(&dataSize, sizeof(uint64_t), 1, f);
+	fwrite(this->rowOffsets.data(), sizeof(uint64_t), this->rowOffsets.size(), f);
+	fwrite(this->data.data(), sizeof(uint8_t), this->data.size(), f);
+	fclose(f);
+
+}
+
+template struct Projections::CompressedReprojection<int>;
+template struct Projections::CompressedReprojection<short>;
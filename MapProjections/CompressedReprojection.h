@@ -0,0 +1,412 @@
+#ifndef COMPRESSED_REPROJECTION_H
+#define COMPRESSED_REPROJECTION_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+#include "./MapProjectionStructures.h"
+#include "./Reprojection.h"
+
+namespace Projections
+{
+
+	/// <summary>
+	/// Compressed reprojection structure
+	/// Holds the same mapping as Reprojection, but every output row
+	/// is encoded as a stream of operations:
+	///
+	/// SKIP n   - n output pixels without mapping (-1)
+	/// FILL n   - n output pixels mapped to the same input pixel as the previous one
+	///            (upsampling)
+	/// DELTA n  - n output pixels, each mapped to previous input pixel + (dx, dy)
+	///            (dx, dy) are stored as signed 4-bit values in a single byte
+	/// SET      - single output pixel with absolute input position
+	///
+	/// Operation header is a single byte: 2 bits operation, 6 bits count - 1.
+	/// If count - 1 does not fit to 6 bits, 63 is stored and the rest
+	/// follows as varint.
+	///
+	/// Rows are encoded independently and rowOffsets[y] points to the start
+	/// of row y in data (rowOffsets[outH] is size of data).
+	///
+	/// Only integral T is supported (positions must be exact)
+	/// </summary>
+	template <typename T = int>
+	struct CompressedReprojection
+	{
+		static_assert(std::is_integral<T>::value, "CompressedReprojection supports only integral pixel type");
+
+		enum class Operation : uint8_t
+		{
+			SKIP = 0,
+			FILL = 1,
+			DELTA = 2,
+			SET = 3
+		};
+
+		int inW;
+		int inH;
+		int outW;
+		int outH;
+		std::vector<uint64_t> rowOffsets;
+		std::vector<uint8_t> data;
+
+		CompressedReprojection() :
+			inW(0),
+			inH(0),
+			outW(0),
+			outH(0)
+		{
+		}
+
+		/// <summary>
+		/// Load reprojection from file
+		/// </summary>
+		/// <param name="fileName"></param>
+		/// <returns></returns>
+		static CompressedReprojection<T> CreateFromFile(const std::string& fileName);
+
+		/// <summary>
+		/// Compress existing reprojection
+		/// </summary>
+		/// <param name="r"></param>
+		/// <returns></returns>
+		static CompressedReprojection<T> Compress(const Reprojection<T>& r)
+		{
+			CompressedReprojection<T> c;
+			c.inW = r.inW;
+			c.inH = r.inH;
+			c.outW = r.outW;
+			c.outH = r.outH;
+
+			c.rowOffsets.resize(r.outH + 1);
+
+			for (int y = 0; y < r.outH; y++)
+			{
+				c.rowOffsets[y] = c.data.size();
+				c.EncodeRow(&r.pixels[static_cast<size_t>(y) * r.outW]);
+			}
+			c.rowOffsets[r.outH] = c.data.size();
+
+			c.data.shrink_to_fit();
+
+			return c;
+		}
+
+		/// <summary>
+		/// Decompress to the full reprojection
+		/// Valid spans are built from decoded rows if buildValidSpans is true
+		/// </summary>
+		/// <param name="buildValidSpans"></param>
+		/// <returns></returns>
+		Reprojection<T> Decompress(bool buildValidSpans = true) const
+		{
+			Reprojection<T> r;
+			r.inW = this->inW;
+			r.inH = this->inH;
+			r.outW = this->outW;
+			r.outH = this->outH;
+			r.pixels.resize(static_cast<size_t>(this->outW) * this->outH, { -1, -1 });
+
+			std::vector<std::vector<ValidSpans::Span>> spanRows(buildValidSpans ? this->outH : 0);
+
+			for (int y = 0; y < this->outH; y++)
+			{
+				Pixel<T>* row = &r.pixels[static_cast<size_t>(y) * this->outW];
+
+				this->DecodeRow(y,
+					[](int, int) {
+						//pixels are already set to -1
+					},
+					[&](int x, int count, T px, T py) {
+						std::fill(row + x, row + x + count, Pixel<T>{ px, py });
+					},
+					[&](int x, T px, T py) {
+						row[x] = { px, py };
+					});
+
+				if (buildValidSpans)
+				{
+					ValidSpans::BuildRows(r.pixels.data(), this->outW, y, y + 1, spanRows);
+				}
+			}
+
+			if (buildValidSpans)
+			{
+				r.validSpans.SetRows(spanRows);
+			}
+
+			return r;
+		}
+
+		/// <summary>
+		/// Save reprojection to file
+		/// </summary>
+		/// <param name="fileName"></param>
+		void SaveToFile(const std::string& fileName);
+
+		/// <summary>
+		/// Get size of compressed data in bytes
+		/// </summary>
+		/// <returns></returns>
+		size_t GetCompressedSize() const
+		{
+			return this->data.size() + this->rowOffsets.size() * sizeof(uint64_t);
+		}
+
+		/// <summary>
+		/// Reproject inputData based on reproj with Nearest Neighbor interpolation.
+		/// Mapping is decoded on the fly, FILL runs copy the previous output pixel
+		/// and SKIP runs are filled with NO_VALUE at once.
+		///
+		/// Output array has size reproj.outW * reproj.outH
+		/// Output array must be released with delete[]
+		///
+		/// Template parameters:
+		/// DataType - type of input data
+		/// Out - output structure - can be raw array of std::vector
+		/// ChannelsCount - number of channels in input / output data
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out = DataType*, size_t ChannelsCount = 1>
+		Out ReprojectDataNerestNeighbor(const DataType* inputData, const DataType NO_VALUE) const
+		{
+			size_t count = static_cast<size_t>(this->outW) * this->outH;
+
+			Out output = Reprojection<T>::template AllocateOutput<DataType, Out, ChannelsCount>(count);
+
+			for (int y = 0; y < this->outH; y++)
+			{
+				DataType* row = &output[static_cast<size_t>(y) * this->outW * ChannelsCount];
+
+				this->DecodeRow(y,
+					[&](int x, int count) {
+						//outside of the model - no data - put there NO_VALUE
+						std::fill(row + x * ChannelsCount, row + (x + count) * ChannelsCount, NO_VALUE);
+					},
+					[&](int x, int count, T px, T py) {
+						DataType* out = row + x * ChannelsCount;
+						Reprojection<T>::template CopyNerestNeighbor<DataType, ChannelsCount>(inputData, this->inW,
+							static_cast<int>(px), static_cast<int>(py), out);
+
+						for (int i = 1; i < count; i++)
+						{
+							std::copy(out, out + ChannelsCount, out + i * ChannelsCount);
+						}
+					},
+					[&](int x, T px, T py) {
+						Reprojection<T>::template CopyNerestNeighbor<DataType, ChannelsCount>(inputData, this->inW,
+							static_cast<int>(px), static_cast<int>(py), row + x * ChannelsCount);
+					});
+			}
+
+			return output;
+		}
+
+	protected:
+
+		//DELTA runs are interrupted if at least this number
+		//of the same input pixels follows (they are stored as FILL)
+		static const int MIN_FILL_IN_DELTA = 3;
+
+		static const int DELTA_MIN = -8;
+		static const int DELTA_MAX = 7;
+
+		static bool IsValid(const Pixel<T>& p)
+		{
+			return (p.x != -1) && (p.y != -1);
+		}
+
+		static bool IsSame(const Pixel<T>& a, const Pixel<T>& b)
+		{
+			return (a.x == b.x) && (a.y == b.y);
+		}
+
+		static bool CanDelta(const Pixel<T>& prev, const Pixel<T>& p)
+		{
+			int dx = static_cast<int>(p.x) - static_cast<int>(prev.x);
+			int dy = static_cast<int>(p.y) - static_cast<int>(prev.y);
+			return (dx >= DELTA_MIN) && (dx <= DELTA_MAX) && (dy >= DELTA_MIN) && (dy <= DELTA_MAX);
+		}
+
+		void WriteOperation(Operation op, int count)
+		{
+			uint32_t v = static_cast<uint32_t>(count - 1);
+			uint8_t header = static_cast<uint8_t>(op) << 6;
+
+			if (v < 63)
+			{
+				this->data.push_back(header | static_cast<uint8_t>(v));
+				return;
+			}
+
+			this->data.push_back(header | 63);
+			v -= 63;
+			while (v >= 0x80)
+			{
+				this->data.push_back(static_cast<uint8_t>(v | 0x80));
+				v >>= 7;
+			}
+			this->data.push_back(static_cast<uint8_t>(v));
+		}
+
+		static int ReadCount(const uint8_t*& ptr, uint8_t header)
+		{
+			uint32_t v = header & 63;
+			if (v == 63)
+			{
+				uint32_t shift = 0;
+				uint32_t extra = 0;
+				uint8_t b;
+				do
+				{
+					b = *ptr++;
+					extra |= static_cast<uint32_t>(b & 0x7F) << shift;
+					shift += 7;
+				} while (b & 0x80);
+				v += extra;
+			}
+			return static_cast<int>(v) + 1;
+		}
+
+		/// <summary>
+		/// Encode single row of pixels and append it to data
+		/// </summary>
+		/// <param name="row"></param>
+		void EncodeRow(const Pixel<T>* row)
+		{
+			Pixel<T> prev = { -1, -1 };
+			bool hasPrev = false;
+
+			int x = 0;
+			while (x < this->outW)
+			{
+				const Pixel<T>& p = row[x];
+
+				if (IsValid(p) == false)
+				{
+					int end = x + 1;
+					while ((end < this->outW) && (IsValid(row[end]) == false)) end++;
+
+					this->WriteOperation(Operation::SKIP, end - x);
+					x = end;
+				}
+				else if (hasPrev && IsSame(prev, p))
+				{
+					int end = x + 1;
+					while ((end < this->outW) && IsSame(prev, row[end])) end++;
+
+					this->WriteOperation(Operation::FILL, end - x);
+					x = end;
+				}
+				else if (hasPrev && CanDelta(prev, p))
+				{
+					int end = x;
+					Pixel<T> last = prev;
+					while ((end < this->outW) && IsValid(row[end]) && CanDelta(last, row[end]))
+					{
+						if ((end > x) && IsSame(last, row[end]))
+						{
+							//long run of the same pixel - end delta and store it as FILL
+							int sameEnd = end;
+							while ((sameEnd < this->outW) && IsSame(last, row[sameEnd])) sameEnd++;
+							if (sameEnd - end >= MIN_FILL_IN_DELTA) break;
+						}
+						last = row[end];
+						end++;
+					}
+
+					this->WriteOperation(Operation::DELTA, end - x);
+					for (int i = x; i < end; i++)
+					{
+						const Pixel<T>& a = (i == x) ? prev : row[i - 1];
+						int dx = static_cast<int>(row[i].x) - static_cast<int>(a.x);
+						int dy = static_cast<int>(row[i].y) - static_cast<int>(a.y);
+						this->data.push_back(static_cast<uint8_t>(((dx & 0xF) << 4) | (dy & 0xF)));
+					}
+
+					prev = row[end - 1];
+					x = end;
+				}
+				else
+				{
+					this->WriteOperation(Operation::SET, 1);
+
+					uint8_t tmp[2 * sizeof(T)];
+					std::memcpy(tmp, &p.x, sizeof(T));
+					std::memcpy(tmp + sizeof(T), &p.y, sizeof(T));
+					this->data.insert(this->data.end(), tmp, tmp + 2 * sizeof(T));
+
+					prev = p;
+					hasPrev = true;
+					x++;
+				}
+			}
+		}
+
+		/// <summary>
+		/// Decode single row and call:
+		/// onSkip(x, count) - for count pixels without mapping starting at x
+		/// onFill(x, count, px, py) - for count pixels starting at x mapped to [px, py]
+		/// onPixel(x, px, py) - for single pixel x mapped to [px, py]
+		/// </summary>
+		/// <param name="y"></param>
+		/// <param name="onSkip"></param>
+		/// <param name="onFill"></param>
+		/// <param name="onPixel"></param>
+		template <typename OnSkip, typename OnFill, typename OnPixel>
+		void DecodeRow(int y, OnSkip onSkip, OnFill onFill, OnPixel onPixel) const
+		{
+			const uint8_t* ptr = this->data.data() + this->rowOffsets[y];
+			const uint8_t* end = this->data.data() + this->rowOffsets[y + 1];
+
+			T px = -1;
+			T py = -1;
+
+			int x = 0;
+			while (ptr < end)
+			{
+				uint8_t header = *ptr++;
+				Operation op = static_cast<Operation>(header >> 6);
+				int count = ReadCount(ptr, header);
+
+				switch (op)
+				{
+				case Operation::SKIP:
+					onSkip(x, count);
+					break;
+				case Operation::FILL:
+					onFill(x, count, px, py);
+					break;
+				case Operation::DELTA:
+					for (int i = 0; i < count; i++)
+					{
+						uint8_t d = *ptr++;
+						//sign extend 4-bit values
+						px = static_cast<T>(px + (static_cast<int8_t>(d & 0xF0) >> 4));
+						py = static_cast<T>(py + (static_cast<int8_t>(d << 4) >> 4));
+						onPixel(x + i, px, py);
+					}
+					break;
+				case Operation::SET:
+					std::memcpy(&px, ptr, sizeof(T));
+					std::memcpy(&py, ptr + sizeof(T), sizeof(T));
+					ptr += 2 * sizeof(T);
+					onPixel(x, px, py);
+					break;
+				}
+
+				x += count;
+			}
+		}
+	};
+
+};
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef DATA_LAYOUT_H
+#define DATA_LAYOUT_H
+
+#include <cstddef>
+
+namespace Projections
+{
+
+	/// <summary>
+	/// Memory layout of multi-channel (multi-band) raster data
+	/// with number of channels known at runtime
+	///
+	/// Value of channel c of pixel with index i (i = x + y * w) is at
+	/// data[i * pixelStride + c * channelStride]
+	///
+	/// Interleaved - channels of pixel are next to each other (RGBRGB...)
+	/// Planar (band-sequential) - every channel is stored as separate plane (RR..GG..BB..),
+	/// planes can be padded - channelStride is distance between starts of planes
+	///
+	/// Strides are in DataType elements, not in bytes
+	/// </summary>
+	struct DataLayout
+	{
+		size_t channelsCount;
+		size_t pixelStride;
+		size_t channelStride;
+
+		static DataLayout Interleaved(size_t channelsCount)
+		{
+			return { channelsCount, channelsCount, 1 };
+		}
+
+		static DataLayout Planar(size_t channelsCount, size_t planeSize)
+		{
+			return { channelsCount, 1, planeSize };
+		}
+
+		size_t GetChannelsCount() const
+		{
+			return this->channelsCount;
+		}
+
+		size_t GetPixelOffset(size_t index) const
+		{
+			return index * this->pixelStride;
+		}
+
+		size_t GetChannelOffset(size_t channel) const
+		{
+			return channel * this->channelStride;
+		}
+
+		bool IsInterleaved() const
+		{
+			return (this->channelStride == 1) && (this->pixelStride == this->channelsCount);
+		}
+
+		/// <summary>
+		/// Number of elements that have to be allocated for count pixels
+		/// </summary>
+		/// <param name="count"></param>
+		/// <returns></returns>
+		size_t GetBufferSize(size_t count) const
+		{
+			if ((count == 0) || (this->channelsCount == 0))
+			{
+				return 0;
+			}
+			return (count - 1) * this->pixelStride + (this->channelsCount - 1) * this->channelStride + 1;
+		}
+	};
+
+	/// <summary>
+	/// Interleaved layout with ChannelsCount known at compile time
+	/// It has same interface as DataLayout and it is used by
+	/// ReprojectData* methods with ChannelsCount template parameter
+	/// </summary>
+	template <size_t ChannelsCount>
+	struct InterleavedLayout
+	{
+		static constexpr size_t GetChannelsCount()
+		{
+			return ChannelsCount;
+		}
+
+		static constexpr size_t GetPixelOffset(size_t index)
+		{
+			return index * ChannelsCount;
+		}
+
+		static constexpr size_t GetChannelOffset(size_t channel)
+		{
+			return channel;
+		}
+
+		static constexpr bool IsInterleaved()
+		{
+			return true;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef FINGERPRINT_H
+#define FINGERPRINT_H
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace Projections
+{
+
+	/// <summary>
+	/// 64-bit fingerprint builder
+	/// Values are added one by one (FNV-1a over their bytes)
+	/// and the result is finalized with splitmix64 mixing,
+	/// so also small changes of parameters change all bits
+	///
+	/// Floating point values are normalized (-0 == 0, all NaNs are the same)
+	/// and added as double, so the same value gives the same fingerprint
+	/// regardless of its type
+	/// </summary>
+	struct Fingerprint
+	{
+		uint64_t hash;
+
+		Fingerprint() :
+			hash(0xcbf29ce484222325ULL)
+		{
+		}
+
+		/// <summary>
+		/// Add raw bytes
+		/// </summary>
+		/// <param name="data"></param>
+		/// <param name="size"></param>
+		/// <returns></returns>
+		Fingerprint& AddBytes(const void* data, size_t size)
+		{
+			const uint8_t* ptr = static_cast<const uint8_t*>(data);
+			for (size_t i = 0; i < size; i++)
+			{
+				hash = (hash ^ ptr[i]) * 0x100000001b3ULL;
+			}
+			return *this;
+		}
+
+		/// <summary>
+		/// Add string including its length
+		/// (so "ab" + "c" differs from "a" + "bc")
+		/// </summary>
+		/// <param name="str"></param>
+		/// <returns></returns>
+		Fingerprint& Add(const char* str)
+		{
+			uint64_t len = (str == nullptr) ? 0 : std::strlen(str);
+			this->Add(len);
+			return this->AddBytes(str, static_cast<size_t>(len));
+		}
+
+		/// <summary>
+		/// Add arithmetic or enum value
+		/// </summary>
+		/// <param name="v"></param>
+		/// <returns></returns>
+		template <typename V>
+		Fingerprint& Add(V v)
+		{
+			static_assert(std::is_arithmetic<V>::value || std::is_enum<V>::value,
+				"Only arithmetic and enum values can be added to fingerprint");
+
+			if constexpr (std::is_floating_point<V>::value)
+			{
+				double d = static_cast<double>(v);
+				if (d == 0.0) d = 0.0;
+				if (std::isnan(d)) d = std::numeric_limits<double>::quiet_NaN();
+				return this->AddBytes(&d, sizeof(double));
+			}
+			else
+			{
+				uint64_t u = static_cast<uint64_t>(v);
+				return this->AddBytes(&u, sizeof(uint64_t));
+			}
+		}
+
+		/// <summary>
+		/// Get final fingerprint
+		/// </summary>
+		/// <returns></returns>
+		uint64_t Get() const
+		{
+			uint64_t z = hash + 0x9e3779b97f4a7c15ULL;
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+			return z ^ (z >> 31);
+		}
+	};
+
+};
+
+#endif
@@ -0,0 +1,217 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <cstdint>
+#include <cmath>
+#include <array>
+#include <limits>
+#include <type_traits>
+
+namespace Projections
+{
+
+	/// <summary>
+	/// Signed fixed point number with FractionBits fractional bits
+	/// stored in StorageType
+	///
+	/// Used as sub-pixel reprojection pixel type. Integer part and fraction
+	/// are obtained with shift and mask, so interpolation kernels
+	/// do not convert positions from floating point and use integer weights.
+	///
+	/// Conversion from integer is exact. Conversion from real number is rounded
+	/// to the nearest 1 / ONE. NaN and values out of range are converted to -1
+	/// (invalid pixel).
+	/// </summary>
+	template <typename StorageType, int FractionBits>
+	struct FixedPoint
+	{
+		static_assert(std::is_integral<StorageType>::value && std::is_signed<StorageType>::value,
+			"FixedPoint storage must be signed integer");
+
+		static const int FRACTION_BITS = FractionBits;
+		static const int32_t ONE = 1 << FractionBits;
+		static const int32_t FRACTION_MASK = ONE - 1;
+
+		StorageType raw;
+
+		FixedPoint() = default;
+
+		constexpr FixedPoint(int v) :
+			raw(static_cast<StorageType>(v * ONE))
+		{
+		}
+
+		FixedPoint(float v) :
+			raw(FromReal(v))
+		{
+		}
+
+		FixedPoint(double v) :
+			raw(FromReal(v))
+		{
+		}
+
+		static FixedPoint FromRaw(StorageType raw)
+		{
+			FixedPoint v;
+			v.raw = raw;
+			return v;
+		}
+
+		/// <summary>
+		/// Get integer part (floor)
+		/// </summary>
+		/// <returns></returns>
+		int GetInt() const
+		{
+			return static_cast<int>(this->raw) >> FractionBits;
+		}
+
+		/// <summary>
+		/// Get fraction in [0, ONE)
+		/// </summary>
+		/// <returns></returns>
+		int GetFraction() const
+		{
+			return static_cast<int>(this->raw) & FRACTION_MASK;
+		}
+
+		explicit operator int() const { return this->GetInt(); }
+		explicit operator float() const { return static_cast<float>(this->raw) / ONE; }
+		explicit operator double() const { return static_cast<double>(this->raw) / ONE; }
+
+		FixedPoint& operator+=(FixedPoint v) { this->raw = static_cast<StorageType>(this->raw + v.raw); return *this; }
+		FixedPoint& operator-=(FixedPoint v) { this->raw = static_cast<StorageType>(this->raw - v.raw); return *this; }
+
+		friend FixedPoint operator+(FixedPoint a, FixedPoint b) { return a += b; }
+		friend FixedPoint operator-(FixedPoint a, FixedPoint b) { return a -= b; }
+
+		friend bool operator==(FixedPoint a, FixedPoint b) { return a.raw == b.raw; }
+		friend bool operator!=(FixedPoint a, FixedPoint b) { return a.raw != b.raw; }
+		friend bool operator<(FixedPoint a, FixedPoint b) { return a.raw < b.raw; }
+		friend bool operator<=(FixedPoint a, FixedPoint b) { return a.raw <= b.raw; }
+		friend bool operator>(FixedPoint a, FixedPoint b) { return a.raw > b.raw; }
+		friend bool operator>=(FixedPoint a, FixedPoint b) { return a.raw >= b.raw; }
+
+	protected:
+		static StorageType FromReal(double v)
+		{
+			double r = std::round(v * ONE);
+			if ((std::isnan(r)) ||
+				(r < static_cast<double>(std::numeric_limits<StorageType>::min())) ||
+				(r > static_cast<double>(std::numeric_limits<StorageType>::max())))
+			{
+				return static_cast<StorageType>(-ONE);
+			}
+			return static_cast<StorageType>(r);
+		}
+	};
+
+	//24 bits integer part (up to 8M pixels) and 8 bits fraction (1/256 pixel)
+	using Fixed24_8 = FixedPoint<int32_t, 8>;
+
+	template <typename T>
+	struct IsFixedPoint : std::false_type {};
+
+	template <typename StorageType, int FractionBits>
+	struct IsFixedPoint<FixedPoint<StorageType, FractionBits>> : std::true_type {};
+
+	/// <summary>
+	/// Split non-negative position v to pixel and its fraction 
+	/// quantized to 1 / FractionsCount.
+	/// Fraction that rounds to 1 is moved to the next pixel
+	/// (or clamped to FractionsCount - 1 at the last pixel)
+	/// 
+	/// Shared by InterpolationPlan and LanczosFilter, so their weights are same
+	/// </summary>
+	/// <param name="v"></param>
+	/// <param name="size"></param>
+	/// <param name="fraction"></param>
+	/// <returns></returns>
+	template <int FractionsCount, typename T>
+	int QuantizePosition(T v, int size, int& fraction)
+	{
+		//no floor, just cast, because values are non-negative
+		int p = static_cast<int>(v);
+		int q = static_cast<int>(std::lround(static_cast<double>(v - p) * FractionsCount));
+		if (q == FractionsCount)
+		{
+			if (p + 1 < size)
+			{
+				p++;
+				q = 0;
+			}
+			else
+			{
+				q = FractionsCount - 1;
+			}
+		}
+		fraction = q;
+		return p;
+	}
+
+	/// <summary>
+	/// Quantize weights w to integers so their sum is exactly one
+	/// Rounding error is moved to the largest weight
+	/// </summary>
+	/// <param name="w"></param>
+	/// <param name="one"></param>
+	/// <param name="q"></param>
+	template <typename WeightType, size_t TapsCount>
+	void QuantizeWeights(const double* w, int32_t one, std::array<WeightType, TapsCount>& q)
+	{
+		int32_t sum = 0;
+		size_t maxIndex = 0;
+		for (size_t i = 0; i < TapsCount; i++)
+		{
+			q[i] = static_cast<WeightType>(std::lround(w[i] * one));
+			sum += q[i];
+			if (std::abs(w[i]) > std::abs(w[maxIndex])) maxIndex = i;
+		}
+		q[maxIndex] = static_cast<WeightType>(q[maxIndex] + (one - sum));
+	}
+
+	/// <summary>
+	/// Integer weights of cubic B-spline for all fractions
+	/// of FixedPoint with FractionBits.
+	/// Weights of every fraction are non-negative and their sum is ONE
+	/// </summary>
+	template <int FractionBits>
+	struct FixedPointBicubicWeights
+	{
+		static const int BITS = 11;
+		static const int32_t ONE = 1 << BITS;
+
+		using Table = std::array<std::array<int32_t, 4>, (1 << FractionBits)>;
+
+		static const Table& Get()
+		{
+			static const Table table = Create();
+			return table;
+		}
+
+	protected:
+		static Table Create()
+		{
+			Table table;
+			for (size_t i = 0; i < table.size(); i++)
+			{
+				double f = static_cast<double>(i) / table.size();
+				double g = 1.0 - f;
+
+				double w[4] = {
+					g * g * g / 6.0,
+					(4.0 + 3.0 * f * f * f - 6.0 * f * f) / 6.0,
+					(4.0 + 3.0 * g * g * g - 6.0 * g * g) / 6.0,
+					f * f * f / 6.0
+				};
+
+				QuantizeWeights(w, ONE, table[i]);
+			}
+			return table;
+		}
+	};
+
+};
+
+#endif
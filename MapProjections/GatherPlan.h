@@ -0,0 +1,331 @@
+#ifndef GATHER_PLAN_H
+#define GATHER_PLAN_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+#include <intrin.h>
+#endif
+
+#include "./MapProjectionStructures.h"
+
+namespace Projections
+{
+
+	/// <summary>
+	/// Traversal order of output pixels with better locality of input reads
+	///
+	/// If the mapping is rotated (eg. LambertConic -> Equirectangular,
+	/// pole rotation), consecutive pixels of output row read from different
+	/// input rows and row-major traversal touches a new cache line
+	/// and memory page for almost every pixel. If these lines do not fit
+	/// in cache, next output row has to load them from memory again.
+	/// Plan splits output to square tiles, whose size is chosen from
+	/// the mapping, so one tile reads at most MAX_TILE_INPUT_ROWS input rows.
+	/// Tiles are ordered along Z-order curve of their position in input,
+	/// so following tiles read neighbouring parts of input.
+	///
+	/// Plan is built by Reprojection::BuildGatherPlan and it is used by
+	/// ReprojectDataNerestNeighbor and ReprojectDataBilinear.
+	/// Order of computation does not change results.
+	/// </summary>
+	struct GatherPlan
+	{
+		/// <summary>
+		/// Output rectangle [x0, x1) x [y0, y1)
+		/// </summary>
+		struct Tile
+		{
+			int x0;
+			int y0;
+			int x1;
+			int y1;
+		};
+
+		static const int MIN_TILE_SIZE = 16;
+		static const int MAX_TILE_SIZE = 256;
+
+		//input rows read by one tile (about number of L1 TLB entries)
+		static const int MAX_TILE_INPUT_ROWS = 64;
+
+		//if output row reads at most this number of input rows, their cache lines
+		//(one per row, 512kB) stay in L2 cache for the next output row
+		//and row-major order is faster than tiles
+		static const int ROW_MAJOR_MAX_INPUT_ROWS = 8192;
+
+		//inputs of the first PREFETCH_ROWS rows of the next tile are prefetched before tile is computed
+		static const int PREFETCH_ROWS = 2;
+
+		//every SAMPLE_STEP-th pixel in both directions is used to estimate the mapping
+		static const int SAMPLE_STEP = 16;
+
+		int outW;
+		int outH;
+		int tileSize;
+
+		//tiles in traversal order (empty - row-major order)
+		std::vector<Tile> tiles;
+
+		GatherPlan() :
+			outW(0),
+			outH(0),
+			tileSize(0)
+		{
+		}
+
+		bool IsEmpty() const
+		{
+			return this->tiles.empty();
+		}
+
+		void Clear()
+		{
+			this->tileSize = 0;
+			this->tiles.clear();
+		}
+
+		/// <summary>
+		/// Get size of plan in memory
+		/// </summary>
+		/// <returns></returns>
+		size_t GetBytes() const
+		{
+			return this->tiles.size() * sizeof(Tile);
+		}
+
+		/// <summary>
+		/// Build plan from outW x outH mapping pixels
+		/// If tileSize is 0, it is chosen from the mapping.
+		/// If output rows read only few input rows (mapping is not rotated
+		/// or output is small), row-major order is already local 
+		/// and the plan stays empty.
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="outW"></param>
+		/// <param name="outH"></param>
+		/// <param name="tileSize"></param>
+		template <typename T>
+		void Build(const Pixel<T>* pixels, int outW, int outH, int tileSize = 0)
+		{
+			this->outW = outW;
+			this->outH = outH;
+			this->Clear();
+
+			if ((outW <= 0) || (outH <= 0))
+			{
+				return;
+			}
+
+			if (tileSize <= 0)
+			{
+				tileSize = EstimateTileSize(pixels, outW, outH);
+				if (tileSize <= 0)
+				{
+					return;
+				}
+			}
+
+			this->tileSize = tileSize;
+
+			int tilesX = (outW + tileSize - 1) / tileSize;
+			int tilesY = (outH + tileSize - 1) / tileSize;
+
+			std::vector<uint64_t> keys;
+			keys.reserve(static_cast<size_t>(tilesX) * tilesY);
+			this->tiles.reserve(static_cast<size_t>(tilesX) * tilesY);
+
+			for (int ty = 0; ty < tilesY; ty++)
+			{
+				for (int tx = 0; tx < tilesX; tx++)
+				{
+					Tile t;
+					t.x0 = tx * tileSize;
+					t.y0 = ty * tileSize;
+					t.x1 = std::min(t.x0 + tileSize, outW);
+					t.y1 = std::min(t.y0 + tileSize, outH);
+
+					this->tiles.push_back(t);
+					keys.push_back(GetKey(pixels, outW, t));
+				}
+			}
+
+			std::vector<uint32_t> order(this->tiles.size());
+			std::iota(order.begin(), order.end(), 0);
+			std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+				return keys[a] < keys[b];
+			});
+
+			std::vector<Tile> sorted;
+			sorted.reserve(this->tiles.size());
+			for (uint32_t i : order)
+			{
+				sorted.push_back(this->tiles[i]);
+			}
+			this->tiles = std::move(sorted);
+		}
+
+		/// <summary>
+		/// Hint to load memory at address p to cache
+		/// It never faults, so p can be any address
+		/// </summary>
+		/// <param name="p"></param>
+		static void Prefetch(const void* p)
+		{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+			_mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+			__prefetch(p);
+#elif defined(__GNUC__) || defined(__clang__)
+			__builtin_prefetch(p);
+#else
+			(void)p;
+#endif
+		}
+
+	protected:
+
+		template <typename T>
+		static bool IsValid(const Pixel<T>& p)
+		{
+			return (p.x != -1) && (p.y != -1);
+		}
+
+		/// <summary>
+		/// Choose tile size from sampled mapping
+		/// For sampled pixels, number of input rows crossed by step
+		/// in output x (dx) and in output x + y (dxy) is computed.
+		/// Output row reads about outW * median(dx) input rows and
+		/// tile of size s about s * median(dxy) rows.
+		/// Returns 0 if output row reads at most ROW_MAJOR_MAX_INPUT_ROWS rows
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="outW"></param>
+		/// <param name="outH"></param>
+		/// <returns></returns>
+		template <typename T>
+		static int EstimateTileSize(const Pixel<T>* pixels, int outW, int outH)
+		{
+			std::vector<double> dx;
+			std::vector<double> dxy;
+
+			for (int y = 0; y + 1 < outH; y += SAMPLE_STEP)
+			{
+				for (int x = 0; x + 1 < outW; x += SAMPLE_STEP)
+				{
+					const Pixel<T>& p = pixels[x + static_cast<size_t>(y) * outW];
+					const Pixel<T>& px = pixels[x + 1 + static_cast<size_t>(y) * outW];
+					const Pixel<T>& py = pixels[x + static_cast<size_t>(y + 1) * outW];
+
+					if ((IsValid(p) == false) || (IsValid(px) == false) || (IsValid(py) == false))
+					{
+						continue;
+					}
+
+					double stepX = std::abs(static_cast<double>(px.y) - static_cast<double>(p.y));
+					double stepY = std::abs(static_cast<double>(py.y) - static_cast<double>(p.y));
+
+					dx.push_back(stepX);
+					dxy.push_back(stepX + stepY);
+				}
+			}
+
+			if (dx.empty())
+			{
+				return 0;
+			}
+
+			double medianX = GetMedian(dx);
+			double medianXY = GetMedian(dxy);
+
+			if (medianX * outW <= ROW_MAJOR_MAX_INPUT_ROWS)
+			{
+				return 0;
+			}
+
+			int tileSize = MAX_TILE_SIZE;
+			while ((tileSize > MIN_TILE_SIZE) && (tileSize * medianXY > MAX_TILE_INPUT_ROWS))
+			{
+				tileSize /= 2;
+			}
+			return tileSize;
+		}
+
+		static double GetMedian(std::vector<double>& v)
+		{
+			auto mid = v.begin() + v.size() / 2;
+			std::nth_element(v.begin(), mid, v.end());
+			return *mid;
+		}
+
+		/// <summary>
+		/// Z-order (Morton) key of input position of the tile center pixel.
+		/// If the center pixel is not valid, the first valid pixel of tile 
+		/// (in row-major order) is used instead.
+		/// Input position is quantized to cells of MIN_TILE_SIZE pixels.
+		/// Tiles without valid pixels are last.
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="outW"></param>
+		/// <param name="t"></param>
+		/// <returns></returns>
+		template <typename T>
+		static uint64_t GetKey(const Pixel<T>* pixels, int outW, const Tile& t)
+		{
+			//start from the tile center
+			int cx = (t.x0 + t.x1) / 2;
+			int cy = (t.y0 + t.y1) / 2;
+			const Pixel<T>& c = pixels[cx + static_cast<size_t>(cy) * outW];
+			if (IsValid(c))
+			{
+				return GetMortonKey(c);
+			}
+
+			for (int y = t.y0; y < t.y1; y++)
+			{
+				for (int x = t.x0; x < t.x1; x++)
+				{
+					const Pixel<T>& p = pixels[x + static_cast<size_t>(y) * outW];
+					if (IsValid(p))
+					{
+						return GetMortonKey(p);
+					}
+				}
+			}
+
+			return UINT64_MAX;
+		}
+
+		template <typename T>
+		static uint64_t GetMortonKey(const Pixel<T>& p)
+		{
+			uint32_t x = static_cast<uint32_t>(static_cast<int>(p.x)) / MIN_TILE_SIZE;
+			uint32_t y = static_cast<uint32_t>(static_cast<int>(p.y)) / MIN_TILE_SIZE;
+			return (SpreadBits(y) << 1) | SpreadBits(x);
+		}
+
+		/// <summary>
+		/// Insert zero bit after every bit of v
+		/// </summary>
+		/// <param name="v"></param>
+		/// <returns></returns>
+		static uint64_t SpreadBits(uint32_t v)
+		{
+			uint64_t x = v;
+			x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+			x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+			x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+			x = (x | (x << 2)) & 0x3333333333333333ull;
+			x = (x | (x << 1)) & 0x5555555555555555ull;
+			return x;
+		}
+	};
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define IPROJECTION_INFO_H
 
 #include <functional>
+#include <typeinfo>
 
 #include "MapProjectionStructures.h"
 
@@ -22,6 +23,17 @@ namespace Projections
 
 		virtual Coordinate Transform(const Coordinate& c) const = 0;
 		virtual Coordinate TransformInverse(const Coordinate& c) const = 0;		
+
+		/// <summary>
+		/// Get fingerprint of transform and its parameters
+		/// Default implementation uses only type of transform,
+		/// transforms with parameters should override it
+		/// </summary>
+		/// <returns></returns>
+		virtual uint64_t GetFingerprint() const
+		{
+			return Fingerprint().Add(typeid(*this).name()).Get();
+		}
 	};
 
 
@@ -91,6 +103,8 @@ namespace Projections
 
 		virtual bool IsIndependentLatLon() const = 0;
 		virtual bool IsOrthogonalLatLon() const = 0;
+
+		virtual uint64_t GetFingerprint() const = 0;
 #endif
 	protected:
 		mutable ITransform* transform;
@@ -0,0 +1,309 @@
+#ifndef INPUT_FOOTPRINT_H
+#define INPUT_FOOTPRINT_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "./MapProjectionStructures.h"
+
+namespace Projections
+{
+
+	/// <summary>
+	/// Region of input image that is used by reprojection
+	///
+	/// Bounding rectangle [startX, endX) x [startY, endY) of all valid
+	/// input pixels and [begin, end) range of used columns for every
+	/// input row inside the rectangle (rows[y - startY]).
+	/// Range of row without used pixels is empty (begin == end).
+	///
+	/// Only this region of large inputs (eg. satellite full disk)
+	/// has to be decoded / read / transferred.
+	/// </summary>
+	struct InputFootprint
+	{
+		struct Range
+		{
+			int begin;
+			int end;
+		};
+
+		int startX;
+		int startY;
+		int endX;
+		int endY;
+		std::vector<Range> rows;
+
+		InputFootprint() :
+			startX(0),
+			startY(0),
+			endX(0),
+			endY(0)
+		{
+		}
+
+		bool IsEmpty() const
+		{
+			return this->rows.empty();
+		}
+
+		void Clear()
+		{
+			this->startX = 0;
+			this->startY = 0;
+			this->endX = 0;
+			this->endY = 0;
+			this->rows.clear();
+		}
+
+		int GetWidth() const
+		{
+			return this->endX - this->startX;
+		}
+
+		int GetHeight() const
+		{
+			return this->endY - this->startY;
+		}
+
+		/// <summary>
+		/// Get range of used columns of input row y
+		/// Rows outside of bounding rectangle have empty range
+		/// </summary>
+		/// <param name="y"></param>
+		/// <returns></returns>
+		Range GetRow(int y) const
+		{
+			if ((y < this->startY) || (y >= this->endY))
+			{
+				return { 0, 0 };
+			}
+			return this->rows[y - this->startY];
+		}
+
+		/// <summary>
+		/// Get number of used input pixels
+		/// (sum of all row ranges)
+		/// </summary>
+		/// <returns></returns>
+		size_t GetPixelsCount() const
+		{
+			size_t count = 0;
+			for (const auto& r : this->rows)
+			{
+				count += r.end - r.begin;
+			}
+			return count;
+		}
+
+		/// <summary>
+		/// Build footprint from pixels of reprojection with inW x inH input
+		/// Floating point positions are truncated (as in nearest neighbor)
+		/// 
+		/// Ranges are allocated only for rows between the first and the last
+		/// used input row, so it can be called for every band of output rows
+		/// (see Merge)
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="count"></param>
+		/// <param name="inW"></param>
+		/// <param name="inH"></param>
+		template <typename T>
+		void Build(const Pixel<T>* pixels, size_t count, int inW, int inH)
+		{
+			int minY = inH;
+			int maxY = -1;
+
+			for (size_t i = 0; i < count; i++)
+			{
+				const Pixel<T>& p = pixels[i];
+				if ((p.x == -1) || (p.y == -1))
+				{
+					continue;
+				}
+
+				int y = static_cast<int>(p.y);
+				if (y < minY) minY = y;
+				if (y > maxY) maxY = y;
+			}
+
+			this->Clear();
+
+			if (maxY < minY)
+			{
+				return;
+			}
+
+			this->startY = minY;
+			this->endY = maxY + 1;
+			this->rows.resize(this->endY - this->startY, { inW, 0 });
+
+			for (size_t i = 0; i < count; i++)
+			{
+				const Pixel<T>& p = pixels[i];
+				if ((p.x == -1) || (p.y == -1))
+				{
+					continue;
+				}
+
+				int x = static_cast<int>(p.x);
+
+				Range& r = this->rows[static_cast<int>(p.y) - minY];
+				if (x < r.begin) r.begin = x;
+				if (x >= r.end) r.end = x + 1;
+			}
+
+			this->startX = inW;
+			this->endX = 0;
+
+			for (auto& r : this->rows)
+			{
+				if (r.begin >= r.end)
+				{
+					r = { 0, 0 };
+				}
+				else
+				{
+					this->startX = std::min(this->startX, r.begin);
+					this->endX = std::max(this->endX, r.end);
+				}
+			}
+		}
+
+		/// <summary>
+		/// Build footprint as union of parts 
+		/// (eg. footprints of bands of output rows built in parallel)
+		/// Empty parts are skipped
+		/// </summary>
+		/// <param name="parts"></param>
+		void Merge(const std::vector<InputFootprint>& parts)
+		{
+			this->Clear();
+
+			bool first = true;
+			for (const auto& part : parts)
+			{
+				if (part.IsEmpty())
+				{
+					continue;
+				}
+
+				if (first)
+				{
+					this->startX = part.startX;
+					this->startY = part.startY;
+					this->endX = part.endX;
+					this->endY = part.endY;
+					first = false;
+				}
+				else
+				{
+					this->startX = std::min(this->startX, part.startX);
+					this->startY = std::min(this->startY, part.startY);
+					this->endX = std::max(this->endX, part.endX);
+					this->endY = std::max(this->endY, part.endY);
+				}
+			}
+
+			if (first)
+			{
+				return;
+			}
+
+			this->rows.resize(this->endY - this->startY, { 0, 0 });
+
+			for (const auto& part : parts)
+			{
+				for (int y = part.startY; y < part.endY; y++)
+				{
+					const Range& s = part.rows[y - part.startY];
+					if (s.begin >= s.end)
+					{
+						continue;
+					}
+
+					Range& r = this->rows[y - this->startY];
+					if (r.begin >= r.end)
+					{
+						r = s;
+					}
+					else
+					{
+						r.begin = std::min(r.begin, s.begin);
+						r.end = std::max(r.end, s.end);
+					}
+				}
+			}
+		}
+
+		/// <summary>
+		/// Create footprint enlarged by margin pixels in all directions
+		/// (clamped to inW x inH input). Used for interpolation,
+		/// that reads neighbours of mapped pixels (1 for bilinear, 2 for bicubic)
+		/// </summary>
+		/// <param name="margin"></param>
+		/// <param name="inW"></param>
+		/// <param name="inH"></param>
+		/// <returns></returns>
+		InputFootprint Expand(int margin, int inW, int inH) const
+		{
+			if ((margin <= 0) || (this->IsEmpty()))
+			{
+				return *this;
+			}
+
+			InputFootprint res;
+			res.startX = std::max(0, this->startX - margin);
+			res.startY = std::max(0, this->startY - margin);
+			res.endX = std::min(inW, this->endX + margin);
+			res.endY = std::min(inH, this->endY + margin);
+			res.rows.resize(res.endY - res.startY);
+
+			for (int y = res.startY; y < res.endY; y++)
+			{
+				Range r = { inW, 0 };
+				for (int yy = std::max(this->startY, y - margin); yy < std::min(this->endY, y + margin + 1); yy++)
+				{
+					const Range& s = this->rows[yy - this->startY];
+					if (s.begin >= s.end)
+					{
+						continue;
+					}
+					r.begin = std::min(r.begin, std::max(0, s.begin - margin));
+					r.end = std::max(r.end, std::min(inW, s.end + margin));
+				}
+
+				res.rows[y - res.startY] = (r.begin < r.end) ? r : Range{ 0, 0 };
+			}
+
+			return res;
+		}
+
+		/// <summary>
+		/// Move footprint by [dx, dy]
+		/// Empty row ranges are kept empty
+		/// </summary>
+		/// <param name="dx"></param>
+		/// <param name="dy"></param>
+		void Offset(int dx, int dy)
+		{
+			this->startX += dx;
+			this->startY += dy;
+			this->endX += dx;
+			this->endY += dy;
+
+			for (auto& r : this->rows)
+			{
+				if (r.begin < r.end)
+				{
+					r.begin += dx;
+					r.end += dx;
+				}
+			}
+		}
+	};
+
+};
+
+#endif
@@ -0,0 +1,510 @@
+#ifndef INTERPOLATION_PLAN_H
+#define INTERPOLATION_PLAN_H
+
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include "./MapProjectionStructures.h"
+#include "./ValidSpans.h"
+#include "./Reprojection.h"
+#include "./LanczosFilter.h"
+
+namespace Projections
+{
+
+	/// <summary>
+	/// Bilinear filter for InterpolationPlan
+	/// Same neighbours and weights as Reprojection::InterpolateBilinear
+	/// </summary>
+	struct BilinearFilter
+	{
+		static const int TAPS = 2;
+
+		//offset of the first tap from the pixel
+		static const int ORIGIN = 0;
+
+		//kernel uses exact fractions (see InterpolationPlan::Create)
+		static const bool EXACT_FRACTIONS = true;
+
+		static void GetIndices(int p, int size, int* idx)
+		{
+			idx[0] = p;
+			idx[1] = (p + 1 >= size) ? size - 1 : p + 1;
+		}
+
+		static void GetWeights(double f, double* w)
+		{
+			w[0] = 1.0 - f;
+			w[1] = f;
+		}
+	};
+
+	/// <summary>
+	/// Bicubic (B-spline) filter for InterpolationPlan
+	/// Same neighbours and weights as Reprojection::InterpolateBicubic
+	/// </summary>
+	struct BicubicFilter
+	{
+		static const int TAPS = 4;
+
+		//offset of the first tap from the pixel
+		static const int ORIGIN = -1;
+
+		//kernel uses exact fractions (see InterpolationPlan::Create)
+		static const bool EXACT_FRACTIONS = true;
+
+		static void GetIndices(int p, int size, int* idx)
+		{
+			idx[0] = (p < 1) ? 0 : p - 1;
+			idx[1] = p;
+			idx[2] = (p + 1 >= size) ? size - 1 : p + 1;
+			idx[3] = (p + 2 >= size) ? size - 2 : p + 2;
+		}
+
+		static void GetWeights(double f, double* w)
+		{
+			double g = 1.0 - f;
+
+			w[0] = (g * g * g) / 6.0;
+			w[1] = (4.0 + 3.0 * f * f * f - 6.0 * f * f) / 6.0;
+			w[2] = (4.0 + 3.0 * g * g * g - 6.0 * g * g) / 6.0;
+			w[3] = (f * f * f) / 6.0;
+		}
+	};
+
+	/// <summary>
+	/// Precomputed resampling plan
+	///
+	/// Created once from reprojection with sub-pixel positions
+	/// (float or fixed point). For every valid output pixel it holds
+	/// input pixel offset and fractions quantized to FRACTION_BITS.
+	/// Filter weights of all fractions are precomputed and quantized 
+	/// to WEIGHT_BITS in a small table. Pixels whose taps are clamped 
+	/// at input border are marked, so neighbours of other pixels are 
+	/// at fixed offsets. Apply is then only gather and multiply-accumulate 
+	/// without any per-pixel position or weight math.
+	///
+	/// If the filter kernel uses exact fractions (EXACT_FRACTIONS), floating point data 
+	/// are not accumulated with quantized weights. Plan created from floating point 
+	/// positions keeps the fractions and weights are computed from them.
+	/// Other filters (Lanczos) use quantized weights as their kernels do.
+	///
+	/// Useful if the same reprojection is applied to many inputs
+	/// (time steps, bands) and filter has more taps (bicubic, Lanczos).
+	/// Bilinear weights are cheaper to compute than to load,
+	/// so ReprojectDataBilinear is as fast as the plan.
+	///
+	/// Filter defines TAPS (per axis), ORIGIN, EXACT_FRACTIONS, GetIndices and GetWeights
+	/// (see BilinearFilter, BicubicFilter, LanczosFilter)
+	/// </summary>
+	template <typename Filter>
+	struct InterpolationPlan
+	{
+		static const int TAPS = Filter::TAPS;
+
+		static const int FRACTION_BITS = 8;
+		static const int FRACTIONS_COUNT = 1 << FRACTION_BITS;
+
+		static const int WEIGHT_BITS = 14;
+		static const int32_t WEIGHT_ONE = 1 << WEIGHT_BITS;
+
+		struct Entry
+		{
+			uint32_t offset; //index of input pixel [x, y]
+			uint8_t fx;
+			uint8_t fy;
+			uint8_t border; //1 - some taps are clamped at input border
+			uint8_t reserved;
+		};
+
+		using Weights = std::array<int16_t, TAPS>;
+		using FloatWeights = std::array<double, TAPS>;
+
+		int inW;
+		int inH;
+		int outW;
+		int outH;
+
+		//valid output pixels, entries are stored only for them (in row-major order)
+		ValidSpans validSpans;
+		std::vector<Entry> entries;
+
+		//quantized weights for every fraction
+		std::vector<Weights> weights;
+
+		//weights for every fraction for floating point data (not quantized)
+		//only for filters with EXACT_FRACTIONS
+		std::vector<FloatWeights> weightsFloat;
+
+		//exact [fx, fy] of every entry for floating point data
+		//(empty - fractions of entries are used)
+		std::vector<std::array<float, 2>> fractions;
+
+		InterpolationPlan() :
+			inW(0),
+			inH(0),
+			outW(0),
+			outH(0)
+		{
+		}
+
+		/// <summary>
+		/// Create plan from reprojection
+		/// For integral T, all fractions are 0
+		/// 
+		/// If exactFractions is true (default for floating point T and filters 
+		/// with EXACT_FRACTIONS), fractions of positions are kept (8 bytes per pixel)
+		/// and Apply for floating point data gives the same result as the kernel.
+		/// Plans applied only to integral data can be created without them.
+		/// </summary>
+		/// <param name="reprojection"></param>
+		/// <param name="exactFractions"></param>
+		/// <returns></returns>
+		template <typename T>
+		static InterpolationPlan<Filter> Create(const Reprojection<T>& reprojection, 
+			bool exactFractions = Filter::EXACT_FRACTIONS && std::is_floating_point<T>::value)
+		{
+			InterpolationPlan<Filter> plan;
+			plan.inW = reprojection.inW;
+			plan.inH = reprojection.inH;
+			plan.outW = reprojection.outW;
+			plan.outH = reprojection.outH;
+
+			plan.weights.resize(FRACTIONS_COUNT);
+			for (int i = 0; i < FRACTIONS_COUNT; i++)
+			{
+				FloatWeights w;
+				Filter::GetWeights(static_cast<double>(i) / FRACTIONS_COUNT, w.data());
+				QuantizeWeights(w.data(), WEIGHT_ONE, plan.weights[i]);
+
+				if (Filter::EXACT_FRACTIONS)
+				{
+					plan.weightsFloat.push_back(w);
+				}
+			}
+
+			exactFractions = exactFractions && Filter::EXACT_FRACTIONS && std::is_floating_point<T>::value;
+
+			if (reprojection.validSpans.IsEmpty())
+			{
+				plan.validSpans.Build(reprojection.pixels.data(), plan.outW, plan.outH);
+			}
+			else
+			{
+				plan.validSpans = reprojection.validSpans;
+			}
+
+			plan.entries.reserve(plan.validSpans.GetPixelsCount());
+			if (exactFractions)
+			{
+				plan.fractions.reserve(plan.validSpans.GetPixelsCount());
+			}
+
+			for (int y = 0; y < plan.outH; y++)
+			{
+				const Pixel<T>* row = reprojection.pixels.data() + static_cast<size_t>(y) * plan.outW;
+
+				plan.validSpans.ForEachSpan(y, plan.outW,
+					[](int, int) {},
+					[&](int begin, int end) {
+						for (int x = begin; x < end; x++)
+						{
+							plan.entries.push_back(plan.CreateEntry(row[x], exactFractions));
+						}
+					});
+			}
+
+			return plan;
+		}
+
+		bool IsEmpty() const
+		{
+			return this->validSpans.IsEmpty();
+		}
+
+		/// <summary>
+		/// Get size of plan in memory
+		/// </summary>
+		/// <returns></returns>
+		size_t GetBytes() const
+		{
+			return this->entries.size() * sizeof(Entry) +
+				this->weights.size() * sizeof(Weights) +
+				this->weightsFloat.size() * sizeof(FloatWeights) +
+				this->fractions.size() * sizeof(std::array<float, 2>) +
+				this->validSpans.spans.size() * sizeof(ValidSpans::Span) +
+				this->validSpans.rowOffsets.size() * sizeof(uint32_t);
+		}
+
+		/// <summary>
+		/// Reproject inputData with the plan
+		/// Output array has size outW * outH
+		/// Output array must be released with delete[]
+		///
+		/// Template parameters:
+		/// DataType - type of input data
+		/// Out - output structure - can be raw array of std::vector
+		/// ChannelsCount - number of channels in input / output data
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out = DataType*, size_t ChannelsCount = 1>
+		Out Apply(const DataType* inputData, const DataType NO_VALUE) const
+		{
+			size_t count = static_cast<size_t>(this->outW) * this->outH;
+
+			Out output = Reprojection<int>::template AllocateOutput<DataType, Out, ChannelsCount>(count);
+
+			const Entry* e = this->entries.data();
+
+			//offset of the first tap from the pixel
+			const ptrdiff_t origin = static_cast<ptrdiff_t>(Filter::ORIGIN) * (1 + this->inW);
+
+			//taps of pixels not clamped at border
+			size_t fastRows[TAPS];
+			size_t fastCols[TAPS];
+			for (int i = 0; i < TAPS; i++)
+			{
+				fastRows[i] = static_cast<size_t>(i) * this->inW * ChannelsCount;
+				fastCols[i] = static_cast<size_t>(i) * ChannelsCount;
+			}
+
+			for (int y = 0; y < this->outH; y++)
+			{
+				DataType* rowOut = &output[static_cast<size_t>(y) * this->outW * ChannelsCount];
+
+				this->validSpans.ForEachSpan(y, this->outW,
+					[&](int begin, int end) {
+						//outside of the model - no data - put there NO_VALUE
+						std::fill(rowOut + begin * ChannelsCount, rowOut + end * ChannelsCount, NO_VALUE);
+					},
+					[&](int begin, int end) {
+						for (int x = begin; x < end; x++, e++)
+						{
+							DataType* out = rowOut + x * ChannelsCount;
+
+							if constexpr (std::is_floating_point<DataType>::value && Filter::EXACT_FRACTIONS)
+							{
+								//floating point data - weights are not quantized
+								FloatWeights wx;
+								FloatWeights wy;
+								this->GetFloatWeights(*e, static_cast<size_t>(e - this->entries.data()), wx, wy);
+
+								this->AccumulateEntry<DataType, ChannelsCount>(inputData, *e, origin, fastRows, fastCols, wx, wy, out);
+							}
+							else
+							{
+								this->AccumulateEntry<DataType, ChannelsCount>(inputData, *e, origin, fastRows, fastCols,
+									this->weights[e->fx], this->weights[e->fy], out);
+							}
+						}
+					});
+			}
+
+			return output;
+		}
+
+	protected:
+
+		/// <summary>
+		/// Create entry for position p
+		/// With exact fractions, position is split by truncation (as in the kernel)
+		/// and its fractions are stored to fractions, otherwise 
+		/// fraction that rounds to 1 moves position to the next pixel (see QuantizePosition)
+		/// </summary>
+		/// <param name="p"></param>
+		/// <param name="exactFractions"></param>
+		/// <returns></returns>
+		template <typename T>
+		Entry CreateEntry(const Pixel<T>& p, bool exactFractions)
+		{
+			Entry e;
+			int fx;
+			int fy;
+			int px;
+			int py;
+
+			if (exactFractions)
+			{
+				//no floor, just cast, because values are non-negative
+				px = static_cast<int>(p.x);
+				py = static_cast<int>(p.y);
+
+				std::array<float, 2> f = { static_cast<float>(p.x - px), static_cast<float>(p.y - py) };
+				this->fractions.push_back(f);
+
+				fx = std::min(static_cast<int>(std::lround(f[0] * FRACTIONS_COUNT)), FRACTIONS_COUNT - 1);
+				fy = std::min(static_cast<int>(std::lround(f[1] * FRACTIONS_COUNT)), FRACTIONS_COUNT - 1);
+			}
+			else
+			{
+				px = QuantizePosition<FRACTIONS_COUNT>(p.x, this->inW, fx);
+				py = QuantizePosition<FRACTIONS_COUNT>(p.y, this->inH, fy);
+			}
+
+			e.fx = static_cast<uint8_t>(fx);
+			e.fy = static_cast<uint8_t>(fy);
+
+			e.offset = static_cast<uint32_t>(px + static_cast<size_t>(py) * this->inW);
+			e.reserved = 0;
+
+			//taps at fixed offsets from the pixel?
+			int ix[TAPS];
+			int iy[TAPS];
+			Filter::GetIndices(px, this->inW, ix);
+			Filter::GetIndices(py, this->inH, iy);
+
+			e.border = 0;
+			for (int i = 0; i < TAPS; i++)
+			{
+				if ((ix[i] != px + Filter::ORIGIN + i) || (iy[i] != py + Filter::ORIGIN + i))
+				{
+					e.border = 1;
+				}
+			}
+
+			return e;
+		}
+
+		/// <summary>
+		/// Get weights of entry with given index for floating point data
+		/// (from exact fractions if they are kept)
+		/// </summary>
+		/// <param name="e"></param>
+		/// <param name="index"></param>
+		/// <param name="wx"></param>
+		/// <param name="wy"></param>
+		void GetFloatWeights(const Entry& e, size_t index, FloatWeights& wx, FloatWeights& wy) const
+		{
+			if (this->fractions.empty())
+			{
+				wx = this->weightsFloat[e.fx];
+				wy = this->weightsFloat[e.fy];
+				return;
+			}
+
+			Filter::GetWeights(this->fractions[index][0], wx.data());
+			Filter::GetWeights(this->fractions[index][1], wy.data());
+		}
+
+		/// <summary>
+		/// Weighted sum of taps of entry e (see Accumulate)
+		/// Taps of entries not clamped at border are at fixed offsets (fastRows, fastCols)
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="e"></param>
+		/// <param name="origin"></param>
+		/// <param name="fastRows"></param>
+		/// <param name="fastCols"></param>
+		/// <param name="wx"></param>
+		/// <param name="wy"></param>
+		/// <param name="out"></param>
+		template <typename DataType, size_t ChannelsCount, typename W>
+		void AccumulateEntry(const DataType* inputData, const Entry& e, ptrdiff_t origin, 
+			const size_t* fastRows, const size_t* fastCols, const W& wx, const W& wy, DataType* out) const
+		{
+			if (e.border == 0)
+			{
+				const DataType* p = inputData + (static_cast<ptrdiff_t>(e.offset) + origin) * ChannelsCount;
+
+				Accumulate<DataType, ChannelsCount>(p, fastRows, fastCols, wx, wy, out);
+				return;
+			}
+
+			int ix[TAPS];
+			int iy[TAPS];
+			Filter::GetIndices(static_cast<int>(e.offset % this->inW), this->inW, ix);
+			Filter::GetIndices(static_cast<int>(e.offset / this->inW), this->inH, iy);
+
+			size_t rows[TAPS];
+			size_t cols[TAPS];
+			for (int i = 0; i < TAPS; i++)
+			{
+				rows[i] = static_cast<size_t>(iy[i]) * this->inW * ChannelsCount;
+				cols[i] = static_cast<size_t>(ix[i]) * ChannelsCount;
+			}
+
+			Accumulate<DataType, ChannelsCount>(inputData, rows, cols, wx, wy, out);
+		}
+
+		/// <summary>
+		/// Weighted sum of TAPS x TAPS input pixels
+		/// p[rows[j] + cols[i]] with weights wx[i] * wy[j]
+		/// Integral data are summed with quantized Weights,
+		/// floating point data with Weights (scaled) or FloatWeights
+		/// </summary>
+		/// <param name="p"></param>
+		/// <param name="rows"></param>
+		/// <param name="cols"></param>
+		/// <param name="wx"></param>
+		/// <param name="wy"></param>
+		/// <param name="out"></param>
+		template <typename DataType, size_t ChannelsCount, typename W>
+		static void Accumulate(const DataType* p, const size_t* rows, const size_t* cols,
+			const W& wx, const W& wy, DataType* out)
+		{
+			using Taps = std::make_index_sequence<TAPS>;
+
+			for (size_t c = 0; c < ChannelsCount; c++)
+			{
+				if constexpr (std::is_integral<DataType>::value)
+				{
+					const int SHIFT = 2 * WEIGHT_BITS;
+					const int64_t ROUND = int64_t(1) << (SHIFT - 1);
+
+					//8-bit data with 14-bit weights fits to 32 bits in a single row
+					using RowAcc = typename std::conditional<sizeof(DataType) == 1, int32_t, int64_t>::type;
+
+					int64_t acc = Sum<int64_t, RowAcc>(p + c, rows, cols, wx, wy, Taps{});
+
+					acc = (acc + ROUND) >> SHIFT;
+					acc = std::min<int64_t>(std::max<int64_t>(acc, std::numeric_limits<DataType>::lowest()), std::numeric_limits<DataType>::max());
+
+					out[c] = static_cast<DataType>(acc);
+				}
+				else if constexpr (std::is_integral<typename W::value_type>::value)
+				{
+					const double SCALE = 1.0 / (static_cast<double>(WEIGHT_ONE) * WEIGHT_ONE);
+
+					double acc = Sum<double, double>(p + c, rows, cols, wx, wy, Taps{});
+
+					out[c] = static_cast<DataType>(acc * SCALE);
+				}
+				else
+				{
+					out[c] = static_cast<DataType>(Sum<double, double>(p + c, rows, cols, wx, wy, Taps{}));
+				}
+			}
+		}
+
+		//sums are expanded for all taps at compile time
+
+		template <typename Acc, typename DataType, typename W, size_t... I>
+		static Acc SumRow(const DataType* row, const size_t* cols, const W& wx, std::index_sequence<I...>)
+		{
+			return (Acc(0) + ... + (static_cast<Acc>(row[cols[I]]) * wx[I]));
+		}
+
+		template <typename Acc, typename RowAcc, typename DataType, typename W, size_t... J>
+		static Acc Sum(const DataType* p, const size_t* rows, const size_t* cols,
+			const W& wx, const W& wy, std::index_sequence<J...> taps)
+		{
+			return (Acc(0) + ... + (static_cast<Acc>(SumRow<RowAcc>(p + rows[J], cols, wx, taps)) * wy[J]));
+		}
+	};
+
+	using BicubicPlan = InterpolationPlan<BicubicFilter>;
+	using Lanczos2Plan = InterpolationPlan<LanczosFilter<2>>;
+	using Lanczos3Plan = InterpolationPlan<LanczosFilter<3>>;
+
+};
+
+#endif
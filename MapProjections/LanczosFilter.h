@@ -0,0 +1,148 @@
+#ifndef LANCZOS_FILTER_H
+#define LANCZOS_FILTER_H
+
+#include <array>
+#include <cstdint>
+#include <cmath>
+
+#include "./FixedPoint.h"
+
+namespace Projections
+{
+
+	/// <summary>
+	/// Lanczos (windowed sinc) filter with LOBES lobes
+	/// (Lanczos-2 has 4 x 4 taps, Lanczos-3 has 6 x 6 taps)
+	///
+	/// Weights are not computed per tap. They are precomputed
+	/// for PHASES_COUNT sub-pixel phases (fractions quantized to PHASE_BITS),
+	/// normalized to sum 1 and quantized to WEIGHT_BITS (see Get).
+	/// Table is same as InterpolationPlan<LanczosFilter<LOBES>> weights,
+	/// so Reprojection::ReprojectDataLanczos and the plan give same results.
+	///
+	/// It can be used as InterpolationPlan filter (TAPS, ORIGIN, EXACT_FRACTIONS, GetIndices, GetWeights)
+	/// </summary>
+	template <int LOBES>
+	struct LanczosFilter
+	{
+		static_assert(LOBES >= 1, "Lanczos filter must have at least one lobe");
+
+		static const int TAPS = 2 * LOBES;
+
+		//offset of the first tap from the pixel
+		static const int ORIGIN = 1 - LOBES;
+
+		//kernel uses quantized phases, plan keeps them (see InterpolationPlan::Create)
+		static const bool EXACT_FRACTIONS = false;
+
+		static const int PHASE_BITS = 8;
+		static const int PHASES_COUNT = 1 << PHASE_BITS;
+
+		static const int WEIGHT_BITS = 14;
+		static const int32_t WEIGHT_ONE = 1 << WEIGHT_BITS;
+
+		/// <summary>
+		/// Weights of all phases
+		/// weights[phase][tap] - quantized, sum of every phase is WEIGHT_ONE
+		/// weightsFloat[phase][tap] - same weights divided by WEIGHT_ONE
+		/// </summary>
+		struct Table
+		{
+			std::array<std::array<int32_t, TAPS>, PHASES_COUNT> weights;
+			std::array<std::array<float, TAPS>, PHASES_COUNT> weightsFloat;
+		};
+
+		static const Table& Get()
+		{
+			static const Table table = Create();
+			return table;
+		}
+
+		/// <summary>
+		/// Indices of taps of pixel p clamped to [0, size)
+		/// </summary>
+		/// <param name="p"></param>
+		/// <param name="size"></param>
+		/// <param name="idx"></param>
+		static void GetIndices(int p, int size, int* idx)
+		{
+			for (int i = 0; i < TAPS; i++)
+			{
+				int v = p + ORIGIN + i;
+				idx[i] = (v < 0) ? 0 : ((v >= size) ? size - 1 : v);
+			}
+		}
+
+		/// <summary>
+		/// Normalized weights of taps for fraction f in [0, 1)
+		/// </summary>
+		/// <param name="f"></param>
+		/// <param name="w"></param>
+		static void GetWeights(double f, double* w)
+		{
+			double sum = 0;
+			for (int i = 0; i < TAPS; i++)
+			{
+				w[i] = Kernel(ORIGIN + i - f);
+				sum += w[i];
+			}
+
+			for (int i = 0; i < TAPS; i++)
+			{
+				w[i] /= sum;
+			}
+		}
+
+		/// <summary>
+		/// Split position v to pixel and phase of its fraction
+		/// (see QuantizePosition, same as InterpolationPlan)
+		/// </summary>
+		/// <param name="v"></param>
+		/// <param name="size"></param>
+		/// <param name="phase"></param>
+		/// <returns></returns>
+		template <typename T>
+		static int GetPhase(T v, int size, int& phase)
+		{
+			return QuantizePosition<PHASES_COUNT>(v, size, phase);
+		}
+
+	protected:
+		static double Kernel(double t)
+		{
+			const double PI = 3.14159265358979323846;
+
+			if (t == 0.0)
+			{
+				return 1.0;
+			}
+			if (std::abs(t) >= LOBES)
+			{
+				return 0.0;
+			}
+
+			double a = PI * t;
+			return LOBES * std::sin(a) * std::sin(a / LOBES) / (a * a);
+		}
+
+		static Table Create()
+		{
+			Table table;
+			for (int i = 0; i < PHASES_COUNT; i++)
+			{
+				double w[TAPS];
+				GetWeights(static_cast<double>(i) / PHASES_COUNT, w);
+				QuantizeWeights(w, WEIGHT_ONE, table.weights[i]);
+
+				for (int j = 0; j < TAPS; j++)
+				{
+					table.weightsFloat[i][j] = static_cast<float>(table.weights[i][j]) / WEIGHT_ONE;
+				}
+			}
+			return table;
+		}
+	};
+
+};
+
+#endif
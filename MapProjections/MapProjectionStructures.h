@@ -9,6 +9,8 @@
 #include <ostream>
 
 #include "GeoCoordinate.h"
+#include "Fingerprint.h"
+#include "FixedPoint.h"
 
 #ifdef _MSC_VER
 #	ifndef my_fopen 
@@ -55,7 +57,7 @@ namespace Projections
 
 
 	template <typename PixelType = int,
-    typename = typename std::enable_if<std::is_arithmetic<PixelType>::value, PixelType>::type>
+    typename = typename std::enable_if<std::is_arithmetic<PixelType>::value || IsFixedPoint<PixelType>::value, PixelType>::type>
     struct Pixel
     {
         PixelType x;
@@ -250,6 +252,27 @@ namespace Projections
 
 			return hash;
 		}
+
+		/// <summary>
+		/// Get 64-bit fingerprint of all frame fields
+		/// Unlike GetId, frames that differ in any field 
+		/// (size, padding, step type, wrap around...) have different fingerprint
+		/// </summary>
+		/// <returns></returns>
+		uint64_t GetFingerprint() const
+		{
+			Fingerprint fp;
+			fp.Add(min.lat.rad()).Add(min.lon.rad());
+			fp.Add(max.lat.rad()).Add(max.lon.rad());
+			fp.Add(w).Add(h);
+			fp.Add(wPadding).Add(hPadding);
+			fp.Add(wAR).Add(hAR);
+			fp.Add(projPrecomX).Add(projPrecomY);
+			fp.Add(stepType);
+			fp.Add(repeatNegCount).Add(repeatPosCount);
+			fp.Add(ww).Add(hh);
+			return fp.Get();
+		}
 	};
 
 	//================================================================================================
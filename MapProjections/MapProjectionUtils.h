@@ -54,10 +54,14 @@ namespace Projections
 		static std::array<Longitude, 2> EarthLongitudeRange(Latitude lat, Longitude lng, MyRealType earthRadius, MyRealType distance);
 		static MyRealType CalcEarthRadiusAtLat(Latitude latitude);
 
-        inline static MyRealType cot(MyRealType x) { return 1.0 / std::tan(x); };
-        inline static MyRealType sec(MyRealType x) { return 1.0 / std::cos(x); };
-        inline static MyRealType sinc(MyRealType x) { return std::sin(x) / x; };
-        inline static MyRealType sgn(MyRealType x) { return (x < 0) ? -1 : (x > 0); };
+        template <typename T = MyRealType>
+        inline static T cot(T x) { return T(1) / std::tan(x); };
+        template <typename T = MyRealType>
+        inline static T sec(T x) { return T(1) / std::cos(x); };
+        template <typename T = MyRealType>
+        inline static T sinc(T x) { return std::sin(x) / x; };
+        template <typename T = MyRealType>
+        inline static T sgn(T x) { return (x < 0) ? T(-1) : T(x > 0); };
           
 
 
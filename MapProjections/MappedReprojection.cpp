@@ -0,0 +1,210 @@
+#include "./MappedReprojection.h"
+
+#ifndef MY_LOG_ERROR
+#	define MY_LOG_ERROR(...) printf(__VA_ARGS__)
+#endif
+
+#ifdef _WIN32
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <windows.h>
+#else
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
+
+#include <utility>
+
+using namespace Projections;
+
+//=============================================================================
+// MappedFile
+//=============================================================================
+
+MappedFile::MappedFile() :
+	data(nullptr),
+	size(0)
+#ifdef _WIN32
+	, fileHandle(nullptr),
+	mappingHandle(nullptr)
+#endif
+{
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept :
+	MappedFile()
+{
+	*this = std::move(other);
+}
+
+MappedFile::~MappedFile()
+{
+	this->Close();
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		this->Close();
+
+		std::swap(this->data, other.data);
+		std::swap(this->size, other.size);
+#ifdef _WIN32
+		std::swap(this->fileHandle, other.fileHandle);
+		std::swap(this->mappingHandle, other.mappingHandle);
+#endif
+	}
+	return *this;
+}
+
+/// <summary>
+/// Map whole file to memory as read-only
+/// </summary>
+/// <param name="fileName"></param>
+/// <returns></returns>
+bool MappedFile::Open(const std::string& fileName)
+{
+	this->Close();
+
+#ifdef _WIN32
+	HANDLE hFile = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if ((GetFileSizeEx(hFile, &fileSize) == FALSE) || (fileSize.QuadPart == 0))
+	{
+		CloseHandle(hFile);
+		return false;
+	}
+
+	HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (hMapping == nullptr)
+	{
+		CloseHandle(hFile);
+		return false;
+	}
+
+	void* ptr = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+	if (ptr == nullptr)
+	{
+		CloseHandle(hMapping);
+		CloseHandle(hFile);
+		return false;
+	}
+
+	this->fileHandle = hFile;
+	this->mappingHandle = hMapping;
+	this->data = static_cast<const uint8_t*>(ptr);
+	this->size = static_cast<uint64_t>(fileSize.QuadPart);
+#else
+	int fd = open(fileName.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	struct stat st;
+	if ((fstat(fd, &st) != 0) || (st.st_size == 0))
+	{
+		close(fd);
+		return false;
+	}
+
+	void* ptr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+
+	//mapping is kept alive after file descriptor is closed
+	close(fd);
+
+	if (ptr == MAP_FAILED)
+	{
+		return false;
+	}
+
+	this->data = static_cast<const uint8_t*>(ptr);
+	this->size = static_cast<uint64_t>(st.st_size);
+#endif
+
+	return true;
+}
+
+/// <summary>
+/// Release mapping
+/// </summary>
+void MappedFile::Close()
+{
+	if (this->data == nullptr)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	UnmapViewOfFile(this->data);
+	CloseHandle(this->mappingHandle);
+	CloseHandle(this->fileHandle);
+	this->fileHandle = nullptr;
+	this->mappingHandle = nullptr;
+#else
+	munmap(const_cast<uint8_t*>(this->data), static_cast<size_t>(this->size));
+#endif
+
+	this->data = nullptr;
+	this->size = 0;
+}
+
+//=============================================================================
+// MappedReprojection
+//=============================================================================
+
+/// <summary>
+/// Map reprojection from versioned file
+/// </summary>
+/// <param name="fileName"></param>
+/// <returns></returns>
+template <typename T>
+MappedReprojection<T> MappedReprojection<T>::CreateFromFile(const std::string& fileName)
+{
+	MappedReprojection<T> r;
+
+	if (r.file.Open(fileName) == false)
+	{
+		MY_LOG_ERROR("Failed to map file: \"%s\"\n", fileName.c_str());
+		return r;
+	}
+
+	if (r.file.GetSize() < sizeof(ReprojectionFileHeader))
+	{
+		MY_LOG_ERROR("Invalid reprojection file: \"%s\"\n", fileName.c_str());
+		return MappedReprojection<T>();
+	}
+
+	std::memcpy(&r.header, r.file.GetData(), sizeof(ReprojectionFileHeader));
+
+	if ((r.header.IsValid<T>(r.file.GetSize()) == false) ||
+		(r.header.headerSize % alignof(Pixel<T>) != 0))
+	{
+		MY_LOG_ERROR("Invalid reprojection file header: \"%s\"\n", fileName.c_str());
+		return MappedReprojection<T>();
+	}
+
+	r.inW = r.header.inW;
+	r.inH = r.header.inH;
+	r.outW = r.header.outW;
+	r.outH = r.header.outH;
+	r.pixels = reinterpret_cast<const Pixel<T>*>(r.file.GetData() + r.header.headerSize);
+	r.pixelsCount = static_cast<size_t>(r.header.pixelsCount);
+
+	return r;
+}
+
+template struct Projections::MappedReprojection<int>;
+template struct Projections::MappedReprojection<short>;
+template struct Projections::MappedReprojection<float>;
+template struct Projections::MappedReprojection<Projections::Fixed24_8>;
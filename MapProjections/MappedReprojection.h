@@ -0,0 +1,223 @@
+#ifndef MAPPED_REPROJECTION_H
+#define MAPPED_REPROJECTION_H
+
+#include <string>
+#include <cstdint>
+#include <utility>
+
+#include "./MapProjectionStructures.h"
+#include "./ReprojectionFile.h"
+#include "./Reprojection.h"
+
+namespace Projections
+{
+
+	/// <summary>
+	/// Read-only memory mapped file
+	/// </summary>
+	class MappedFile
+	{
+	public:
+		MappedFile();
+		MappedFile(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		~MappedFile();
+
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		bool Open(const std::string& fileName);
+		void Close();
+
+		const uint8_t* GetData() const { return this->data; }
+		uint64_t GetSize() const { return this->size; }
+
+	protected:
+		const uint8_t* data;
+		uint64_t size;
+
+#ifdef _WIN32
+		void* fileHandle;
+		void* mappingHandle;
+#endif
+	};
+
+	/// <summary>
+	/// Reprojection loaded from versioned file (see ReprojectionFileHeader)
+	/// with memory mapping.
+	///
+	/// Pixels are not copied, they point directly to the mapped file.
+	/// Loading is O(1) and pages of the same file are shared between processes.
+	/// Checksum is not verified during loading (it would read the whole file),
+	/// use VerifyChecksum if needed.
+	///
+	/// Object is movable but not copyable. Mapping is released
+	/// in destructor.
+	/// </summary>
+	template <typename T = int>
+	struct MappedReprojection
+	{
+		ReprojectionFileHeader header;
+
+		int inW;
+		int inH;
+		int outW;
+		int outH;
+		const Pixel<T>* pixels; //[to] = from
+		size_t pixelsCount;
+
+		MappedReprojection() :
+			inW(0),
+			inH(0),
+			outW(0),
+			outH(0),
+			pixels(nullptr),
+			pixelsCount(0)
+		{
+		}
+
+		MappedReprojection(const MappedReprojection&) = delete;
+		MappedReprojection(MappedReprojection&& other) noexcept :
+			MappedReprojection()
+		{
+			*this = std::move(other);
+		}
+
+		MappedReprojection& operator=(const MappedReprojection&) = delete;
+		MappedReprojection& operator=(MappedReprojection&& other) noexcept
+		{
+			if (this != &other)
+			{
+				//mapped address is not changed by move, so pixels stay valid
+				this->file = std::move(other.file);
+				this->header = other.header;
+				this->inW = other.inW;
+				this->inH = other.inH;
+				this->outW = other.outW;
+				this->outH = other.outH;
+				this->pixels = other.pixels;
+				this->pixelsCount = other.pixelsCount;
+
+				other.pixels = nullptr;
+				other.pixelsCount = 0;
+			}
+			return *this;
+		}
+
+		/// <summary>
+		/// Map reprojection from versioned file
+		/// If file is not valid, empty reprojection is returned
+		/// </summary>
+		/// <param name="fileName"></param>
+		/// <returns></returns>
+		static MappedReprojection<T> CreateFromFile(const std::string& fileName);
+
+		/// <summary>
+		/// Test if reprojection is empty (eg. failed to load)
+		/// </summary>
+		/// <returns></returns>
+		bool IsEmpty() const
+		{
+			return (this->pixels == nullptr);
+		}
+
+		/// <summary>
+		/// Calculate checksum of mapped pixels and compare it with header
+		/// </summary>
+		/// <returns></returns>
+		bool VerifyChecksum() const
+		{
+			if (this->pixels == nullptr)
+			{
+				return false;
+			}
+			return ReprojectionFileHeader::CalcChecksum(this->pixels, this->pixelsCount * sizeof(Pixel<T>)) == this->header.checksum;
+		}
+
+		/// <summary>
+		/// Copy mapped pixels to the Reprojection
+		/// Valid spans are built if buildValidSpans is true
+		/// </summary>
+		/// <param name="buildValidSpans"></param>
+		/// <returns></returns>
+		Reprojection<T> ToReprojection(bool buildValidSpans = true) const
+		{
+			Reprojection<T> r;
+			r.inW = this->inW;
+			r.inH = this->inH;
+			r.outW = this->outW;
+			r.outH = this->outH;
+			r.pixels.assign(this->pixels, this->pixels + this->pixelsCount);
+			if (buildValidSpans)
+			{
+				r.BuildValidSpans();
+			}
+			return r;
+		}
+
+		/// <summary>
+		/// Reproject inputData with Nearest Neighbor interpolation
+		/// (see Reprojection::ReprojectDataNerestNeighbor)
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out = DataType*, size_t ChannelsCount = 1>
+		Out ReprojectDataNerestNeighbor(const DataType* inputData, const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			const int w = this->inW;
+
+			return Reprojection<T>::template ReprojectData<DataType, Out, ChannelsCount>(this->pixels, this->outW, this->outH, nullptr, NO_VALUE,
+				[=](T x, T y, DataType* out) {
+				Reprojection<T>::template CopyNerestNeighbor<DataType, ChannelsCount>(inputData, w, static_cast<int>(x), static_cast<int>(y), out);
+			}, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject inputData with Bilinear interpolation
+		/// (see Reprojection::ReprojectDataBilinear)
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out = DataType*, size_t ChannelsCount = 1>
+		Out ReprojectDataBilinear(const DataType* inputData, const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			const int w = this->inW;
+			const int h = this->inH;
+
+			return Reprojection<T>::template ReprojectData<DataType, Out, ChannelsCount>(this->pixels, this->outW, this->outH, nullptr, NO_VALUE,
+				[=](T x, T y, DataType* out) {
+				Reprojection<T>::template InterpolateBilinear<DataType, ChannelsCount>(inputData, w, h, x, y, out);
+			}, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject inputData with Bicubic interpolation
+		/// (see Reprojection::ReprojectDataBicubic)
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out = DataType*, size_t ChannelsCount = 1>
+		Out ReprojectDataBicubic(const DataType* inputData, const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			const int w = this->inW;
+			const int h = this->inH;
+
+			return Reprojection<T>::template ReprojectData<DataType, Out, ChannelsCount>(this->pixels, this->outW, this->outH, nullptr, NO_VALUE,
+				[=](T x, T y, DataType* out) {
+				Reprojection<T>::template InterpolateBicubic<DataType, ChannelsCount>(inputData, w, h, x, y, out);
+			}, threadsCount);
+		}
+
+	protected:
+		MappedFile file;
+	};
+
+};
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef PARALLEL_UTILS_H
+#define PARALLEL_UTILS_H
+
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+
+namespace Projections
+{
+
+	struct ParallelUtils
+	{
+		/// <summary>
+		/// Size of data processed by one band of rows
+		/// (fits in L2 cache of a core)
+		/// </summary>
+		static const size_t CACHE_BLOCK_BYTES = 256 * 1024;
+
+		/// <summary>
+		/// Get number of threads that will be really used
+		/// If threadsCount is 0, number of hardware threads is used
+		/// </summary>
+		/// <param name="threadsCount"></param>
+		/// <returns></returns>
+		static size_t GetThreadsCount(size_t threadsCount)
+		{
+			if (threadsCount == 0)
+			{
+				threadsCount = std::thread::hardware_concurrency();
+			}
+			return (threadsCount == 0) ? 1 : threadsCount;
+		}
+
+		/// <summary>
+		/// Get number of rows with rowBytes, that fit in CACHE_BLOCK_BYTES
+		/// Band has at least 1 row
+		/// </summary>
+		/// <param name="rowBytes"></param>
+		/// <returns></returns>
+		static int GetCacheRowBandSize(size_t rowBytes)
+		{
+			if (rowBytes == 0)
+			{
+				return 1;
+			}
+			return static_cast<int>(std::max<size_t>(1, CACHE_BLOCK_BYTES / rowBytes));
+		}
+
+		/// <summary>
+		/// Split rows [0, rowsCount) to bands of bandSize rows and call
+		/// callback(startRow, endRow) for every band.
+		/// Each band is processed exactly once.
+		///
+		/// Bands are distributed with work stealing:
+		/// Every thread owns a continuous range of bands and takes them from its front.
+		/// If thread has finished its own range, it steals bands from the back
+		/// of other threads ranges. This way, cheap rows (eg. rows outside
+		/// of the projection with no data) do not leave threads idle.
+		///
+		/// If threadsCount is 0, number of hardware threads is used
+		/// If threadsCount is 1, callback is run directly on the calling thread
+		/// </summary>
+		/// <param name="rowsCount"></param>
+		/// <param name="bandSize"></param>
+		/// <param name="threadsCount"></param>
+		/// <param name="callback"></param>
+		static void RunRowBands(int rowsCount, int bandSize, size_t threadsCount,
+			const std::function<void(int startRow, int endRow)>& callback)
+		{
+			if (rowsCount <= 0)
+			{
+				return;
+			}
+
+			bandSize = std::max(1, bandSize);
+
+			uint32_t bandsCount = static_cast<uint32_t>((rowsCount + bandSize - 1) / bandSize);
+
+			threadsCount = std::min<size_t>(GetThreadsCount(threadsCount), bandsCount);
+			if (threadsCount <= 1)
+			{
+				callback(0, rowsCount);
+				return;
+			}
+
+			//range of bands owned by thread packed as [begin (upper 32 bits), end (lower 32 bits))
+			//both owner and thieves modify it with CAS, so no band is taken twice
+			struct alignas(64) BandRange
+			{
+				std::atomic<uint64_t> range;
+			};
+
+			std::unique_ptr<BandRange[]> ranges(new BandRange[threadsCount]);
+			for (size_t i = 0; i < threadsCount; i++)
+			{
+				uint64_t begin = (bandsCount * i) / threadsCount;
+				uint64_t end = (bandsCount * (i + 1)) / threadsCount;
+				ranges[i].range.store((begin << 32) | end);
+			}
+
+			auto runBand = [&](uint32_t band) {
+				int startRow = static_cast<int>(band) * bandSize;
+				int endRow = std::min(startRow + bandSize, rowsCount);
+				callback(startRow, endRow);
+			};
+
+			auto worker = [&](size_t threadId) {
+				while (true)
+				{
+					uint32_t band;
+					if (PopFront(ranges[threadId].range, band))
+					{
+						runBand(band);
+						continue;
+					}
+
+					bool stolen = false;
+					for (size_t i = 1; i < threadsCount; i++)
+					{
+						size_t victim = (threadId + i) % threadsCount;
+						if (PopBack(ranges[victim].range, band))
+						{
+							stolen = true;
+							break;
+						}
+					}
+
+					if (stolen == false)
+					{
+						//ranges only shrink - if all are empty, we are done
+						return;
+					}
+
+					runBand(band);
+				}
+			};
+
+			std::vector<std::thread> threads;
+			threads.reserve(threadsCount - 1);
+			for (size_t i = 1; i < threadsCount; i++)
+			{
+				threads.emplace_back(worker, i);
+			}
+
+			worker(0);
+
+			for (auto& t : threads)
+			{
+				t.join();
+			}
+		}
+
+	protected:
+
+		static bool PopFront(std::atomic<uint64_t>& range, uint32_t& band)
+		{
+			uint64_t cur = range.load();
+			while (true)
+			{
+				uint32_t begin = static_cast<uint32_t>(cur >> 32);
+				uint32_t end = static_cast<uint32_t>(cur);
+				if (begin >= end)
+				{
+					return false;
+				}
+
+				uint64_t next = (static_cast<uint64_t>(begin + 1) << 32) | end;
+				if (range.compare_exchange_weak(cur, next))
+				{
+					band = begin;
+					return true;
+				}
+			}
+		}
+
+		static bool PopBack(std::atomic<uint64_t>& range, uint32_t& band)
+		{
+			uint64_t cur = range.load();
+			while (true)
+			{
+				uint32_t begin = static_cast<uint32_t>(cur >> 32);
+				uint32_t end = static_cast<uint32_t>(cur);
+				if (begin >= end)
+				{
+					return false;
+				}
+
+				uint64_t next = (static_cast<uint64_t>(begin) << 32) | (end - 1);
+				if (range.compare_exchange_weak(cur, next))
+				{
+					band = end - 1;
+					return true;
+				}
+			}
+		}
+	};
+
+};
+
+#endif
@@ -0,0 +1,1281 @@
+#include "./PngStreamDecoder.h"
+
+#ifndef MY_LOG_ERROR
+#	define MY_LOG_ERROR(...) printf(__VA_ARGS__)
+#endif
+
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <functional>
+#include <algorithm>
+
+#include "./lodepng.h"
+
+namespace Projections
+{
+
+	/// <summary>
+	/// Incremental decoder of zlib stream (RFC 1950, 1951)
+	/// Compressed data are pulled from source when they are needed
+	/// and output is produced in parts of any size.
+	/// Only the last 32kB of output (window for back references) is kept.
+	/// </summary>
+	class PngInflater
+	{
+	public:
+		//returns next part of compressed data, false at the end of data
+		using Source = std::function<bool(const uint8_t*& data, size_t& size)>;
+
+		explicit PngInflater(Source source);
+
+		bool Read(uint8_t* out, size_t count);
+		bool Finish();
+
+	protected:
+		static const int WINDOW_SIZE = 32768;
+		static const int WINDOW_MASK = WINDOW_SIZE - 1;
+
+		/// <summary>
+		/// Canonical Huffman code
+		/// Codes up to FAST_BITS are decoded by single table lookup,
+		/// longer codes bit by bit
+		/// </summary>
+		struct Huffman
+		{
+			static const int MAX_BITS = 15;
+			static const int FAST_BITS = 10;
+
+			uint16_t counts[MAX_BITS + 1];
+			uint16_t symbols[288];
+
+			//(length << 9) | symbol, 0 - code is longer than FAST_BITS
+			uint16_t fast[1 << FAST_BITS];
+
+			bool Build(const uint8_t* lengths, int count);
+		};
+
+		enum class State
+		{
+			ZLIB_HEADER,
+			BLOCK_HEADER,
+			STORED,
+			HUFFMAN,
+			DONE,
+			FAILED
+		};
+
+		Source source;
+		const uint8_t* in;
+		size_t inSize;
+		bool inEnd;
+
+		uint64_t bitBuffer;
+		int bitCount;
+
+		State state;
+		bool lastBlock;
+		uint32_t storedRemaining;
+
+		Huffman literals;
+		Huffman distances;
+
+		//unfinished back reference
+		int matchRemaining;
+		int matchDistance;
+
+		std::vector<uint8_t> window;
+		uint32_t windowPos;
+		uint64_t totalOut;
+
+		uint32_t adlerA;
+		uint32_t adlerB;
+
+		bool Fail(const char* msg);
+		void Refill();
+		bool GetBits(int count, uint32_t& v);
+		bool DecodeSymbol(const Huffman& huffman, int& symbol);
+		bool ReadZlibHeader();
+		bool ReadBlockHeader();
+		bool ReadDynamicCodes();
+		bool ReadAdler();
+		bool EndBlock(uint8_t*& flushed, uint8_t* out);
+		void UpdateAdler(const uint8_t* data, size_t size);
+	};
+
+}
+
+using namespace Projections;
+
+//=============================================================================
+// PngInflater
+//=============================================================================
+
+static const uint16_t LENGTH_BASE[29] = {
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+	35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+
+static const uint8_t LENGTH_EXTRA[29] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+	3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+
+static const uint16_t DISTANCE_BASE[30] = {
+	1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+	257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+
+static const uint8_t DISTANCE_EXTRA[30] = {
+	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+	7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+//order of code length codes in dynamic block header
+static const uint8_t CODE_LENGTH_ORDER[19] = {
+	16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+bool PngInflater::Huffman::Build(const uint8_t* lengths, int count)
+{
+	std::fill(this->counts, this->counts + MAX_BITS + 1, 0);
+	std::fill(this->fast, this->fast + (1 << FAST_BITS), 0);
+
+	for (int i = 0; i < count; i++)
+	{
+		this->counts[lengths[i]]++;
+	}
+	this->counts[0] = 0;
+
+	//over-subscribed code is invalid, incomplete code is allowed
+	int left = 1;
+	for (int len = 1; len <= MAX_BITS; len++)
+	{
+		left <<= 1;
+		left -= this->counts[len];
+		if (left < 0)
+		{
+			return false;
+		}
+	}
+
+	uint16_t offsets[MAX_BITS + 2];
+	offsets[1] = 0;
+	for (int len = 1; len <= MAX_BITS; len++)
+	{
+		offsets[len + 1] = offsets[len] + this->counts[len];
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		if (lengths[i] != 0)
+		{
+			this->symbols[offsets[lengths[i]]++] = static_cast<uint16_t>(i);
+		}
+	}
+
+	//codes are stored from the most significant bit, stream is read
+	//from the least significant bit - table index is reversed code
+	int code = 0;
+	int index = 0;
+	for (int len = 1; len <= FAST_BITS; len++)
+	{
+		for (int i = 0; i < this->counts[len]; i++, code++, index++)
+		{
+			int reversed = 0;
+			for (int b = 0; b < len; b++)
+			{
+				reversed |= ((code >> b) & 1) << (len - 1 - b);
+			}
+
+			for (int j = reversed; j < (1 << FAST_BITS); j += (1 << len))
+			{
+				this->fast[j] = static_cast<uint16_t>((len << 9) | this->symbols[index]);
+			}
+		}
+		code <<= 1;
+	}
+
+	return true;
+}
+
+PngInflater::PngInflater(Source source) :
+	source(source),
+	in(nullptr),
+	inSize(0),
+	inEnd(false),
+	bitBuffer(0),
+	bitCount(0),
+	state(State::ZLIB_HEADER),
+	lastBlock(false),
+	storedRemaining(0),
+	matchRemaining(0),
+	matchDistance(0),
+	window(WINDOW_SIZE),
+	windowPos(0),
+	totalOut(0),
+	adlerA(1),
+	adlerB(0)
+{
+}
+
+bool PngInflater::Fail(const char* msg)
+{
+	if (this->state != State::FAILED)
+	{
+		MY_LOG_ERROR("Failed to inflate PNG data: %s\n", msg);
+	}
+	this->state = State::FAILED;
+	return false;
+}
+
+/// <summary>
+/// Fill bit buffer with at least 57 bits if data are available
+/// </summary>
+void PngInflater::Refill()
+{
+	while (this->bitCount <= 56)
+	{
+		if (this->inSize == 0)
+		{
+			if ((this->inEnd) || (this->source(this->in, this->inSize) == false))
+			{
+				this->inEnd = true;
+				this->inSize = 0;
+				return;
+			}
+			continue;
+		}
+
+		this->bitBuffer |= static_cast<uint64_t>(*this->in) << this->bitCount;
+		this->bitCount += 8;
+		this->in++;
+		this->inSize--;
+	}
+}
+
+bool PngInflater::GetBits(int count, uint32_t& v)
+{
+	if (this->bitCount < count)
+	{
+		this->Refill();
+		if (this->bitCount < count)
+		{
+			return this->Fail("unexpected end of data");
+		}
+	}
+
+	v = static_cast<uint32_t>(this->bitBuffer & ((uint64_t(1) << count) - 1));
+	this->bitBuffer >>= count;
+	this->bitCount -= count;
+	return true;
+}
+
+bool PngInflater::DecodeSymbol(const Huffman& huffman, int& symbol)
+{
+	if (this->bitCount < Huffman::MAX_BITS)
+	{
+		this->Refill();
+	}
+
+	//missing bits at the end of data are zeros, their use is checked below
+	uint16_t entry = huffman.fast[this->bitBuffer & ((1 << Huffman::FAST_BITS) - 1)];
+	if (entry != 0)
+	{
+		int len = entry >> 9;
+		if (len > this->bitCount)
+		{
+			return this->Fail("unexpected end of data");
+		}
+
+		symbol = entry & 0x1FF;
+		this->bitBuffer >>= len;
+		this->bitCount -= len;
+		return true;
+	}
+
+	int code = 0;
+	int first = 0;
+	int index = 0;
+	for (int len = 1; len <= Huffman::MAX_BITS; len++)
+	{
+		if (len > this->bitCount)
+		{
+			return this->Fail("unexpected end of data");
+		}
+
+		code |= static_cast<int>((this->bitBuffer >> (len - 1)) & 1);
+		int count = huffman.counts[len];
+		if (code - count < first)
+		{
+			symbol = huffman.symbols[index + (code - first)];
+			this->bitBuffer >>= len;
+			this->bitCount -= len;
+			return true;
+		}
+		index += count;
+		first += count;
+		first <<= 1;
+		code <<= 1;
+	}
+
+	return this->Fail("invalid Huffman code");
+}
+
+bool PngInflater::ReadZlibHeader()
+{
+	uint32_t cmf, flg;
+	if ((this->GetBits(8, cmf) == false) || (this->GetBits(8, flg) == false))
+	{
+		return false;
+	}
+
+	if ((((cmf << 8) | flg) % 31) != 0) return this->Fail("invalid zlib header");
+	if ((cmf & 15) != 8) return this->Fail("unsupported compression method");
+	if ((cmf >> 4) > 7) return this->Fail("invalid window size");
+	if (flg & 32) return this->Fail("preset dictionary is not allowed");
+
+	this->state = State::BLOCK_HEADER;
+	return true;
+}
+
+bool PngInflater::ReadBlockHeader()
+{
+	uint32_t v;
+	if (this->GetBits(3, v) == false)
+	{
+		return false;
+	}
+
+	this->lastBlock = (v & 1) != 0;
+	uint32_t type = v >> 1;
+
+	if (type == 0)
+	{
+		//stored block starts at byte boundary
+		this->bitBuffer >>= (this->bitCount & 7);
+		this->bitCount -= (this->bitCount & 7);
+
+		uint32_t len, nlen;
+		if ((this->GetBits(16, len) == false) || (this->GetBits(16, nlen) == false))
+		{
+			return false;
+		}
+		if (len != (~nlen & 0xFFFF))
+		{
+			return this->Fail("invalid stored block length");
+		}
+
+		this->storedRemaining = len;
+		this->state = State::STORED;
+		return true;
+	}
+
+	if (type == 1)
+	{
+		uint8_t lengths[288 + 32];
+		std::fill(lengths, lengths + 144, 8);
+		std::fill(lengths + 144, lengths + 256, 9);
+		std::fill(lengths + 256, lengths + 280, 7);
+		std::fill(lengths + 280, lengths + 288, 8);
+		std::fill(lengths + 288, lengths + 288 + 32, 5);
+
+		this->literals.Build(lengths, 288);
+		this->distances.Build(lengths + 288, 32);
+
+		this->state = State::HUFFMAN;
+		return true;
+	}
+
+	if (type == 2)
+	{
+		if (this->ReadDynamicCodes() == false)
+		{
+			return false;
+		}
+
+		this->state = State::HUFFMAN;
+		return true;
+	}
+
+	return this->Fail("invalid block type");
+}
+
+bool PngInflater::ReadDynamicCodes()
+{
+	uint32_t hlit, hdist, hclen;
+	if ((this->GetBits(5, hlit) == false) || (this->GetBits(5, hdist) == false) || (this->GetBits(4, hclen) == false))
+	{
+		return false;
+	}
+
+	hlit += 257;
+	hdist += 1;
+	hclen += 4;
+
+	if ((hlit > 286) || (hdist > 30))
+	{
+		return this->Fail("invalid dynamic block header");
+	}
+
+	uint8_t codeLengths[19] = {};
+	for (uint32_t i = 0; i < hclen; i++)
+	{
+		uint32_t v;
+		if (this->GetBits(3, v) == false)
+		{
+			return false;
+		}
+		codeLengths[CODE_LENGTH_ORDER[i]] = static_cast<uint8_t>(v);
+	}
+
+	Huffman codeLengthCode;
+	if (codeLengthCode.Build(codeLengths, 19) == false)
+	{
+		return this->Fail("invalid code lengths code");
+	}
+
+	uint8_t lengths[286 + 30];
+	uint32_t count = 0;
+	while (count < hlit + hdist)
+	{
+		int symbol;
+		if (this->DecodeSymbol(codeLengthCode, symbol) == false)
+		{
+			return false;
+		}
+
+		if (symbol < 16)
+		{
+			lengths[count++] = static_cast<uint8_t>(symbol);
+			continue;
+		}
+
+		uint8_t value = 0;
+		uint32_t repeat = 0;
+		if (symbol == 16)
+		{
+			if (count == 0)
+			{
+				return this->Fail("repeat of missing code length");
+			}
+			value = lengths[count - 1];
+			if (this->GetBits(2, repeat) == false) return false;
+			repeat += 3;
+		}
+		else if (symbol == 17)
+		{
+			if (this->GetBits(3, repeat) == false) return false;
+			repeat += 3;
+		}
+		else
+		{
+			if (this->GetBits(7, repeat) == false) return false;
+			repeat += 11;
+		}
+
+		if (count + repeat > hlit + hdist)
+		{
+			return this->Fail("too many code lengths");
+		}
+
+		std::fill(lengths + count, lengths + count + repeat, value);
+		count += repeat;
+	}
+
+	if (lengths[256] == 0)
+	{
+		return this->Fail("missing end of block code");
+	}
+
+	if ((this->literals.Build(lengths, hlit) == false) || (this->distances.Build(lengths + hlit, hdist) == false))
+	{
+		return this->Fail("invalid Huffman code lengths");
+	}
+
+	return true;
+}
+
+/// <summary>
+/// End of block - next block header follows or, after the last block,
+/// the stream checksum (output up to out is added to checksum first)
+/// </summary>
+/// <param name="flushed"></param>
+/// <param name="out"></param>
+/// <returns></returns>
+bool PngInflater::EndBlock(uint8_t*& flushed, uint8_t* out)
+{
+	if (this->lastBlock == false)
+	{
+		this->state = State::BLOCK_HEADER;
+		return true;
+	}
+
+	this->totalOut += out - flushed;
+	this->UpdateAdler(flushed, out - flushed);
+	flushed = out;
+
+	return this->ReadAdler();
+}
+
+bool PngInflater::ReadAdler()
+{
+	//checksum starts at byte boundary, it is stored as big endian
+	this->bitBuffer >>= (this->bitCount & 7);
+	this->bitCount -= (this->bitCount & 7);
+
+	uint32_t adler = 0;
+	for (int i = 0; i < 4; i++)
+	{
+		uint32_t v;
+		if (this->GetBits(8, v) == false)
+		{
+			return false;
+		}
+		adler = (adler << 8) | v;
+	}
+
+	if (adler != ((this->adlerB << 16) | this->adlerA))
+	{
+		return this->Fail("Adler-32 checksum mismatch");
+	}
+
+	this->state = State::DONE;
+	return true;
+}
+
+void PngInflater::UpdateAdler(const uint8_t* data, size_t size)
+{
+	//5552 is the largest count for which sums do not overflow before modulo
+	while (size > 0)
+	{
+		size_t n = std::min<size_t>(size, 5552);
+		for (size_t i = 0; i < n; i++)
+		{
+			this->adlerA += data[i];
+			this->adlerB += this->adlerA;
+		}
+		this->adlerA %= 65521;
+		this->adlerB %= 65521;
+
+		data += n;
+		size -= n;
+	}
+}
+
+/// <summary>
+/// Decompress next count bytes to out
+/// Returns false if stream ends before count bytes or data are invalid
+/// </summary>
+/// <param name="out"></param>
+/// <param name="count"></param>
+/// <returns></returns>
+bool PngInflater::Read(uint8_t* out, size_t count)
+{
+	//output before flushed is already included in checksum
+	uint8_t* flushed = out;
+	uint8_t* const end = out + count;
+	uint8_t* window = this->window.data();
+
+	while (out < end)
+	{
+		if (this->matchRemaining > 0)
+		{
+			int n = static_cast<int>(std::min<ptrdiff_t>(this->matchRemaining, end - out));
+			uint32_t from = this->windowPos - this->matchDistance;
+			for (int i = 0; i < n; i++)
+			{
+				uint8_t b = window[(from + i) & WINDOW_MASK];
+				window[(this->windowPos + i) & WINDOW_MASK] = b;
+				out[i] = b;
+			}
+			this->windowPos += n;
+			this->matchRemaining -= n;
+			out += n;
+			continue;
+		}
+
+		if (this->state == State::HUFFMAN)
+		{
+			int symbol;
+			if (this->DecodeSymbol(this->literals, symbol) == false)
+			{
+				return false;
+			}
+
+			if (symbol < 256)
+			{
+				window[this->windowPos & WINDOW_MASK] = static_cast<uint8_t>(symbol);
+				this->windowPos++;
+				*out++ = static_cast<uint8_t>(symbol);
+				continue;
+			}
+
+			if (symbol == 256)
+			{
+				if (this->EndBlock(flushed, out) == false)
+				{
+					return false;
+				}
+				continue;
+			}
+
+			symbol -= 257;
+			if (symbol >= 29)
+			{
+				return this->Fail("invalid length code");
+			}
+
+			uint32_t extra;
+			if (this->GetBits(LENGTH_EXTRA[symbol], extra) == false)
+			{
+				return false;
+			}
+			int length = LENGTH_BASE[symbol] + extra;
+
+			int distanceSymbol;
+			if (this->DecodeSymbol(this->distances, distanceSymbol) == false)
+			{
+				return false;
+			}
+			if (distanceSymbol >= 30)
+			{
+				return this->Fail("invalid distance code");
+			}
+			if (this->GetBits(DISTANCE_EXTRA[distanceSymbol], extra) == false)
+			{
+				return false;
+			}
+			int distance = DISTANCE_BASE[distanceSymbol] + extra;
+
+			if (static_cast<uint64_t>(distance) > this->totalOut + (out - flushed))
+			{
+				return this->Fail("distance is too far back");
+			}
+
+			this->matchRemaining = length;
+			this->matchDistance = distance;
+			continue;
+		}
+
+		if (this->state == State::STORED)
+		{
+			if (this->storedRemaining == 0)
+			{
+				if (this->EndBlock(flushed, out) == false)
+				{
+					return false;
+				}
+				continue;
+			}
+
+			uint32_t v;
+			if (this->GetBits(8, v) == false)
+			{
+				return false;
+			}
+			window[this->windowPos & WINDOW_MASK] = static_cast<uint8_t>(v);
+			this->windowPos++;
+			*out++ = static_cast<uint8_t>(v);
+			this->storedRemaining--;
+			continue;
+		}
+
+		if (this->state == State::BLOCK_HEADER)
+		{
+			if (this->ReadBlockHeader() == false)
+			{
+				return false;
+			}
+			continue;
+		}
+
+		if (this->state == State::ZLIB_HEADER)
+		{
+			if (this->ReadZlibHeader() == false)
+			{
+				return false;
+			}
+			continue;
+		}
+
+		if (this->state == State::DONE)
+		{
+			return this->Fail("unexpected end of data");
+		}
+
+		return false;
+	}
+
+	this->totalOut += end - flushed;
+	this->UpdateAdler(flushed, end - flushed);
+	return true;
+}
+
+/// <summary>
+/// Read the rest of the stream after all expected output was read
+/// and verify its checksum
+/// </summary>
+/// <returns></returns>
+bool PngInflater::Finish()
+{
+	uint8_t* none = nullptr;
+
+	while (this->state != State::DONE)
+	{
+		if (this->state == State::FAILED)
+		{
+			return false;
+		}
+
+		if ((this->matchRemaining > 0) || ((this->state == State::STORED) && (this->storedRemaining > 0)))
+		{
+			return this->Fail("more data than expected");
+		}
+
+		bool ok = true;
+		if (this->state == State::HUFFMAN)
+		{
+			int symbol;
+			ok = this->DecodeSymbol(this->literals, symbol) && 
+				((symbol == 256) ? this->EndBlock(none, none) : this->Fail("more data than expected"));
+		}
+		else if (this->state == State::STORED)
+		{
+			ok = this->EndBlock(none, none);
+		}
+		else if (this->state == State::BLOCK_HEADER)
+		{
+			ok = this->ReadBlockHeader();
+		}
+		else if (this->state == State::ZLIB_HEADER)
+		{
+			ok = this->ReadZlibHeader();
+		}
+
+		if (ok == false)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//=============================================================================
+// PngStreamDecoder
+//=============================================================================
+
+PngStreamDecoder::PngStreamDecoder() :
+	memory(nullptr),
+	memorySize(0),
+	memoryPos(0),
+	w(0),
+	h(0),
+	colorType(0),
+	bitDepth(0),
+	channelsCount(0),
+	bytesPerPixel(0),
+	scanlineSize(0),
+	paletteAlpha(false),
+	idatRemaining(0),
+	idatCrc(0),
+	idatFinished(false),
+	rowIndex(0)
+{
+}
+
+PngStreamDecoder::~PngStreamDecoder()
+{
+	this->Close();
+}
+
+/// <summary>
+/// Open PNG file and read its header
+/// File is then read in blocks by ReadRow
+/// </summary>
+/// <param name="fileName"></param>
+/// <returns></returns>
+bool PngStreamDecoder::Open(const std::string& fileName)
+{
+	this->Close();
+
+	this->file.open(fileName, std::ios::binary);
+	if (this->file.is_open() == false)
+	{
+		MY_LOG_ERROR("Failed to open file %s\n", fileName.c_str());
+		return false;
+	}
+
+	return this->ReadHeader();
+}
+
+/// <summary>
+/// Open PNG in memory and read its header
+/// Data are not copied, they must be valid until Close
+/// </summary>
+/// <param name="data"></param>
+/// <param name="size"></param>
+/// <returns></returns>
+bool PngStreamDecoder::Open(const uint8_t* data, size_t size)
+{
+	this->Close();
+
+	this->memory = data;
+	this->memorySize = size;
+	this->memoryPos = 0;
+
+	return this->ReadHeader();
+}
+
+void PngStreamDecoder::Close()
+{
+	if (this->file.is_open())
+	{
+		this->file.close();
+	}
+	this->file.clear();
+
+	this->memory = nullptr;
+	this->memorySize = 0;
+	this->memoryPos = 0;
+
+	this->w = 0;
+	this->h = 0;
+	this->colorType = 0;
+	this->bitDepth = 0;
+	this->channelsCount = 0;
+	this->bytesPerPixel = 0;
+	this->scanlineSize = 0;
+
+	this->palette.clear();
+	this->paletteAlpha = false;
+
+	this->scanline.clear();
+	this->previousScanline.clear();
+
+	this->idatRemaining = 0;
+	this->idatCrc = 0;
+	this->idatFinished = false;
+	this->idatBuffer.clear();
+
+	this->inflater = nullptr;
+	this->rowIndex = 0;
+}
+
+/// <summary>
+/// Decode next row to row (GetRowSize() elements)
+/// Image must have 8 bits per sample
+/// </summary>
+/// <param name="row"></param>
+/// <returns></returns>
+bool PngStreamDecoder::ReadRow(uint8_t* row)
+{
+	if (this->bitDepth != 8)
+	{
+		MY_LOG_ERROR("PNG has %u bits per sample, use ReadRow(uint16_t*)\n", this->bitDepth);
+		return false;
+	}
+
+	if (this->DecodeScanline() == false)
+	{
+		return false;
+	}
+
+	if (this->colorType != LCT_PALETTE)
+	{
+		std::memcpy(row, this->scanline.data(), this->scanlineSize);
+		return true;
+	}
+
+	for (size_t x = 0; x < this->w; x++)
+	{
+		const uint8_t* c = &this->palette[this->scanline[x] * 4];
+		for (size_t i = 0; i < this->channelsCount; i++)
+		{
+			row[x * this->channelsCount + i] = c[i];
+		}
+	}
+	return true;
+}
+
+/// <summary>
+/// Decode next row to row (GetRowSize() elements)
+/// Image must have 16 bits per sample
+/// </summary>
+/// <param name="row"></param>
+/// <returns></returns>
+bool PngStreamDecoder::ReadRow(uint16_t* row)
+{
+	if (this->bitDepth != 16)
+	{
+		MY_LOG_ERROR("PNG has %u bits per sample, use ReadRow(uint8_t*)\n", this->bitDepth);
+		return false;
+	}
+
+	if (this->DecodeScanline() == false)
+	{
+		return false;
+	}
+
+	//PNG samples are big endian
+	const uint8_t* s = this->scanline.data();
+	for (size_t i = 0; i < this->GetRowSize(); i++)
+	{
+		row[i] = static_cast<uint16_t>((s[2 * i] << 8) | s[2 * i + 1]);
+	}
+	return true;
+}
+
+bool PngStreamDecoder::ReadSource(uint8_t* data, size_t size)
+{
+	if (this->memory != nullptr)
+	{
+		if (this->memorySize - this->memoryPos < size)
+		{
+			MY_LOG_ERROR("Unexpected end of PNG data\n");
+			return false;
+		}
+		std::memcpy(data, this->memory + this->memoryPos, size);
+		this->memoryPos += size;
+		return true;
+	}
+
+	this->file.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(size));
+	if (static_cast<size_t>(this->file.gcount()) != size)
+	{
+		MY_LOG_ERROR("Unexpected end of PNG file\n");
+		return false;
+	}
+	return true;
+}
+
+/// <summary>
+/// Read signature and IHDR (validated by lodepng_inspect)
+/// and all chunks before the first IDAT
+/// </summary>
+/// <returns></returns>
+bool PngStreamDecoder::ReadHeader()
+{
+	//signature (8), IHDR length and type (8), data (13), CRC (4)
+	uint8_t header[33];
+	if (this->ReadSource(header, sizeof(header)) == false)
+	{
+		return false;
+	}
+
+	LodePNGState lodeState;
+	lodepng_state_init(&lodeState);
+
+	unsigned error = lodepng_inspect(&this->w, &this->h, &lodeState, header, sizeof(header));
+
+	this->colorType = lodeState.info_png.color.colortype;
+	this->bitDepth = lodeState.info_png.color.bitdepth;
+	unsigned interlace = lodeState.info_png.interlace_method;
+
+	lodepng_state_cleanup(&lodeState);
+
+	if (error)
+	{
+		MY_LOG_ERROR("Invalid PNG header: %s\n", lodepng_error_text(error));
+		return false;
+	}
+
+	if (interlace != 0)
+	{
+		MY_LOG_ERROR("Interlaced PNG can not be decoded by rows\n");
+		return false;
+	}
+
+	size_t samplesCount = 0;
+	switch (this->colorType)
+	{
+	case LCT_GREY: samplesCount = 1; break;
+	case LCT_GREY_ALPHA: samplesCount = 2; break;
+	case LCT_RGB: samplesCount = 3; break;
+	case LCT_RGBA: samplesCount = 4; break;
+	case LCT_PALETTE: samplesCount = 1; break;
+	default: break;
+	}
+
+	bool supported = (this->colorType == LCT_PALETTE) ? (this->bitDepth == 8) :
+		((this->bitDepth == 8) || (this->bitDepth == 16));
+
+	if ((samplesCount == 0) || (supported == false))
+	{
+		MY_LOG_ERROR("PNG color type %u with %u bits is not supported by stream decoder\n", this->colorType, this->bitDepth);
+		return false;
+	}
+
+	this->bytesPerPixel = samplesCount * this->bitDepth / 8;
+	this->scanlineSize = static_cast<size_t>(this->w) * this->bytesPerPixel;
+	this->channelsCount = samplesCount;
+
+	this->palette.assign(256 * 4, 0);
+	for (size_t i = 0; i < 256; i++)
+	{
+		this->palette[i * 4 + 3] = 255;
+	}
+
+	//chunks before image data
+	while (true)
+	{
+		uint32_t length;
+		char type[5];
+		if (this->ReadChunkHeader(length, type) == false)
+		{
+			return false;
+		}
+
+		uint32_t crc = UpdateCrc(0xFFFFFFFFu, reinterpret_cast<const uint8_t*>(type), 4);
+
+		if (std::strcmp(type, "IDAT") == 0)
+		{
+			this->idatRemaining = length;
+			this->idatCrc = crc;
+			break;
+		}
+
+		if (std::strcmp(type, "IEND") == 0)
+		{
+			MY_LOG_ERROR("PNG has no image data\n");
+			return false;
+		}
+
+		//PLTE and tRNS are small, other chunks are read in blocks and skipped
+		std::vector<uint8_t> data(std::min<size_t>(length, READ_BLOCK_SIZE));
+		bool keep = (std::strcmp(type, "PLTE") == 0) || (std::strcmp(type, "tRNS") == 0);
+		if (keep)
+		{
+			data.resize(length);
+		}
+
+		for (uint32_t read = 0; read < length; )
+		{
+			size_t n = std::min<size_t>(length - read, data.size());
+			if (this->ReadSource(data.data() + (keep ? read : 0), n) == false)
+			{
+				return false;
+			}
+			crc = UpdateCrc(crc, data.data() + (keep ? read : 0), n);
+			read += static_cast<uint32_t>(n);
+		}
+
+		if (this->ReadChunkEnd(crc) == false)
+		{
+			return false;
+		}
+
+		if ((std::strcmp(type, "PLTE") == 0) && (this->colorType == LCT_PALETTE))
+		{
+			for (size_t i = 0; (i < 256) && (i * 3 + 2 < data.size()); i++)
+			{
+				this->palette[i * 4 + 0] = data[i * 3 + 0];
+				this->palette[i * 4 + 1] = data[i * 3 + 1];
+				this->palette[i * 4 + 2] = data[i * 3 + 2];
+			}
+		}
+		else if ((std::strcmp(type, "tRNS") == 0) && (this->colorType == LCT_PALETTE))
+		{
+			for (size_t i = 0; (i < 256) && (i < data.size()); i++)
+			{
+				this->palette[i * 4 + 3] = data[i];
+			}
+			this->paletteAlpha = true;
+		}
+	}
+
+	if (this->colorType == LCT_PALETTE)
+	{
+		this->channelsCount = (this->paletteAlpha) ? 4 : 3;
+	}
+
+	this->scanline.assign(this->scanlineSize, 0);
+	this->previousScanline.assign(this->scanlineSize, 0);
+
+	this->inflater = std::make_unique<PngInflater>([this](const uint8_t*& data, size_t& size) {
+		return this->NextCompressedData(data, size);
+	});
+
+	return true;
+}
+
+bool PngStreamDecoder::ReadChunkHeader(uint32_t& length, char type[5])
+{
+	uint8_t header[8];
+	if (this->ReadSource(header, sizeof(header)) == false)
+	{
+		return false;
+	}
+
+	length = ReadUInt32(header);
+	std::memcpy(type, header + 4, 4);
+	type[4] = 0;
+
+	if (length > 0x7FFFFFFFu)
+	{
+		MY_LOG_ERROR("Invalid PNG chunk length\n");
+		return false;
+	}
+	return true;
+}
+
+bool PngStreamDecoder::ReadChunkEnd(uint32_t crc)
+{
+	uint8_t stored[4];
+	if (this->ReadSource(stored, sizeof(stored)) == false)
+	{
+		return false;
+	}
+
+	if (ReadUInt32(stored) != (crc ^ 0xFFFFFFFFu))
+	{
+		MY_LOG_ERROR("PNG chunk CRC mismatch\n");
+		return false;
+	}
+	return true;
+}
+
+/// <summary>
+/// Source of PngInflater - next block of IDAT data
+/// Consecutive IDAT chunks form single zlib stream
+/// </summary>
+/// <param name="data"></param>
+/// <param name="size"></param>
+/// <returns></returns>
+bool PngStreamDecoder::NextCompressedData(const uint8_t*& data, size_t& size)
+{
+	while (this->idatRemaining == 0)
+	{
+		if (this->idatFinished)
+		{
+			return false;
+		}
+
+		if (this->ReadChunkEnd(this->idatCrc) == false)
+		{
+			this->idatFinished = true;
+			return false;
+		}
+
+		uint32_t length;
+		char type[5];
+		if ((this->ReadChunkHeader(length, type) == false) || (std::strcmp(type, "IDAT") != 0))
+		{
+			this->idatFinished = true;
+			return false;
+		}
+
+		this->idatRemaining = length;
+		this->idatCrc = UpdateCrc(0xFFFFFFFFu, reinterpret_cast<const uint8_t*>(type), 4);
+	}
+
+	size_t n = std::min<size_t>(this->idatRemaining, READ_BLOCK_SIZE);
+	this->idatBuffer.resize(n);
+	if (this->ReadSource(this->idatBuffer.data(), n) == false)
+	{
+		this->idatFinished = true;
+		return false;
+	}
+
+	this->idatCrc = UpdateCrc(this->idatCrc, this->idatBuffer.data(), n);
+	this->idatRemaining -= static_cast<uint32_t>(n);
+
+	data = this->idatBuffer.data();
+	size = n;
+	return true;
+}
+
+/// <summary>
+/// Inflate and unfilter next scanline
+/// </summary>
+/// <returns></returns>
+bool PngStreamDecoder::DecodeScanline()
+{
+	if ((this->inflater == nullptr) || (this->rowIndex >= this->h))
+	{
+		MY_LOG_ERROR("No more PNG rows to decode\n");
+		return false;
+	}
+
+	std::swap(this->scanline, this->previousScanline);
+
+	uint8_t filterType;
+	if ((this->inflater->Read(&filterType, 1) == false) ||
+		(this->inflater->Read(this->scanline.data(), this->scanlineSize) == false))
+	{
+		return false;
+	}
+
+	uint8_t* recon = this->scanline.data();
+	const uint8_t* prev = this->previousScanline.data();
+	const size_t bpp = this->bytesPerPixel;
+	const size_t size = this->scanlineSize;
+
+	switch (filterType)
+	{
+	case 0:
+		break;
+	case 1:
+		for (size_t i = bpp; i < size; i++) recon[i] = static_cast<uint8_t>(recon[i] + recon[i - bpp]);
+		break;
+	case 2:
+		for (size_t i = 0; i < size; i++) recon[i] = static_cast<uint8_t>(recon[i] + prev[i]);
+		break;
+	case 3:
+		for (size_t i = 0; i < bpp; i++) recon[i] = static_cast<uint8_t>(recon[i] + (prev[i] >> 1));
+		for (size_t i = bpp; i < size; i++) recon[i] = static_cast<uint8_t>(recon[i] + ((recon[i - bpp] + prev[i]) >> 1));
+		break;
+	case 4:
+		for (size_t i = 0; i < bpp; i++) recon[i] = static_cast<uint8_t>(recon[i] + prev[i]);
+		for (size_t i = bpp; i < size; i++)
+		{
+			int a = recon[i - bpp];
+			int b = prev[i];
+			int c = prev[i - bpp];
+			int pa = std::abs(b - c);
+			int pb = std::abs(a - c);
+			int pc = std::abs(a + b - c - c);
+			int p = ((pa <= pb) && (pa <= pc)) ? a : ((pb <= pc) ? b : c);
+			recon[i] = static_cast<uint8_t>(recon[i] + p);
+		}
+		break;
+	default:
+		MY_LOG_ERROR("Invalid PNG filter type %u\n", filterType);
+		return false;
+	}
+
+	this->rowIndex++;
+
+	//after the last row, the rest of stream is checked
+	if ((this->rowIndex == this->h) && (this->inflater->Finish() == false))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+uint32_t PngStreamDecoder::UpdateCrc(uint32_t crc, const uint8_t* data, size_t size)
+{
+	static const std::vector<uint32_t> table = []() {
+		std::vector<uint32_t> t(256);
+		for (uint32_t i = 0; i < 256; i++)
+		{
+			uint32_t c = i;
+			for (int k = 0; k < 8; k++)
+			{
+				c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+			}
+			t[i] = c;
+		}
+		return t;
+	}();
+
+	for (size_t i = 0; i < size; i++)
+	{
+		crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+	}
+	return crc;
+}
+
+uint32_t PngStreamDecoder::ReadUInt32(const uint8_t* data)
+{
+	return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+		(static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+}
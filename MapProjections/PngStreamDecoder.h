@@ -0,0 +1,112 @@
+#ifndef PNG_STREAM_DECODER_H
+#define PNG_STREAM_DECODER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <memory>
+
+namespace Projections
+{
+	class PngInflater;
+
+	/// <summary>
+	/// PNG decoder that decodes image row by row
+	///
+	/// lodepng::decode needs the whole file and the whole decoded image in memory.
+	/// This decoder reads the file (or memory) in small blocks, inflates
+	/// IDAT data incrementally (only 32kB window of zlib stream is kept)
+	/// and unfilters one scanline at a time, so its memory does not depend
+	/// on the image height. Header is validated by lodepng.
+	/// Rows can be passed to StreamingReprojection.
+	///
+	/// Supported are non-interlaced images with 8 or 16 bits per sample
+	/// (grey, grey + alpha, RGB, RGBA) and 8-bit palette images
+	/// (expanded to RGB, or RGBA if tRNS chunk is present).
+	/// Samples of 16-bit images are returned in native byte order.
+	/// Other formats have to be decoded with lodepng::decode.
+	/// </summary>
+	class PngStreamDecoder
+	{
+	public:
+		PngStreamDecoder();
+		PngStreamDecoder(const PngStreamDecoder&) = delete;
+		~PngStreamDecoder();
+
+		PngStreamDecoder& operator=(const PngStreamDecoder&) = delete;
+
+		bool Open(const std::string& fileName);
+		bool Open(const uint8_t* data, size_t size);
+		void Close();
+
+		unsigned GetWidth() const { return this->w; }
+		unsigned GetHeight() const { return this->h; }
+		unsigned GetBitDepth() const { return this->bitDepth; }
+		size_t GetChannelsCount() const { return this->channelsCount; }
+
+		/// <summary>
+		/// Number of elements (samples) of one decoded row
+		/// </summary>
+		/// <returns></returns>
+		size_t GetRowSize() const { return static_cast<size_t>(this->w) * this->channelsCount; }
+
+		/// <summary>
+		/// Number of rows already decoded
+		/// </summary>
+		/// <returns></returns>
+		unsigned GetRowIndex() const { return this->rowIndex; }
+
+		bool ReadRow(uint8_t* row);
+		bool ReadRow(uint16_t* row);
+
+	protected:
+		static const size_t READ_BLOCK_SIZE = 64 * 1024;
+
+		//source - file or memory
+		std::ifstream file;
+		const uint8_t* memory;
+		size_t memorySize;
+		size_t memoryPos;
+
+		unsigned w;
+		unsigned h;
+		unsigned colorType;
+		unsigned bitDepth;
+		size_t channelsCount;
+
+		//bytes of pixel and scanline in PNG (without filter type byte)
+		size_t bytesPerPixel;
+		size_t scanlineSize;
+
+		//RGBA entries of palette (256)
+		std::vector<uint8_t> palette;
+		bool paletteAlpha;
+
+		//unfiltered scanlines (previous is needed by filters)
+		std::vector<uint8_t> scanline;
+		std::vector<uint8_t> previousScanline;
+
+		//remaining bytes and CRC of the current IDAT chunk
+		uint32_t idatRemaining;
+		uint32_t idatCrc;
+		bool idatFinished;
+		std::vector<uint8_t> idatBuffer;
+
+		std::unique_ptr<PngInflater> inflater;
+		unsigned rowIndex;
+
+		bool ReadSource(uint8_t* data, size_t size);
+		bool ReadHeader();
+		bool ReadChunkHeader(uint32_t& length, char type[5]);
+		bool ReadChunkEnd(uint32_t crc);
+		bool NextCompressedData(const uint8_t*& data, size_t& size);
+		bool DecodeScanline();
+
+		static uint32_t UpdateCrc(uint32_t crc, const uint8_t* data, size_t size);
+		static uint32_t ReadUInt32(const uint8_t* data);
+	};
+}
+
+#endif
@@ -28,6 +28,14 @@ namespace Projections
 		PoleRotationTransform(const PoleRotationTransform& ot) :
 			PoleRotationTransform(Coordinate(ot.southpoleLon, ot.southpoleLat))
 		{}
+
+		uint64_t GetFingerprint() const override
+		{
+			Fingerprint fp;
+			fp.Add("PoleRotationTransform");
+			fp.Add(southpoleLon.rad()).Add(southpoleLat.rad());
+			return fp.Get();
+		}
 		
 		/// <summary>
 		/// Original -> Rotated
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <cstring>
 #include <cassert>
+#include <type_traits>
 
 #include "./Projections/Mercator.h"
 #include "./Projections/Miller.h"
@@ -23,12 +24,43 @@ using namespace Projections;
 /// Get name of projection
 /// </summary>
 /// <returns></returns>
-template <typename Proj>
-const char* ProjectionInfo<Proj>::GetName() const
+template <typename Proj, typename Real>
+const char* ProjectionInfo<Proj, Real>::GetName() const
 {
 	return static_cast<const Proj*>(this)->GetNameInternal();
 }
 
+/// <summary>
+/// Get 64-bit fingerprint of projection
+/// It contains projection type, all projection parameters, 
+/// all frame fields and lat / lon transform (if any)
+/// Two projections with the same fingerprint produce the same pixels
+/// 
+/// Projections with other than default precision (MyRealType)
+/// have also the size of their numeric type in fingerprint
+/// </summary>
+/// <typeparam name="Proj"></typeparam>
+/// <returns></returns>
+template <typename Proj, typename Real>
+uint64_t ProjectionInfo<Proj, Real>::GetFingerprint() const
+{
+	Fingerprint fp;
+	fp.Add(this->curProjection);
+	fp.Add(this->GetName());
+
+	static_cast<const Proj*>(this)->AddFingerprintInternal(fp);
+
+	if (std::is_same<Real, MyRealType>::value == false)
+	{
+		fp.Add(sizeof(Real));
+	}
+
+	fp.Add(this->frame.GetFingerprint());
+	fp.Add((this->transform) ? this->transform->GetFingerprint() : 0);
+
+	return fp.Get();
+}
+
 /// <summary>
 /// Get info if projections lat / lon are independet to each other
 /// (one can be caltulated without the other)
@@ -38,8 +70,8 @@ const char* ProjectionInfo<Proj>::GetName() const
 /// </summary>
 /// <typeparam name="Proj"></typeparam>
 /// <returns></returns>
-template <typename Proj>
-bool ProjectionInfo<Proj>::IsIndependentLatLon() const
+template <typename Proj, typename Real>
+bool ProjectionInfo<Proj, Real>::IsIndependentLatLon() const
 {
 	if (this->transform != nullptr)
 	{
@@ -55,8 +87,8 @@ bool ProjectionInfo<Proj>::IsIndependentLatLon() const
 /// </summary>
 /// <typeparam name="Proj"></typeparam>
 /// <returns></returns>
-template <typename Proj>
-bool ProjectionInfo<Proj>::IsOrthogonalLatLon() const
+template <typename Proj, typename Real>
+bool ProjectionInfo<Proj, Real>::IsOrthogonalLatLon() const
 {
 	return Proj::ORTHOGONAL_LAT_LON;
 }
@@ -66,14 +98,14 @@ bool ProjectionInfo<Proj>::IsOrthogonalLatLon() const
 // Main interface
 //=======================================================================
 
-template <typename Proj>
-ProjectionInfo<Proj>::ProjectionInfo(PROJECTION curProjection) : 
+template <typename Proj, typename Real>
+ProjectionInfo<Proj, Real>::ProjectionInfo(PROJECTION curProjection) : 
 	IProjectionInfo(curProjection)		
 {	
 
 }
-template <typename Proj>
-typename ProjectionInfo<Proj>::InternalBoundingBox ProjectionInfo<Proj>::GetInternalBoundingBox(
+template <typename Proj, typename Real>
+typename ProjectionInfo<Proj, Real>::InternalBoundingBox ProjectionInfo<Proj, Real>::GetInternalBoundingBox(
 	const Coordinate & botLeft, const Coordinate & topRight)
 {
 	ProjectedValue tmpMinPixel = static_cast<Proj*>(this)->ProjectInternal(botLeft);
@@ -91,8 +123,8 @@ typename ProjectionInfo<Proj>::InternalBoundingBox ProjectionInfo<Proj>::GetInte
 }
 
 
-template <typename Proj>
-void ProjectionInfo<Proj>::SetFrameWithAdjustment(const ProjectionFrame & frame)
+template <typename Proj, typename Real>
+void ProjectionInfo<Proj, Real>::SetFrameWithAdjustment(const ProjectionFrame & frame)
 {	
 	this->frame.h = frame.h;
 	this->frame.w = frame.w;
@@ -158,8 +190,8 @@ void ProjectionInfo<Proj>::SetFrameWithAdjustment(const ProjectionFrame & frame)
 /// <param name="keepAR">keep AR of data (default: true) 
 /// if yes, data are enlarged beyond AABB to keep AR
 /// </param>
-template <typename Proj>
-void ProjectionInfo<Proj>::SetRawFrame(const Coordinate & botLeft, const Coordinate & topRight,
+template <typename Proj, typename Real>
+void ProjectionInfo<Proj, Real>::SetRawFrame(const Coordinate & botLeft, const Coordinate & topRight,
 	MyRealType w, MyRealType h, STEP_TYPE stepType, bool keepAR)
 {		
 	//temporary disable transform
@@ -239,8 +271,8 @@ void ProjectionInfo<Proj>::SetRawFrame(const Coordinate & botLeft, const Coordin
 /// </summary>
 /// <param name="botLeft"></param>
 /// <param name="topRight"></param>
-template <typename Proj>
-void ProjectionInfo<Proj>::CalculateWrapRepeat(const Coordinate& botLeft, const Coordinate& topRight)
+template <typename Proj, typename Real>
+void ProjectionInfo<Proj, Real>::CalculateWrapRepeat(const Coordinate& botLeft, const Coordinate& topRight)
 {
 	if (Proj::ORTHOGONAL_LAT_LON == false)
 	{
@@ -313,8 +345,8 @@ void ProjectionInfo<Proj>::CalculateWrapRepeat(const Coordinate& botLeft, const
 /// <param name="h"></param>
 /// <param name="stepType"></param>
 /// <param name="keepAR"></param>
-template <typename Proj>
-void ProjectionInfo<Proj>::SetFrameWithAdjustment(const Coordinate & botLeft, const Coordinate & topRight,
+template <typename Proj, typename Real>
+void ProjectionInfo<Proj, Real>::SetFrameWithAdjustment(const Coordinate & botLeft, const Coordinate & topRight,
 	MyRealType w, MyRealType h, STEP_TYPE stepType, bool keepAR)
 {				
 	this->SetRawFrame(botLeft, topRight, w, h, stepType, keepAR);
@@ -335,8 +367,8 @@ void ProjectionInfo<Proj>::SetFrameWithAdjustment(const Coordinate & botLeft, co
 /// <param name="w"></param>
 /// <param name="h"></param>
 /// <param name="keepAR"></param>
-template <typename Proj>
-void ProjectionInfo<Proj>::SetFrameFromAABB(const Coordinate & min, const Coordinate & max,
+template <typename Proj, typename Real>
+void ProjectionInfo<Proj, Real>::SetFrameFromAABB(const Coordinate & min, const Coordinate & max,
 	MyRealType w, MyRealType h, STEP_TYPE stepType, bool keepAR)
 {
 	//not working correctly for non-orthogonal lat/lon projections !!!!!
@@ -363,8 +395,8 @@ void ProjectionInfo<Proj>::SetFrameFromAABB(const Coordinate & min, const Coordi
 /// Step longitude : (180 - (-180)) / 2 = 180
 /// </summary>
 /// <returns></returns>
-template <typename Proj>
-Coordinate ProjectionInfo<Proj>::GetDeltaStep() const
+template <typename Proj, typename Real>
+Coordinate ProjectionInfo<Proj, Real>::GetDeltaStep() const
 {	
 	Coordinate step;
 	step.lat = Latitude::rad((this->frame.max.lat.rad() - this->frame.min.lat.rad()) / 
@@ -379,14 +411,14 @@ Coordinate ProjectionInfo<Proj>::GetDeltaStep() const
 /// Get projection top left corner
 /// </summary>
 /// <returns></returns>
-template <typename Proj>
-Coordinate ProjectionInfo<Proj>::GetTopLeftCorner() const
+template <typename Proj, typename Real>
+Coordinate ProjectionInfo<Proj, Real>::GetTopLeftCorner() const
 {
 	return this->ProjectInverse({ 0, 0 });
 }
 
-template <typename Proj>
-const ProjectionFrame & ProjectionInfo<Proj>::GetFrame() const
+template <typename Proj, typename Real>
+const ProjectionFrame & ProjectionInfo<Proj, Real>::GetFrame() const
 {
 	return this->frame;
 }
@@ -398,8 +430,8 @@ const ProjectionFrame & ProjectionInfo<Proj>::GetFrame() const
 /// <param name="start"></param>
 /// <param name="end"></param>
 /// <param name="callback"></param>
-template <typename Proj>
-void ProjectionInfo<Proj>::LineBresenham(Pixel<int> start, Pixel<int> end,
+template <typename Proj, typename Real>
+void ProjectionInfo<Proj, Real>::LineBresenham(Pixel<int> start, Pixel<int> end,
 	std::function<void(int x, int y)> callback) const
 {
 	if ((start.x < 0) || (start.y < 0))
@@ -465,8 +497,8 @@ void ProjectionInfo<Proj>::LineBresenham(Pixel<int> start, Pixel<int> end,
 	}
 }
 
-template <typename Proj>
-void ProjectionInfo<Proj>::ComputeAABBWithoutTransform(Coordinate& min, Coordinate& max) const
+template <typename Proj, typename Real>
+void ProjectionInfo<Proj, Real>::ComputeAABBWithoutTransform(Coordinate& min, Coordinate& max) const
 {
 	//temporary disable transform
 	auto oldTransform = this->transform;
@@ -477,8 +509,8 @@ void ProjectionInfo<Proj>::ComputeAABBWithoutTransform(Coordinate& min, Coordina
 	this->transform = oldTransform;
 }
 
-template <typename Proj>
-void ProjectionInfo<Proj>::ComputeAABBWithoutTransform(int startX, int startY, int endX, int endY, Coordinate& min, Coordinate& max) const
+template <typename Proj, typename Real>
+void ProjectionInfo<Proj, Real>::ComputeAABBWithoutTransform(int startX, int startY, int endX, int endY, Coordinate& min, Coordinate& max) const
 {
 	//temporary disable transform
 	auto oldTransform = this->transform;
@@ -497,8 +529,8 @@ void ProjectionInfo<Proj>::ComputeAABBWithoutTransform(int startX, int startY, i
 /// </summary>
 /// <param name="min"></param>
 /// <param name="max"></param>
-template <typename Proj>
-void ProjectionInfo<Proj>::ComputeAABB(Coordinate& min, Coordinate& max) const
+template <typename Proj, typename Real>
+void ProjectionInfo<Proj, Real>::ComputeAABB(Coordinate& min, Coordinate& max) const
 {
 	//for coordinates at pixel corner:
 	//[0, 0] is at pixel corner
@@ -524,8 +556,8 @@ void ProjectionInfo<Proj>::ComputeAABB(Coordinate& min, Coordinate& max) const
 /// <param name="endY"></param>
 /// <param name="min"></param>
 /// <param name="max"></param>
-template <typename Proj>
-void ProjectionInfo<Proj>::ComputeAABB(int startX, int startY, int endX, int endY, Coordinate& min, Coordinate& max) const
+template <typename Proj, typename Real>
+void ProjectionInfo<Proj, Real>::ComputeAABB(int startX, int startY, int endX, int endY, Coordinate& min, Coordinate& max) const
 {		
 	std::vector<Coordinate> border;
 
@@ -591,3 +623,13 @@ template class Projections::ProjectionInfo<PolarSteregographic>;
 template class Projections::ProjectionInfo<GEOS>;
 template class Projections::ProjectionInfo<AEQD>;
 template class Projections::ProjectionInfo<TransverseMercator>;
+
+template class Projections::ProjectionInfo<LambertConicT<float>, float>;
+template class Projections::ProjectionInfo<LambertAzimuthalT<float>, float>;
+template class Projections::ProjectionInfo<MercatorT<float>, float>;
+template class Projections::ProjectionInfo<MillerT<float>, float>;
+template class Projections::ProjectionInfo<EquirectangularT<float>, float>;
+template class Projections::ProjectionInfo<PolarSteregographicT<float>, float>;
+template class Projections::ProjectionInfo<GEOST<float>, float>;
+template class Projections::ProjectionInfo<AEQDT<float>, float>;
+template class Projections::ProjectionInfo<TransverseMercatorT<float>, float>;
@@ -23,10 +23,20 @@
 
 namespace Projections
 {
-	template <typename Proj>
+	/// <summary>
+	/// Base of all projections
+	/// 
+	/// Real is numeric type used by projection equations 
+	/// (ProjectInternal / ProjectInverseInternal) and by conversion
+	/// between projected values and pixels. Coordinate and frame 
+	/// are always stored in MyRealType.
+	/// </summary>
+	template <typename Proj, typename Real = MyRealType>
 	class ProjectionInfo : public IProjectionInfo
 	{
 	public:				
+		using RealType = Real;
+
 		virtual ~ProjectionInfo() = default;
 
 		const char* GetName() const override;
@@ -34,12 +44,17 @@ namespace Projections
 		bool IsIndependentLatLon() const OVERRIDE;
 		bool IsOrthogonalLatLon() const OVERRIDE;
 
+		uint64_t GetFingerprint() const OVERRIDE;
+
 		template <typename PixelType = int>
 		RET_VAL(PixelType, std::is_integral) Project(const Coordinate & c) const;
 
 
 		template <typename PixelType = float>
 		RET_VAL(PixelType, std::is_floating_point) Project(const Coordinate & c) const;
+
+		template <typename PixelType = Fixed24_8>
+		RET_VAL(PixelType, IsFixedPoint) Project(const Coordinate & c) const;
         
 		template <typename PixelType = int, bool Normalize = true>
 		Coordinate ProjectInverse(const Pixel<PixelType> & p) const;
@@ -96,8 +111,8 @@ namespace Projections
         ///</summary>
         struct ProjectedValue
         {
-            MyRealType x;
-            MyRealType y;
+            Real x;
+            Real y;
         };
 		
 		struct InternalBoundingBox 
@@ -126,9 +141,9 @@ namespace Projections
 	/// <param name="keepAR">keep AR of data (default: true) 
 	/// if yes, data are enlarged and not 1:1 to bounding box to keep AR
 	/// </param>
-	template <typename Proj>
+	template <typename Proj, typename Real>
 	template <typename InputProj>
-	void ProjectionInfo<Proj>::SetFrame(InputProj * proj, bool keepAR)
+	void ProjectionInfo<Proj, Real>::SetFrame(InputProj * proj, bool keepAR)
 	{
 		auto f = proj->GetFrame();
 		this->SetFrameFromAABB(f.min, f.max, f.w, f.h, f.stepType, keepAR);
@@ -144,9 +159,9 @@ namespace Projections
 	/// <param name="keepAR">keep AR of data (default: true) 
 	/// if yes, data are enlarged and not 1:1 to bounding box to keep AR
 	/// </param>
-	template <typename Proj>
+	template <typename Proj, typename Real>
 	template <typename InputProj>
-	void ProjectionInfo<Proj>::SetFrame(InputProj * proj, MyRealType w, MyRealType h, STEP_TYPE stepType, bool keepAR)
+	void ProjectionInfo<Proj, Real>::SetFrame(InputProj * proj, MyRealType w, MyRealType h, STEP_TYPE stepType, bool keepAR)
 	{
 		auto f = proj->GetFrame();
 		this->SetFrameWithAdjustment(f.min, f.max, w, h, stepType, keepAR);
@@ -159,9 +174,9 @@ namespace Projections
 	/// </summary>
 	/// <param name="c"></param>
 	/// <returns></returns>
-	template <typename Proj>
+	template <typename Proj, typename Real>
 	template <typename PixelType>	
-	RET_VAL(PixelType, std::is_integral) ProjectionInfo<Proj>::Project(const Coordinate & c) const
+	RET_VAL(PixelType, std::is_integral) ProjectionInfo<Proj, Real>::Project(const Coordinate & c) const
 	{		
 		ProjectedValue rawPixel;
 
@@ -177,16 +192,16 @@ namespace Projections
 		}
 
 		Pixel<PixelType> p{
-			static_cast<PixelType>(std::round(rawPixel.x * this->frame.wAR - this->frame.projPrecomX)),
-			static_cast<PixelType>(std::round(-rawPixel.y * this->frame.hAR - this->frame.projPrecomY))
+			static_cast<PixelType>(std::round(rawPixel.x * static_cast<Real>(this->frame.wAR) - static_cast<Real>(this->frame.projPrecomX))),
+			static_cast<PixelType>(std::round(-rawPixel.y * static_cast<Real>(this->frame.hAR) - static_cast<Real>(this->frame.projPrecomY)))
 		};
 		
 		return p;
 	};
 
-	template <typename Proj>
+	template <typename Proj, typename Real>
 	template <typename PixelType>	
-	RET_VAL(PixelType, std::is_floating_point) ProjectionInfo<Proj>::Project(const Coordinate & c) const
+	RET_VAL(PixelType, std::is_floating_point) ProjectionInfo<Proj, Real>::Project(const Coordinate & c) const
 	{
 		ProjectedValue rawPixel;
 
@@ -202,8 +217,8 @@ namespace Projections
 		}
 
 		Pixel<PixelType> p{
-			static_cast<PixelType>(rawPixel.x * this->frame.wAR - this->frame.projPrecomX),
-			static_cast<PixelType>(-rawPixel.y * this->frame.hAR - this->frame.projPrecomY)
+			static_cast<PixelType>(rawPixel.x * static_cast<Real>(this->frame.wAR) - static_cast<Real>(this->frame.projPrecomX)),
+			static_cast<PixelType>(-rawPixel.y * static_cast<Real>(this->frame.hAR) - static_cast<Real>(this->frame.projPrecomY))
 		};
 
 		//move our pseoude pixel to "origin"
@@ -218,30 +233,43 @@ namespace Projections
 		return p;
 	};
 
+	template <typename Proj, typename Real>
+	template <typename PixelType>	
+	RET_VAL(PixelType, IsFixedPoint) ProjectionInfo<Proj, Real>::Project(const Coordinate & c) const
+	{
+		//fixed point is rounded from the floating point position
+		Pixel<MyRealType> p = this->Project<MyRealType>(c);
+
+		return Pixel<PixelType>{
+			PixelType(p.x),
+			PixelType(p.y)
+		};
+	};
+
 	/// <summary>
 	/// Project pixel to coordinate
 	/// </summary>
 	/// <param name="p"></param>
 	/// <returns></returns>
-	template <typename Proj>
+	template <typename Proj, typename Real>
 	template <typename PixelType, bool Normalize>
-	Coordinate ProjectionInfo<Proj>::ProjectInverse(const Pixel<PixelType>& p) const
+	Coordinate ProjectionInfo<Proj, Real>::ProjectInverse(const Pixel<PixelType>& p) const
 	{
 		return this->ProjectInverse<PixelType, Normalize>(p.x, p.y);
 	}
 
-	template <typename Proj>
+	template <typename Proj, typename Real>
 	template <typename PixelType, bool Normalize>
-	Coordinate ProjectionInfo<Proj>::ProjectInverse(PixelType x, PixelType y) const
+	Coordinate ProjectionInfo<Proj, Real>::ProjectInverse(PixelType x, PixelType y) const
 	{
 
 		//double xx = (static_cast<double>(p.x) - this->frame.wPadding + this->frame.wAR * this->frame.minPixelOffset.x);
-		MyRealType xx = (static_cast<MyRealType>(x) + this->frame.projPrecomX);
-		xx /= this->frame.wAR;
+		Real xx = (static_cast<Real>(x) + static_cast<Real>(this->frame.projPrecomX));
+		xx /= static_cast<Real>(this->frame.wAR);
 
 		//double yy = (static_cast<double>(p.y) - this->frame.h + this->frame.hPadding - this->frame.hAR * this->frame.minPixelOffset.y);
-		MyRealType yy = (static_cast<MyRealType>(y) + this->frame.projPrecomY);
-		yy /= -this->frame.hAR;
+		Real yy = (static_cast<Real>(y) + static_cast<Real>(this->frame.projPrecomY));
+		yy /= -static_cast<Real>(this->frame.hAR);
 
 
 		
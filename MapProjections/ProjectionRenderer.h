@@ -13,6 +13,7 @@ namespace Projections
 
 #include "./ProjectionInfo.h"
 #include "./Reprojection.h"
+#include "./ParallelUtils.h"
 
 namespace Projections
 {
@@ -30,7 +31,8 @@ namespace Projections
 
 		template <typename ReprojType>
 		static void ReprojectImage(const uint8_t * fromData, RenderImageType fromType, 
-			uint8_t * toData, RenderImageType toType, const Reprojection<ReprojType> & reproj);
+			uint8_t * toData, RenderImageType toType, const Reprojection<ReprojType> & reproj,
+			size_t threadsCount = 1);
 
 		template <typename Proj>
 		ProjectionRenderer(Proj * proj, RenderImageType type = RenderImageType::GRAY);
@@ -202,9 +204,23 @@ namespace Projections
 		ProjectionRenderer::ReprojectImage(imData, imType, this->rawData, this->type, reproj);
 	}
 
+	/// <summary>
+	/// Reproject image fromData to toData with Nearest Neighbor
+	/// Invalid pixels of toData are not modified
+	/// 
+	/// Output rows are processed in bands, that fit in cache, by threadsCount threads 
+	/// (0 - all hardware threads). Result is same as with single thread.
+	/// </summary>
+	/// <param name="fromData"></param>
+	/// <param name="fromType"></param>
+	/// <param name="toData"></param>
+	/// <param name="toType"></param>
+	/// <param name="reproj"></param>
+	/// <param name="threadsCount"></param>
 	template <typename ReprojType>
 	void ProjectionRenderer::ReprojectImage(const uint8_t * fromData, RenderImageType fromType,
-		uint8_t * toData, RenderImageType toType, const Reprojection<ReprojType> & reproj)
+		uint8_t * toData, RenderImageType toType, const Reprojection<ReprojType> & reproj,
+		size_t threadsCount)
 	{
 
 		if (fromType != toType)
@@ -212,32 +228,37 @@ namespace Projections
 			return;
 		}
 
-		for (int y = 0; y < reproj.outH; y++)
-		{
-			int yw = y * reproj.outW;
-			for (int x = 0; x < reproj.outW; x++)
+		int bandSize = ParallelUtils::GetCacheRowBandSize(static_cast<size_t>(reproj.outW) * 
+			(sizeof(Pixel<ReprojType>) + static_cast<int>(toType)));
+
+		ParallelUtils::RunRowBands(reproj.outH, bandSize, threadsCount, [&](int startRow, int endRow) {
+			for (int y = startRow; y < endRow; y++)
 			{
-				int index = x + yw;
+				int yw = y * reproj.outW;
+				for (int x = 0; x < reproj.outW; x++)
+				{
+					int index = x + yw;
 
-				int px = static_cast<int>(reproj.pixels[index].x);
-				int py = static_cast<int>(reproj.pixels[index].y);
+					int px = static_cast<int>(reproj.pixels[index].x);
+					int py = static_cast<int>(reproj.pixels[index].y);
 
 
-				if ((px == -1) || (py == -1))
-				{
-					continue;
-				}
+					if ((px == -1) || (py == -1))
+					{
+						continue;
+					}
 
 				
-				int origIndex = (px + py * reproj.inW) * static_cast<int>(fromType);
-				int outIndex = index * static_cast<int>(toType);
+					int origIndex = (px + py * reproj.inW) * static_cast<int>(fromType);
+					int outIndex = index * static_cast<int>(toType);
 
-				for (int k = 0; k < static_cast<int>(toType); k++)
-				{
-					toData[outIndex + k] = fromData[origIndex + k];
+					for (int k = 0; k < static_cast<int>(toType); k++)
+					{
+						toData[outIndex + k] = fromData[origIndex + k];
+					}
 				}
 			}
-		}
+		});
 	}
 };
 
@@ -14,15 +14,24 @@ namespace Projections
 	/// <summary>
 	/// Based on:
 	/// https://en.wikipedia.org/wiki/Azimuthal_equidistant_projection
+	/// 
+	/// Real is numeric type of projection equations (see ProjectionInfo)
 	/// </summary>
-	class AEQD : public ProjectionInfo<AEQD>
+	template <typename Real = MyRealType>
+	class AEQDT : public ProjectionInfo<AEQDT<Real>, Real>
 	{
+	protected:
+		using Base = ProjectionInfo<AEQDT<Real>, Real>;
+		using typename Base::ProjectedValue;
+		using typename Base::ProjectedValueInverse;
+		using typename Base::InternalBoundingBox;
+
 	public:
 		static const bool INDEPENDENT_LAT_LON = false; //can Lat / Lon be computed separatly. To compute one, we dont need the other
 		static const bool ORTHOGONAL_LAT_LON = false; //is lat / lon is orthogonal to each other
 		
-		AEQD(const Longitude& centerLon, const Latitude& centerLat, MyRealType radius) :
-			ProjectionInfo(PROJECTION::AEQD),
+		AEQDT(const Longitude& centerLon, const Latitude& centerLat, MyRealType radius) :
+			Base(PROJECTION::AEQD),
 			centerLon(centerLon),
 			centerLat(centerLat),
 			radius(radius),
@@ -30,8 +39,8 @@ namespace Projections
 			cosCenterLat(std::cos(centerLat.rad()))
 		{}
 
-		AEQD(const AEQD& mi) : 
-			AEQD(mi.centerLon, mi.centerLat, mi.radius)
+		AEQDT(const AEQDT& mi) : 
+			AEQDT(mi.centerLon, mi.centerLat, mi.radius)
 		{
 			this->frame = mi.frame;
 		}
@@ -76,7 +85,7 @@ namespace Projections
 		}
 
 
-		friend class ProjectionInfo<AEQD>;
+		friend class ProjectionInfo<AEQDT<Real>, Real>;
 
 	protected:
 
@@ -84,38 +93,46 @@ namespace Projections
 		const Latitude centerLat;
 		const MyRealType radius;
 
-		const double sinCenterLat;
-		const double cosCenterLat;
+		const Real sinCenterLat;
+		const Real cosCenterLat;
 		
 		const char* GetNameInternal() const
 		{
 			return "AEQD";
 		}
 
+		void AddFingerprintInternal(Fingerprint& fp) const
+		{
+			fp.Add(centerLon.rad()).Add(centerLat.rad()).Add(radius);
+		}
+
 		InternalBoundingBox GetInternalBoundingBox(const Coordinate& botLeft, const Coordinate& topRight) override
 		{
 			InternalBoundingBox bb;
-			bb.min.x = -radius;
-			bb.min.y = -radius;
+			bb.min.x = static_cast<Real>(-radius);
+			bb.min.y = static_cast<Real>(-radius);
 
-			bb.max.x = radius;
-			bb.max.y = radius;
+			bb.max.x = static_cast<Real>(radius);
+			bb.max.y = static_cast<Real>(radius);
 
 			return bb;
 		}
 
 		ProjectedValue ProjectInternal(const Coordinate& c) const
 		{
-			auto cosLat = std::cos(c.lat.rad());
-			auto sinLat = std::sin(c.lat.rad());
-			auto cosDifLon = std::cos(c.lon.rad() - centerLon.rad());
-			auto sinDifLon = std::sin(c.lon.rad() - centerLon.rad());
+			auto lat = static_cast<Real>(c.lat.rad());
+			auto difLon = static_cast<Real>(c.lon.rad() - centerLon.rad());
+
+			auto cosLat = std::cos(lat);
+			auto sinLat = std::sin(lat);
+			auto cosDifLon = std::cos(difLon);
+			auto sinDifLon = std::sin(difLon);
 
 			
 			auto cosPhiR = sinCenterLat * sinLat + cosCenterLat * cosLat * cosDifLon;
 
 			auto phiR = std::acos(cosPhiR);
-			auto phi = phiR * ProjectionConstants::EARTH_RADIUS;
+			auto phi = phiR * static_cast<Real>(ProjectionConstants::EARTH_RADIUS);
 
 			auto tmp0 = (cosLat * sinDifLon);
 			auto tmp1 = (cosCenterLat * sinLat - sinCenterLat * cosLat * cosDifLon);
@@ -129,32 +146,32 @@ namespace Projections
 			};
 		};
 
-		ProjectedValueInverse ProjectInverseInternal(MyRealType x, MyRealType y) const
+		ProjectedValueInverse ProjectInverseInternal(Real x, Real y) const
 		{
 			
 			//ChatGpt
 			
-			const double p = std::hypot(x, y);
-			if (p < 1e-12) 
+			const Real p = std::hypot(x, y);
+			if (p < Real(1e-12)) 
 			{
 				return { centerLat, centerLon};
 			}
 
-			const double c = p / ProjectionConstants::EARTH_RADIUS;
-			const double sinc = std::sin(c);
-			const double cosc = std::cos(c);
+			const Real c = p / static_cast<Real>(ProjectionConstants::EARTH_RADIUS);
+			const Real sinc = std::sin(c);
+			const Real cosc = std::cos(c);
 						
-			double sinPhi = cosc * sinCenterLat + (y * sinc * cosCenterLat) / p;
+			Real sinPhi = cosc * sinCenterLat + (y * sinc * cosCenterLat) / p;
 
 			// Clamp for numeric safety
-			if (sinPhi > 1.0) sinPhi = 1.0;
-			if (sinPhi < -1.0) sinPhi = -1.0;
+			if (sinPhi > Real(1.0)) sinPhi = Real(1.0);
+			if (sinPhi < Real(-1.0)) sinPhi = Real(-1.0);
 
-			const double lat = std::asin(sinPhi);
+			const Real lat = std::asin(sinPhi);
 
-			const double numerator = x * sinc;
-			const double denominator = p * cosCenterLat * cosc - y * sinCenterLat * sinc;
-			double lon = centerLon.rad() + std::atan2(numerator, denominator);
+			const Real numerator = x * sinc;
+			const Real denominator = p * cosCenterLat * cosc - y * sinCenterLat * sinc;
+			Real lon = static_cast<Real>(centerLon.rad()) + std::atan2(numerator, denominator);
 
 			/*
 			// Normalize longitude to [-pi, pi) if you want
@@ -174,6 +191,8 @@ namespace Projections
 		};
 
 	};
+
+	using AEQD = AEQDT<MyRealType>;
 }
 
 #endif
@@ -14,59 +14,74 @@ namespace Projections
 	/// <summary>
 	/// Based on:
 	/// https://en.wikipedia.org/wiki/Equirectangular_projection
+	/// 
+	/// Real is numeric type of projection equations (see ProjectionInfo)
 	/// </summary>
-	class Equirectangular : public ProjectionInfo<Equirectangular>
+	template <typename Real = MyRealType>
+	class EquirectangularT : public ProjectionInfo<EquirectangularT<Real>, Real>
 	{
+	protected:
+		using Base = ProjectionInfo<EquirectangularT<Real>, Real>;
+		using typename Base::ProjectedValue;
+		using typename Base::ProjectedValueInverse;
+
 	public:
 
 		static const bool INDEPENDENT_LAT_LON = true; //can Lat / Lon be computed separatly. To compute one, we dont need the other
 		static const bool ORTHOGONAL_LAT_LON = true; //lat / lon is orthogonal to each otjer
 
-		Equirectangular() : Equirectangular(Longitude::deg(0.0)) {}
+		EquirectangularT() : EquirectangularT(Longitude::deg(0.0)) {}
 
-		Equirectangular(const Longitude & lonCentralMeridian) :
-			ProjectionInfo(PROJECTION::EQUIRECTANGULAR),
+		EquirectangularT(const Longitude & lonCentralMeridian) :
+			Base(PROJECTION::EQUIRECTANGULAR),
 			lonCentralMeridian(lonCentralMeridian),
 			standardParallel(Latitude::deg(0.0)),
 			cosStandardParallel(std::cos(standardParallel.rad()))
 		{ }
 
-		Equirectangular(const Equirectangular& eq) :
-			Equirectangular(eq.lonCentralMeridian)
+		EquirectangularT(const EquirectangularT& eq) :
+			EquirectangularT(eq.lonCentralMeridian)
 		{
 			this->frame = eq.frame;
 		}
 
-		friend class ProjectionInfo<Equirectangular>;
+		friend class ProjectionInfo<EquirectangularT<Real>, Real>;
 
 	protected:
 
 		const Longitude lonCentralMeridian;
 		const Latitude standardParallel;
-		const MyRealType cosStandardParallel;
+		const Real cosStandardParallel;
 
 		const char* GetNameInternal() const
 		{
 			return "Equirectangular";
 		}
 
+		void AddFingerprintInternal(Fingerprint& fp) const
+		{
+			fp.Add(lonCentralMeridian.rad()).Add(standardParallel.rad());
+		}
+
 		ProjectedValue ProjectInternal(const Coordinate & c) const
 		{
 			return {
-				(c.lon.rad() - lonCentralMeridian.rad()) * cosStandardParallel,
-				c.lat.rad() - standardParallel.rad()
+				static_cast<Real>(c.lon.rad() - lonCentralMeridian.rad()) * cosStandardParallel,
+				static_cast<Real>(c.lat.rad() - standardParallel.rad())
 			};
 		};
 
-		ProjectedValueInverse ProjectInverseInternal(MyRealType x, MyRealType y) const
+		ProjectedValueInverse ProjectInverseInternal(Real x, Real y) const
 		{			
 			return {
-				Latitude::rad(y / cosStandardParallel + lonCentralMeridian.rad()),
-				Longitude::rad(x + standardParallel.rad())
+				Latitude::rad(y / cosStandardParallel + static_cast<Real>(lonCentralMeridian.rad())),
+				Longitude::rad(x + static_cast<Real>(standardParallel.rad()))
 			};
 		};
 
 	};
+
+	using Equirectangular = EquirectangularT<MyRealType>;
 }
 
 #endif
@@ -12,135 +12,155 @@
 namespace Projections
 {
 	/// <summary>
-	/// Based on section 4.4:
-	/// https://www.cgms-info.org/documents/cgms-lrit-hrit-global-specification-(v2-8-of-30-oct-2013).pdf
-	/// 
-	/// https://github.com/yaswant/ypylib/blob/master/geo.py
+	/// Settings of geostationary satellite for GEOS projection
+	/// (independent on numeric type of projection)
 	/// </summary>
-	class GEOS : public ProjectionInfo<GEOS>
+	struct GEOSSatelliteSettings
 	{
-	public:
-
-		struct SatelliteSettings
-		{
-			//satellite longitude position 
-			Longitude lon;
+		//satellite longitude position 
+		Longitude lon;
 
-			//column / row offsets
-			//(basically half of satellite image size)
-			MyRealType coff;
-			MyRealType loff;
+		//column / row offsets
+		//(basically half of satellite image size)
+		MyRealType coff;
+		MyRealType loff;
 
-			// Intermediate coords deltas
-			MyRealType cfac;
-			MyRealType lfac;
+		// Intermediate coords deltas
+		MyRealType cfac;
+		MyRealType lfac;
 
-			bool sweepY = true;
+		bool sweepY = true;
 
-			static SatelliteSettings Himawari8()
-			{
-				return {
-					140.7_deg,
-					MyRealType(5500.5),
-					MyRealType(5500.5),
-					MyRealType(40'932'513.0),
-					MyRealType(-40'932'513.0)
-				};
+		static GEOSSatelliteSettings Himawari8()
+		{
+			return {
+				140.7_deg,
+				MyRealType(5500.5),
+				MyRealType(5500.5),
+				MyRealType(40'932'513.0),
+				MyRealType(-40'932'513.0)
 			};
+		};
 
-			static SatelliteSettings Meteosat11()
-			{
-				return {
-					0.0_deg,
-					MyRealType(5566.0),
-					MyRealType(5566.0),
-					MyRealType(40'927'010.0),
-					MyRealType(-40'927'010.0)
-				};
+		static GEOSSatelliteSettings Meteosat11()
+		{
+			return {
+				0.0_deg,
+				MyRealType(5566.0),
+				MyRealType(5566.0),
+				MyRealType(40'927'010.0),
+				MyRealType(-40'927'010.0)
 			};
+		};
 
-			static SatelliteSettings Meteosat8()
-			{
-				return {
-					41.5_deg,
-					MyRealType(5566.0),
-					MyRealType(5566.0),
-					MyRealType(40'927'010.0),
-					MyRealType(-40'927'010.0)
-				};
-			};
-			
-			static SatelliteSettings Goes16()
-			{
-				//cfac calculated as:
-				//(2.0 / AngleUtils::radToDeg(0.000056))) = (2^-16) * cfac,
-
-				// !!!!!!
-				// GOES has sweep axis x
-				// !!!!!!
-
-				//Visible area:
-				//bbMin.lat = -81.3282_deg; bbMin.lon = -156.2995_deg;
-				//bbMax.lat = 81.3282_deg; bbMax.lon = 6.2995_deg;
-
-				return
-				{
-					-75.0_deg,
-					MyRealType(5423.5),
-					MyRealType(5423.5),
-					MyRealType(40'850'678.0),
-					MyRealType (-40'850'678.0),
-					false
-				};
+		static GEOSSatelliteSettings Meteosat8()
+		{
+			return {
+				41.5_deg,
+				MyRealType(5566.0),
+				MyRealType(5566.0),
+				MyRealType(40'927'010.0),
+				MyRealType(-40'927'010.0)
 			};
+		};
+		
+		static GEOSSatelliteSettings Goes16()
+		{
+			//cfac calculated as:
+			//(2.0 / AngleUtils::radToDeg(0.000056))) = (2^-16) * cfac,
 
-			static SatelliteSettings Goes17()
+			// !!!!!!
+			// GOES has sweep axis x
+			// !!!!!!
+
+			//Visible area:
+			//bbMin.lat = -81.3282_deg; bbMin.lon = -156.2995_deg;
+			//bbMax.lat = 81.3282_deg; bbMax.lon = 6.2995_deg;
+
+			return
 			{
-				SatelliteSettings goes = SatelliteSettings::Goes16();
-				goes.lon = -137.2_deg;
-				return goes;
+				-75.0_deg,
+				MyRealType(5423.5),
+				MyRealType(5423.5),
+				MyRealType(40'850'678.0),
+				MyRealType (-40'850'678.0),
+				false
 			};
 		};
 
+		static GEOSSatelliteSettings Goes17()
+		{
+			GEOSSatelliteSettings goes = GEOSSatelliteSettings::Goes16();
+			goes.lon = -137.2_deg;
+			return goes;
+		};
+	};
+
+	/// <summary>
+	/// Based on section 4.4:
+	/// https://www.cgms-info.org/documents/cgms-lrit-hrit-global-specification-(v2-8-of-30-oct-2013).pdf
+	/// 
+	/// https://github.com/yaswant/ypylib/blob/master/geo.py
+	/// 
+	/// Real is numeric type of projection equations (see ProjectionInfo)
+	/// </summary>
+	template <typename Real = MyRealType>
+	class GEOST : public ProjectionInfo<GEOST<Real>, Real>
+	{
+	protected:
+		using Base = ProjectionInfo<GEOST<Real>, Real>;
+		using typename Base::ProjectedValue;
+		using typename Base::ProjectedValueInverse;
+		using typename Base::InternalBoundingBox;
+
+	public:
+
+		using SatelliteSettings = GEOSSatelliteSettings;
+
 
 		static const bool INDEPENDENT_LAT_LON = false; //can Lat / Lon be computed separatly. To compute one, we dont need the other
 		static const bool ORTHOGONAL_LAT_LON = false; //is lat / lon is orthogonal to each other
 
 
-		GEOS(const SatelliteSettings & sets) :
-			ProjectionInfo(PROJECTION::GEOS),
+		GEOST(const SatelliteSettings & sets) :
+			Base(PROJECTION::GEOS),
 			sat(sets)
 		{}
 
-		GEOS(const GEOS& ge) :
-			GEOS(ge.sat)
+		GEOST(const GEOST& ge) :
+			GEOST(ge.sat)
 		{
 			this->frame = ge.frame;
 		}
 
-		friend class ProjectionInfo<GEOS>;
+		friend class ProjectionInfo<GEOST<Real>, Real>;
 
 	protected:
 		const SatelliteSettings sat;
 		
-		const MyRealType SAT_DIST = MyRealType(42164.160); //Semi-major axis, in km
-		const MyRealType RADIUS_EQUATOR = MyRealType(6378.1370); //in km
-		const MyRealType RADIUS_POLAR = MyRealType(6356.7523); //in km
-		const MyRealType TWO_POW_MINUS_16 = std::pow(2, -16);
+		const Real SAT_DIST = Real(42164.160); //Semi-major axis, in km
+		const Real RADIUS_EQUATOR = Real(6378.1370); //in km
+		const Real RADIUS_POLAR = Real(6356.7523); //in km
+		const Real TWO_POW_MINUS_16 = static_cast<Real>(std::pow(2, -16));
 
 		const char* GetNameInternal() const
 		{
 			return "GEOS";
 		}
 
+		void AddFingerprintInternal(Fingerprint& fp) const
+		{
+			fp.Add(sat.lon.rad()).Add(sat.coff).Add(sat.loff).Add(sat.cfac).Add(sat.lfac).Add(sat.sweepY);
+		}
+
 		InternalBoundingBox GetInternalBoundingBox(const Coordinate & botLeft, const Coordinate & topRight) override
 		{
 			InternalBoundingBox bb;
 			bb.min.x = 0;
 			bb.min.y = 0;
 
-			bb.max.x = 2 * sat.coff;
-			bb.max.y = 2 * sat.loff;
+			bb.max.x = static_cast<Real>(2 * sat.coff);
+			bb.max.y = static_cast<Real>(2 * sat.loff);
 
 			return bb;
 		}
@@ -150,62 +170,62 @@ namespace Projections
 			//0.993305616 = RADIUS_POLAR^2 / RADIUS_EQUATOR^2
 			//0.00669438444 = (RADIUS_EQUATOR^2 - RADIUS_POLAR^2) / RADIUS_EQUATOR^2 
 
-			MyRealType lonDif = c.lon.rad() - sat.lon.rad();
+			Real lonDif = static_cast<Real>(c.lon.rad() - sat.lon.rad());
 
-			MyRealType cLat = std::atan(0.993305616 * std::tan(c.lat.rad()));
-			MyRealType cosCLat = std::cos(cLat);
+			Real cLat = std::atan(Real(0.993305616) * std::tan(static_cast<Real>(c.lat.rad())));
+			Real cosCLat = std::cos(cLat);
 
-			MyRealType r = RADIUS_POLAR / std::sqrt(1 - 0.00669438444 * cosCLat * cosCLat);
+			Real r = RADIUS_POLAR / std::sqrt(1 - Real(0.00669438444) * cosCLat * cosCLat);
 
-			MyRealType r1 = SAT_DIST - r * cosCLat * std::cos(lonDif);
-			MyRealType r2 = r * cosCLat * std::sin(lonDif);
-			MyRealType r3 = r * std::sin(cLat);
+			Real r1 = SAT_DIST - r * cosCLat * std::cos(lonDif);
+			Real r2 = r * cosCLat * std::sin(lonDif);
+			Real r3 = r * std::sin(cLat);
 			
 			ProjectedValue p;
 						
 			if (sat.sweepY)
 			{
-				MyRealType rn = std::sqrt(r1 * r1 + r2 * r2 + r3 * r3);
+				Real rn = std::sqrt(r1 * r1 + r2 * r2 + r3 * r3);
 				p.x = std::atan(r2 / r1);
 				p.y = std::asin(-r3 / rn);
 			}
 			else
 			{
-				MyRealType rn = std::sqrt(r1 * r1 + r3 * r3);
+				Real rn = std::sqrt(r1 * r1 + r3 * r3);
 				p.x = std::atan(r2 / rn);
 				p.y = std::atan(-r3 / r1);
 			}
 			
-			p.x = sat.coff + (AngleUtils::radToDeg(p.x) * TWO_POW_MINUS_16 * sat.cfac);
-			p.y = sat.loff + (AngleUtils::radToDeg(p.y) * TWO_POW_MINUS_16 * sat.lfac);
+			p.x = static_cast<Real>(sat.coff + (AngleUtils::radToDeg(p.x) * TWO_POW_MINUS_16 * sat.cfac));
+			p.y = static_cast<Real>(sat.loff + (AngleUtils::radToDeg(p.y) * TWO_POW_MINUS_16 * sat.lfac));
 
 			return p;
 		};
 
-		ProjectedValueInverse ProjectInverseInternal(MyRealType x, MyRealType y) const
+		ProjectedValueInverse ProjectInverseInternal(Real x, Real y) const
 		{			
 			//1.006739501 = RADIUS_EQUATOR^2 / RADIUS_POLAR^2
 			//1737122264 = (SAT_DIST^2 - RADIUS_EQUATOR^2)
 
-			x = AngleUtils::degToRad((x - sat.coff) / (TWO_POW_MINUS_16 * sat.cfac));
-			y = AngleUtils::degToRad((y - sat.loff) / (TWO_POW_MINUS_16 * sat.lfac));
+			x = static_cast<Real>(AngleUtils::degToRad((x - sat.coff) / (TWO_POW_MINUS_16 * sat.cfac)));
+			y = static_cast<Real>(AngleUtils::degToRad((y - sat.loff) / (TWO_POW_MINUS_16 * sat.lfac)));
 
-			MyRealType cosX = std::cos(x);
-			MyRealType cosY = std::cos(y);
-			MyRealType cos2Y = cosY * cosY;
+			Real cosX = std::cos(x);
+			Real cosY = std::cos(y);
+			Real cos2Y = cosY * cosY;
 
-			MyRealType sinX = std::sin(x);
-			MyRealType sinY = std::sin(y);
-			MyRealType sin2Y = sinY * sinY;
+			Real sinX = std::sin(x);
+			Real sinY = std::sin(y);
+			Real sin2Y = sinY * sinY;
 
-			MyRealType tmp = SAT_DIST * cosX * cosY;
-			MyRealType tmp2 = (cos2Y + 1.006739501 * sin2Y);
+			Real tmp = SAT_DIST * cosX * cosY;
+			Real tmp2 = (cos2Y + Real(1.006739501) * sin2Y);
 
-			MyRealType sd = std::sqrt(tmp * tmp - tmp2 * 1'737'122'264);
-			MyRealType sn = (tmp - sd) / tmp2;
+			Real sd = std::sqrt(tmp * tmp - tmp2 * Real(1'737'122'264));
+			Real sn = (tmp - sd) / tmp2;
 
-			MyRealType s1 = SAT_DIST - sn * cosX * cosY;
-			MyRealType s2, s3;
+			Real s1 = SAT_DIST - sn * cosX * cosY;
+			Real s2, s3;
 			if (sat.sweepY)
 			{
 				s2 = sn * sinX * cosY;
@@ -216,14 +236,16 @@ namespace Projections
 				s2 = sn * sinX;
 				s3 = -sn * sinY * cosX;
 			}
-			MyRealType sxy = std::sqrt(s1 * s1 + s2 * s2);
+			Real sxy = std::sqrt(s1 * s1 + s2 * s2);
 
 			return {
-				Latitude::rad(std::atan(1.006739501 * s3 / sxy)),
-				Longitude::rad(std::atan(s2 / s1) + sat.lon.rad())
+				Latitude::rad(std::atan(Real(1.006739501) * s3 / sxy)),
+				Longitude::rad(std::atan(s2 / s1) + static_cast<Real>(sat.lon.rad()))
 			};			
 		};
 	};
+
+	using GEOS = GEOST<MyRealType>;
 }
 
 #endif
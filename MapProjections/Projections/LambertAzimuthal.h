@@ -15,15 +15,22 @@ namespace Projections
 	/// Based on:
 	/// https://mathworld.wolfram.com/LambertAzimuthalEqual-AreaProjection.html
 	/// 
+	/// Real is numeric type of projection equations (see ProjectionInfo)
 	/// </summary>
-	class LambertAzimuthal : public ProjectionInfo<LambertAzimuthal>
+	template <typename Real = MyRealType>
+	class LambertAzimuthalT : public ProjectionInfo<LambertAzimuthalT<Real>, Real>
 	{
+	protected:
+		using Base = ProjectionInfo<LambertAzimuthalT<Real>, Real>;
+		using typename Base::ProjectedValue;
+		using typename Base::ProjectedValueInverse;
+
 	public:
 		static const bool INDEPENDENT_LAT_LON = false; //can Lat / Lon be computed separatly. To compute one, we dont need the other
 		static const bool ORTHOGONAL_LAT_LON = false; //is lat / lon is orthogonal to each other
 
-		LambertAzimuthal(const Longitude& centralLon, const Latitude& stanParallel) :
-			ProjectionInfo(PROJECTION::LAMBERT_AZIMUTHAL),			
+		LambertAzimuthalT(const Longitude& centralLon, const Latitude& stanParallel) :
+			Base(PROJECTION::LAMBERT_AZIMUTHAL),			
 			centralLon(centralLon),
 			stanParallel(stanParallel),
 			sinStanParallel(std::sin(stanParallel.rad())),
@@ -31,21 +38,21 @@ namespace Projections
 		{			
 		}
 
-		LambertAzimuthal(const LambertAzimuthal& lc) :
-			LambertAzimuthal(lc.centralLon, lc.stanParallel)
+		LambertAzimuthalT(const LambertAzimuthalT& lc) :
+			LambertAzimuthalT(lc.centralLon, lc.stanParallel)
 		{
 			this->frame = lc.frame;
 		}
 
 
-		friend class ProjectionInfo<LambertAzimuthal>;
+		friend class ProjectionInfo<LambertAzimuthalT<Real>, Real>;
 
 	protected:		
 		const Longitude centralLon;
 		const Latitude stanParallel;
 		
-		const double sinStanParallel;
-		const double cosStanParallel;
+		const Real sinStanParallel;
+		const Real cosStanParallel;
 
 		
 		const char* GetNameInternal() const
@@ -53,37 +60,45 @@ namespace Projections
 			return "LambertAzimuthal";
 		}
 
+		void AddFingerprintInternal(Fingerprint& fp) const
+		{
+			fp.Add(centralLon.rad()).Add(stanParallel.rad());
+		}
+
 		ProjectedValue ProjectInternal(const Coordinate& c) const
 		{
 			//vrtule = lat
 
-			double sinLat = std::sin(c.lat.rad());
-			double cosLat = std::cos(c.lat.rad());
-			double cosLonDif = std::cos(c.lon.rad() - centralLon.rad());
+			Real lat = static_cast<Real>(c.lat.rad());
+			Real lonDif = static_cast<Real>(c.lon.rad() - centralLon.rad());
+
+			Real sinLat = std::sin(lat);
+			Real cosLat = std::cos(lat);
+			Real cosLonDif = std::cos(lonDif);
 
-			double tmp0 = sinStanParallel * sinLat;
-			double tmp1 = cosStanParallel * cosLat * cosLonDif;
+			Real tmp0 = sinStanParallel * sinLat;
+			Real tmp1 = cosStanParallel * cosLat * cosLonDif;
 
-			double k = std::sqrt(2.0 / (1.0 + tmp0 + tmp1));
+			Real k = std::sqrt(Real(2.0) / (Real(1.0) + tmp0 + tmp1));
 
-			MyRealType x = k * cosLat * std::sin(c.lon.rad() - centralLon.rad());
-			MyRealType y = k * (cosStanParallel * sinLat - sinStanParallel * cosLat * cosLonDif);
+			Real x = k * cosLat * std::sin(lonDif);
+			Real y = k * (cosStanParallel * sinLat - sinStanParallel * cosLat * cosLonDif);
 			
 			return { x, y };
 		};
 
-		ProjectedValueInverse ProjectInverseInternal(MyRealType x, MyRealType y) const
+		ProjectedValueInverse ProjectInverseInternal(Real x, Real y) const
 		{
-			double ro = std::sqrt(x * x + y * y);
-			double c = 2 * std::asin(0.5 * ro);
+			Real ro = std::sqrt(x * x + y * y);
+			Real c = 2 * std::asin(Real(0.5) * ro);
 
-			double cosC = std::cos(c);
-			double sinC = std::sin(c);
+			Real cosC = std::cos(c);
+			Real sinC = std::sin(c);
 
 
-			MyRealType lat = std::asin(cosC * sinStanParallel + (y * sinC * cosStanParallel) / ro);
+			Real lat = std::asin(cosC * sinStanParallel + (y * sinC * cosStanParallel) / ro);
 
-			MyRealType lon = centralLon.rad() + std::atan((x * sinC) / (ro * cosStanParallel * cosC - y * sinStanParallel * sinC));
+			Real lon = static_cast<Real>(centralLon.rad()) + std::atan((x * sinC) / (ro * cosStanParallel * cosC - y * sinStanParallel * sinC));
 
 			return {
 				Latitude::rad(lat),
@@ -92,6 +107,8 @@ namespace Projections
 		};
 
 	};
+
+	using LambertAzimuthal = LambertAzimuthalT<MyRealType>;
 }
 
 #endif
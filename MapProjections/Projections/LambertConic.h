@@ -15,21 +15,29 @@ namespace Projections
 	/// Based on:
 	/// http://mathworld.wolfram.com/LambertConformalConicProjection.html
 	/// https://en.wikipedia.org/wiki/Lambert_conformal_conic_projection (see only one standard parallel)
+	/// 
+	/// Real is numeric type of projection equations (see ProjectionInfo)
 	/// </summary>
-	class LambertConic : public ProjectionInfo<LambertConic>
+	template <typename Real = MyRealType>
+	class LambertConicT : public ProjectionInfo<LambertConicT<Real>, Real>
 	{
+	protected:
+		using Base = ProjectionInfo<LambertConicT<Real>, Real>;
+		using typename Base::ProjectedValue;
+		using typename Base::ProjectedValueInverse;
+
 	public:
 		static const bool INDEPENDENT_LAT_LON = false; //can Lat / Lon be computed separatly. To compute one, we dont need the other
 		static const bool ORTHOGONAL_LAT_LON = false; //is lat / lon is orthogonal to each other
 
-		LambertConic(const Latitude& latProjOrigin, const Longitude& lonCentMeridian, const Latitude& stanParallel) :
-			LambertConic(latProjOrigin, lonCentMeridian, stanParallel, stanParallel)
+		LambertConicT(const Latitude& latProjOrigin, const Longitude& lonCentMeridian, const Latitude& stanParallel) :
+			LambertConicT(latProjOrigin, lonCentMeridian, stanParallel, stanParallel)
 		{
 		}
 
-		LambertConic(const Latitude& latProjOrigin, const Longitude& lonCentMeridian,
+		LambertConicT(const Latitude& latProjOrigin, const Longitude& lonCentMeridian,
 			const Latitude& stanParallel1, const Latitude& stanParallel2) :
-			ProjectionInfo(PROJECTION::LAMBERT_CONIC),
+			Base(PROJECTION::LAMBERT_CONIC),
 			latProjectionOrigin(latProjOrigin),
 			lonCentralMeridian(lonCentMeridian),
 			standardParallel1(stanParallel1),
@@ -54,14 +62,14 @@ namespace Projections
 			phi0 = f * std::pow(t5, n);
 		}
 
-		LambertConic(const LambertConic& lc) :
-			LambertConic(lc.latProjectionOrigin, lc.lonCentralMeridian, lc.standardParallel1)
+		LambertConicT(const LambertConicT& lc) :
+			LambertConicT(lc.latProjectionOrigin, lc.lonCentralMeridian, lc.standardParallel1)
 		{
 			this->frame = lc.frame;
 		}
 
 
-		friend class ProjectionInfo<LambertConic>;
+		friend class ProjectionInfo<LambertConicT<Real>, Real>;
 
 	protected:
 		const Latitude latProjectionOrigin;
@@ -70,35 +78,42 @@ namespace Projections
 		const Latitude standardParallel2;
 
 
-		double f;
-		double n;
-		double phi0;
+		Real f;
+		Real n;
+		Real phi0;
 
 		const char* GetNameInternal() const
 		{
 			return "LambertConic";
 		}
 
+		void AddFingerprintInternal(Fingerprint& fp) const
+		{
+			fp.Add(latProjectionOrigin.rad()).Add(lonCentralMeridian.rad()).Add(standardParallel1.rad()).Add(standardParallel2.rad());
+		}
+
 		ProjectedValue ProjectInternal(const Coordinate & c) const
 		{
-			MyRealType t = ProjectionUtils::cot(ProjectionConstants::PI_4 + 0.5 * c.lat.rad());
-			MyRealType phi = f * std::pow(t, n);
+			Real lonDif = static_cast<Real>(c.lon.rad() - lonCentralMeridian.rad());
+
+			Real t = ProjectionUtils::cot(Real(ProjectionConstants::PI_4) + Real(0.5) * static_cast<Real>(c.lat.rad()));
+			Real phi = f * std::pow(t, n);
 
-			MyRealType x = phi * std::sin(n * (c.lon.rad() - lonCentralMeridian.rad()));
-			MyRealType y = phi0 - phi * std::cos(n * (c.lon.rad() - lonCentralMeridian.rad()));
+			Real x = phi * std::sin(n * lonDif);
+			Real y = phi0 - phi * std::cos(n * lonDif);
 
 			return { x, y };			
 		};
 
-		ProjectedValueInverse ProjectInverseInternal(MyRealType x, MyRealType y) const
+		ProjectedValueInverse ProjectInverseInternal(Real x, Real y) const
 		{
-			MyRealType phi = ProjectionUtils::sgn(n) * std::sqrt(x * x + (phi0 - y) * (phi0 - y));
-			MyRealType delta = std::atan(x / (phi0 - y));
+			Real phi = ProjectionUtils::sgn(n) * std::sqrt(x * x + (phi0 - y) * (phi0 - y));
+			Real delta = std::atan(x / (phi0 - y));
 
-			MyRealType t = std::pow(f / phi, (1.0 / n));
+			Real t = std::pow(f / phi, (Real(1.0) / n));
 
-			MyRealType lat = 2.0 * std::atan(t) - ProjectionConstants::PI_2;
-			MyRealType lon = lonCentralMeridian.rad() + delta / n;
+			Real lat = Real(2.0) * std::atan(t) - Real(ProjectionConstants::PI_2);
+			Real lon = static_cast<Real>(lonCentralMeridian.rad()) + delta / n;
 
 			return {
 				Latitude::rad(lat),
@@ -107,6 +122,8 @@ namespace Projections
 		};
 
 	};
+
+	using LambertConic = LambertConicT<MyRealType>;
 }
 
 #endif
@@ -14,9 +14,17 @@ namespace Projections
 	/// <summary>
 	/// Based on:
 	/// http://mathworld.wolfram.com/MercatorProjection.html
+	/// 
+	/// Real is numeric type of projection equations (see ProjectionInfo)
 	/// </summary>
-	class Mercator : public ProjectionInfo<Mercator>
+	template <typename Real = MyRealType>
+	class MercatorT : public ProjectionInfo<MercatorT<Real>, Real>
 	{
+	protected:
+		using Base = ProjectionInfo<MercatorT<Real>, Real>;
+		using typename Base::ProjectedValue;
+		using typename Base::ProjectedValueInverse;
+
 	public:
 		inline static const Latitude  MERCATOR_MIN = -85.051_deg;
 		inline static const Latitude  MERCATOR_MAX = 85.051_deg;
@@ -24,15 +32,15 @@ namespace Projections
 		static const bool INDEPENDENT_LAT_LON = true; //can Lat / Lon be computed separatly. To compute one, we dont need the other
 		static const bool ORTHOGONAL_LAT_LON = true; //is lat / lon is orthogonal to each other
 
-		Mercator() : ProjectionInfo(PROJECTION::MERCATOR)
+		MercatorT() : Base(PROJECTION::MERCATOR)
 		{ }
 
-		Mercator(const Mercator& me) : Mercator()
+		MercatorT(const MercatorT& me) : MercatorT()
 		{ 
 			this->frame = me.frame;
 		}
 
-		friend class ProjectionInfo<Mercator>;
+		friend class ProjectionInfo<MercatorT<Real>, Real>;
 
 	protected:
 
@@ -41,15 +49,20 @@ namespace Projections
 			return "Mercator";
 		}
 
+		void AddFingerprintInternal(Fingerprint&) const
+		{
+			//no parameters
+		}
+
 		ProjectedValue ProjectInternal(const Coordinate & c) const
 		{
 			return {
-				c.lon.rad(),
-				std::log(std::tan(ProjectionConstants::PI_4 + MyRealType(0.5) * c.lat.rad()))
+				static_cast<Real>(c.lon.rad()),
+				std::log(std::tan(Real(ProjectionConstants::PI_4) + Real(0.5) * static_cast<Real>(c.lat.rad())))
 			};
 		};
 
-		ProjectedValueInverse ProjectInverseInternal(MyRealType x, MyRealType y) const
+		ProjectedValueInverse ProjectInverseInternal(Real x, Real y) const
 		{
 			//https://www.johndcook.com/blog/2009/09/21/gudermannian/
 			//return {
@@ -58,12 +71,14 @@ namespace Projections
 			//};
 
 			return {
-				Latitude::rad(2.0 * std::atan(std::pow(ProjectionConstants::E, y)) - ProjectionConstants::PI_2),
+				Latitude::rad(Real(2.0) * std::atan(std::pow(Real(ProjectionConstants::E), y)) - Real(ProjectionConstants::PI_2)),
 				Longitude::rad(x)
 			};
 		};
 
 	};
+
+	using Mercator = MercatorT<MyRealType>;
 }
 
 #endif
@@ -14,21 +14,29 @@ namespace Projections
 	/// <summary>
 	/// Based on:
 	/// https://en.wikipedia.org/wiki/Miller_cylindrical_projection
+	/// 
+	/// Real is numeric type of projection equations (see ProjectionInfo)
 	/// </summary>
-	class Miller : public ProjectionInfo<Miller>
+	template <typename Real = MyRealType>
+	class MillerT : public ProjectionInfo<MillerT<Real>, Real>
 	{
+	protected:
+		using Base = ProjectionInfo<MillerT<Real>, Real>;
+		using typename Base::ProjectedValue;
+		using typename Base::ProjectedValueInverse;
+
 	public:
 		static const bool INDEPENDENT_LAT_LON = true; //can Lat / Lon be computed separatly. To compute one, we dont need the other
 		static const bool ORTHOGONAL_LAT_LON = true; //is lat / lon is orthogonal to each other
 
-		Miller() : ProjectionInfo(PROJECTION::MILLER) {}
+		MillerT() : Base(PROJECTION::MILLER) {}
 
-		Miller(const Miller& mi) : ProjectionInfo(PROJECTION::MILLER) 
+		MillerT(const MillerT& mi) : Base(PROJECTION::MILLER) 
 		{
 			this->frame = mi.frame;
 		}
 
-		friend class ProjectionInfo<Miller>;
+		friend class ProjectionInfo<MillerT<Real>, Real>;
 
 	protected:
 
@@ -37,23 +45,30 @@ namespace Projections
 			return "Miller";
 		}
 
+		void AddFingerprintInternal(Fingerprint&) const
+		{
+			//no parameters
+		}
+
 		ProjectedValue ProjectInternal(const Coordinate & c) const
 		{			
 			return {
-				c.lon.rad(),
-				MyRealType(1.25) * std::log(std::tan(ProjectionConstants::PI_4 + MyRealType(0.4) * c.lat.rad()))
+				static_cast<Real>(c.lon.rad()),
+				Real(1.25) * std::log(std::tan(Real(ProjectionConstants::PI_4) + Real(0.4) * static_cast<Real>(c.lat.rad())))
 			};
 		};
 
-		ProjectedValueInverse ProjectInverseInternal(MyRealType x, MyRealType y) const
+		ProjectedValueInverse ProjectInverseInternal(Real x, Real y) const
 		{
 			return {
-				Latitude::rad(2.5 * std::atan(std::pow(ProjectionConstants::E, 0.8 * y)) - 0.625 * ProjectionConstants::PI),
+				Latitude::rad(Real(2.5) * std::atan(std::pow(Real(ProjectionConstants::E), Real(0.8) * y)) - Real(0.625) * Real(ProjectionConstants::PI)),
 				Longitude::rad(x)
 			};
 		};
 
 	};
+
+	using Miller = MillerT<MyRealType>;
 }
 
 #endif
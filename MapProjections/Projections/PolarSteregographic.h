@@ -15,28 +15,36 @@ namespace Projections
 	/// https://web.archive.org/web/20150723100408/http://www.knmi.nl/~beekhuis/rad_proj.html
 	/// with Eccentricity is 1.0 => Based on:
 	/// https://www.dwd.de/DE/leistungen/radolan/radolan_info/radolan_radvor_op_komposit_format_pdf.pdf?__blob=publicationFile&v=8
+	/// 
+	/// Real is numeric type of projection equations (see ProjectionInfo)
 	/// </summary>
-	class PolarSteregographic : public ProjectionInfo<PolarSteregographic>
+	template <typename Real = MyRealType>
+	class PolarSteregographicT : public ProjectionInfo<PolarSteregographicT<Real>, Real>
 	{
+	protected:
+		using Base = ProjectionInfo<PolarSteregographicT<Real>, Real>;
+		using typename Base::ProjectedValue;
+		using typename Base::ProjectedValueInverse;
+
 	public:
 
 		static const bool INDEPENDENT_LAT_LON = false; //can Lat / Lon be computed separatly. To compute one, we dont need the other
 		static const bool ORTHOGONAL_LAT_LON = false; //is lat / lon is orthogonal to each other
 
-		PolarSteregographic() : PolarSteregographic(Longitude::deg(10.0), Latitude::deg(60.0)) {}
-		PolarSteregographic(const Longitude & lonCentralMeridian, const Latitude & latCentral) : ProjectionInfo(PROJECTION::POLAR_STEREOGRAPHICS),
+		PolarSteregographicT() : PolarSteregographicT(Longitude::deg(10.0), Latitude::deg(60.0)) {}
+		PolarSteregographicT(const Longitude & lonCentralMeridian, const Latitude & latCentral) : Base(PROJECTION::POLAR_STEREOGRAPHICS),
 			lonCentralMeridian(lonCentralMeridian),
 			latCentral(latCentral)
 		{ }
 
-		PolarSteregographic(const PolarSteregographic& po) :
-			PolarSteregographic(po.lonCentralMeridian, po.latCentral)			
+		PolarSteregographicT(const PolarSteregographicT& po) :
+			PolarSteregographicT(po.lonCentralMeridian, po.latCentral)			
 		{ 
 			this->frame = po.frame;
 		}
 
 
-		friend class ProjectionInfo<PolarSteregographic>;
+		friend class ProjectionInfo<PolarSteregographicT<Real>, Real>;
 
 	protected:
 
@@ -48,31 +56,45 @@ namespace Projections
 			return "PolarSteregographic";
 		}
 
+		void AddFingerprintInternal(Fingerprint& fp) const
+		{
+			fp.Add(lonCentralMeridian.rad()).Add(latCentral.rad());
+		}
+
 		ProjectedValue ProjectInternal(const Coordinate & c) const
 		{
-			MyRealType m = (1.0 + std::sin(latCentral.rad())) / (1.0 + std::sin(c.lat.rad()));
-			MyRealType cosLat = std::cos(c.lat.rad());
+			const Real EARTH_RADIUS = static_cast<Real>(ProjectionConstants::EARTH_RADIUS);
+
+			Real lat = static_cast<Real>(c.lat.rad());
+			Real lonDif = static_cast<Real>(c.lon.rad() - lonCentralMeridian.rad());
+
+			Real m = (Real(1.0) + std::sin(static_cast<Real>(latCentral.rad()))) / (Real(1.0) + std::sin(lat));
+			Real cosLat = std::cos(lat);
 
 			return {
-				ProjectionConstants::EARTH_RADIUS * m * cosLat * std::sin(c.lon.rad() - lonCentralMeridian.rad()),
-				-ProjectionConstants::EARTH_RADIUS * m * cosLat * std::cos(c.lon.rad() - lonCentralMeridian.rad())
+				EARTH_RADIUS * m * cosLat * std::sin(lonDif),
+				-EARTH_RADIUS * m * cosLat * std::cos(lonDif)
 			};			
 		};
 
-		ProjectedValueInverse ProjectInverseInternal(MyRealType x, MyRealType y) const
+		ProjectedValueInverse ProjectInverseInternal(Real x, Real y) const
 		{			
-			MyRealType tmpSin = std::sin(latCentral.rad());
-			MyRealType tmp = ProjectionConstants::EARTH_RADIUS * ProjectionConstants::EARTH_RADIUS * (1.0 + tmpSin) * (1.0 + tmpSin);
-			MyRealType tmp1 = tmp - (x * x + y * y);
-			MyRealType tmp2 = tmp + (x * x + y * y);
+			const Real EARTH_RADIUS = static_cast<Real>(ProjectionConstants::EARTH_RADIUS);
+
+			Real tmpSin = std::sin(static_cast<Real>(latCentral.rad()));
+			Real tmp = EARTH_RADIUS * EARTH_RADIUS * (Real(1.0) + tmpSin) * (Real(1.0) + tmpSin);
+			Real tmp1 = tmp - (x * x + y * y);
+			Real tmp2 = tmp + (x * x + y * y);
 		
 			return {
 				Latitude::rad(std::asin(tmp1 / tmp2)),
-				Longitude::rad(std::atan(-x / y) + lonCentralMeridian.rad())
+				Longitude::rad(std::atan(-x / y) + static_cast<Real>(lonCentralMeridian.rad()))
 			};
 		};
 
 	};
+
+	using PolarSteregographic = PolarSteregographicT<MyRealType>;
 }
 
 #endif
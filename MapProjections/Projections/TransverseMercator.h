@@ -14,32 +14,40 @@ namespace Projections
 	/// <summary>
 	/// Based on:
 	/// https://en.wikipedia.org/wiki/Transverse_Mercator_projection
+	/// 
+	/// Real is numeric type of projection equations (see ProjectionInfo)
 	/// </summary>
-	class TransverseMercator : public ProjectionInfo<TransverseMercator>
+	template <typename Real = MyRealType>
+	class TransverseMercatorT : public ProjectionInfo<TransverseMercatorT<Real>, Real>
 	{
+	protected:
+		using Base = ProjectionInfo<TransverseMercatorT<Real>, Real>;
+		using typename Base::ProjectedValue;
+		using typename Base::ProjectedValueInverse;
+
 	public:
 		
 		static const bool INDEPENDENT_LAT_LON = false; //can Lat / Lon be computed separatly. To compute one, we dont need the other
 		static const bool ORTHOGONAL_LAT_LON = false; //is lat / lon is orthogonal to each other
 
-		TransverseMercator(const Longitude& centralLon, const Latitude& centralLat) :
-			ProjectionInfo(PROJECTION::TRANSVERSE_MERCATOR),
+		TransverseMercatorT(const Longitude& centralLon, const Latitude& centralLat) :
+			Base(PROJECTION::TRANSVERSE_MERCATOR),
 			centralLon(centralLon),
 			centralLat(centralLat)
 		{
 		}
 
-		TransverseMercator(const TransverseMercator& tme) :
-			TransverseMercator(tme.centralLon, tme.centralLat)
+		TransverseMercatorT(const TransverseMercatorT& tme) :
+			TransverseMercatorT(tme.centralLon, tme.centralLat)
 		{
 			this->frame = tme.frame;
 		}
 
-		friend class ProjectionInfo<TransverseMercator>;
+		friend class ProjectionInfo<TransverseMercatorT<Real>, Real>;
 
 	protected:
 
-		const MyRealType RADIUS_EQUATOR = MyRealType(6378.1370); //in km
+		const Real RADIUS_EQUATOR = Real(6378.1370); //in km
 
 		const Longitude centralLon;
 		const Latitude centralLat;
@@ -49,30 +57,36 @@ namespace Projections
 			return "TransverseMercator";
 		}
 
+		void AddFingerprintInternal(Fingerprint& fp) const
+		{
+			fp.Add(centralLon.rad()).Add(centralLat.rad());
+		}
+
 		ProjectedValue ProjectInternal(const Coordinate& c) const
 		{
 			//centralLon / centralLat added by ChatGPT
 
-			auto dLon = c.lon.rad() - centralLon.rad();
-			auto tmp = std::sin(dLon) * std::cos(c.lat.rad());
+			auto lat = static_cast<Real>(c.lat.rad());
+			auto dLon = static_cast<Real>(c.lon.rad() - centralLon.rad());
+			auto tmp = std::sin(dLon) * std::cos(lat);
 
 			//ses(x) = 1.0 / cos(x)
 
 			return {
-				0.5 * RADIUS_EQUATOR * std::log((1 + tmp) / (1 - tmp)),
-				RADIUS_EQUATOR * (std::atan(ProjectionUtils::sec(dLon) * std::tan(c.lat.rad())) - centralLat.rad())
+				Real(0.5) * RADIUS_EQUATOR * std::log((1 + tmp) / (1 - tmp)),
+				RADIUS_EQUATOR * (std::atan(ProjectionUtils::sec(dLon) * std::tan(lat)) - static_cast<Real>(centralLat.rad()))
 			};
 		};
 
-		ProjectedValueInverse ProjectInverseInternal(MyRealType x, MyRealType y) const
+		ProjectedValueInverse ProjectInverseInternal(Real x, Real y) const
 		{	
 			//centralLon / centralLat added by ChatGPT
 
 			const auto D = x / RADIUS_EQUATOR;
-			const auto E = y / RADIUS_EQUATOR + centralLat.rad();
+			const auto E = y / RADIUS_EQUATOR + static_cast<Real>(centralLat.rad());
 
 			const auto lat = std::asin(std::sin(E) / std::cosh(D));
-			const auto lon = centralLon.rad() + std::atan2(std::sinh(D), std::cos(E));
+			const auto lon = static_cast<Real>(centralLon.rad()) + std::atan2(std::sinh(D), std::cos(E));
 
 			return {
 				Latitude::rad(lat),
@@ -81,6 +95,8 @@ namespace Projections
 		};
 
 	};
+
+	using TransverseMercator = TransverseMercatorT<MyRealType>;
 }
 
 #endif
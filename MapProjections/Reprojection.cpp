@@ -14,7 +14,7 @@ using namespace Projections;
 /// <param name="fileName"></param>
 /// <returns></returns>
 template <typename T>
-Reprojection<T> Reprojection<T>::CreateFromFile(const std::string& fileName)
+Reprojection<T> Reprojection<T>::CreateFromFile(const std::string& fileName, const ReprojectionOptions& options)
 {
 	Reprojection r;
 	r.inH = 0;
@@ -34,6 +34,61 @@ Reprojection<T> Reprojection<T>::CreateFromFile(const std::string& fileName)
 	long size = ftell(f);
 	fseek(f, 0L, SEEK_SET);
 
+	uint32_t magic = 0;
+	fread(&magic, sizeof(uint32_t), 1, f);
+	fseek(f, 0L, SEEK_SET);
+
+	if (magic == ReprojectionFileHeader::MAGIC)
+	{
+		//versioned file - any header error is an error,
+		//file is never read as older format
+		ReprojectionFileHeader header;
+		if (fread(&header, sizeof(ReprojectionFileHeader), 1, f) != 1)
+		{
+			MY_LOG_ERROR("Truncated reprojection file header: \"%s\"\n", fileName.c_str());
+			fclose(f);
+			return r;
+		}
+
+		if (header.version != ReprojectionFileHeader::VERSION)
+		{
+			MY_LOG_ERROR("Unsupported reprojection file version %u: \"%s\"\n", header.version, fileName.c_str());
+			fclose(f);
+			return r;
+		}
+
+		if (header.IsValid<T>(static_cast<uint64_t>(size)) == false)
+		{
+			MY_LOG_ERROR("Invalid reprojection file header: \"%s\"\n", fileName.c_str());
+			fclose(f);
+			return r;
+		}
+
+		fseek(f, static_cast<long>(header.headerSize), SEEK_SET);
+
+		r.pixels.resize(header.pixelsCount);
+		fread(r.pixels.data(), sizeof(Pixel<T>), r.pixels.size(), f);
+
+		fclose(f);
+
+		if (ReprojectionFileHeader::CalcChecksum(r.pixels.data(), r.pixels.size() * sizeof(Pixel<T>)) != header.checksum)
+		{
+			MY_LOG_ERROR("Reprojection file checksum mismatch: \"%s\"\n", fileName.c_str());
+			return Reprojection();
+		}
+
+		r.inW = header.inW;
+		r.inH = header.inH;
+		r.outW = header.outW;
+		r.outH = header.outH;
+
+		r.FinishCreation(options, 1);
+
+		return r;
+	}
+
+	//older format without header
+
 	long dataSize = size - 4 * sizeof(int);
 
 	fread(&(r.inW), sizeof(int), 1, f);
@@ -41,11 +96,23 @@ Reprojection<T> Reprojection<T>::CreateFromFile(const std::string& fileName)
 	fread(&(r.outW), sizeof(int), 1, f);
 	fread(&(r.outH), sizeof(int), 1, f);
 
+	//older format has no checksum, at least the size must match
+	//(eg. versioned file with damaged magic)
+	if ((dataSize < 0) || (r.outW < 0) || (r.outH < 0) ||
+		(static_cast<uint64_t>(dataSize) != static_cast<uint64_t>(r.outW) * static_cast<uint64_t>(r.outH) * sizeof(Pixel<T>)))
+	{
+		MY_LOG_ERROR("Invalid reprojection file: \"%s\"\n", fileName.c_str());
+		fclose(f);
+		return Reprojection();
+	}
+
 	r.pixels.resize(dataSize / sizeof(Pixel<T>));
 	fread(&r.pixels[0], sizeof(Pixel<T>), r.pixels.size(), f);
 
 	fclose(f);
 
+	r.FinishCreation(options, 1);
+
 	return r;
 }
 
@@ -54,7 +121,18 @@ Reprojection<T> Reprojection<T>::CreateFromFile(const std::string& fileName)
 /// </summary>
 /// <param name="fileName"></param>
 template <typename T>
-void Reprojection<T>::SaveToFile(const std::string& fileName)
+bool Reprojection<T>::SaveToFile(const std::string& fileName) const
+{
+	return this->SaveToFile(fileName, this->CreateFileHeader());
+}
+
+/// <summary>
+/// Save reprojection info to file with header
+/// </summary>
+/// <param name="fileName"></param>
+/// <param name="header"></param>
+template <typename T>
+bool Reprojection<T>::SaveToFile(const std::string& fileName, ReprojectionFileHeader header) const
 {
 	FILE* f = nullptr;
 	my_fopen(&f, fileName.c_str(), "wb");
@@ -62,17 +140,33 @@ void Reprojection<T>::SaveToFile(const std::string& fileName)
 	if (f == nullptr)
 	{
 		MY_LOG_ERROR("Failed to open file %s (%s)", fileName.c_str(), strerror(errno));
-		return;
+		return false;
+	}
+
+	header.magic = ReprojectionFileHeader::MAGIC;
+	header.version = ReprojectionFileHeader::VERSION;
+	header.headerSize = sizeof(ReprojectionFileHeader);
+	header.pixelType = ReprojectionFileHeader::GetPixelType<T>();
+	header.inW = this->inW;
+	header.inH = this->inH;
+	header.outW = this->outW;
+	header.outH = this->outH;
+	header.pixelsCount = this->pixels.size();
+	header.checksum = ReprojectionFileHeader::CalcChecksum(this->pixels.data(), this->pixels.size() * sizeof(Pixel<T>));
+
+	bool ok = (fwrite(&header, sizeof(ReprojectionFileHeader), 1, f) == 1);
+	ok &= (fwrite(this->pixels.data(), sizeof(Pixel<T>), this->pixels.size(), f) == this->pixels.size());
+	ok &= (fclose(f) == 0);
+
+	if (ok == false)
+	{
+		MY_LOG_ERROR("Failed to write file %s", fileName.c_str());
 	}
-	fwrite(&this->inW, sizeof(int), 1, f);
-	fwrite(&this->inH, sizeof(int), 1, f);
-	fwrite(&this->outW, sizeof(int), 1, f);
-	fwrite(&this->outH, sizeof(int), 1, f);
-	fwrite(this->pixels.data(), sizeof(Pixel<T>), this->pixels.size(), f);
-	fclose(f);
 
+	return ok;
 }
 
 template struct Projections::Reprojection<int>;
 template struct Projections::Reprojection<short>;
 template struct Projections::Reprojection<float>;
+template struct Projections::Reprojection<Projections::Fixed24_8>;
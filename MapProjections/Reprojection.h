@@ -2,14 +2,41 @@
 #define REPROJECTION_H
 
 #include <vector>
+#include <array>
+#include <memory_resource>
+#include <cmath>
+#include <algorithm>
 
 
 #include "./MapProjectionStructures.h"
 #include "./ProjectionInfo.h"
+#include "./ParallelUtils.h"
+#include "./ReprojectionFile.h"
+#include "./ValidSpans.h"
+#include "./InputFootprint.h"
+#include "./DataLayout.h"
+#include "./LanczosFilter.h"
+#include "./GatherPlan.h"
 
 namespace Projections
 {
 
+	/// <summary>
+	/// Optional work done at the end of CreateReprojection* / Compose
+	/// </summary>
+	struct ReprojectionOptions
+	{
+		//if not null, input is remapped to input footprint enlarged by cropMargin
+		//(see Reprojection::CropInputToFootprint) and region of the original input,
+		//that has to be passed to ReprojectData*, is stored here
+		InputFootprint* cropRegion = nullptr;
+		int cropMargin = 0;
+
+		//build index of valid pixels (see Reprojection::validSpans)
+		//if false, it is not built and ReprojectData* test every pixel
+		bool buildValidSpans = true;
+	};
+
 	/// <summary>
 	/// Reprojection structure
 	/// It holds info needed to reproject data from one projection
@@ -34,11 +61,33 @@ namespace Projections
 	template <typename T = int>
 	struct Reprojection
 	{	
+		//number of output rows processed as a single work item
+		//in multi-threaded creation
+		static const int ROW_BAND_SIZE = 8;
+
 		int inW;
 		int inH;
 		int outW;
 		int outH;
-		std::vector<Pixel<T>> pixels; //[to] = from
+		//allocated from memory resource passed to constructor (default - new / delete)
+		std::pmr::vector<Pixel<T>> pixels; //[to] = from
+
+		//optional index of valid pixels for every output row
+		//collected by CreateReprojection* / Compose while pixels are created,
+		//built by loaders, skipped if ReprojectionOptions::buildValidSpans is false
+		//if pixels are modified directly, BuildValidSpans must be called again
+		ValidSpans validSpans;
+
+		//region of input used by pixels
+		//collected by CreateReprojection* / Compose while pixels are created,
+		//loaded or converted (compressed / mapped) reprojections have it empty
+		//(CropInputToFootprint builds it on demand)
+		//if pixels are modified directly, BuildInputFootprint must be called again
+		InputFootprint inputFootprint;
+
+		//optional order of output tiles with better locality of input reads
+		//(empty - row-major order), see BuildGatherPlan
+		GatherPlan gatherPlan;
 
 		Reprojection() : 
 			inW(0),
@@ -48,6 +97,23 @@ namespace Projections
 		{
 		}
 
+		/// <summary>
+		/// Create empty reprojection, whose pixels are allocated from resource
+		/// (eg. std::pmr::unsynchronized_pool_resource reused in processing loop).
+		/// Reprojection created by CreateReprojection* / CreateFromFile 
+		/// can be moved to it with assignment - pixels are copied to the resource.
+		/// Resource must outlive the reprojection.
+		/// </summary>
+		/// <param name="resource"></param>
+		explicit Reprojection(std::pmr::memory_resource* resource) :
+			inW(0),
+			inH(0),
+			outW(0),
+			outH(0),
+			pixels(resource)
+		{
+		}
+
 		/// <summary>
 		/// Create cache name in format:
 		/// reproj_from_w_h_to_w_h
@@ -87,19 +153,34 @@ namespace Projections
 
 		/// <summary>
 		/// Load reprojection from file		
+		/// Versioned files are checked for version, pixel type, size and checksum,
+		/// file with invalid header is never read as older format.
+		/// Files without header (older format) are checked only for size.
+		/// Valid spans are built and input is cropped as in CreateReprojection (see ReprojectionOptions).
 		/// </summary>
 		/// <param name="imProj"></param>
+		/// <param name="options"></param>
 		/// <returns></returns>	
-		static Reprojection<T> CreateFromFile(const std::string& fileName);
+		static Reprojection<T> CreateFromFile(const std::string& fileName, 
+			const ReprojectionOptions& options = ReprojectionOptions());
 		
 		/// <summary>
 		/// Re-project data from -> to
 		/// Calculates mapping: toData[index] = fromData[reprojection[index]]
+		/// 
+		/// threadsCount - number of threads used to build the mapping
+		/// (1 - run on calling thread, 0 - use all hardware threads)
+		/// Output rows are split to bands that are distributed among threads 
+		/// with work stealing. Result is identical to the single thread build.
 		/// </summary>
-		/// <param name="imProj"></param>
+		/// <param name="from"></param>
+		/// <param name="to"></param>
+		/// <param name="threadsCount"></param>
+		/// <param name="options"></param>
 		/// <returns></returns>	
 		template <typename FromProjection, typename ToProjection>
-		static Reprojection<T> CreateReprojection(FromProjection* from, ToProjection* to)
+		static Reprojection<T> CreateReprojection(FromProjection* from, ToProjection* to, size_t threadsCount = 1,
+			const ReprojectionOptions& options = ReprojectionOptions())
 		{
 
 			Reprojection<T> reprojection;
@@ -107,150 +188,260 @@ namespace Projections
 
 			const auto& f = to->GetFrame();
 
-			if ((f.repeatNegCount != 0) || (f.repeatPosCount != 0))
+			bool wrapAround = (f.repeatNegCount != 0) || (f.repeatPosCount != 0);
+
+			reprojection.inW = from->GetFrameWidth();
+			reprojection.inH = from->GetFrameHeight();
+			reprojection.outW = to->GetFrameWidth();
+			reprojection.outH = to->GetFrameHeight();
+
+			if ((from->IsIndependentLatLon()) && (to->IsIndependentLatLon()))
 			{
-				//we have multiple wrap around of the world
+				//if x and y are independent, simplify
+				std::vector<T> cacheX;
+				std::vector<T> cacheY;
+
+				CreateSeparableCache(from, to, cacheX, cacheY);
 
-				//calculate full size of from projection image
-				Projections::Coordinate bbMin, bbMax;
+				reprojection.FillFromSeparableCache(cacheX, cacheY, threadsCount, options.buildValidSpans);
+			}
+			else if (wrapAround)
+			{
+				//we have multiple wrap around of the world
+				int offset = GetWrapAroundOffset(from);
+				
+				reprojection.CreateRows(threadsCount, options.buildValidSpans, [&](int y) {
+					int yw = y * to->GetFrameWidth();
+					for (int x = 0; x < to->GetFrameWidth(); x++)
+					{
+						Pixel<T> p = Reprojection<T>::ReProject<int, T>({ x, y }, from, to);
 
-				bbMin.lat = -90.0_deg;
-				bbMin.lon = -180.0_deg;
+						if ((p.y < 0) || (p.y >= from->GetFrameHeight()))
+						{
+							continue;
+						}
 
-				bbMax.lat = 90.06_deg;
-				bbMax.lon = 180.0_deg;
+						p.x = ResolveWrapAroundX(p.x, offset, f, reprojection.inW);
 
-				Pixel<MyRealType> pp1 = from->template Project<MyRealType>(bbMin);
-				Pixel<MyRealType> pp2 = from->template Project<MyRealType>(bbMax);
+						if (p.x >= 0)
+						{
+							reprojection.pixels[x + yw] = p;
+						}
+					}
+				});
 
-				MyRealType ww = pp2.x - pp1.x;
-				MyRealType hh = pp1.y - pp2.y;
-				
-				for (int y = 0; y < to->GetFrameHeight(); y++)
-				{
+			}			
+			else 
+			{				
+				reprojection.CreateRows(threadsCount, options.buildValidSpans, [&](int y) {
 					int yw = y * to->GetFrameWidth();
 					for (int x = 0; x < to->GetFrameWidth(); x++)
 					{
 						Pixel<T> p = Reprojection<T>::ReProject<int, T>({ x, y }, from, to);
 
-						if ((p.x >= 0) &&
-							(p.y >= 0) &&
+						if ((p.x >= 0) && 
+							(p.y >= 0) && 
 							(p.x < from->GetFrameWidth()) &&
 							(p.y < from->GetFrameHeight()))
 						{
 							reprojection.pixels[x + yw] = p;
-						}
+						}						
+					}
+				});
+			}
 
+			reprojection.FinishCreation(options, threadsCount);
 
-						int offset = static_cast<int>(ww);
+			return reprojection;
+		};
 
-						T px = p.x;
+		/// <summary>
+		/// Calculate input column for every output column (cacheX) 
+		/// and input row for every output row (cacheY).
+		/// Usable only if both projections have independent lat / lon.
+		/// 
+		/// With wrap around, only one world period of columns is computed
+		/// and the rest is replicated.
+		/// Values outside of the input image are kept as they are.
+		/// </summary>
+		/// <param name="from"></param>
+		/// <param name="to"></param>
+		/// <param name="cacheX"></param>
+		/// <param name="cacheY"></param>
+		template <typename FromProjection, typename ToProjection>
+		static void CreateSeparableCache(FromProjection* from, ToProjection* to,
+			std::vector<T>& cacheX, std::vector<T>& cacheY)
+		{
+			const auto& f = to->GetFrame();
 
-						MyRealType nc = f.repeatNegCount;						
-						while (nc > 0)
-						{
-							p.x += offset;
+			bool wrapAround = (f.repeatNegCount != 0) || (f.repeatPosCount != 0);
 
-							if ((p.x >= 0) &&
-								(p.y >= 0) &&
-								(p.x < from->GetFrameWidth()) &&
-								(p.y < from->GetFrameHeight()))
-							{
-								reprojection.pixels[x + yw] = p;
-							}
-							nc--;
-						}
+			int periodW = (wrapAround) ? GetWrapAroundPeriod(f, to->GetFrameWidth()) : to->GetFrameWidth();
 
-						p.x = px; //restore p.x
+			cacheX.resize(to->GetFrameWidth());
+			cacheY.resize(to->GetFrameHeight());
 
-						MyRealType pc = f.repeatPosCount;						
-						while (pc > 0)
-						{
-							p.x -= offset;
+			for (int x = 0; x < periodW; x++)
+			{
+				Projections::Pixel<T> p = Reprojection<T>::template ReProject<int, T>({ x, 0 }, from, to);
+				cacheX[x] = p.x;
+			}
 
-							if ((p.x >= 0) &&
-								(p.y >= 0) &&
-								(p.x < from->GetFrameWidth()) &&
-								(p.y < from->GetFrameHeight()))
-							{
-								reprojection.pixels[x + yw] = p;
-							}
-							pc--;
-						}
+			for (int y = 0; y < to->GetFrameHeight(); y++)
+			{
+				Projections::Pixel<T> p = Reprojection<T>::template ReProject<int, T>({ 0, y }, from, to);
+				cacheY[y] = p.y;
 
-					}
-				}
+			}
 
-			}						
-			else if ((from->IsIndependentLatLon()) && (to->IsIndependentLatLon()))
+			if (wrapAround)
 			{
-				//if x and y are independent, simplify
+				ResolveWrapAroundColumns(cacheX, periodW, GetWrapAroundOffset(from), f, from->GetFrameWidth());
+			}
+		}
 
-				std::vector<T> cacheX;
-				cacheX.resize(to->GetFrameWidth());
+		/// <summary>
+		/// Re-project data from -> to with approximation
+		/// Calculates mapping: toData[index] = fromData[reprojection[index]]
+		/// 
+		/// Exact mapping is evaluated only in corners of output tiles. 
+		/// Pixels inside the tile are bilinearly interpolated from the corners.
+		/// Interpolation is checked against exact values in tile center and 
+		/// edge midpoints. If the difference is larger than maxError (in input pixels),
+		/// tile is subdivided. Small tiles, or tiles with invalid values 
+		/// (eg. outside of GEOS disk), are evaluated exactly per pixel.
+		/// 
+		/// For pairs with independent lat / lon and for frames with multiple 
+		/// wrap around of the world, exact CreateReprojection is used, 
+		/// because it is already cheap
+		/// </summary>
+		/// <param name="from"></param>
+		/// <param name="to"></param>
+		/// <param name="maxError">maximal error in input pixels</param>
+		/// <param name="threadsCount"></param>
+		/// <param name="options"></param>
+		/// <returns></returns>
+		template <typename FromProjection, typename ToProjection>
+		static Reprojection<T> CreateReprojectionApproximate(FromProjection* from, ToProjection* to,
+			MyRealType maxError = MyRealType(0.125), size_t threadsCount = 1,
+			const ReprojectionOptions& options = ReprojectionOptions())
+		{
+			const auto& f = to->GetFrame();
 
-				std::vector<T> cacheY;
-				cacheY.resize(to->GetFrameHeight());
+			if ((f.repeatNegCount != 0) || (f.repeatPosCount != 0) ||
+				((from->IsIndependentLatLon()) && (to->IsIndependentLatLon())))
+			{
+				return CreateReprojection(from, to, threadsCount, options);
+			}
 
-				for (int x = 0; x < to->GetFrameWidth(); x++)
-				{
-					Projections::Pixel<T> p = Reprojection<T>::ReProject<int, T>({ x, 0 }, from, to);
-					cacheX[x] = p.x;
-				}
+			Reprojection<T> reprojection;
+			reprojection.inW = from->GetFrameWidth();
+			reprojection.inH = from->GetFrameHeight();
+			reprojection.outW = to->GetFrameWidth();
+			reprojection.outH = to->GetFrameHeight();
+			reprojection.pixels.resize(reprojection.outW * reprojection.outH, { -1, -1 });
 
-				for (int y = 0; y < to->GetFrameHeight(); y++)
-				{
-					Projections::Pixel<T> p = Reprojection<T>::ReProject<int, T>({ 0, y }, from, to);
-					cacheY[y] = p.y;
+			int tilesX = (reprojection.outW + APPROX_TILE_SIZE - 1) / APPROX_TILE_SIZE;
+			int tilesY = (reprojection.outH + APPROX_TILE_SIZE - 1) / APPROX_TILE_SIZE;
 
-				}
+			//input footprint of every row of tiles
+			std::vector<InputFootprint> bands(tilesY);
 
-				for (int y = 0; y < to->GetFrameHeight(); y++)
+			//valid spans of every output row
+			std::vector<std::vector<ValidSpans::Span>> spanRows(options.buildValidSpans ? reprojection.outH : 0);
+
+			ParallelUtils::RunRowBands(tilesY, 1, threadsCount, [&](int startRow, int endRow) {
+				for (int ty = startRow; ty < endRow; ty++)
 				{
-					int yw = y * to->GetFrameWidth();
-					for (int x = 0; x < to->GetFrameWidth(); x++)
+					int y0 = ty * APPROX_TILE_SIZE;
+					int y1 = std::min(y0 + APPROX_TILE_SIZE, reprojection.outH) - 1;
+
+					for (int tx = 0; tx < tilesX; tx++)
 					{
-						Pixel<T> p;
-						p.x = cacheX[x];
-						p.y = cacheY[y];
+						int x0 = tx * APPROX_TILE_SIZE;
+						int x1 = std::min(x0 + APPROX_TILE_SIZE, reprojection.outW) - 1;
 
-						if (p.x < 0) continue;
-						if (p.y < 0) continue;
-						if (p.x >= from->GetFrameWidth()) continue;
-						if (p.y >= from->GetFrameHeight()) continue;
+						reprojection.ApproximateTile(x0, y0, x1, y1, maxError, from, to);
+					}
 
-						reprojection.pixels[x + yw] = p;
+					reprojection.BuildBandFootprint(y0, y1 + 1, bands[ty]);
 
+					if (options.buildValidSpans)
+					{
+						ValidSpans::BuildRows(reprojection.pixels.data(), reprojection.outW, y0, y1 + 1, spanRows);
 					}
 				}
-			}			
-			else 
-			{				
-				for (int y = 0; y < to->GetFrameHeight(); y++)
+			});
+
+			reprojection.inputFootprint.Merge(bands);
+			if (options.buildValidSpans)
+			{
+				reprojection.validSpans.SetRows(spanRows);
+			}
+			reprojection.FinishCreation(options, threadsCount);
+
+			return reprojection;
+		};
+
+		/// <summary>
+		/// Compose two reprojections A -> B and B -> C 
+		/// to the reprojection A -> C without evaluating projections
+		/// Calculates mapping: C[index] = A[a[b[index]]]
+		/// 
+		/// For integral T, mapping of a is taken directly.
+		/// For floating / fixed point T, mapping of a is bilinearly interpolated
+		/// at fractional positions of b. If some of the 4 neighbours is invalid
+		/// or neighbours are across wrap around seam (more than half of input 
+		/// image apart), nearest neighbour is used instead.
+		/// 
+		/// If output of a does not match input of b, empty reprojection is returned
+		/// </summary>
+		/// <param name="a">reprojection A -> B</param>
+		/// <param name="b">reprojection B -> C</param>
+		/// <param name="threadsCount"></param>
+		/// <param name="options"></param>
+		/// <returns></returns>
+		static Reprojection<T> Compose(const Reprojection<T>& a, const Reprojection<T>& b, size_t threadsCount = 1,
+			const ReprojectionOptions& options = ReprojectionOptions())
+		{
+			Reprojection<T> reprojection;
+
+			if ((a.outW != b.inW) || (a.outH != b.inH) || (a.pixels.size() != static_cast<size_t>(a.outW) * a.outH))
+			{
+				return reprojection;
+			}
+
+			reprojection.inW = a.inW;
+			reprojection.inH = a.inH;
+			reprojection.outW = b.outW;
+			reprojection.outH = b.outH;
+			reprojection.pixels.resize(b.pixels.size(), { -1, -1 });
+
+			reprojection.CreateRows(threadsCount, options.buildValidSpans, [&](int y) {
+				size_t yw = static_cast<size_t>(y) * b.outW;
+				for (int x = 0; x < b.outW; x++)
 				{
-					int yw = y * to->GetFrameWidth();
-					for (int x = 0; x < to->GetFrameWidth(); x++)
+					const Pixel<T>& p = b.pixels[x + yw];
+					if ((p.x == -1) || (p.y == -1))
 					{
-						Pixel<T> p = Reprojection<T>::ReProject<int, T>({ x, y }, from, to);
+						continue;
+					}
 
-						if ((p.x >= 0) && 
-							(p.y >= 0) && 
-							(p.x < from->GetFrameWidth()) &&
-							(p.y < from->GetFrameHeight()))
-						{
-							reprojection.pixels[x + yw] = p;
-						}						
+					if constexpr (std::is_integral<T>::value)
+					{
+						reprojection.pixels[x + yw] = a.pixels[p.x + static_cast<size_t>(p.y) * a.outW];
+					}
+					else
+					{
+						reprojection.pixels[x + yw] = a.InterpolateMapping(p.x, p.y);
 					}
 				}
-			}
+			});
 
-			reprojection.inW = from->GetFrameWidth();
-			reprojection.inH = from->GetFrameHeight();
-			reprojection.outW = to->GetFrameWidth();
-			reprojection.outH = to->GetFrameHeight();
+			reprojection.FinishCreation(options, threadsCount);
 
 			return reprojection;
-		};
+		}
 
 		/// <summary>
 		/// Clamp input fromData to map only from sub-image (sub-region)
@@ -281,89 +472,177 @@ namespace Projections
 			}
 			this->inW = w;
 			this->inH = h;
-		}
-		
-		/// <summary>
-		/// Save reprojection to file
-		/// </summary>
-		/// <param name="fileName"></param>
-		void SaveToFile(const std::string& fileName);
 
+			if (this->validSpans.IsEmpty() == false)
+			{
+				this->BuildValidSpans();
+			}
+
+			if (this->inputFootprint.IsEmpty() == false)
+			{
+				this->BuildInputFootprint();
+			}
+		}
 
 		/// <summary>
-		/// Reproject inputData based on reproj with Nerest Neighbor interpolation.
-		/// Output array has size reproj.outW * reproj.outH
-		/// Output array must be released with delete[]
+		/// Remap input of reprojection to its footprint (region of input 
+		/// that is really used, see inputFootprint), enlarged by margin 
+		/// (1 for bilinear, 2 for bicubic interpolation).
 		/// 
-		/// Template parameters:
-		/// DataType - type of input data		
-		/// Out - output structure - can be raw array of std::vector
-		/// ChannelsCount - number of channels in input / output data
+		/// Returns footprint in coordinates of the original input. 
+		/// Only its [startX, endX) x [startY, endY) region has to be passed 
+		/// to ReprojectData* methods as inputData.
+		/// 
+		/// Unlike ClampInputToSubImage, all valid pixels are inside the region,
+		/// so pixels are only moved in one pass and valid spans are kept.
+		/// After the call, inputFootprint is relative to the new input.
 		/// </summary>
-		/// <param name="reproj"></param>
-		/// <param name="inputData"></param>
-		/// <param name="NO_VALUE"></param>
+		/// <param name="margin"></param>
 		/// <returns></returns>
-		template <typename DataType, typename Out = DataType*, size_t ChannelsCount = 1>
-		Out ReprojectDataNerestNeighbor(const DataType* inputData, const DataType NO_VALUE) const
+		InputFootprint CropInputToFootprint(int margin = 0)
 		{
-			size_t count = this->outW * this->outH;
-
-			Out output;
-
-			if constexpr (std::is_same<Out, DataType*>::value)
+			if (this->inputFootprint.IsEmpty())
 			{
-				output = new DataType[count * ChannelsCount];
+				this->BuildInputFootprint();
 			}
-			else if constexpr (std::is_same<Out, std::vector<DataType>>::value)
+
+			InputFootprint fp = this->inputFootprint.Expand(margin, this->inW, this->inH);
+			if (fp.IsEmpty())
 			{
-				output.resize(count * ChannelsCount);
+				return fp;
 			}
 
-			for (size_t index = 0; index < count; index++)
-			{
-				int x = static_cast<int>(this->pixels[index].x);
-				int y = static_cast<int>(this->pixels[index].y);
+			const T dx = static_cast<T>(fp.startX);
+			const T dy = static_cast<T>(fp.startY);
 
-				if ((x == -1) || (y == -1))
-				{
-					//outside of the model - no data - put there NO_VALUE
-					if constexpr (ChannelsCount == 1)
-					{
-						output[index] = NO_VALUE;
-					}
-					else
-					{
-						for (size_t i = 0; i < ChannelsCount; i++)
-						{
-							output[index * ChannelsCount + i] = NO_VALUE;
-						}
-					}
-				}
-				else
+			if ((dx != 0) || (dy != 0))
+			{
+				for (auto& v : this->pixels)
 				{
-					size_t origIndex = x + y * this->inW;
-					if constexpr (ChannelsCount == 1)
+					if ((v.x == -1) || (v.y == -1))
 					{
-						output[index] = inputData[origIndex];
-					}
-					else
-					{
-						for (size_t i = 0; i < ChannelsCount; i++)
-						{
-							output[index * ChannelsCount + i] = inputData[origIndex * ChannelsCount + i];
-						}
+						continue;
 					}
+
+					v.x -= dx;
+					v.y -= dy;
 				}
 			}
 
-			return output;
+			this->inW = fp.GetWidth();
+			this->inH = fp.GetHeight();
+			this->inputFootprint.Offset(-fp.startX, -fp.startY);
+
+			return fp;
 		}
 
 		/// <summary>
-		/// Reproject inputData based on reproj with Bilinear interpolation.
-		/// Note: Usable only if T is nor int number
+		/// Build index of valid pixels for every output row
+		/// ReprojectData* methods use it to fill invalid parts of rows at once
+		/// and to skip per pixel validity tests
+		/// </summary>
+		/// <param name="threadsCount"></param>
+		void BuildValidSpans(size_t threadsCount = 1)
+		{
+			this->validSpans.Build(this->pixels.data(), this->outW, this->outH, threadsCount);
+		}
+
+		/// <summary>
+		/// Build region of input that is used by pixels
+		/// (bounding rectangle and used columns of every input row)
+		/// CreateReprojection* collect it while pixels are created,
+		/// it has to be called only after pixels are modified or loaded
+		/// </summary>
+		void BuildInputFootprint()
+		{
+			this->inputFootprint.Build(this->pixels.data(), this->pixels.size(), this->inW, this->inH);
+		}
+
+		/// <summary>
+		/// Build order of output tiles with better locality of input reads (see GatherPlan)
+		/// ReprojectDataNerestNeighbor and ReprojectDataBilinear then traverse output
+		/// in tiles and prefetch inputs of the next tile.
+		/// Useful for rotated mappings and inputs much larger than cache.
 		/// 
+		/// If tileSize is 0, it is chosen from the mapping and if output rows
+		/// read only few input rows, plan stays empty (row-major order is used).
+		/// If pixels are modified directly, it must be called again (or gatherPlan cleared)
+		/// </summary>
+		/// <param name="tileSize"></param>
+		void BuildGatherPlan(int tileSize = 0)
+		{
+			this->gatherPlan.Build(this->pixels.data(), this->outW, this->outH, tileSize);
+		}
+
+		/// <summary>
+		/// Get size of reprojection in memory
+		/// (pixels, valid spans, input footprint and gather plan)
+		/// </summary>
+		/// <returns></returns>
+		size_t GetBytes() const
+		{
+			return sizeof(Reprojection<T>) +
+				this->pixels.size() * sizeof(Pixel<T>) +
+				this->validSpans.spans.size() * sizeof(ValidSpans::Span) +
+				this->validSpans.rowOffsets.size() * sizeof(uint32_t) +
+				this->inputFootprint.rows.size() * sizeof(InputFootprint::Range) +
+				this->gatherPlan.GetBytes();
+		}
+		
+		/// <summary>
+		/// Save reprojection to versioned file
+		/// without info about projections
+		/// </summary>
+		/// <param name="fileName"></param>
+		bool SaveToFile(const std::string& fileName) const;
+
+		/// <summary>
+		/// Save reprojection to versioned file
+		/// Header contains names and frame ids of from and to projections
+		/// </summary>
+		/// <param name="fileName"></param>
+		/// <param name="from"></param>
+		/// <param name="to"></param>
+		/// <returns>false, if file could not be written</returns>
+		template <typename FromProjection, typename ToProjection>
+		bool SaveToFile(const std::string& fileName, const FromProjection* from, const ToProjection* to) const
+		{
+			ReprojectionFileHeader header = this->CreateFileHeader();
+			header.SetProjectionInfo(from->GetName(), from->GetFrame().GetId(),
+				to->GetName(), to->GetFrame().GetId());
+
+			return this->SaveToFile(fileName, header);
+		}
+
+		/// <summary>
+		/// Save reprojection to versioned file with given header
+		/// Dimensions, pixel type and checksum in the header are updated
+		/// </summary>
+		/// <param name="fileName"></param>
+		/// <param name="header"></param>
+		/// <returns>false, if file could not be written</returns>
+		bool SaveToFile(const std::string& fileName, ReprojectionFileHeader header) const;
+
+		/// <summary>
+		/// Create file header with dimensions and pixel type 
+		/// of this reprojection
+		/// </summary>
+		/// <returns></returns>
+		ReprojectionFileHeader CreateFileHeader() const
+		{
+			ReprojectionFileHeader header;
+			header.pixelType = ReprojectionFileHeader::GetPixelType<T>();
+			header.inW = this->inW;
+			header.inH = this->inH;
+			header.outW = this->outW;
+			header.outH = this->outH;
+			header.pixelsCount = this->pixels.size();
+			return header;
+		}
+
+
+		/// <summary>
+		/// Reproject inputData based on reproj with Nerest Neighbor interpolation.
 		/// Output array has size reproj.outW * reproj.outH
 		/// Output array must be released with delete[]
 		/// 
@@ -371,255 +650,2094 @@ namespace Projections
 		/// DataType - type of input data		
 		/// Out - output structure - can be raw array of std::vector
 		/// ChannelsCount - number of channels in input / output data
+		/// 
+		/// threadsCount - number of threads used to compute output (0 - all hardware threads)
+		/// result is same as with single thread
 		/// </summary>
 		/// <param name="reproj"></param>
 		/// <param name="inputData"></param>
 		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
 		/// <returns></returns>
 		template <typename DataType, typename Out = DataType*, size_t ChannelsCount = 1>
-		Out ReprojectDataBilinear(const DataType* inputData, const DataType NO_VALUE) const
+		Out ReprojectDataNerestNeighbor(const DataType* inputData, const DataType NO_VALUE, size_t threadsCount = 1) const
 		{
-			size_t count = this->outW * this->outH;
+			size_t count = static_cast<size_t>(this->outW) * this->outH;
 
-			Out output;
+			Out output = AllocateOutput<DataType, Out, ChannelsCount>(count);
 
-			if constexpr (std::is_same<Out, DataType*>::value)
+			this->template ReprojectDataNerestNeighbor<DataType, ChannelsCount>(inputData, GetOutputData<DataType>(output),
+				static_cast<size_t>(this->outW) * ChannelsCount, NO_VALUE, threadsCount);
+
+			return output;
+		}
+
+		/// <summary>
+		/// Reproject inputData based on reproj with Bilinear interpolation.
+		/// Note: Usable only if T is nor int number
+		/// With fixed point T (eg. Fixed24_8) and integral data,
+		/// integer weights are used
+		/// 
+		/// Output array has size reproj.outW * reproj.outH
+		/// Output array must be released with delete[]
+		/// 
+		/// Template parameters:
+		/// DataType - type of input data		
+		/// Out - output structure - can be raw array of std::vector
+		/// ChannelsCount - number of channels in input / output data
+		/// 
+		/// threadsCount - number of threads used to compute output (0 - all hardware threads)
+		/// result is same as with single thread
+		/// </summary>
+		/// <param name="reproj"></param>
+		/// <param name="inputData"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out = DataType*, size_t ChannelsCount = 1>
+		Out ReprojectDataBilinear(const DataType* inputData, const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			size_t count = static_cast<size_t>(this->outW) * this->outH;
+
+			Out output = AllocateOutput<DataType, Out, ChannelsCount>(count);
+
+			this->template ReprojectDataBilinear<DataType, ChannelsCount>(inputData, GetOutputData<DataType>(output),
+				static_cast<size_t>(this->outW) * ChannelsCount, NO_VALUE, threadsCount);
+
+			return output;
+		}
+
+
+		/// <summary>
+		/// Reproject inputData based on reproj with Bicubic interpolation.
+		/// Note: Usable only if T is nor int number
+		/// With fixed point T (eg. Fixed24_8) and integral data,
+		/// integer weights are used
+		/// 
+		/// Output array has size reproj.outW * reproj.outH
+		/// Output array must be released with delete[]
+		/// 
+		/// Template parameters:
+		/// DataType - type of input data		
+		/// Out - output structure - can be raw array of std::vector
+		/// ChannelsCount - number of channels in input / output data
+		/// 
+		/// threadsCount - number of threads used to compute output (0 - all hardware threads)
+		/// result is same as with single thread
+		/// </summary>
+		/// <param name="reproj"></param>
+		/// <param name="inputData"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out = DataType*, size_t ChannelsCount = 1>
+		Out ReprojectDataBicubic(const DataType* inputData, const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			const int w = this->inW;
+			const int h = this->inH;
+
+			return ReprojectData<DataType, Out, ChannelsCount>(this->pixels.data(), this->outW, this->outH, &this->validSpans, NO_VALUE,
+				[=](T x, T y, DataType* out) {
+				InterpolateBicubic<DataType, ChannelsCount>(inputData, w, h, x, y, out);
+			}, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject inputData based on reproj with Lanczos (windowed sinc) interpolation.
+		/// It is sharper than bicubic (B-spline) interpolation.
+		/// Note: Usable only if T is nor int number
+		/// 
+		/// Fractions of positions are quantized to 1/256 and weights are taken 
+		/// from precomputed table (see LanczosFilter). Integral data are 
+		/// accumulated in integers, result is rounded and clamped to range of DataType
+		/// (Lanczos filter has negative lobes). Result is same as with
+		/// InterpolationPlan<LanczosFilter<LOBES>> (Lanczos2Plan, Lanczos3Plan)
+		/// 
+		/// Output array has size reproj.outW * reproj.outH
+		/// Output array must be released with delete[]
+		/// 
+		/// Template parameters:
+		/// DataType - type of input data		
+		/// Out - output structure - can be raw array of std::vector
+		/// ChannelsCount - number of channels in input / output data
+		/// LOBES - 2 (Lanczos-2, 4 x 4 taps) or 3 (Lanczos-3, 6 x 6 taps)
+		/// 
+		/// threadsCount - number of threads used to compute output (0 - all hardware threads)
+		/// result is same as with single thread
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out = DataType*, size_t ChannelsCount = 1, int LOBES = 3>
+		Out ReprojectDataLanczos(const DataType* inputData, const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			const int w = this->inW;
+			const int h = this->inH;
+
+			return ReprojectData<DataType, Out, ChannelsCount>(this->pixels.data(), this->outW, this->outH, &this->validSpans, NO_VALUE,
+				[=](T x, T y, DataType* out) {
+				InterpolateLanczos<DataType, ChannelsCount, LOBES>(inputData, w, h, x, y, out);
+			}, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject inputData based on reproj with Nerest Neighbor interpolation.
+		/// Same as ReprojectDataNerestNeighbor with ChannelsCount channels,
+		/// but output is written to caller-provided memory (nothing is allocated).
+		/// Output row y starts at outputData + y * outputRowPitch,
+		/// outputRowPitch (in DataType elements) must be at least reproj.outW * ChannelsCount.
+		/// Memory between rows is not modified.
+		/// 
+		/// Output buffers can be reused between calls (see BufferPool)
+		/// If gatherPlan is built, output is traversed in its tiles (see BuildGatherPlan)
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="outputData"></param>
+		/// <param name="outputRowPitch"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, size_t ChannelsCount = 1>
+		void ReprojectDataNerestNeighbor(const DataType* inputData, DataType* outputData, size_t outputRowPitch,
+			const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			const int w = this->inW;
+
+			if (this->gatherPlan.IsEmpty() == false)
+			{
+				ReprojectDataTilesTo<DataType, ChannelsCount>(this->pixels.data(), this->outW, &this->validSpans, this->gatherPlan,
+					outputData, outputRowPitch, NO_VALUE,
+					[=](const Pixel<T>* segment, int count, DataType* out) {
+					InterpolateSegment<DataType, ChannelsCount>(segment, count, out, NO_VALUE, [=](T x, T y, DataType* o) {
+						CopyNerestNeighbor<DataType, ChannelsCount>(inputData, w, static_cast<int>(x), static_cast<int>(y), o);
+					});
+				},
+					[=](const Pixel<T>& p) {
+					PrefetchNearestNeighbor<DataType, ChannelsCount>(inputData, w, p);
+				}, threadsCount);
+				return;
+			}
+
+			ReprojectDataTo(this->pixels.data(), this->outW, this->outH, &this->validSpans, 
+				outputData, InterleavedLayout<ChannelsCount>(), outputRowPitch, NO_VALUE,
+				[=](T x, T y, DataType* out) {
+				CopyNerestNeighbor<DataType, ChannelsCount>(inputData, w, static_cast<int>(x), static_cast<int>(y), out);
+			}, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject inputData based on reproj with Bilinear interpolation.
+		/// Same as ReprojectDataBilinear with ChannelsCount channels,
+		/// but output is written to caller-provided memory (nothing is allocated).
+		/// Output row y starts at outputData + y * outputRowPitch,
+		/// outputRowPitch (in DataType elements) must be at least reproj.outW * ChannelsCount.
+		/// Memory between rows is not modified.
+		/// 
+		/// Output buffers can be reused between calls (see BufferPool)
+		/// If gatherPlan is built, output is traversed in its tiles (see BuildGatherPlan)
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="outputData"></param>
+		/// <param name="outputRowPitch"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, size_t ChannelsCount = 1>
+		void ReprojectDataBilinear(const DataType* inputData, DataType* outputData, size_t outputRowPitch,
+			const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			const int w = this->inW;
+			const int h = this->inH;
+
+			if (this->gatherPlan.IsEmpty() == false)
+			{
+				ReprojectDataTilesTo<DataType, ChannelsCount>(this->pixels.data(), this->outW, &this->validSpans, this->gatherPlan,
+					outputData, outputRowPitch, NO_VALUE,
+					[=](const Pixel<T>* segment, int count, DataType* out) {
+					InterpolateSegment<DataType, ChannelsCount>(segment, count, out, NO_VALUE, [=](T x, T y, DataType* o) {
+						InterpolateBilinear<DataType, ChannelsCount>(inputData, w, h, x, y, o);
+					});
+				},
+					[=](const Pixel<T>& p) {
+					PrefetchBilinear<DataType, ChannelsCount>(inputData, w, h, p);
+				}, threadsCount);
+				return;
+			}
+
+			ReprojectDataTo(this->pixels.data(), this->outW, this->outH, &this->validSpans, 
+				outputData, InterleavedLayout<ChannelsCount>(), outputRowPitch, NO_VALUE,
+				[=](T x, T y, DataType* out) {
+				InterpolateBilinear<DataType, ChannelsCount>(inputData, w, h, x, y, out);
+			}, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject inputData based on reproj with Bicubic interpolation.
+		/// Same as ReprojectDataBicubic with ChannelsCount channels,
+		/// but output is written to caller-provided memory (nothing is allocated).
+		/// Output row y starts at outputData + y * outputRowPitch,
+		/// outputRowPitch (in DataType elements) must be at least reproj.outW * ChannelsCount.
+		/// Memory between rows is not modified.
+		/// 
+		/// Output buffers can be reused between calls (see BufferPool)
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="outputData"></param>
+		/// <param name="outputRowPitch"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, size_t ChannelsCount = 1>
+		void ReprojectDataBicubic(const DataType* inputData, DataType* outputData, size_t outputRowPitch,
+			const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			const int w = this->inW;
+			const int h = this->inH;
+
+			ReprojectDataTo(this->pixels.data(), this->outW, this->outH, &this->validSpans, 
+				outputData, InterleavedLayout<ChannelsCount>(), outputRowPitch, NO_VALUE,
+				[=](T x, T y, DataType* out) {
+				InterpolateBicubic<DataType, ChannelsCount>(inputData, w, h, x, y, out);
+			}, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject inputData based on reproj with Lanczos interpolation.
+		/// Same as ReprojectDataLanczos with ChannelsCount channels,
+		/// but output is written to caller-provided memory (nothing is allocated).
+		/// Output row y starts at outputData + y * outputRowPitch,
+		/// outputRowPitch (in DataType elements) must be at least reproj.outW * ChannelsCount.
+		/// Memory between rows is not modified.
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="outputData"></param>
+		/// <param name="outputRowPitch"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, size_t ChannelsCount = 1, int LOBES = 3>
+		void ReprojectDataLanczos(const DataType* inputData, DataType* outputData, size_t outputRowPitch,
+			const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			const int w = this->inW;
+			const int h = this->inH;
+
+			ReprojectDataTo(this->pixels.data(), this->outW, this->outH, &this->validSpans, 
+				outputData, InterleavedLayout<ChannelsCount>(), outputRowPitch, NO_VALUE,
+				[=](T x, T y, DataType* out) {
+				InterpolateLanczos<DataType, ChannelsCount, LOBES>(inputData, w, h, x, y, out);
+			}, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject inputData based on reproj with Nerest Neighbor interpolation.
+		/// Number of channels and memory layout (interleaved or planar) of input
+		/// and output are given at runtime (see DataLayout).
+		/// Mapping is read only once and all channels of output pixel are written,
+		/// so planar data do not have to be reprojected band by band.
+		/// 
+		/// outputData must be allocated by caller 
+		/// with outputLayout.GetBufferSize(reproj.outW * reproj.outH) elements
+		/// Input and output layouts must have same number of channels
+		/// 
+		/// threadsCount - number of threads used to compute output (0 - all hardware threads)
+		/// result is same as with single thread
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="inputLayout"></param>
+		/// <param name="outputData"></param>
+		/// <param name="outputLayout"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType>
+		void ReprojectDataNerestNeighbor(const DataType* inputData, const DataLayout& inputLayout,
+			DataType* outputData, const DataLayout& outputLayout, const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			const int w = this->inW;
+
+			ReprojectDataTo(this->pixels.data(), this->outW, this->outH, &this->validSpans, 
+				outputData, outputLayout, outputLayout.GetPixelOffset(this->outW), NO_VALUE,
+				[=](T x, T y, DataType* out) {
+				CopyNerestNeighbor(inputData, inputLayout, w, static_cast<int>(x), static_cast<int>(y), out, outputLayout);
+			}, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject inputData based on reproj with Bilinear interpolation.
+		/// Number of channels and memory layout of input and output 
+		/// are given at runtime (see DataLayout).
+		/// Weights are computed only once for all channels of output pixel.
+		/// 
+		/// outputData must be allocated by caller 
+		/// with outputLayout.GetBufferSize(reproj.outW * reproj.outH) elements
+		/// Input and output layouts must have same number of channels
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="inputLayout"></param>
+		/// <param name="outputData"></param>
+		/// <param name="outputLayout"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType>
+		void ReprojectDataBilinear(const DataType* inputData, const DataLayout& inputLayout,
+			DataType* outputData, const DataLayout& outputLayout, const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			const int w = this->inW;
+			const int h = this->inH;
+
+			ReprojectDataTo(this->pixels.data(), this->outW, this->outH, &this->validSpans, 
+				outputData, outputLayout, outputLayout.GetPixelOffset(this->outW), NO_VALUE,
+				[=](T x, T y, DataType* out) {
+				InterpolateBilinear(inputData, inputLayout, w, h, x, y, out, outputLayout);
+			}, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject inputData based on reproj with Bicubic interpolation.
+		/// Number of channels and memory layout of input and output 
+		/// are given at runtime (see DataLayout).
+		/// Weights are computed only once for all channels of output pixel.
+		/// 
+		/// outputData must be allocated by caller 
+		/// with outputLayout.GetBufferSize(reproj.outW * reproj.outH) elements
+		/// Input and output layouts must have same number of channels
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="inputLayout"></param>
+		/// <param name="outputData"></param>
+		/// <param name="outputLayout"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType>
+		void ReprojectDataBicubic(const DataType* inputData, const DataLayout& inputLayout,
+			DataType* outputData, const DataLayout& outputLayout, const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			const int w = this->inW;
+			const int h = this->inH;
+
+			ReprojectDataTo(this->pixels.data(), this->outW, this->outH, &this->validSpans, 
+				outputData, outputLayout, outputLayout.GetPixelOffset(this->outW), NO_VALUE,
+				[=](T x, T y, DataType* out) {
+				InterpolateBicubic(inputData, inputLayout, w, h, x, y, out, outputLayout);
+			}, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject inputData based on reproj with Lanczos interpolation.
+		/// Number of channels and memory layout of input and output 
+		/// are given at runtime (see DataLayout).
+		/// Weights are taken only once for all channels of output pixel.
+		/// 
+		/// outputData must be allocated by caller 
+		/// with outputLayout.GetBufferSize(reproj.outW * reproj.outH) elements
+		/// Input and output layouts must have same number of channels
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="inputLayout"></param>
+		/// <param name="outputData"></param>
+		/// <param name="outputLayout"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, int LOBES = 3>
+		void ReprojectDataLanczos(const DataType* inputData, const DataLayout& inputLayout,
+			DataType* outputData, const DataLayout& outputLayout, const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			const int w = this->inW;
+			const int h = this->inH;
+
+			ReprojectDataTo(this->pixels.data(), this->outW, this->outH, &this->validSpans, 
+				outputData, outputLayout, outputLayout.GetPixelOffset(this->outW), NO_VALUE,
+				[=](T x, T y, DataType* out) {
+				InterpolateLanczos<LOBES>(inputData, inputLayout, w, h, x, y, out, outputLayout);
+			}, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject framesCount inputs with the same geometry 
+		/// (eg. time steps, ensemble members) with Nerest Neighbor interpolation.
+		/// Result is same as calling ReprojectDataNerestNeighbor for every input,
+		/// but inputs are processed in groups (see GetBatchGroupSize) - every mapping row
+		/// is applied to all inputs of the group while it is in cache, so the mapping
+		/// is read from memory once per group. Inputs with pixels wider than half of mapping
+		/// entry are processed one by one.
+		/// 
+		/// outputs[i] must be allocated by caller with reproj.outW * reproj.outH * ChannelsCount elements
+		/// </summary>
+		/// <param name="inputs"></param>
+		/// <param name="outputs"></param>
+		/// <param name="framesCount"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, size_t ChannelsCount = 1>
+		void ReprojectDataNerestNeighbor(const DataType* const* inputs, DataType* const* outputs, size_t framesCount,
+			const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			const int w = this->inW;
+
+			ReprojectDataBatch<DataType, ChannelsCount>(this->pixels.data(), this->outW, this->outH, &this->validSpans,
+				outputs, framesCount, NO_VALUE,
+				[=](size_t frame, T x, T y, DataType* out) {
+				CopyNerestNeighbor<DataType, ChannelsCount>(inputs[frame], w, static_cast<int>(x), static_cast<int>(y), out);
+			}, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject framesCount inputs with the same geometry with Bilinear interpolation.
+		/// Result is same as calling ReprojectDataBilinear for every input,
+		/// but the mapping is read from memory once per group of inputs (see batched ReprojectDataNerestNeighbor)
+		/// 
+		/// outputs[i] must be allocated by caller with reproj.outW * reproj.outH * ChannelsCount elements
+		/// </summary>
+		/// <param name="inputs"></param>
+		/// <param name="outputs"></param>
+		/// <param name="framesCount"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, size_t ChannelsCount = 1>
+		void ReprojectDataBilinear(const DataType* const* inputs, DataType* const* outputs, size_t framesCount,
+			const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			const int w = this->inW;
+			const int h = this->inH;
+
+			ReprojectDataBatch<DataType, ChannelsCount>(this->pixels.data(), this->outW, this->outH, &this->validSpans,
+				outputs, framesCount, NO_VALUE,
+				[=](size_t frame, T x, T y, DataType* out) {
+				InterpolateBilinear<DataType, ChannelsCount>(inputs[frame], w, h, x, y, out);
+			}, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject framesCount inputs with the same geometry with Bicubic interpolation.
+		/// Result is same as calling ReprojectDataBicubic for every input,
+		/// but the mapping is read from memory once per group of inputs (see batched ReprojectDataNerestNeighbor)
+		/// 
+		/// outputs[i] must be allocated by caller with reproj.outW * reproj.outH * ChannelsCount elements
+		/// </summary>
+		/// <param name="inputs"></param>
+		/// <param name="outputs"></param>
+		/// <param name="framesCount"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, size_t ChannelsCount = 1>
+		void ReprojectDataBicubic(const DataType* const* inputs, DataType* const* outputs, size_t framesCount,
+			const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			const int w = this->inW;
+			const int h = this->inH;
+
+			ReprojectDataBatch<DataType, ChannelsCount>(this->pixels.data(), this->outW, this->outH, &this->validSpans,
+				outputs, framesCount, NO_VALUE,
+				[=](size_t frame, T x, T y, DataType* out) {
+				InterpolateBicubic<DataType, ChannelsCount>(inputs[frame], w, h, x, y, out);
+			}, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject framesCount inputs with the same geometry with Lanczos interpolation.
+		/// Result is same as calling ReprojectDataLanczos for every input,
+		/// but the mapping is read from memory once per group of inputs (see batched ReprojectDataNerestNeighbor)
+		/// 
+		/// outputs[i] must be allocated by caller with reproj.outW * reproj.outH * ChannelsCount elements
+		/// </summary>
+		/// <param name="inputs"></param>
+		/// <param name="outputs"></param>
+		/// <param name="framesCount"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, size_t ChannelsCount = 1, int LOBES = 3>
+		void ReprojectDataLanczos(const DataType* const* inputs, DataType* const* outputs, size_t framesCount,
+			const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			const int w = this->inW;
+			const int h = this->inH;
+
+			ReprojectDataBatch<DataType, ChannelsCount>(this->pixels.data(), this->outW, this->outH, &this->validSpans,
+				outputs, framesCount, NO_VALUE,
+				[=](size_t frame, T x, T y, DataType* out) {
+				InterpolateLanczos<DataType, ChannelsCount, LOBES>(inputs[frame], w, h, x, y, out);
+			}, threadsCount);
+		}
+
+		//=====================================================================
+		// Kernel helpers
+		// Shared by all reprojection types
+		//=====================================================================
+
+		/// <summary>
+		/// Iterate outW * outH mapping pixels and call 
+		/// interpolate(fromX, fromY, out) for every valid output pixel.
+		/// Invalid pixels are set to NO_VALUE.
+		/// 
+		/// Output is allocated with ChannelsCount interleaved channels
+		/// and filled by ReprojectDataTo
+		/// 
+		/// Used by ReprojectData* methods. Pixels can be owned by the 
+		/// reprojection or mapped from file (see MappedReprojection)
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="outW"></param>
+		/// <param name="outH"></param>
+		/// <param name="spans">can be nullptr</param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="interpolate"></param>
+		/// <param name="threadsCount"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out, size_t ChannelsCount, typename Interpolate>
+		static Out ReprojectData(const Pixel<T>* pixels, int outW, int outH, const ValidSpans* spans,
+			const DataType NO_VALUE, Interpolate interpolate, size_t threadsCount = 1)
+		{
+			size_t count = static_cast<size_t>(outW) * outH;
+
+			Out output = AllocateOutput<DataType, Out, ChannelsCount>(count);
+
+			ReprojectDataTo(pixels, outW, outH, spans, GetOutputData<DataType>(output), InterleavedLayout<ChannelsCount>(),
+				static_cast<size_t>(outW) * ChannelsCount, NO_VALUE, interpolate, threadsCount);
+
+			return output;
+		}
+
+		/// <summary>
+		/// Iterate outW * outH mapping pixels and call 
+		/// interpolate(fromX, fromY, out) for every valid output pixel.
+		/// out points to the first channel of output pixel, 
+		/// other channels are at out + outputLayout.GetChannelOffset(channel).
+		/// Invalid pixels are set to NO_VALUE (all channels).
+		/// 
+		/// Every mapping pixel is read only once, 
+		/// so interpolate should write all channels at once.
+		/// Output row y starts at output + y * outputRowPitch 
+		/// (outputLayout.GetPixelOffset(outW) for continuous output).
+		/// 
+		/// If valid spans are passed (and not empty), invalid parts of rows
+		/// are filled at once and pixels inside valid spans are not tested.
+		/// 
+		/// Output rows are processed in bands, that fit in cache
+		/// (see ParallelUtils::GetCacheRowBandSize), by threadsCount threads.
+		/// Every output pixel is computed independently, so result does not
+		/// depend on threadsCount. Raw array output is not initialized by allocation,
+		/// so its memory pages are first touched (and placed to NUMA node) 
+		/// by the thread that computes them.
+		/// 
+		/// Layout can be DataLayout (runtime channels count, interleaved or planar)
+		/// or InterleavedLayout (compile time channels count)
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="outW"></param>
+		/// <param name="outH"></param>
+		/// <param name="spans">can be nullptr</param>
+		/// <param name="output"></param>
+		/// <param name="outputLayout"></param>
+		/// <param name="outputRowPitch">distance of output rows in DataType elements</param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="interpolate"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, typename Layout, typename Interpolate>
+		static void ReprojectDataTo(const Pixel<T>* pixels, int outW, int outH, const ValidSpans* spans,
+			DataType* output, const Layout& outputLayout, size_t outputRowPitch,
+			const DataType NO_VALUE, Interpolate interpolate, size_t threadsCount = 1)
+		{
+			int bandSize = ParallelUtils::GetCacheRowBandSize(static_cast<size_t>(outW) * 
+				(sizeof(Pixel<T>) + outputLayout.GetChannelsCount() * sizeof(DataType)));
+
+			ParallelUtils::RunRowBands(outH, bandSize, threadsCount, [&](int startRow, int endRow) {
+				ReprojectRows(pixels, outW, startRow, endRow, spans, output, outputLayout, outputRowPitch, NO_VALUE, interpolate);
+			});
+		}
+
+		/// <summary>
+		/// Number of frames that share one mapping row in batch reprojection.
+		/// Frames are grouped only while their data is not larger than the mapping itself.
+		/// Wider frames gain more from input rows cached between neighbouring output rows
+		/// than from the shared mapping read, so they are processed one by one.
+		/// </summary>
+		/// <returns></returns>
+		template <typename DataType, size_t ChannelsCount>
+		static size_t GetBatchGroupSize()
+		{
+			return std::max<size_t>(1, sizeof(Pixel<T>) / (ChannelsCount * sizeof(DataType)));
+		}
+
+		/// <summary>
+		/// Same as ReprojectDataTo, but the mapping is applied to framesCount inputs
+		/// with the same geometry (eg. time steps, ensemble members) at once.
+		/// interpolate(frame, fromX, fromY, out) is called for every frame.
+		/// 
+		/// Frames are processed in groups (see GetBatchGroupSize). Every mapping row is read 
+		/// from memory once per group and while it is in L1 cache, it is applied to all frames of the group.
+		/// Band is sized for the mapping and outputs of the group, so they stay in cache together.
+		/// outputs[frame] are allocated by caller with outW * outH * ChannelsCount elements.
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="outW"></param>
+		/// <param name="outH"></param>
+		/// <param name="spans">can be nullptr</param>
+		/// <param name="outputs"></param>
+		/// <param name="framesCount"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="interpolate"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, size_t ChannelsCount, typename Interpolate>
+		static void ReprojectDataBatch(const Pixel<T>* pixels, int outW, int outH, const ValidSpans* spans,
+			DataType* const* outputs, size_t framesCount,
+			const DataType NO_VALUE, Interpolate interpolate, size_t threadsCount = 1)
+		{
+			const InterleavedLayout<ChannelsCount> layout;
+			const size_t rowPitch = static_cast<size_t>(outW) * ChannelsCount;
+
+			const size_t groupSize = std::min(framesCount, GetBatchGroupSize<DataType, ChannelsCount>());
+			int bandSize = ParallelUtils::GetCacheRowBandSize(static_cast<size_t>(outW) * 
+				(sizeof(Pixel<T>) + groupSize * ChannelsCount * sizeof(DataType)));
+
+			for (size_t groupStart = 0; groupStart < framesCount; groupStart += groupSize)
+			{
+				const size_t groupEnd = std::min(framesCount, groupStart + groupSize);
+				ParallelUtils::RunRowBands(outH, bandSize, threadsCount, [&](int startRow, int endRow) {
+					for (int y = startRow; y < endRow; y++)
+					{
+						for (size_t i = groupStart; i < groupEnd; i++)
+						{
+							ReprojectRows(pixels, outW, y, y + 1, spans, outputs[i], layout, rowPitch, NO_VALUE,
+								[&](T x, T y, DataType* out) {
+								interpolate(i, x, y, out);
+							});
+						}
+					}
+				});
+			}
+		}
+
+		/// <summary>
+		/// Reproject output rows [startRow, endRow) - one band of ReprojectDataTo
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="outW"></param>
+		/// <param name="startRow"></param>
+		/// <param name="endRow"></param>
+		/// <param name="spans">can be nullptr</param>
+		/// <param name="output"></param>
+		/// <param name="outputLayout"></param>
+		/// <param name="outputRowPitch"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="interpolate"></param>
+		template <typename DataType, typename Layout, typename Interpolate>
+		static void ReprojectRows(const Pixel<T>* pixels, int outW, int startRow, int endRow, const ValidSpans* spans,
+			DataType* output, const Layout& outputLayout, size_t outputRowPitch,
+			const DataType NO_VALUE, const Interpolate& interpolate)
+		{
+			const bool useSpans = (spans != nullptr) && (spans->IsEmpty() == false);
+
+			for (int y = startRow; y < endRow; y++)
+			{
+				const Pixel<T>* rowPixels = pixels + static_cast<size_t>(y) * outW;
+				DataType* rowOut = output + static_cast<size_t>(y) * outputRowPitch;
+
+				if (useSpans)
+				{
+					spans->ForEachSpan(y, outW,
+						[&](int begin, int end) {
+							//outside of the model - no data - put there NO_VALUE
+							FillNoValue(rowOut + outputLayout.GetPixelOffset(begin), end - begin, outputLayout, NO_VALUE);
+						},
+						[&](int begin, int end) {
+							for (int x = begin; x < end; x++)
+							{
+								interpolate(rowPixels[x].x, rowPixels[x].y, rowOut + outputLayout.GetPixelOffset(x));
+							}
+						});
+
+					continue;
+				}
+
+				for (int x = 0; x < outW; x++)
+				{
+					T px = rowPixels[x].x;
+					T py = rowPixels[x].y;
+
+					DataType* out = rowOut + outputLayout.GetPixelOffset(x);
+
+					if ((px == -1) || (py == -1))
+					{
+						//outside of the model - no data - put there NO_VALUE
+						SetNoValue(out, outputLayout, NO_VALUE);
+					}
+					else
+					{
+						interpolate(px, py, out);
+					}
+				}
+			}
+		}
+
+		/// <summary>
+		/// Same as ReprojectData, but calls copySegment(segmentPixels, count, out)
+		/// for continuous segments of output rows instead of single pixels.
+		/// Used by vectorized kernels (see Avx::Reprojection, Neon::Reprojection).
+		/// 
+		/// If valid spans are passed (and not empty), segments are valid spans
+		/// and invalid parts of rows are filled with NO_VALUE.
+		/// Otherwise segments are whole rows and they can contain invalid pixels,
+		/// that have to be set to NO_VALUE by copySegment.
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="outW"></param>
+		/// <param name="outH"></param>
+		/// <param name="spans">can be nullptr</param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="copySegment"></param>
+		/// <param name="threadsCount"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out, size_t ChannelsCount, typename CopySegment>
+		static Out ReprojectDataSegments(const Pixel<T>* pixels, int outW, int outH, const ValidSpans* spans,
+			const DataType NO_VALUE, CopySegment copySegment, size_t threadsCount = 1)
+		{
+			size_t count = static_cast<size_t>(outW) * outH;
+
+			Out output = AllocateOutput<DataType, Out, ChannelsCount>(count);
+
+			ReprojectDataSegmentsTo<DataType, ChannelsCount>(pixels, outW, outH, spans, 
+				GetOutputData<DataType>(output), static_cast<size_t>(outW) * ChannelsCount, 
+				NO_VALUE, copySegment, threadsCount);
+
+			return output;
+		}
+
+		/// <summary>
+		/// Same as ReprojectDataSegments, but output is allocated by caller.
+		/// Output row y starts at output + y * outputRowPitch.
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="outW"></param>
+		/// <param name="outH"></param>
+		/// <param name="spans">can be nullptr</param>
+		/// <param name="output"></param>
+		/// <param name="outputRowPitch">distance of output rows in DataType elements</param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="copySegment"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, size_t ChannelsCount, typename CopySegment>
+		static void ReprojectDataSegmentsTo(const Pixel<T>* pixels, int outW, int outH, const ValidSpans* spans,
+			DataType* output, size_t outputRowPitch,
+			const DataType NO_VALUE, CopySegment copySegment, size_t threadsCount = 1)
+		{
+			int bandSize = ParallelUtils::GetCacheRowBandSize(static_cast<size_t>(outW) * (sizeof(Pixel<T>) + ChannelsCount * sizeof(DataType)));
+
+			ParallelUtils::RunRowBands(outH, bandSize, threadsCount, [&](int startRow, int endRow) {
+				ReprojectSegmentRows<DataType, ChannelsCount>(pixels, outW, startRow, endRow, spans, 
+					output, outputRowPitch, NO_VALUE, copySegment);
+			});
+		}
+
+		/// <summary>
+		/// Same as ReprojectDataSegments, but the mapping is applied 
+		/// to framesCount inputs at once (see ReprojectDataBatch).
+		/// copySegment(frame, segmentPixels, count, out) is called for every frame.
+		/// outputs[frame] are allocated by caller with outW * outH * ChannelsCount elements.
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="outW"></param>
+		/// <param name="outH"></param>
+		/// <param name="spans">can be nullptr</param>
+		/// <param name="outputs"></param>
+		/// <param name="framesCount"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="copySegment"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, size_t ChannelsCount, typename CopySegment>
+		static void ReprojectDataSegmentsBatch(const Pixel<T>* pixels, int outW, int outH, const ValidSpans* spans,
+			DataType* const* outputs, size_t framesCount,
+			const DataType NO_VALUE, CopySegment copySegment, size_t threadsCount = 1)
+		{
+			const size_t groupSize = std::min(framesCount, GetBatchGroupSize<DataType, ChannelsCount>());
+			int bandSize = ParallelUtils::GetCacheRowBandSize(static_cast<size_t>(outW) * 
+				(sizeof(Pixel<T>) + groupSize * ChannelsCount * sizeof(DataType)));
+
+			for (size_t groupStart = 0; groupStart < framesCount; groupStart += groupSize)
+			{
+				const size_t groupEnd = std::min(framesCount, groupStart + groupSize);
+				ParallelUtils::RunRowBands(outH, bandSize, threadsCount, [&](int startRow, int endRow) {
+					for (int y = startRow; y < endRow; y++)
+					{
+						for (size_t i = groupStart; i < groupEnd; i++)
+						{
+							ReprojectSegmentRows<DataType, ChannelsCount>(pixels, outW, y, y + 1, spans, 
+								outputs[i], static_cast<size_t>(outW) * ChannelsCount, NO_VALUE,
+								[&](const Pixel<T>* segmentPixels, int count, DataType* out) {
+								copySegment(i, segmentPixels, count, out);
+							});
+						}
+					}
+				});
+			}
+		}
+
+		/// <summary>
+		/// Reproject output rows [startRow, endRow) - one band of ReprojectDataSegments
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="outW"></param>
+		/// <param name="startRow"></param>
+		/// <param name="endRow"></param>
+		/// <param name="spans">can be nullptr</param>
+		/// <param name="output"></param>
+		/// <param name="outputRowPitch"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="copySegment"></param>
+		template <typename DataType, size_t ChannelsCount, typename CopySegment>
+		static void ReprojectSegmentRows(const Pixel<T>* pixels, int outW, int startRow, int endRow, const ValidSpans* spans,
+			DataType* output, size_t outputRowPitch, const DataType NO_VALUE, const CopySegment& copySegment)
+		{
+			const bool useSpans = (spans != nullptr) && (spans->IsEmpty() == false);
+
+			for (int y = startRow; y < endRow; y++)
+			{
+				const Pixel<T>* rowPixels = pixels + static_cast<size_t>(y) * outW;
+				DataType* rowOut = output + static_cast<size_t>(y) * outputRowPitch;
+
+				if (useSpans == false)
+				{
+					copySegment(rowPixels, outW, rowOut);
+					continue;
+				}
+
+				spans->ForEachSpan(y, outW,
+					[&](int begin, int end) {
+						//outside of the model - no data - put there NO_VALUE
+						std::fill(rowOut + begin * ChannelsCount, rowOut + end * ChannelsCount, NO_VALUE);
+					},
+					[&](int begin, int end) {
+						copySegment(rowPixels + begin, end - begin, rowOut + begin * ChannelsCount);
+					});
+			}
+		}
+
+		/// <summary>
+		/// Same as ReprojectDataSegmentsTo, but output is traversed 
+		/// in tiles of the plan (see GatherPlan) instead of rows.
+		/// Segments are parts of tile rows.
+		/// Before tile is computed, prefetch(pixel) is called for valid pixels
+		/// of the first GatherPlan::PREFETCH_ROWS rows of the next tile,
+		/// so its input is loaded while the current tile is computed.
+		/// 
+		/// Tiles are processed in plan order by threadsCount threads,
+		/// result is same as with ReprojectDataSegmentsTo.
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="outW"></param>
+		/// <param name="spans">can be nullptr</param>
+		/// <param name="plan"></param>
+		/// <param name="output"></param>
+		/// <param name="outputRowPitch">distance of output rows in DataType elements</param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="copySegment"></param>
+		/// <param name="prefetch"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, size_t ChannelsCount, typename CopySegment, typename Prefetch>
+		static void ReprojectDataTilesTo(const Pixel<T>* pixels, int outW, const ValidSpans* spans, const GatherPlan& plan,
+			DataType* output, size_t outputRowPitch, const DataType NO_VALUE, 
+			CopySegment copySegment, Prefetch prefetch, size_t threadsCount = 1)
+		{
+			ParallelUtils::RunRowBands(static_cast<int>(plan.tiles.size()), 1, threadsCount, [&](int startTile, int endTile) {
+				for (int i = startTile; i < endTile; i++)
+				{
+					if (i + 1 < endTile)
+					{
+						PrefetchTile(pixels, outW, plan.tiles[i + 1], prefetch);
+					}
+
+					ReprojectTile<DataType, ChannelsCount>(pixels, outW, plan.tiles[i], spans, 
+						output, outputRowPitch, NO_VALUE, copySegment);
+				}
+			});
+		}
+
+		/// <summary>
+		/// Reproject single tile of gather plan - see ReprojectDataTilesTo
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="outW"></param>
+		/// <param name="tile"></param>
+		/// <param name="spans">can be nullptr</param>
+		/// <param name="output"></param>
+		/// <param name="outputRowPitch"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="copySegment"></param>
+		template <typename DataType, size_t ChannelsCount, typename CopySegment>
+		static void ReprojectTile(const Pixel<T>* pixels, int outW, const GatherPlan::Tile& tile, const ValidSpans* spans,
+			DataType* output, size_t outputRowPitch, const DataType NO_VALUE, 
+			const CopySegment& copySegment)
+		{
+			const bool useSpans = (spans != nullptr) && (spans->IsEmpty() == false);
+
+			for (int y = tile.y0; y < tile.y1; y++)
+			{
+				const Pixel<T>* rowPixels = pixels + static_cast<size_t>(y) * outW;
+				DataType* rowOut = output + static_cast<size_t>(y) * outputRowPitch;
+
+				if (useSpans == false)
+				{
+					copySegment(rowPixels + tile.x0, tile.x1 - tile.x0, rowOut + tile.x0 * ChannelsCount);
+					continue;
+				}
+
+				spans->ForEachSpan(y, outW,
+					[&](int begin, int end) {
+						begin = std::max(begin, tile.x0);
+						end = std::min(end, tile.x1);
+						if (begin < end)
+						{
+							//outside of the model - no data - put there NO_VALUE
+							std::fill(rowOut + begin * ChannelsCount, rowOut + end * ChannelsCount, NO_VALUE);
+						}
+					},
+					[&](int begin, int end) {
+						begin = std::max(begin, tile.x0);
+						end = std::min(end, tile.x1);
+						if (begin < end)
+						{
+							copySegment(rowPixels + begin, end - begin, rowOut + begin * ChannelsCount);
+						}
+					});
+			}
+		}
+
+		/// <summary>
+		/// Call prefetch(pixel) for valid pixels of the first 
+		/// GatherPlan::PREFETCH_ROWS rows of tile
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="outW"></param>
+		/// <param name="tile"></param>
+		/// <param name="prefetch"></param>
+		template <typename Prefetch>
+		static void PrefetchTile(const Pixel<T>* pixels, int outW, const GatherPlan::Tile& tile, const Prefetch& prefetch)
+		{
+			int y1 = std::min(tile.y0 + GatherPlan::PREFETCH_ROWS, tile.y1);
+			for (int y = tile.y0; y < y1; y++)
+			{
+				const Pixel<T>* rowPixels = pixels + static_cast<size_t>(y) * outW;
+				for (int x = tile.x0; x < tile.x1; x++)
+				{
+					if ((rowPixels[x].x != -1) && (rowPixels[x].y != -1))
+					{
+						prefetch(rowPixels[x]);
+					}
+				}
+			}
+		}
+
+		/// <summary>
+		/// Call interpolate(fromX, fromY, out) for count pixels of segment
+		/// Invalid pixels are set to NO_VALUE
+		/// </summary>
+		/// <param name="segment"></param>
+		/// <param name="count"></param>
+		/// <param name="out"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="interpolate"></param>
+		template <typename DataType, size_t ChannelsCount, typename Interpolate>
+		static void InterpolateSegment(const Pixel<T>* segment, int count, DataType* out, 
+			const DataType NO_VALUE, const Interpolate& interpolate)
+		{
+			for (int i = 0; i < count; i++, out += ChannelsCount)
+			{
+				if ((segment[i].x == -1) || (segment[i].y == -1))
+				{
+					SetNoValue<DataType, ChannelsCount>(out, NO_VALUE);
+				}
+				else
+				{
+					interpolate(segment[i].x, segment[i].y, out);
+				}
+			}
+		}
+
+		/// <summary>
+		/// Prefetch input pixel used by nearest neighbor at pixel p
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="inW"></param>
+		/// <param name="p"></param>
+		template <typename DataType, size_t ChannelsCount>
+		static void PrefetchNearestNeighbor(const DataType* inputData, int inW, const Pixel<T>& p)
+		{
+			GatherPlan::Prefetch(inputData + (static_cast<int>(p.x) + static_cast<size_t>(static_cast<int>(p.y)) * inW) * ChannelsCount);
+		}
+
+		/// <summary>
+		/// Prefetch both input rows used by bilinear interpolation at pixel p
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="inW"></param>
+		/// <param name="inH"></param>
+		/// <param name="p"></param>
+		template <typename DataType, size_t ChannelsCount>
+		static void PrefetchBilinear(const DataType* inputData, int inW, int inH, const Pixel<T>& p)
+		{
+			int px = static_cast<int>(p.x);
+			int py = static_cast<int>(p.y);
+			int py1 = (py + 1 >= inH) ? inH - 1 : py + 1;
+
+			GatherPlan::Prefetch(inputData + (px + static_cast<size_t>(py) * inW) * ChannelsCount);
+			GatherPlan::Prefetch(inputData + (px + static_cast<size_t>(py1) * inW) * ChannelsCount);
+		}
+
+		/// <summary>
+		/// Allocate output for count pixels with ChannelsCount channels
+		/// Out can be raw array (must be released with delete[]) or 
+		/// container with resize and data (std::vector, std::pmr::vector)
+		/// </summary>
+		/// <param name="count"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out, size_t ChannelsCount>
+		static Out AllocateOutput(size_t count)
+		{
+			Out output;
+
+			if constexpr (std::is_same<Out, DataType*>::value)
 			{
 				output = new DataType[count * ChannelsCount];
 			}
-			else if constexpr (std::is_same<Out, std::vector<DataType>>::value)
+			else
+			{
+				output.resize(count * ChannelsCount);
+			}
+
+			return output;
+		}
+
+		/// <summary>
+		/// Get pointer to data of output allocated by AllocateOutput
+		/// </summary>
+		/// <param name="output"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out>
+		static DataType* GetOutputData(Out& output)
+		{
+			if constexpr (std::is_same<Out, DataType*>::value)
+			{
+				return output;
+			}
+			else
+			{
+				return output.data();
+			}
+		}
+
+		/// <summary>
+		/// Set all channels of output pixel to NO_VALUE
+		/// </summary>
+		/// <param name="out"></param>
+		/// <param name="NO_VALUE"></param>
+		template <typename DataType, size_t ChannelsCount>
+		static void SetNoValue(DataType* out, const DataType NO_VALUE)
+		{
+			SetNoValue(out, InterleavedLayout<ChannelsCount>(), NO_VALUE);
+		}
+
+		/// <summary>
+		/// Set all channels of output pixel with layout to NO_VALUE
+		/// </summary>
+		/// <param name="out"></param>
+		/// <param name="layout"></param>
+		/// <param name="NO_VALUE"></param>
+		template <typename DataType, typename Layout>
+		static void SetNoValue(DataType* out, const Layout& layout, const DataType NO_VALUE)
+		{
+			for (size_t i = 0; i < layout.GetChannelsCount(); i++)
+			{
+				out[layout.GetChannelOffset(i)] = NO_VALUE;
+			}
+		}
+
+		/// <summary>
+		/// Set all channels of count output pixels with layout to NO_VALUE
+		/// Continuous memory (interleaved data or single plane)
+		/// is filled at once
+		/// </summary>
+		/// <param name="out"></param>
+		/// <param name="count"></param>
+		/// <param name="layout"></param>
+		/// <param name="NO_VALUE"></param>
+		template <typename DataType, typename Layout>
+		static void FillNoValue(DataType* out, size_t count, const Layout& layout, const DataType NO_VALUE)
+		{
+			if (layout.IsInterleaved())
+			{
+				std::fill(out, out + count * layout.GetChannelsCount(), NO_VALUE);
+				return;
+			}
+
+			for (size_t i = 0; i < layout.GetChannelsCount(); i++)
+			{
+				DataType* channel = out + layout.GetChannelOffset(i);
+				if (layout.GetPixelOffset(1) == 1)
+				{
+					std::fill(channel, channel + count, NO_VALUE);
+					continue;
+				}
+
+				for (size_t j = 0; j < count; j++)
+				{
+					channel[layout.GetPixelOffset(j)] = NO_VALUE;
+				}
+			}
+		}
+
+		/// <summary>
+		/// Copy input pixel [x, y] to output pixel
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="inW"></param>
+		/// <param name="x"></param>
+		/// <param name="y"></param>
+		/// <param name="out"></param>
+		template <typename DataType, size_t ChannelsCount>
+		static void CopyNerestNeighbor(const DataType* inputData, int inW, int x, int y, DataType* out)
+		{
+			CopyNerestNeighbor(inputData, InterleavedLayout<ChannelsCount>(), inW, x, y, 
+				out, InterleavedLayout<ChannelsCount>());
+		}
+
+		/// <summary>
+		/// Copy input pixel [x, y] to output pixel
+		/// Input and output have layouts with same number of channels
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="inLayout"></param>
+		/// <param name="inW"></param>
+		/// <param name="x"></param>
+		/// <param name="y"></param>
+		/// <param name="out"></param>
+		/// <param name="outLayout"></param>
+		template <typename DataType, typename InLayout, typename OutLayout>
+		static void CopyNerestNeighbor(const DataType* inputData, const InLayout& inLayout, int inW, int x, int y, 
+			DataType* out, const OutLayout& outLayout)
+		{
+			const DataType* in = inputData + inLayout.GetPixelOffset(x + static_cast<size_t>(y) * inW);
+
+			for (size_t i = 0; i < inLayout.GetChannelsCount(); i++)
+			{
+				out[outLayout.GetChannelOffset(i)] = in[inLayout.GetChannelOffset(i)];
+			}
+		}
+
+		/// <summary>
+		/// Bilinear interpolation of input at position [x, y]
+		/// x and y must be non-negative and inside input image
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="inW"></param>
+		/// <param name="inH"></param>
+		/// <param name="x"></param>
+		/// <param name="y"></param>
+		/// <param name="out"></param>
+		template <typename DataType, size_t ChannelsCount>
+		static void InterpolateBilinear(const DataType* inputData, int inW, int inH, T x, T y, DataType* out)
+		{
+			InterpolateBilinear(inputData, InterleavedLayout<ChannelsCount>(), inW, inH, x, y, 
+				out, InterleavedLayout<ChannelsCount>());
+		}
+
+		/// <summary>
+		/// Bilinear interpolation of input at position [x, y]
+		/// Weights are computed once and used for all channels
+		/// Input and output have layouts with same number of channels
+		/// x and y must be non-negative and inside input image
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="inLayout"></param>
+		/// <param name="inW"></param>
+		/// <param name="inH"></param>
+		/// <param name="x"></param>
+		/// <param name="y"></param>
+		/// <param name="out"></param>
+		/// <param name="outLayout"></param>
+		template <typename DataType, typename InLayout, typename OutLayout>
+		static void InterpolateBilinear(const DataType* inputData, const InLayout& inLayout, int inW, int inH, T x, T y, 
+			DataType* out, const OutLayout& outLayout)
+		{
+			if constexpr (IsFixedPoint<T>::value && std::is_integral<DataType>::value)
+			{
+				InterpolateBilinearFixed(inputData, inLayout, inW, inH, x, y, out, outLayout);
+				return;
+			}
+
+			//no floor, just cast, because values x and y are non-negative
+			int px = static_cast<int>(x);
+			int py = static_cast<int>(y);
+
+			double tx = static_cast<double>(x - px);
+			double ty = static_cast<double>(y - py);
+
+			int x1p = (px + 1 >= inW) ? inW - 1 : px + 1;
+			int y1p = (py + 1 >= inH) ? inH - 1 : py + 1;
+
+			const DataType* c00 = &inputData[inLayout.GetPixelOffset(px + static_cast<size_t>(py) * inW)];
+			const DataType* c10 = &inputData[inLayout.GetPixelOffset(x1p + static_cast<size_t>(py) * inW)];
+			const DataType* c01 = &inputData[inLayout.GetPixelOffset(px + static_cast<size_t>(y1p) * inW)];
+			const DataType* c11 = &inputData[inLayout.GetPixelOffset(x1p + static_cast<size_t>(y1p) * inW)];
+
+
+
+			for (size_t i = 0; i < inLayout.GetChannelsCount(); i++)
+			{
+				size_t c = inLayout.GetChannelOffset(i);
+
+				auto a = c00[c] * (1 - tx) + c10[c] * tx;
+				auto b = c01[c] * (1 - tx) + c11[c] * tx;
+				auto res = a * (1 - ty) + b * ty;
+				
+				out[outLayout.GetChannelOffset(i)] = res;
+			}
+		}
+
+		/// <summary>
+		/// Bicubic (B-spline) interpolation of input at position [x, y]
+		/// x and y must be non-negative and inside input image
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="inW"></param>
+		/// <param name="inH"></param>
+		/// <param name="x"></param>
+		/// <param name="y"></param>
+		/// <param name="out"></param>
+		template <typename DataType, size_t ChannelsCount>
+		static void InterpolateBicubic(const DataType* inputData, int inW, int inH, T x, T y, DataType* out)
+		{
+			InterpolateBicubic(inputData, InterleavedLayout<ChannelsCount>(), inW, inH, x, y, 
+				out, InterleavedLayout<ChannelsCount>());
+		}
+
+		/// <summary>
+		/// Bicubic (B-spline) interpolation of input at position [x, y]
+		/// Weights are computed once and used for all channels
+		/// Input and output have layouts with same number of channels
+		/// x and y must be non-negative and inside input image
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="inLayout"></param>
+		/// <param name="inW"></param>
+		/// <param name="inH"></param>
+		/// <param name="x"></param>
+		/// <param name="y"></param>
+		/// <param name="out"></param>
+		/// <param name="outLayout"></param>
+		template <typename DataType, typename InLayout, typename OutLayout>
+		static void InterpolateBicubic(const DataType* inputData, const InLayout& inLayout, int inW, int inH, T x, T y, 
+			DataType* out, const OutLayout& outLayout)
+		{
+			if constexpr (IsFixedPoint<T>::value && std::is_integral<DataType>::value)
+			{
+				InterpolateBicubicFixed(inputData, inLayout, inW, inH, x, y, out, outLayout);
+				return;
+			}
+
+			//no floor, just cast, because values x and y are non-negative
+			int px = static_cast<int>(x);
+			int py = static_cast<int>(y);
+
+			double fx = static_cast<double>(x - px);
+			double fy = static_cast<double>(y - py);
+		
+
+			//we'll need the second and third powers
+			//of f to compute our filter weights
+			double f2x = fx * fx;
+			double f3x = f2x * fx;
+
+			double f2y = fy * fy;
+			double f3y = f2y * fy;
+			
+			double fmpF1x = (1.0f - fx);
+			double f12x = fmpF1x * fmpF1x;
+			double f13x = f12x * fmpF1x;
+
+			double fmpF1y = (1.0f - fy);
+			double f12y = fmpF1y * fmpF1y;
+			double f13y = f12y * fmpF1y;
+
+
+			//compute the filter weights
+
+			double w0x = (f13x);
+			double w1x = (4.0f + 3.0f * f3x - 6.0f * f2x);
+			double w2x = (4.0f + 3.0f * f13x - 6.0f * f12x);
+			double w3x = (f3x);
+
+			double w0y = (f13y);
+			double w1y = (4.0f + 3.0f * f3y - 6.0f * f2y);
+			double w2y = (4.0f + 3.0f * f13y - 6.0f * f12y);
+			double w3y = (f3y);
+
+
+			//column offsets
+			const size_t x0 = inLayout.GetPixelOffset((px < 1) ? 0 : px - 1);
+			const size_t x1 = inLayout.GetPixelOffset(px);
+			const size_t x2 = inLayout.GetPixelOffset((px + 1 >= inW) ? inW - 1 : px + 1);
+			const size_t x3 = inLayout.GetPixelOffset((px + 2 >= inW) ? inW - 2 : px + 2);
+
+			//row starts
+			const DataType* r0 = &inputData[inLayout.GetPixelOffset(static_cast<size_t>((py < 1) ? 0 : py - 1) * inW)];
+			const DataType* r1 = &inputData[inLayout.GetPixelOffset(static_cast<size_t>(py) * inW)];
+			const DataType* r2 = &inputData[inLayout.GetPixelOffset(static_cast<size_t>((py + 1 >= inH) ? inH - 1 : py + 1) * inW)];
+			const DataType* r3 = &inputData[inLayout.GetPixelOffset(static_cast<size_t>((py + 2 >= inH) ? inH - 2 : py + 2) * inW)];
+
+
+			for (size_t i = 0; i < inLayout.GetChannelsCount(); i++)
+			{
+				size_t c = inLayout.GetChannelOffset(i);
+
+				double res = (1.0 / 36.0) * (
+					w0y * (r0[x0 + c] * w0x
+						+ r0[x1 + c] * w1x
+						+ r0[x2 + c] * w2x
+						+ r0[x3 + c] * w3x)
+
+					+ w1y * (r1[x0 + c] * w0x
+						+ r1[x1 + c] * w1x
+						+ r1[x2 + c] * w2x
+						+ r1[x3 + c] * w3x)
+
+					+ w2y * (r2[x0 + c] * w0x
+						+ r2[x1 + c] * w1x
+						+ r2[x2 + c] * w2x
+						+ r2[x3 + c] * w3x)
+
+					+ w3y * (r3[x0 + c] * w0x
+						+ r3[x1 + c] * w1x
+						+ r3[x2 + c] * w2x
+						+ r3[x3 + c] * w3x)
+					);
+
+				out[outLayout.GetChannelOffset(i)] = static_cast<DataType>(res);
+			}
+		}
+
+		/// <summary>
+		/// Lanczos interpolation of input at position [x, y]
+		/// x and y must be non-negative and inside input image
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="inW"></param>
+		/// <param name="inH"></param>
+		/// <param name="x"></param>
+		/// <param name="y"></param>
+		/// <param name="out"></param>
+		template <typename DataType, size_t ChannelsCount, int LOBES>
+		static void InterpolateLanczos(const DataType* inputData, int inW, int inH, T x, T y, DataType* out)
+		{
+			InterpolateLanczos<LOBES>(inputData, InterleavedLayout<ChannelsCount>(), inW, inH, x, y, 
+				out, InterleavedLayout<ChannelsCount>());
+		}
+
+		/// <summary>
+		/// Lanczos interpolation of input at position [x, y]
+		/// Weights of quantized fractions are taken from LanczosFilter table 
+		/// and used for all channels. Taps outside input are clamped to border.
+		/// Input and output have layouts with same number of channels
+		/// x and y must be non-negative and inside input image
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="inLayout"></param>
+		/// <param name="inW"></param>
+		/// <param name="inH"></param>
+		/// <param name="x"></param>
+		/// <param name="y"></param>
+		/// <param name="out"></param>
+		/// <param name="outLayout"></param>
+		template <int LOBES, typename DataType, typename InLayout, typename OutLayout>
+		static void InterpolateLanczos(const DataType* inputData, const InLayout& inLayout, int inW, int inH, T x, T y, 
+			DataType* out, const OutLayout& outLayout)
+		{
+			using Filter = LanczosFilter<LOBES>;
+			const int TAPS = Filter::TAPS;
+
+			const auto& table = Filter::Get();
+
+			int phaseX;
+			int phaseY;
+			int px = Filter::GetPhase(x, inW, phaseX);
+			int py = Filter::GetPhase(y, inH, phaseY);
+
+			const auto& wx = table.weights[phaseX];
+			const auto& wy = table.weights[phaseY];
+
+			int ix[TAPS];
+			int iy[TAPS];
+			Filter::GetIndices(px, inW, ix);
+			Filter::GetIndices(py, inH, iy);
+
+			//column offsets and row starts
+			size_t cols[TAPS];
+			const DataType* rows[TAPS];
+			for (int i = 0; i < TAPS; i++)
 			{
-				output.resize(count * ChannelsCount);
+				cols[i] = inLayout.GetPixelOffset(ix[i]);
+				rows[i] = &inputData[inLayout.GetPixelOffset(static_cast<size_t>(iy[i]) * inW)];
 			}
-			
-			for (size_t index = 0; index < count; index++)
+
+			for (size_t k = 0; k < inLayout.GetChannelsCount(); k++)
 			{
-				T x = this->pixels[index].x;
-				T y = this->pixels[index].y;
+				size_t c = inLayout.GetChannelOffset(k);
 
-				if ((x == -1) || (y == -1))
+				if constexpr (std::is_integral<DataType>::value)
 				{
-					//outside of the model - no data - put there NO_VALUE
-					if constexpr (ChannelsCount == 1)
+					const int SHIFT = 2 * Filter::WEIGHT_BITS;
+
+					//8-bit data with 14-bit weights fits to 32 bits in a single row
+					using RowAcc = typename std::conditional<sizeof(DataType) == 1, int32_t, int64_t>::type;
+
+					int64_t acc = 0;
+					for (int j = 0; j < TAPS; j++)
 					{
-						output[index] = NO_VALUE;
+						RowAcc h = 0;
+						for (int i = 0; i < TAPS; i++)
+						{
+							h += static_cast<RowAcc>(rows[j][cols[i] + c]) * wx[i];
+						}
+						acc += static_cast<int64_t>(h) * wy[j];
 					}
-					else
+
+					acc = (acc + (int64_t(1) << (SHIFT - 1))) >> SHIFT;
+					acc = std::min<int64_t>(std::max<int64_t>(acc, std::numeric_limits<DataType>::lowest()), std::numeric_limits<DataType>::max());
+
+					out[outLayout.GetChannelOffset(k)] = static_cast<DataType>(acc);
+				}
+				else
+				{
+					const double SCALE = 1.0 / (static_cast<double>(Filter::WEIGHT_ONE) * Filter::WEIGHT_ONE);
+
+					double acc = 0;
+					for (int j = 0; j < TAPS; j++)
 					{
-						for (size_t i = 0; i < ChannelsCount; i++)
+						double h = 0;
+						for (int i = 0; i < TAPS; i++)
 						{
-							output[index * ChannelsCount + i] = NO_VALUE;
+							h += static_cast<double>(rows[j][cols[i] + c]) * wx[i];
 						}
+						acc += h * wy[j];
 					}
+
+					out[outLayout.GetChannelOffset(k)] = static_cast<DataType>(acc * SCALE);
 				}
-				else
-				{		
-					//no floor, just cast, because values x and y are non-negative
-					int px = static_cast<int>(x);
-					int py = static_cast<int>(y);
+			}
+		}
+
+		/// <summary>
+		/// Bilinear interpolation of integral input at fixed point position [x, y]
+		/// Weights are fractions of x and y, result is rounded
+		/// x and y must be non-negative and inside input image
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="inW"></param>
+		/// <param name="inH"></param>
+		/// <param name="x"></param>
+		/// <param name="y"></param>
+		/// <param name="out"></param>
+		template <typename DataType, size_t ChannelsCount>
+		static void InterpolateBilinearFixed(const DataType* inputData, int inW, int inH, T x, T y, DataType* out)
+		{
+			InterpolateBilinearFixed(inputData, InterleavedLayout<ChannelsCount>(), inW, inH, x, y, 
+				out, InterleavedLayout<ChannelsCount>());
+		}
+
+		/// <summary>
+		/// Bilinear interpolation of integral input at fixed point position [x, y]
+		/// Input and output have layouts with same number of channels
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="inLayout"></param>
+		/// <param name="inW"></param>
+		/// <param name="inH"></param>
+		/// <param name="x"></param>
+		/// <param name="y"></param>
+		/// <param name="out"></param>
+		/// <param name="outLayout"></param>
+		template <typename DataType, typename InLayout, typename OutLayout>
+		static void InterpolateBilinearFixed(const DataType* inputData, const InLayout& inLayout, int inW, int inH, T x, T y, 
+			DataType* out, const OutLayout& outLayout)
+		{
+			//8-bit data with 8-bit fractions fits to 32 bits
+			using Acc = typename std::conditional<(sizeof(DataType) == 1) && (T::FRACTION_BITS <= 8), int32_t, int64_t>::type;
 
-					double tx = x - px;
-					double ty = y - py;
+			const int SHIFT = 2 * T::FRACTION_BITS;
+			const Acc ROUND = Acc(1) << (SHIFT - 1);
 
-					int x1p = (px + 1 >= this->inW) ? this->inW - 1 : px + 1;
-					int y1p = (py + 1 >= this->inH) ? this->inH - 1 : py + 1;
+			int px = x.GetInt();
+			int py = y.GetInt();
 
-					const DataType* c00 = &inputData[(px + py * this->inW) * ChannelsCount];
-					const DataType* c10 = &inputData[(x1p + py * this->inW) * ChannelsCount];
-					const DataType* c01 = &inputData[(px + y1p * this->inW) * ChannelsCount];
-					const DataType* c11 = &inputData[(x1p + y1p * this->inW) * ChannelsCount];
+			Acc tx = x.GetFraction();
+			Acc ty = y.GetFraction();
+			Acc sx = T::ONE - tx;
+			Acc sy = T::ONE - ty;
 
+			int x1p = (px + 1 >= inW) ? inW - 1 : px + 1;
+			int y1p = (py + 1 >= inH) ? inH - 1 : py + 1;
 
+			const DataType* c00 = &inputData[inLayout.GetPixelOffset(px + static_cast<size_t>(py) * inW)];
+			const DataType* c10 = &inputData[inLayout.GetPixelOffset(x1p + static_cast<size_t>(py) * inW)];
+			const DataType* c01 = &inputData[inLayout.GetPixelOffset(px + static_cast<size_t>(y1p) * inW)];
+			const DataType* c11 = &inputData[inLayout.GetPixelOffset(x1p + static_cast<size_t>(y1p) * inW)];
 
-					for (size_t i = 0; i < ChannelsCount; i++)
-					{
-						auto a = c00[i] * (1 - tx) + c10[i] * tx;
-						auto b = c01[i] * (1 - tx) + c11[i] * tx;
-						auto res = a * (1 - ty) + b * ty;
-						
-						output[index * ChannelsCount + i] = res;						
-					}
+			for (size_t i = 0; i < inLayout.GetChannelsCount(); i++)
+			{
+				size_t c = inLayout.GetChannelOffset(i);
+
+				Acc a = c00[c] * sx + c10[c] * tx;
+				Acc b = c01[c] * sx + c11[c] * tx;
+
+				out[outLayout.GetChannelOffset(i)] = static_cast<DataType>((a * sy + b * ty + ROUND) >> SHIFT);
+			}
+		}
+
+		/// <summary>
+		/// Bicubic (B-spline) interpolation of integral input at fixed point position [x, y]
+		/// Weights are taken from table for fractions of x and y (see FixedPointBicubicWeights), 
+		/// result is rounded
+		/// x and y must be non-negative and inside input image
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="inW"></param>
+		/// <param name="inH"></param>
+		/// <param name="x"></param>
+		/// <param name="y"></param>
+		/// <param name="out"></param>
+		template <typename DataType, size_t ChannelsCount>
+		static void InterpolateBicubicFixed(const DataType* inputData, int inW, int inH, T x, T y, DataType* out)
+		{
+			InterpolateBicubicFixed(inputData, InterleavedLayout<ChannelsCount>(), inW, inH, x, y, 
+				out, InterleavedLayout<ChannelsCount>());
+		}
+
+		/// <summary>
+		/// Bicubic (B-spline) interpolation of integral input at fixed point position [x, y]
+		/// Input and output have layouts with same number of channels
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="inLayout"></param>
+		/// <param name="inW"></param>
+		/// <param name="inH"></param>
+		/// <param name="x"></param>
+		/// <param name="y"></param>
+		/// <param name="out"></param>
+		/// <param name="outLayout"></param>
+		template <typename DataType, typename InLayout, typename OutLayout>
+		static void InterpolateBicubicFixed(const DataType* inputData, const InLayout& inLayout, int inW, int inH, T x, T y, 
+			DataType* out, const OutLayout& outLayout)
+		{
+			using Weights = FixedPointBicubicWeights<T::FRACTION_BITS>;
+
+			//8-bit data with 2 * 11-bit weights fits to 32 bits
+			using Acc = typename std::conditional<sizeof(DataType) == 1, int32_t, int64_t>::type;
+
+			const int SHIFT = 2 * Weights::BITS;
+			const Acc ROUND = Acc(1) << (SHIFT - 1);
+
+			const auto& table = Weights::Get();
+			const auto& wx = table[x.GetFraction()];
+			const auto& wy = table[y.GetFraction()];
+
+			int px = x.GetInt();
+			int py = y.GetInt();
+
+			//column offsets
+			const size_t x0 = inLayout.GetPixelOffset((px < 1) ? 0 : px - 1);
+			const size_t x1 = inLayout.GetPixelOffset(px);
+			const size_t x2 = inLayout.GetPixelOffset((px + 1 >= inW) ? inW - 1 : px + 1);
+			const size_t x3 = inLayout.GetPixelOffset((px + 2 >= inW) ? inW - 2 : px + 2);
+
+			const DataType* rows[4] = {
+				&inputData[inLayout.GetPixelOffset(static_cast<size_t>((py < 1) ? 0 : py - 1) * inW)],
+				&inputData[inLayout.GetPixelOffset(static_cast<size_t>(py) * inW)],
+				&inputData[inLayout.GetPixelOffset(static_cast<size_t>((py + 1 >= inH) ? inH - 1 : py + 1) * inW)],
+				&inputData[inLayout.GetPixelOffset(static_cast<size_t>((py + 2 >= inH) ? inH - 2 : py + 2) * inW)]
+			};
+
+			for (size_t i = 0; i < inLayout.GetChannelsCount(); i++)
+			{
+				Acc res = 0;
+				for (int j = 0; j < 4; j++)
+				{
+					const DataType* row = rows[j] + inLayout.GetChannelOffset(i);
+
+					Acc h = row[x0] * Acc(wx[0])
+						+ row[x1] * Acc(wx[1])
+						+ row[x2] * Acc(wx[2])
+						+ row[x3] * Acc(wx[3]);
+
+					res += h * wy[j];
 				}
+
+				out[outLayout.GetChannelOffset(i)] = static_cast<DataType>((res + ROUND) >> SHIFT);
 			}
+		}
+
+		/// <summary>
+		/// Reproject single pixel from -> to
+		/// </summary>
+		/// <param name="p"></param>
+		/// <param name="from"></param>
+		/// <param name="to"></param>
+		/// <returns></returns>
+		template <typename InPixelType, typename OutPixelType,
+			typename FromProjection, typename ToProjection>
+			static Pixel<OutPixelType> ReProject(Pixel<InPixelType> p,
+				const FromProjection* from, const ToProjection* to)
+		{
+			Coordinate cc = to->template ProjectInverse<InPixelType, false>(p);
+			cc.lat.Normalize();
 
+			return from->template Project<OutPixelType>(cc);
+		};
 
-			return output;
+	protected:
+
+		/// <summary>
+		/// Get offset in input pixels between two neighbouring worlds
+		/// Used for frames with multiple wrap around of the world
+		/// </summary>
+		/// <param name="from"></param>
+		/// <returns></returns>
+		template <typename FromProjection>
+		static int GetWrapAroundOffset(const FromProjection* from)
+		{
+			//calculate full size of from projection image
+			Projections::Coordinate bbMin, bbMax;
+
+			bbMin.lat = -90.0_deg;
+			bbMin.lon = -180.0_deg;
+
+			bbMax.lat = 90.06_deg;
+			bbMax.lon = 180.0_deg;
+
+			Pixel<MyRealType> pp1 = from->template Project<MyRealType>(bbMin);
+			Pixel<MyRealType> pp2 = from->template Project<MyRealType>(bbMax);
+
+			return static_cast<int>(pp2.x - pp1.x);
 		}
 
+		/// <summary>
+		/// Get number of output columns that has to be computed 
+		/// for frame with multiple wrap around of the world.
+		/// If single world has integral width in output pixels, 
+		/// columns repeat with this period. Otherwise, all columns
+		/// must be computed.
+		/// </summary>
+		/// <param name="f"></param>
+		/// <param name="outW"></param>
+		/// <returns></returns>
+		static int GetWrapAroundPeriod(const ProjectionFrame& f, int outW)
+		{
+			MyRealType period = std::round(f.ww);
+			if ((period < 1) || (std::abs(f.ww - period) > MyRealType(1e-6)))
+			{
+				return outW;
+			}
+			return std::min(outW, static_cast<int>(period));
+		}
 
 		/// <summary>
-		/// Reproject inputData based on reproj with Bicubic interpolation.
-		/// Note: Usable only if T is nor int number
-		/// 
-		/// Output array has size reproj.outW * reproj.outH
-		/// Output array must be released with delete[]
-		/// 
-		/// Template parameters:
-		/// DataType - type of input data		
-		/// Out - output structure - can be raw array of std::vector
-		/// ChannelsCount - number of channels in input / output data
+		/// Find input column for output pixel in frame with wrap around.
+		/// Candidates px + k * offset (k = 1 .. repeatNegCount)
+		/// and px - k * offset (k = 1 .. repeatPosCount) are tested
+		/// and the last one inside the input image is used.
+		/// Returns -1, if there is no such candidate.
 		/// </summary>
-		/// <param name="reproj"></param>
-		/// <param name="inputData"></param>
-		/// <param name="NO_VALUE"></param>
+		/// <param name="px"></param>
+		/// <param name="offset"></param>
+		/// <param name="f"></param>
+		/// <param name="inW"></param>
 		/// <returns></returns>
-		template <typename DataType, typename Out = DataType*, size_t ChannelsCount = 1>
-		Out ReprojectDataBicubic(const DataType* inputData, const DataType NO_VALUE) const
+		static T ResolveWrapAroundX(T px, int offset, const ProjectionFrame& f, int inW)
 		{
-			size_t count = this->outW * this->outH;
+			T res = -1;
 
-			Out output;
+			if ((px >= 0) && (px < inW))
+			{
+				res = px;
+			}
 
-			if constexpr (std::is_same<Out, DataType*>::value)
+			T p = px;
+			MyRealType nc = f.repeatNegCount;
+			while (nc > 0)
 			{
-				output = new DataType[count * ChannelsCount];
+				p += offset;
+				if ((p >= 0) && (p < inW))
+				{
+					res = p;
+				}
+				nc--;
 			}
-			else if constexpr (std::is_same<Out, std::vector<DataType>>::value)
+
+			p = px;
+			MyRealType pc = f.repeatPosCount;
+			while (pc > 0)
 			{
-				output.resize(count * ChannelsCount);
+				p -= offset;
+				if ((p >= 0) && (p < inW))
+				{
+					res = p;
+				}
+				pc--;
+			}
+
+			return res;
+		}
+
+		/// <summary>
+		/// Resolve wrap around for cached input columns [0, periodW) and 
+		/// replicate them to the rest of columns modulo periodW
+		/// </summary>
+		/// <param name="cacheX"></param>
+		/// <param name="periodW"></param>
+		/// <param name="offset"></param>
+		/// <param name="f"></param>
+		/// <param name="inW"></param>
+		static void ResolveWrapAroundColumns(std::vector<T>& cacheX, int periodW, int offset, 
+			const ProjectionFrame& f, int inW)
+		{
+			for (int x = 0; x < periodW; x++)
+			{
+				cacheX[x] = ResolveWrapAroundX(cacheX[x], offset, f, inW);
 			}
 
-			for (size_t index = 0; index < count; index++)
+			for (size_t x = periodW; x < cacheX.size(); x++)
 			{
-				T x = this->pixels[index].x;
-				T y = this->pixels[index].y;
+				cacheX[x] = cacheX[x - periodW];
+			}
+		}
+
+		/// <summary>
+		/// Fill pixels from separable caches of input columns and rows
+		/// Pixels outside of the input image are left invalid
+		/// (comparisons are written so that NaN positions are skipped as well,
+		/// SIMD caches can contain them)
+		/// </summary>
+		/// <param name="cacheX"></param>
+		/// <param name="cacheY"></param>
+		/// <param name="threadsCount"></param>
+		/// <param name="buildValidSpans"></param>
+		void FillFromSeparableCache(const std::vector<T>& cacheX, const std::vector<T>& cacheY, size_t threadsCount, bool buildValidSpans)
+		{
+			this->CreateRows(threadsCount, buildValidSpans, [&](int y) {
+				int yw = y * this->outW;
+				for (int x = 0; x < this->outW; x++)
+				{
+					Pixel<T> p;
+					p.x = cacheX[x];
+					p.y = cacheY[y];
+
+					if ((p.x >= 0) == false) continue;
+					if ((p.y >= 0) == false) continue;
+					if ((p.x < this->inW) == false) continue;
+					if ((p.y < this->inH) == false) continue;
+
+					this->pixels[x + yw] = p;
+
+				}
+			});
+		}
+
+		/// <summary>
+		/// Call createRow(y) for every output row in bands of ROW_BAND_SIZE rows
+		/// (in parallel if threadsCount != 1) and collect input footprint 
+		/// (and valid spans if buildValidSpans is true) of every band right 
+		/// after it is created, while its pixels are in cache.
+		/// Bands are merged at the end to inputFootprint (and validSpans),
+		/// so no extra pass over pixels is needed.
+		/// </summary>
+		/// <param name="threadsCount"></param>
+		/// <param name="buildValidSpans"></param>
+		/// <param name="createRow"></param>
+		template <typename CreateRow>
+		void CreateRows(size_t threadsCount, bool buildValidSpans, CreateRow createRow)
+		{
+			std::vector<InputFootprint> bands((this->outH + ROW_BAND_SIZE - 1) / ROW_BAND_SIZE);
+			std::vector<std::vector<ValidSpans::Span>> spanRows(buildValidSpans ? this->outH : 0);
 
-				if ((x == -1) || (y == -1))
+			ParallelUtils::RunRowBands(this->outH, ROW_BAND_SIZE, threadsCount, [&](int startRow, int endRow) {
+				//single thread gets all rows at once
+				for (int bandStart = startRow; bandStart < endRow; bandStart += ROW_BAND_SIZE)
 				{
-					//outside of the model - no data - put there NO_VALUE
-					if constexpr (ChannelsCount == 1)
+					int bandEnd = std::min(bandStart + ROW_BAND_SIZE, endRow);
+					for (int y = bandStart; y < bandEnd; y++)
 					{
-						output[index] = NO_VALUE;
+						createRow(y);
 					}
-					else
+
+					this->BuildBandFootprint(bandStart, bandEnd, bands[bandStart / ROW_BAND_SIZE]);
+
+					if (buildValidSpans)
 					{
-						for (size_t i = 0; i < ChannelsCount; i++)
-						{
-							output[index * ChannelsCount + i] = NO_VALUE;
-						}
+						ValidSpans::BuildRows(this->pixels.data(), this->outW, bandStart, bandEnd, spanRows);
 					}
 				}
-				else
-				{
-					//no floor, just cast, because values x and y are non-negative
-					int px = static_cast<int>(x);
-					int py = static_cast<int>(y);
+			});
 
-					double fx = x - px;
-					double fy = y - py;
-				
+			this->inputFootprint.Merge(bands);
+			if (buildValidSpans)
+			{
+				this->validSpans.SetRows(spanRows);
+			}
+		}
+
+		/// <summary>
+		/// Build input footprint of output rows [startRow, endRow)
+		/// (part of inputFootprint, see InputFootprint::Merge)
+		/// </summary>
+		/// <param name="startRow"></param>
+		/// <param name="endRow"></param>
+		/// <param name="band"></param>
+		void BuildBandFootprint(int startRow, int endRow, InputFootprint& band) const
+		{
+			band.Build(this->pixels.data() + static_cast<size_t>(startRow) * this->outW,
+				static_cast<size_t>(endRow - startRow) * this->outW, this->inW, this->inH);
+		}
 
-					//we'll need the second and third powers
-					//of f to compute our filter weights
-					double f2x = fx * fx;
-					double f3x = f2x * fx;
+		/// <summary>
+		/// Build valid spans if they are requested in options and were not 
+		/// collected during creation (eg. loaded pixels) and remap input 
+		/// to its footprint if it is requested in options
+		/// </summary>
+		/// <param name="options"></param>
+		/// <param name="threadsCount"></param>
+		void FinishCreation(const ReprojectionOptions& options, size_t threadsCount)
+		{
+			if ((options.buildValidSpans) && (this->validSpans.IsEmpty()))
+			{
+				this->BuildValidSpans(threadsCount);
+			}
 
-					double f2y = fy * fy;
-					double f3y = f2y * fy;
-					
-					double fmpF1x = (1.0f - fx);
-					double f12x = fmpF1x * fmpF1x;
-					double f13x = f12x * fmpF1x;
+			if (options.cropRegion != nullptr)
+			{
+				*options.cropRegion = this->CropInputToFootprint(options.cropMargin);
+			}
+		}
 
-					double fmpF1y = (1.0f - fy);
-					double f12y = fmpF1y * fmpF1y;
-					double f13y = f12y * fmpF1y;
+		//initial size of tile in approximated creation
+		static const int APPROX_TILE_SIZE = 64;
 
+		//tiles with both dimensions up to this size are evaluated exactly
+		static const int APPROX_MIN_TILE_SIZE = 4;
 
-					//compute the filter weights
+		/// <summary>
+		/// Bilinearly interpolate mapping at fractional output position [x, y]
+		/// Used by Compose for floating / fixed point T
+		/// </summary>
+		/// <param name="x"></param>
+		/// <param name="y"></param>
+		/// <returns></returns>
+		Pixel<T> InterpolateMapping(T x, T y) const
+		{
+			int px = static_cast<int>(x);
+			int py = static_cast<int>(y);
 
-					double w0x = (f13x);
-					double w1x = (4.0f + 3.0f * f3x - 6.0f * f2x);
-					double w2x = (4.0f + 3.0f * f13x - 6.0f * f12x);
-					double w3x = (f3x);
+			double fx = static_cast<double>(x) - px;
+			double fy = static_cast<double>(y) - py;
 
-					double w0y = (f13y);
-					double w1y = (4.0f + 3.0f * f3y - 6.0f * f2y);
-					double w2y = (4.0f + 3.0f * f13y - 6.0f * f12y);
-					double w3y = (f3y);
+			int px1 = std::min(px + 1, this->outW - 1);
+			int py1 = std::min(py + 1, this->outH - 1);
 
+			const Pixel<T>& p00 = this->pixels[px + static_cast<size_t>(py) * this->outW];
+			const Pixel<T>& p10 = this->pixels[px1 + static_cast<size_t>(py) * this->outW];
+			const Pixel<T>& p01 = this->pixels[px + static_cast<size_t>(py1) * this->outW];
+			const Pixel<T>& p11 = this->pixels[px1 + static_cast<size_t>(py1) * this->outW];
 
-					int x1m = (px < 1) ? 0 : px - 1;
-					int x1p = (px + 1 >= this->inW) ? this->inW - 1 : px + 1;
-					int x2p = (px + 2 >= this->inW) ? this->inW - 2 : px + 2;
+			auto isValid = [](const Pixel<T>& p) {
+				return (p.x != -1) && (p.y != -1);
+			};
 
-					int y1m = (py < 1) ? 0 : py - 1;
-					int y1p = (py + 1 >= this->inH) ? this->inH - 1 : py + 1;
-					int y2p = (py + 2 >= this->inH) ? this->inH - 2 : py + 2;
+			auto nearest = [&]() -> Pixel<T> {
+				const Pixel<T>& n = (fy < 0.5) ? ((fx < 0.5) ? p00 : p10) : ((fx < 0.5) ? p01 : p11);
+				return n;
+			};
 
-					
-					const DataType* p00 = &inputData[(x1m + y1m * this->inW) * ChannelsCount];
-					const DataType* p10 = &inputData[(px + y1m * this->inW) * ChannelsCount];
-					const DataType* p20 = &inputData[(x1p + y1m * this->inW) * ChannelsCount];
-					const DataType* p30 = &inputData[(x2p + y1m * this->inW) * ChannelsCount];
+			if ((isValid(p00) == false) || (isValid(p10) == false) ||
+				(isValid(p01) == false) || (isValid(p11) == false))
+			{
+				return nearest();
+			}
 
-					const DataType* p01 = &inputData[(x1m + py * this->inW) * ChannelsCount];
-					const DataType* p11 = &inputData[(px + py * this->inW) * ChannelsCount];
-					const DataType* p21 = &inputData[(x1p + py * this->inW) * ChannelsCount];
-					const DataType* p31 = &inputData[(x2p + py * this->inW) * ChannelsCount];
+			double x00 = static_cast<double>(p00.x), y00 = static_cast<double>(p00.y);
+			double x10 = static_cast<double>(p10.x), y10 = static_cast<double>(p10.y);
+			double x01 = static_cast<double>(p01.x), y01 = static_cast<double>(p01.y);
+			double x11 = static_cast<double>(p11.x), y11 = static_cast<double>(p11.y);
 
-					const DataType* p02 = &inputData[(x1m + y1p * this->inW) * ChannelsCount];
-					const DataType* p12 = &inputData[(px + y1p * this->inW) * ChannelsCount];
-					const DataType* p22 = &inputData[(x1p + y1p * this->inW) * ChannelsCount];
-					const DataType* p32 = &inputData[(x2p + y1p * this->inW) * ChannelsCount];
+			double minX = std::min(std::min(x00, x10), std::min(x01, x11));
+			double maxX = std::max(std::max(x00, x10), std::max(x01, x11));
+			double minY = std::min(std::min(y00, y10), std::min(y01, y11));
+			double maxY = std::max(std::max(y00, y10), std::max(y01, y11));
 
-					const DataType* p03 = &inputData[(x1m + y2p * this->inW) * ChannelsCount];
-					const DataType* p13 = &inputData[(px + y2p * this->inW) * ChannelsCount];
-					const DataType* p23 = &inputData[(x1p + y2p * this->inW) * ChannelsCount];
-					const DataType* p33 = &inputData[(x2p + y2p * this->inW) * ChannelsCount];
+			if ((maxX - minX > 0.5 * this->inW) || (maxY - minY > 0.5 * this->inH))
+			{
+				//neighbours are on the other sides of wrap around seam
+				return nearest();
+			}
 
+			Pixel<T> res;
+			res.x = static_cast<T>((x00 * (1 - fx) + x10 * fx) * (1 - fy) + (x01 * (1 - fx) + x11 * fx) * fy);
+			res.y = static_cast<T>((y00 * (1 - fx) + y10 * fx) * (1 - fy) + (y01 * (1 - fx) + y11 * fx) * fy);
+			return res;
+		}
 
-					for (size_t i = 0; i < ChannelsCount; i++)
-					{
-												
-						double res = (1.0 / 36.0) * (
-							w0y * (p00[i] * w0x
-								+ p10[i] * w1x
-								+ p20[i] * w2x
-								+ p30[i] * w3x)
-
-							+ w1y * (p01[i] * w0x
-								+ p11[i] * w1x
-								+ p21[i] * w2x
-								+ p31[i] * w3x)
-
-							+ w2y * (p02[i] * w0x
-								+ p12[i] * w1x
-								+ p22[i] * w2x
-								+ p32[i] * w3x)
-
-							+ w3y * (p03[i] * w0x
-								+ p13[i] * w1x
-								+ p23[i] * w2x
-								+ p33[i] * w3x)
-							);
-
-						output[index * ChannelsCount + i] = static_cast<DataType>(res);
-					}
-				}
+		/// <summary>
+		/// Store pixel position from input image calculated in floating point
+		/// to the output index. Position is converted to T the same way
+		/// as in Project (rounded for integral types).
+		/// Invalid positions or positions outside input image are skipped.
+		/// </summary>
+		/// <param name="index"></param>
+		/// <param name="p"></param>
+		void SetPixelFromReal(size_t index, const Pixel<MyRealType>& p)
+		{
+			if ((std::isfinite(p.x) == false) || (std::isfinite(p.y) == false))
+			{
+				return;
 			}
 
+			Pixel<T> pt;
+			if constexpr (std::is_integral<T>::value)
+			{
+				MyRealType rx = std::round(p.x);
+				MyRealType ry = std::round(p.y);
+				if ((rx < 0) || (ry < 0) || (rx >= this->inW) || (ry >= this->inH))
+				{
+					return;
+				}
+				pt.x = static_cast<T>(rx);
+				pt.y = static_cast<T>(ry);
+			}
+			else
+			{
+				pt.x = static_cast<T>(p.x);
+				pt.y = static_cast<T>(p.y);
+				if ((pt.x < 0) || (pt.y < 0) || (pt.x >= this->inW) || (pt.y >= this->inH))
+				{
+					return;
+				}
+			}
 
-			return output;
+			this->pixels[index] = pt;
 		}
 
 		/// <summary>
-		/// Reproject single pixel from -> to
+		/// Fill tile [x0, x1] x [y0, y1] (inclusive) of output
+		/// If bilinear interpolation from tile corners is within maxError,
+		/// it is used. Otherwise, tile is subdivided.
 		/// </summary>
-		/// <param name="p"></param>
-		/// <param name="from"></param>
-		/// <param name="to"></param>
-		/// <returns></returns>
-		template <typename InPixelType, typename OutPixelType,
-			typename FromProjection, typename ToProjection>
-			static Pixel<OutPixelType> ReProject(Pixel<InPixelType> p,
-				const FromProjection* from, const ToProjection* to)
+		template <typename FromProjection, typename ToProjection>
+		void ApproximateTile(int x0, int y0, int x1, int y1, MyRealType maxError,
+			const FromProjection* from, const ToProjection* to)
 		{
-			Coordinate cc = to->template ProjectInverse<InPixelType, false>(p);
-			cc.lat.Normalize();
+			auto exact = [&](int x, int y) -> Pixel<MyRealType> {
+				return Reprojection<T>::ReProject<int, MyRealType>({ x, y }, from, to);
+			};
 
-			return from->template Project<OutPixelType>(cc);
-		};
+			auto isValid = [](const Pixel<MyRealType>& p) -> bool {
+				return std::isfinite(p.x) && std::isfinite(p.y);
+			};
+
+			if ((x1 - x0 < APPROX_MIN_TILE_SIZE) && (y1 - y0 < APPROX_MIN_TILE_SIZE))
+			{
+				for (int y = y0; y <= y1; y++)
+				{
+					for (int x = x0; x <= x1; x++)
+					{
+						this->SetPixelFromReal(x + y * this->outW, exact(x, y));
+					}
+				}
+				return;
+			}
+
+			Pixel<MyRealType> c00 = exact(x0, y0);
+			Pixel<MyRealType> c10 = exact(x1, y0);
+			Pixel<MyRealType> c01 = exact(x0, y1);
+			Pixel<MyRealType> c11 = exact(x1, y1);
+
+			MyRealType w = static_cast<MyRealType>(x1 - x0);
+			MyRealType h = static_cast<MyRealType>(y1 - y0);
+
+			auto interpolate = [&](int x, int y) -> Pixel<MyRealType> {
+				MyRealType tx = (w > 0) ? (x - x0) / w : MyRealType(0);
+				MyRealType ty = (h > 0) ? (y - y0) / h : MyRealType(0);
+
+				MyRealType ax = c00.x + (c10.x - c00.x) * tx;
+				MyRealType ay = c00.y + (c10.y - c00.y) * tx;
+				MyRealType bx = c01.x + (c11.x - c01.x) * tx;
+				MyRealType by = c01.y + (c11.y - c01.y) * tx;
+
+				return { ax + (bx - ax) * ty, ay + (by - ay) * ty };
+			};
+
+			int xm = (x0 + x1) / 2;
+			int ym = (y0 + y1) / 2;
+
+			bool canInterpolate = isValid(c00) && isValid(c10) && isValid(c01) && isValid(c11);
+
+			if (canInterpolate)
+			{
+				const std::array<Pixel<int>, 5> checkPoints = { {
+					{ xm, ym }, { xm, y0 }, { xm, y1 }, { x0, ym }, { x1, ym }
+				} };
+
+				for (const auto& cp : checkPoints)
+				{
+					Pixel<MyRealType> e = exact(cp.x, cp.y);
+					Pixel<MyRealType> a = interpolate(cp.x, cp.y);
+
+					//negated test to catch NaN as well
+					if (!((std::abs(e.x - a.x) <= maxError) && (std::abs(e.y - a.y) <= maxError)))
+					{
+						canInterpolate = false;
+						break;
+					}
+				}
+			}
+
+			if (canInterpolate)
+			{
+				for (int y = y0; y <= y1; y++)
+				{
+					//interpolate row end points and step along the row
+					Pixel<MyRealType> left = interpolate(x0, y);
+					Pixel<MyRealType> right = interpolate(x1, y);
+
+					Pixel<MyRealType> step = { MyRealType(0), MyRealType(0) };
+					if (w > 0)
+					{
+						step.x = (right.x - left.x) / w;
+						step.y = (right.y - left.y) / w;
+					}
+
+					size_t index = x0 + y * this->outW;
+					for (int x = x0; x <= x1; x++)
+					{
+						this->SetPixelFromReal(index, left);
+						left.x += step.x;
+						left.y += step.y;
+						index++;
+					}
+				}
+				return;
+			}
+
+			//subdivide - only in dimensions that are large enough
+			if (x1 - x0 < APPROX_MIN_TILE_SIZE)
+			{
+				this->ApproximateTile(x0, y0, x1, ym, maxError, from, to);
+				this->ApproximateTile(x0, ym + 1, x1, y1, maxError, from, to);
+			}
+			else if (y1 - y0 < APPROX_MIN_TILE_SIZE)
+			{
+				this->ApproximateTile(x0, y0, xm, y1, maxError, from, to);
+				this->ApproximateTile(xm + 1, y0, x1, y1, maxError, from, to);
+			}
+			else
+			{
+				this->ApproximateTile(x0, y0, xm, ym, maxError, from, to);
+				this->ApproximateTile(xm + 1, y0, x1, ym, maxError, from, to);
+				this->ApproximateTile(x0, ym + 1, xm, y1, maxError, from, to);
+				this->ApproximateTile(xm + 1, ym + 1, x1, y1, maxError, from, to);
+			}
+		}
 	};
 
 }
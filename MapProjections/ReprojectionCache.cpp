@@ -0,0 +1,386 @@
+#include "./ReprojectionCache.h"
+
+#ifndef MY_LOG_ERROR
+#	define MY_LOG_ERROR(...) printf(__VA_ARGS__)
+#endif
+
+#ifdef _WIN32
+#	include <process.h>
+#else
+#	include <unistd.h>
+#endif
+
+#include <filesystem>
+#include <cstdio>
+#include <cinttypes>
+#include <thread>
+
+using namespace Projections;
+
+//cache files are named FILE_PREFIX + 16 hex digits of key + FILE_SUFFIX
+static const char* FILE_PREFIX = "reproj_";
+static const char* FILE_SUFFIX = ".bin";
+
+/// <summary>
+/// ctor
+/// </summary>
+/// <param name="maxBytes">budget of memory tier in bytes</param>
+/// <param name="cacheDir">directory of disk tier (empty - disk tier is not used)</param>
+template <typename T>
+ReprojectionCache<T>::ReprojectionCache(size_t maxBytes, const std::string& cacheDir) :
+	maxBytes(maxBytes),
+	cacheDir(cacheDir),
+	usedBytes(0)
+{
+	if (this->cacheDir.empty() == false)
+	{
+		std::error_code ec;
+		std::filesystem::create_directories(this->cacheDir, ec);
+	}
+}
+
+/// <summary>
+/// Get reprojection with key
+/// If it is not in memory, it is loaded from disk tier.
+/// If it is not on disk, it is created with create callback
+/// and saved to disk tier (with header, if passed).
+///
+/// Concurrent requests for the same key are merged - create is called only once.
+/// If create throws, exception is passed to all waiting threads.
+/// </summary>
+/// <param name="key"></param>
+/// <param name="create"></param>
+/// <param name="header"></param>
+/// <returns></returns>
+template <typename T>
+typename ReprojectionCache<T>::ReprojectionPtr ReprojectionCache<T>::Get(uint64_t key,
+	const std::function<Reprojection<T>()>& create,
+	const ReprojectionFileHeader* header)
+{
+	std::promise<ReprojectionPtr> promise;
+
+	{
+		std::unique_lock<std::mutex> lock(this->m);
+
+		auto it = this->index.find(key);
+		if (it != this->index.end())
+		{
+			this->lru.splice(this->lru.begin(), this->lru, it->second);
+			this->stats.memoryHits++;
+			return it->second->value;
+		}
+
+		auto pit = this->pending.find(key);
+		if (pit != this->pending.end())
+		{
+			//someone is already creating it - wait for the result
+			std::shared_future<ReprojectionPtr> f = pit->second;
+			lock.unlock();
+			return f.get();
+		}
+
+		this->pending.emplace(key, promise.get_future().share());
+	}
+
+	try
+	{
+		bool fromDisk = false;
+
+		ReprojectionPtr value = this->LoadFromDisk(key);
+		if (value)
+		{
+			fromDisk = true;
+		}
+		else
+		{
+			Reprojection<T> r = create();
+
+			this->SaveToDisk(key, r, header);
+
+			value = std::make_shared<const Reprojection<T>>(std::move(r));
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(this->m);
+
+			if (fromDisk) this->stats.diskHits++;
+			else this->stats.created++;
+
+			this->InsertLocked(key, value);
+			this->pending.erase(key);
+		}
+
+		promise.set_value(value);
+
+		return value;
+	}
+	catch (...)
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->m);
+			this->pending.erase(key);
+		}
+
+		promise.set_exception(std::current_exception());
+		throw;
+	}
+}
+
+/// <summary>
+/// Test if reprojection with key is in memory tier
+/// </summary>
+/// <param name="key"></param>
+/// <returns></returns>
+template <typename T>
+bool ReprojectionCache<T>::Contains(uint64_t key) const
+{
+	std::lock_guard<std::mutex> lock(this->m);
+	return this->index.find(key) != this->index.end();
+}
+
+/// <summary>
+/// Load reprojections from disk tier to memory
+/// Loading stops once the memory budget is full
+/// Returns number of loaded reprojections
+/// </summary>
+/// <returns></returns>
+template <typename T>
+size_t ReprojectionCache<T>::WarmUp()
+{
+	if (this->cacheDir.empty())
+	{
+		return 0;
+	}
+
+	std::error_code ec;
+	std::filesystem::directory_iterator dirIt(this->cacheDir, ec);
+	if (ec)
+	{
+		MY_LOG_ERROR("Failed to open cache directory: \"%s\"\n", this->cacheDir.c_str());
+		return 0;
+	}
+
+	const size_t prefixLen = std::strlen(FILE_PREFIX);
+	const size_t suffixLen = std::strlen(FILE_SUFFIX);
+
+	size_t count = 0;
+
+	for (const auto& e : dirIt)
+	{
+		if (e.is_regular_file(ec) == false)
+		{
+			continue;
+		}
+
+		std::string name = e.path().filename().string();
+		if ((name.size() != prefixLen + 16 + suffixLen) ||
+			(name.compare(0, prefixLen, FILE_PREFIX) != 0) ||
+			(name.compare(name.size() - suffixLen, suffixLen, FILE_SUFFIX) != 0))
+		{
+			continue;
+		}
+
+		uint64_t key = 0;
+		if (std::sscanf(name.c_str() + prefixLen, "%16" SCNx64, &key) != 1)
+		{
+			continue;
+		}
+
+		if (this->Contains(key))
+		{
+			continue;
+		}
+
+		ReprojectionPtr value = this->LoadFromDisk(key);
+		if (value == nullptr)
+		{
+			continue;
+		}
+
+		std::lock_guard<std::mutex> lock(this->m);
+
+		if (this->usedBytes + value->GetBytes() > this->maxBytes)
+		{
+			break;
+		}
+
+		if (this->index.find(key) == this->index.end())
+		{
+			this->InsertLocked(key, value);
+			count++;
+		}
+	}
+
+	return count;
+}
+
+/// <summary>
+/// Remove all reprojections from memory tier
+/// Disk tier is not changed
+/// </summary>
+template <typename T>
+void ReprojectionCache<T>::Clear()
+{
+	std::lock_guard<std::mutex> lock(this->m);
+	this->lru.clear();
+	this->index.clear();
+	this->usedBytes = 0;
+}
+
+template <typename T>
+size_t ReprojectionCache<T>::GetUsedBytes() const
+{
+	std::lock_guard<std::mutex> lock(this->m);
+	return this->usedBytes;
+}
+
+template <typename T>
+size_t ReprojectionCache<T>::GetCount() const
+{
+	std::lock_guard<std::mutex> lock(this->m);
+	return this->lru.size();
+}
+
+template <typename T>
+typename ReprojectionCache<T>::Statistics ReprojectionCache<T>::GetStatistics() const
+{
+	std::lock_guard<std::mutex> lock(this->m);
+	return this->stats;
+}
+
+/// <summary>
+/// Get file name of reprojection with key in disk tier
+/// </summary>
+/// <param name="key"></param>
+/// <returns></returns>
+template <typename T>
+std::string ReprojectionCache<T>::GetFileName(uint64_t key) const
+{
+	char buf[32];
+	std::snprintf(buf, sizeof(buf), "%016" PRIx64, key);
+
+	return (std::filesystem::path(this->cacheDir) / (FILE_PREFIX + std::string(buf) + FILE_SUFFIX)).string();
+}
+
+/// <summary>
+/// Load reprojection from disk tier
+/// Returns nullptr, if there is no valid file
+/// </summary>
+/// <param name="key"></param>
+/// <returns></returns>
+template <typename T>
+typename ReprojectionCache<T>::ReprojectionPtr ReprojectionCache<T>::LoadFromDisk(uint64_t key) const
+{
+	if (this->cacheDir.empty())
+	{
+		return nullptr;
+	}
+
+	std::string fileName = this->GetFileName(key);
+
+	std::error_code ec;
+	if (std::filesystem::exists(fileName, ec) == false)
+	{
+		return nullptr;
+	}
+
+	Reprojection<T> r = Reprojection<T>::CreateFromFile(fileName);
+	if (r.pixels.empty())
+	{
+		return nullptr;
+	}
+
+	return std::make_shared<const Reprojection<T>>(std::move(r));
+}
+
+/// <summary>
+/// Save reprojection to disk tier
+/// File is written under temporary name unique for process and thread
+/// and then renamed, so other processes (or LoadFromDisk after crash)
+/// never see partially written file.
+/// Returns false, if disk tier is not used or file could not be written
+/// </summary>
+/// <param name="key"></param>
+/// <param name="r"></param>
+/// <param name="header"></param>
+/// <returns></returns>
+template <typename T>
+bool ReprojectionCache<T>::SaveToDisk(uint64_t key, const Reprojection<T>& r, const ReprojectionFileHeader* header) const
+{
+	if (this->cacheDir.empty())
+	{
+		return false;
+	}
+
+#ifdef _WIN32
+	unsigned long long pid = static_cast<unsigned long long>(_getpid());
+#else
+	unsigned long long pid = static_cast<unsigned long long>(getpid());
+#endif
+	unsigned long long tid = static_cast<unsigned long long>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+	std::string fileName = this->GetFileName(key);
+	std::string tmpFileName = fileName + ".tmp." + std::to_string(pid) + "." + std::to_string(tid);
+
+	std::error_code ec;
+
+	if (r.SaveToFile(tmpFileName, (header) ? *header : r.CreateFileHeader()) == false)
+	{
+		std::filesystem::remove(tmpFileName, ec);
+		return false;
+	}
+
+	//replaces existing file (eg. written by other process or damaged one)
+	std::filesystem::rename(tmpFileName, fileName, ec);
+	if (ec)
+	{
+		MY_LOG_ERROR("Failed to rename cache file \"%s\" (%s)\n", tmpFileName.c_str(), ec.message().c_str());
+		std::filesystem::remove(tmpFileName, ec);
+		return false;
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Insert reprojection to memory tier and evict least recently used
+/// reprojections over the budget. Reprojection larger than the whole budget
+/// is not stored. Mutex must be locked.
+/// </summary>
+/// <param name="key"></param>
+/// <param name="value"></param>
+template <typename T>
+void ReprojectionCache<T>::InsertLocked(uint64_t key, ReprojectionPtr value)
+{
+	size_t bytes = value->GetBytes();
+	if (bytes > this->maxBytes)
+	{
+		return;
+	}
+
+	auto it = this->index.find(key);
+	if (it != this->index.end())
+	{
+		this->usedBytes -= it->second->bytes;
+		this->lru.erase(it->second);
+		this->index.erase(it);
+	}
+
+	this->lru.push_front({ key, value, bytes });
+	this->index[key] = this->lru.begin();
+	this->usedBytes += bytes;
+
+	while (this->usedBytes > this->maxBytes)
+	{
+		const Entry& last = this->lru.back();
+		this->usedBytes -= last.bytes;
+		this->index.erase(last.key);
+		this->lru.pop_back();
+		this->stats.evicted++;
+	}
+}
+
+template class Projections::ReprojectionCache<int>;
+template class Projections::ReprojectionCache<short>;
+template class Projections::ReprojectionCache<float>;
+template class Projections::ReprojectionCache<Projections::Fixed24_8>;
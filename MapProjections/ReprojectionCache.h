@@ -0,0 +1,133 @@
+#ifndef REPROJECTION_CACHE_H
+#define REPROJECTION_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <future>
+#include <functional>
+
+#include "./Fingerprint.h"
+#include "./ReprojectionFile.h"
+#include "./Reprojection.h"
+
+namespace Projections
+{
+
+	/// <summary>
+	/// Thread-safe cache of reprojections
+	///
+	/// Reprojections are identified by key created from fingerprints
+	/// of both projections (all projection parameters, frames and transforms)
+	/// and pixel type.
+	///
+	/// Memory tier - LRU with byte budget. Reprojections are shared_ptr,
+	/// so evicted reprojection stays valid while it is used.
+	/// Disk tier - if cacheDir is set, created reprojections are saved there
+	/// and missing reprojections are loaded before they are created.
+	///
+	/// If more threads request the same missing reprojection at once,
+	/// it is loaded / created only once and other threads wait for it.
+	/// </summary>
+	template <typename T = int>
+	class ReprojectionCache
+	{
+	public:
+		using ReprojectionPtr = std::shared_ptr<const Reprojection<T>>;
+
+		struct Statistics
+		{
+			size_t memoryHits = 0;
+			size_t diskHits = 0;
+			size_t created = 0;
+			size_t evicted = 0;
+		};
+
+		ReprojectionCache(size_t maxBytes, const std::string& cacheDir = "");
+
+		ReprojectionCache(const ReprojectionCache&) = delete;
+		ReprojectionCache& operator=(const ReprojectionCache&) = delete;
+
+		/// <summary>
+		/// Create cache key for reprojection from -> to
+		/// </summary>
+		/// <param name="from"></param>
+		/// <param name="to"></param>
+		/// <returns></returns>
+		template <typename FromProjection, typename ToProjection>
+		static uint64_t CreateKey(const FromProjection* from, const ToProjection* to)
+		{
+			Fingerprint fp;
+			fp.Add(ReprojectionFileHeader::GetPixelType<T>());
+			fp.Add(from->GetFingerprint());
+			fp.Add(to->GetFingerprint());
+			return fp.Get();
+		}
+
+		/// <summary>
+		/// Get reprojection from -> to
+		/// If it is not cached, it is created with Reprojection::CreateReprojection
+		/// </summary>
+		/// <param name="from"></param>
+		/// <param name="to"></param>
+		/// <param name="threadsCount">number of threads used for creation</param>
+		/// <returns></returns>
+		template <typename FromProjection, typename ToProjection>
+		ReprojectionPtr Get(FromProjection* from, ToProjection* to, size_t threadsCount = 1)
+		{
+			ReprojectionFileHeader header;
+			header.SetProjectionInfo(from->GetName(), from->GetFrame().GetId(),
+				to->GetName(), to->GetFrame().GetId());
+
+			return this->Get(CreateKey(from, to), [&]() {
+				return Reprojection<T>::CreateReprojection(from, to, threadsCount);
+			}, &header);
+		}
+
+		ReprojectionPtr Get(uint64_t key, const std::function<Reprojection<T>()>& create,
+			const ReprojectionFileHeader* header = nullptr);
+
+		bool Contains(uint64_t key) const;
+
+		size_t WarmUp();
+
+		void Clear();
+
+		size_t GetUsedBytes() const;
+		size_t GetCount() const;
+		Statistics GetStatistics() const;
+
+		std::string GetFileName(uint64_t key) const;
+
+	protected:
+
+		struct Entry
+		{
+			uint64_t key;
+			ReprojectionPtr value;
+			size_t bytes;
+		};
+
+		const size_t maxBytes;
+		const std::string cacheDir;
+
+		mutable std::mutex m;
+
+		std::list<Entry> lru; //most recently used first
+		std::unordered_map<uint64_t, typename std::list<Entry>::iterator> index;
+		std::unordered_map<uint64_t, std::shared_future<ReprojectionPtr>> pending;
+
+		size_t usedBytes;
+		Statistics stats;
+
+		ReprojectionPtr LoadFromDisk(uint64_t key) const;
+		bool SaveToDisk(uint64_t key, const Reprojection<T>& r, const ReprojectionFileHeader* header) const;
+		void InsertLocked(uint64_t key, ReprojectionPtr value);
+	};
+
+};
+
+#endif
@@ -0,0 +1,165 @@
+#ifndef REPROJECTION_FILE_H
+#define REPROJECTION_FILE_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "./FixedPoint.h"
+
+namespace Projections
+{
+
+	/// <summary>
+	/// Header of versioned reprojection file
+	/// Pixel data (Pixel<T>[pixelsCount]) starts at headerSize offset
+	///
+	/// Header has fixed size and pixel data are aligned, so the file
+	/// can be memory mapped and pixels used directly (see MappedReprojection)
+	/// </summary>
+	struct ReprojectionFileHeader
+	{
+		//"RPRJ"
+		static const uint32_t MAGIC = 0x4A525052;
+		static const uint32_t VERSION = 1;
+
+		static const size_t NAME_LENGTH = 64;
+
+		enum class PixelType : uint32_t
+		{
+			UNKNOWN = 0,
+			INT32 = 1,
+			INT16 = 2,
+			FLOAT32 = 3,
+			FIXED24_8 = 4
+		};
+
+		uint32_t magic;
+		uint32_t version;
+		uint32_t headerSize;
+		PixelType pixelType;
+
+		int32_t inW;
+		int32_t inH;
+		int32_t outW;
+		int32_t outH;
+
+		uint32_t fromFrameId;
+		uint32_t toFrameId;
+
+		uint64_t pixelsCount;
+		uint64_t checksum;
+
+		char fromName[NAME_LENGTH];
+		char toName[NAME_LENGTH];
+
+		uint8_t reserved[8];
+
+		ReprojectionFileHeader() :
+			magic(MAGIC),
+			version(VERSION),
+			headerSize(sizeof(ReprojectionFileHeader)),
+			pixelType(PixelType::UNKNOWN),
+			inW(0),
+			inH(0),
+			outW(0),
+			outH(0),
+			fromFrameId(0),
+			toFrameId(0),
+			pixelsCount(0),
+			checksum(0)
+		{
+			std::memset(fromName, 0, NAME_LENGTH);
+			std::memset(toName, 0, NAME_LENGTH);
+			std::memset(reserved, 0, sizeof(reserved));
+		}
+
+		/// <summary>
+		/// Get pixel type stored in file for reprojection with Pixel<T>
+		/// </summary>
+		/// <returns></returns>
+		template <typename T>
+		static PixelType GetPixelType()
+		{
+			if constexpr (std::is_same<T, int>::value && (sizeof(int) == 4)) return PixelType::INT32;
+			else if constexpr (std::is_same<T, short>::value && (sizeof(short) == 2)) return PixelType::INT16;
+			else if constexpr (std::is_same<T, float>::value) return PixelType::FLOAT32;
+			else if constexpr (std::is_same<T, Fixed24_8>::value) return PixelType::FIXED24_8;
+			else return PixelType::UNKNOWN;
+		}
+
+		/// <summary>
+		/// Set names and frame ids of projections
+		/// Names longer than NAME_LENGTH - 1 are truncated
+		/// </summary>
+		/// <param name="from"></param>
+		/// <param name="fromId"></param>
+		/// <param name="to"></param>
+		/// <param name="toId"></param>
+		void SetProjectionInfo(const char* from, uint32_t fromId, const char* to, uint32_t toId)
+		{
+			std::memset(fromName, 0, NAME_LENGTH);
+			std::memset(toName, 0, NAME_LENGTH);
+
+			std::strncpy(fromName, from, NAME_LENGTH - 1);
+			std::strncpy(toName, to, NAME_LENGTH - 1);
+
+			fromFrameId = fromId;
+			toFrameId = toId;
+		}
+
+		/// <summary>
+		/// Test if header is valid for reprojection with Pixel<T>
+		/// and file with fileSize bytes
+		/// </summary>
+		/// <param name="fileSize"></param>
+		/// <returns></returns>
+		template <typename T>
+		bool IsValid(uint64_t fileSize) const
+		{
+			if ((magic != MAGIC) || (version != VERSION)) return false;
+			if (headerSize < sizeof(ReprojectionFileHeader)) return false;
+			if (pixelType != GetPixelType<T>()) return false;
+			if ((outW < 0) || (outH < 0)) return false;
+			if (pixelsCount != static_cast<uint64_t>(outW) * static_cast<uint64_t>(outH)) return false;
+
+			return (fileSize == headerSize + pixelsCount * 2 * sizeof(T));
+		}
+
+		/// <summary>
+		/// Calculate checksum of data
+		/// FNV-1a processed by 64-bit words (rest is processed by bytes)
+		/// </summary>
+		/// <param name="data"></param>
+		/// <param name="size"></param>
+		/// <returns></returns>
+		static uint64_t CalcChecksum(const void* data, size_t size)
+		{
+			const uint64_t PRIME = 0x100000001b3ULL;
+			uint64_t hash = 0xcbf29ce484222325ULL;
+
+			const uint8_t* ptr = static_cast<const uint8_t*>(data);
+
+			size_t words = size / sizeof(uint64_t);
+			for (size_t i = 0; i < words; i++)
+			{
+				uint64_t v;
+				std::memcpy(&v, ptr + i * sizeof(uint64_t), sizeof(uint64_t));
+				hash = (hash ^ v) * PRIME;
+			}
+
+			for (size_t i = words * sizeof(uint64_t); i < size; i++)
+			{
+				hash = (hash ^ ptr[i]) * PRIME;
+			}
+
+			return hash;
+		}
+	};
+
+	static_assert(sizeof(ReprojectionFileHeader) == 192, "ReprojectionFileHeader must have fixed size");
+
+};
+
+#endif
@@ -0,0 +1,86 @@
+#include "./SeparableReprojection.h"
+
+#ifndef MY_LOG_ERROR
+#	define MY_LOG_ERROR(...) printf(__VA_ARGS__)
+#endif
+
+#include <string.h>
+
+using namespace Projections;
+
+/// <summary>
+/// Load reprojection info from file
+/// File contains inW, inH, outW, outH followed by 
+/// outW values of pixelsX and outH values of pixelsY
+/// </summary>
+/// <param name="fileName"></param>
+/// <returns></returns>
+template <typename T>
+SeparableReprojection<T> SeparableReprojection<T>::CreateFromFile(const std::string& fileName)
+{
+	SeparableReprojection r;
+
+	FILE* f = nullptr;  //pointer to file we will read in
+	my_fopen(&f, fileName.c_str(), "rb");
+	if (f == nullptr)
+	{
+		MY_LOG_ERROR("Failed to open file: \"%s\"\n", fileName.c_str());
+		return r;
+	}
+
+	fseek(f, 0L, SEEK_END);
+	long size = ftell(f);
+	fseek(f, 0L, SEEK_SET);
+
+	fread(&(r.inW), sizeof(int), 1, f);
+	fread(&(r.inH), sizeof(int), 1, f);
+	fread(&(r.outW), sizeof(int), 1, f);
+	fread(&(r.outH), sizeof(int), 1, f);
+
+	long dataSize = size - 4 * sizeof(int);
+	if ((r.outW <= 0) || (r.outH <= 0) || 
+		(dataSize != static_cast<long>((r.outW + r.outH) * sizeof(T))))
+	{
+		MY_LOG_ERROR("Corrupted separable reprojection file: \"%s\"\n", fileName.c_str());
+		fclose(f);
+		return SeparableReprojection();
+	}
+
+	r.pixelsX.resize(r.outW);
+	r.pixelsY.resize(r.outH);
+	fread(r.pixelsX.data(), sizeof(T), r.pixelsX.size(), f);
+	fread(r.pixelsY.data(), sizeof(T), r.pixelsY.size(), f);
+
+	fclose(f);
+
+	return r;
+}
+
+/// <summary>
+/// Save reprojection info to file
+/// </summary>
+/// <param name="fileName"></param>
+template <typename T>
+void SeparableReprojection<T>::SaveToFile(const std::string& fileName)
+{
+	FILE* f = nullptr;
+	my_fopen(&f, fileName.c_str(), "wb");
+
+	if (f == nullptr)
+	{
+		MY_LOG_ERROR("Failed to open file %s (%s)", fileName.c_str(), strerror(errno));
+		return;
+	}
+	fwrite(&this->inW, sizeof(int), 1, f);
+	fwrite(&this->inH, sizeof(int), 1, f);
+	fwrite(&this->outW, sizeof(int), 1, f);
+	fwrite(&this->outH, sizeof(int), 1, f);
+	fwrite(this->pixelsX.data(), sizeof(T), this->pixelsX.size(), f);
+	fwrite(this->pixelsY.data(), sizeof(T), this->pixelsY.size(), f);
+	fclose(f);
+
+}
+
+template struct Projections::SeparableReprojection<int>;
+template struct Projections::SeparableReprojection<short>;
+template struct Projections::SeparableReprojection<float>;
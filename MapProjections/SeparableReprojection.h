@@ -0,0 +1,226 @@
+#ifndef SEPARABLE_REPROJECTION_H
+#define SEPARABLE_REPROJECTION_H
+
+#include <vector>
+#include <string>
+
+#include "./MapProjectionStructures.h"
+#include "./Reprojection.h"
+
+namespace Projections
+{
+
+	/// <summary>
+	/// Separable reprojection structure
+	/// Usable only if both projections have independent lat / lon
+	/// (eg. Mercator, Miller, Equirectangular)
+	///
+	/// Input column depends only on output column and input row
+	/// depends only on output row, so only two 1D arrays are stored:
+	/// pixelsX[toX] = fromX
+	/// pixelsY[toY] = fromY
+	///
+	/// Memory is O(outW + outH) instead of O(outW * outH)
+	/// Values outside of the input image are stored as -1
+	///
+	/// Calculates mapping:
+	/// toData[toX, toY] = fromData[pixelsX[toX], pixelsY[toY]]
+	/// </summary>
+	template <typename T = int>
+	struct SeparableReprojection
+	{
+		int inW;
+		int inH;
+		int outW;
+		int outH;
+		std::vector<T> pixelsX; //[toX] = fromX
+		std::vector<T> pixelsY; //[toY] = fromY
+
+		SeparableReprojection() :
+			inW(0),
+			inH(0),
+			outW(0),
+			outH(0)
+		{
+		}
+
+		/// <summary>
+		/// Load reprojection from file
+		/// </summary>
+		/// <param name="fileName"></param>
+		/// <returns></returns>
+		static SeparableReprojection<T> CreateFromFile(const std::string& fileName);
+
+		/// <summary>
+		/// Re-project data from -> to
+		/// If projections do not have independent lat / lon,
+		/// empty reprojection is returned (see IsEmpty)
+		/// </summary>
+		/// <param name="from"></param>
+		/// <param name="to"></param>
+		/// <returns></returns>
+		template <typename FromProjection, typename ToProjection>
+		static SeparableReprojection<T> CreateReprojection(FromProjection* from, ToProjection* to)
+		{
+			SeparableReprojection<T> reprojection;
+
+			if ((from->IsIndependentLatLon() == false) || (to->IsIndependentLatLon() == false))
+			{
+				return reprojection;
+			}
+
+			reprojection.inW = from->GetFrameWidth();
+			reprojection.inH = from->GetFrameHeight();
+			reprojection.outW = to->GetFrameWidth();
+			reprojection.outH = to->GetFrameHeight();
+
+			Reprojection<T>::CreateSeparableCache(from, to, reprojection.pixelsX, reprojection.pixelsY);
+
+			for (auto& x : reprojection.pixelsX)
+			{
+				if ((x >= 0) && (x < reprojection.inW)) continue;
+				x = -1;
+			}
+
+			for (auto& y : reprojection.pixelsY)
+			{
+				if ((y >= 0) && (y < reprojection.inH)) continue;
+				y = -1;
+			}
+
+			return reprojection;
+		}
+
+		/// <summary>
+		/// Save reprojection to file
+		/// </summary>
+		/// <param name="fileName"></param>
+		void SaveToFile(const std::string& fileName);
+
+		/// <summary>
+		/// Test if reprojection is empty (eg. failed to create or load)
+		/// </summary>
+		/// <returns></returns>
+		bool IsEmpty() const
+		{
+			return (this->pixelsX.empty() || this->pixelsY.empty());
+		}
+
+		/// <summary>
+		/// Reproject inputData based on reproj with Nearest Neighbor interpolation.
+		/// Output array has size reproj.outW * reproj.outH
+		/// Output array must be released with delete[]
+		///
+		/// Template parameters:
+		/// DataType - type of input data
+		/// Out - output structure - can be raw array of std::vector
+		/// ChannelsCount - number of channels in input / output data
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out = DataType*, size_t ChannelsCount = 1>
+		Out ReprojectDataNerestNeighbor(const DataType* inputData, const DataType NO_VALUE) const
+		{
+			return this->template ReprojectData<DataType, Out, ChannelsCount>(NO_VALUE,
+				[&](T x, T y, DataType* out) {
+				Reprojection<T>::template CopyNerestNeighbor<DataType, ChannelsCount>(inputData, this->inW,
+					static_cast<int>(x), static_cast<int>(y), out);
+			});
+		}
+
+		/// <summary>
+		/// Reproject inputData based on reproj with Bilinear interpolation.
+		/// Note: Usable only if T is nor int number
+		///
+		/// Output array has size reproj.outW * reproj.outH
+		/// Output array must be released with delete[]
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out = DataType*, size_t ChannelsCount = 1>
+		Out ReprojectDataBilinear(const DataType* inputData, const DataType NO_VALUE) const
+		{
+			return this->template ReprojectData<DataType, Out, ChannelsCount>(NO_VALUE,
+				[&](T x, T y, DataType* out) {
+				Reprojection<T>::template InterpolateBilinear<DataType, ChannelsCount>(inputData,
+					this->inW, this->inH, x, y, out);
+			});
+		}
+
+		/// <summary>
+		/// Reproject inputData based on reproj with Bicubic interpolation.
+		/// Note: Usable only if T is nor int number
+		///
+		/// Output array has size reproj.outW * reproj.outH
+		/// Output array must be released with delete[]
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out = DataType*, size_t ChannelsCount = 1>
+		Out ReprojectDataBicubic(const DataType* inputData, const DataType NO_VALUE) const
+		{
+			return this->template ReprojectData<DataType, Out, ChannelsCount>(NO_VALUE,
+				[&](T x, T y, DataType* out) {
+				Reprojection<T>::template InterpolateBicubic<DataType, ChannelsCount>(inputData,
+					this->inW, this->inH, x, y, out);
+			});
+		}
+
+	protected:
+
+		/// <summary>
+		/// Iterate output rows and columns and call
+		/// interpolate(fromX, fromY, out) for every valid output pixel
+		/// Rows outside of the input image are filled with NO_VALUE at once
+		/// </summary>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="interpolate"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out, size_t ChannelsCount, typename Interpolate>
+		Out ReprojectData(const DataType NO_VALUE, Interpolate interpolate) const
+		{
+			size_t count = static_cast<size_t>(this->outW) * this->outH;
+
+			Out output = Reprojection<T>::template AllocateOutput<DataType, Out, ChannelsCount>(count);
+
+			for (int y = 0; y < this->outH; y++)
+			{
+				T py = this->pixelsY[y];
+
+				DataType* out = &output[static_cast<size_t>(y) * this->outW * ChannelsCount];
+
+				if (py == -1)
+				{
+					//whole row is outside of the model - no data - put there NO_VALUE
+					std::fill(out, out + static_cast<size_t>(this->outW) * ChannelsCount, NO_VALUE);
+					continue;
+				}
+
+				for (int x = 0; x < this->outW; x++)
+				{
+					T px = this->pixelsX[x];
+
+					if (px == -1)
+					{
+						//outside of the model - no data - put there NO_VALUE
+						Reprojection<T>::template SetNoValue<DataType, ChannelsCount>(out, NO_VALUE);
+					}
+					else
+					{
+						interpolate(px, py, out);
+					}
+
+					out += ChannelsCount;
+				}
+			}
+
+			return output;
+		}
+	};
+
+};
+
+#endif
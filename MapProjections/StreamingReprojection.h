@@ -0,0 +1,426 @@
+#ifndef STREAMING_REPROJECTION_H
+#define STREAMING_REPROJECTION_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+#include "./MapProjectionStructures.h"
+#include "./DataLayout.h"
+#include "./Reprojection.h"
+
+namespace Projections
+{
+
+	/// <summary>
+	/// Reprojection of input that arrives row by row
+	/// (eg. decoded by PngStreamDecoder), without the whole input in memory
+	///
+	/// For every output row, range of input rows used by its pixels is taken
+	/// from the table. Input rows are read from top to bottom to a ring buffer
+	/// and output row is computed as soon as its last input row is read.
+	/// Ring buffer holds only rows that are still needed by remaining output rows
+	/// (see GetWindowRows), input rows after the last used row are not read at all.
+	/// Every row is stored in the ring twice, so any window of rows is continuous
+	/// and the same kernels as in Reprojection are used - results are same as
+	/// with ReprojectData* on the whole input.
+	///
+	/// Peak memory is bounded only if output rows use few input rows
+	/// (for mapping rotated by 90 degrees, window is the whole input).
+	///
+	/// Reprojection must outlive this object and must not be modified.
+	/// </summary>
+	template <typename T = int>
+	class StreamingReprojection
+	{
+	public:
+		//input rows above and below the pixel that are read by filters
+		static const int NEAREST_NEIGHBOR_MARGIN = 0;
+		static const int BILINEAR_MARGIN = 1;
+		static const int BICUBIC_MARGIN = 2;
+
+		explicit StreamingReprojection(const Reprojection<T>& reprojection) :
+			reprojection(&reprojection)
+		{
+			this->BuildRowRanges();
+		}
+
+		/// <summary>
+		/// Get number of input rows kept in the ring buffer
+		/// for filter that reads margin rows above and below the pixel.
+		/// Ring buffer has 2 * GetWindowRows(margin) * inW pixels.
+		/// </summary>
+		/// <param name="margin"></param>
+		/// <returns></returns>
+		int GetWindowRows(int margin) const
+		{
+			std::vector<int> order;
+			std::vector<int> minBegin;
+			return this->CreateSchedule(margin, order, minBegin);
+		}
+
+		/// <summary>
+		/// Number of input rows that are read (rows after the last used row are skipped)
+		/// </summary>
+		/// <param name="margin"></param>
+		/// <returns></returns>
+		int GetReadRowsCount(int margin) const
+		{
+			int count = 0;
+			for (size_t i = 0; i < this->minRows.size(); i++)
+			{
+				count = std::max(count, this->GetEnd(static_cast<int>(i), margin));
+			}
+			return count;
+		}
+
+		/// <summary>
+		/// Reproject input read by rows with Nearest neighbor.
+		/// readRow(DataType* row) fills next input row (inW * ChannelsCount elements)
+		/// and returns false on error. It is called for input rows in order from 0.
+		/// Output is written to caller-provided memory, output row y starts
+		/// at outputData + y * outputRowPitch.
+		///
+		/// If asyncRead is true, rows are read by another thread
+		/// while output rows are computed.
+		/// Returns false if readRow fails (output is then not complete).
+		/// </summary>
+		/// <param name="readRow"></param>
+		/// <param name="outputData"></param>
+		/// <param name="outputRowPitch"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="asyncRead"></param>
+		/// <returns></returns>
+		template <typename DataType, size_t ChannelsCount = 1, typename ReadRow>
+		bool ReprojectDataNerestNeighbor(ReadRow readRow, DataType* outputData, size_t outputRowPitch,
+			const DataType NO_VALUE, bool asyncRead = false) const
+		{
+			return this->ReprojectDataRows<DataType, ChannelsCount>(readRow, outputData, outputRowPitch, NO_VALUE,
+				NEAREST_NEIGHBOR_MARGIN, asyncRead,
+				[](const DataType* window, int w, int h, T x, T y, DataType* out) {
+				Reprojection<T>::template CopyNerestNeighbor<DataType, ChannelsCount>(window, w,
+					static_cast<int>(x), static_cast<int>(y), out);
+			});
+		}
+
+		/// <summary>
+		/// Same as ReprojectDataNerestNeighbor, but with Bilinear interpolation
+		/// </summary>
+		/// <param name="readRow"></param>
+		/// <param name="outputData"></param>
+		/// <param name="outputRowPitch"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="asyncRead"></param>
+		/// <returns></returns>
+		template <typename DataType, size_t ChannelsCount = 1, typename ReadRow>
+		bool ReprojectDataBilinear(ReadRow readRow, DataType* outputData, size_t outputRowPitch,
+			const DataType NO_VALUE, bool asyncRead = false) const
+		{
+			return this->ReprojectDataRows<DataType, ChannelsCount>(readRow, outputData, outputRowPitch, NO_VALUE,
+				BILINEAR_MARGIN, asyncRead,
+				[](const DataType* window, int w, int h, T x, T y, DataType* out) {
+				Reprojection<T>::template InterpolateBilinear<DataType, ChannelsCount>(window, w, h, x, y, out);
+			});
+		}
+
+		/// <summary>
+		/// Same as ReprojectDataNerestNeighbor, but with Bicubic interpolation
+		/// </summary>
+		/// <param name="readRow"></param>
+		/// <param name="outputData"></param>
+		/// <param name="outputRowPitch"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="asyncRead"></param>
+		/// <returns></returns>
+		template <typename DataType, size_t ChannelsCount = 1, typename ReadRow>
+		bool ReprojectDataBicubic(ReadRow readRow, DataType* outputData, size_t outputRowPitch,
+			const DataType NO_VALUE, bool asyncRead = false) const
+		{
+			return this->ReprojectDataRows<DataType, ChannelsCount>(readRow, outputData, outputRowPitch, NO_VALUE,
+				BICUBIC_MARGIN, asyncRead,
+				[](const DataType* window, int w, int h, T x, T y, DataType* out) {
+				Reprojection<T>::template InterpolateBicubic<DataType, ChannelsCount>(window, w, h, x, y, out);
+			});
+		}
+
+	protected:
+		const Reprojection<T>* reprojection;
+
+		//range of input rows [minRows, maxRows] used by pixels of output row
+		//(minRows > maxRows if row has no valid pixel)
+		std::vector<int> minRows;
+		std::vector<int> maxRows;
+
+		void BuildRowRanges()
+		{
+			const Reprojection<T>& r = *this->reprojection;
+
+			this->minRows.assign(r.outH, std::numeric_limits<int>::max());
+			this->maxRows.assign(r.outH, -1);
+
+			for (int y = 0; y < r.outH; y++)
+			{
+				const Pixel<T>* row = r.pixels.data() + static_cast<size_t>(y) * r.outW;
+				for (int x = 0; x < r.outW; x++)
+				{
+					if ((row[x].x == -1) || (row[x].y == -1))
+					{
+						continue;
+					}
+
+					//no floor, just cast, same as kernels
+					int py = static_cast<int>(row[x].y);
+					this->minRows[y] = std::min(this->minRows[y], py);
+					this->maxRows[y] = std::max(this->maxRows[y], py);
+				}
+			}
+		}
+
+		bool HasInput(int y) const
+		{
+			return this->minRows[y] <= this->maxRows[y];
+		}
+
+		/// <summary>
+		/// First input row of window of output row y
+		/// </summary>
+		/// <param name="y"></param>
+		/// <param name="margin"></param>
+		/// <returns></returns>
+		int GetBegin(int y, int margin) const
+		{
+			return (this->HasInput(y)) ? std::max(0, this->minRows[y] - margin) : std::numeric_limits<int>::max();
+		}
+
+		/// <summary>
+		/// End (exclusive) of window of output row y
+		/// Output row can be computed when this number of input rows is read
+		/// </summary>
+		/// <param name="y"></param>
+		/// <param name="margin"></param>
+		/// <returns></returns>
+		int GetEnd(int y, int margin) const
+		{
+			return (this->HasInput(y)) ? std::min(this->reprojection->inH, this->maxRows[y] + margin + 1) : 0;
+		}
+
+		/// <summary>
+		/// Order of output rows (by end of their windows) and
+		/// minBegin[i] - first input row needed by rows order[i..]
+		/// Returns number of rows of the ring buffer.
+		/// When input row r is read, rows with end <= r are already computed,
+		/// so rows [minBegin of the remaining rows, r] have to be in the ring.
+		/// </summary>
+		/// <param name="margin"></param>
+		/// <param name="order"></param>
+		/// <param name="minBegin"></param>
+		/// <returns></returns>
+		int CreateSchedule(int margin, std::vector<int>& order, std::vector<int>& minBegin) const
+		{
+			const int outH = this->reprojection->outH;
+
+			order.resize(outH);
+			for (int i = 0; i < outH; i++)
+			{
+				order[i] = i;
+			}
+			std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+				return this->GetEnd(a, margin) < this->GetEnd(b, margin);
+			});
+
+			minBegin.assign(outH + 1, std::numeric_limits<int>::max());
+			for (int i = outH - 1; i >= 0; i--)
+			{
+				minBegin[i] = std::min(minBegin[i + 1], this->GetBegin(order[i], margin));
+			}
+
+			int windowRows = 1;
+			int rowsCount = (outH > 0) ? this->GetEnd(order[outH - 1], margin) : 0;
+
+			size_t next = 0;
+			for (int r = 0; r < rowsCount; r++)
+			{
+				while ((next < order.size()) && (this->GetEnd(order[next], margin) <= r))
+				{
+					next++;
+				}
+				if (minBegin[next] <= r)
+				{
+					windowRows = std::max(windowRows, r + 1 - minBegin[next]);
+				}
+			}
+
+			return windowRows;
+		}
+
+		/// <summary>
+		/// Read input rows to the ring buffer and compute output rows
+		/// when their windows are complete.
+		/// interpolate(window, inW, windowH, x, y, out) is called with y relative
+		/// to the first row of the window.
+		/// </summary>
+		/// <param name="readRow"></param>
+		/// <param name="output"></param>
+		/// <param name="outputRowPitch"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="margin"></param>
+		/// <param name="asyncRead"></param>
+		/// <param name="interpolate"></param>
+		/// <returns></returns>
+		template <typename DataType, size_t ChannelsCount, typename ReadRow, typename Interpolate>
+		bool ReprojectDataRows(ReadRow& readRow, DataType* output, size_t outputRowPitch, const DataType NO_VALUE,
+			int margin, bool asyncRead, const Interpolate& interpolate) const
+		{
+			const Reprojection<T>& r = *this->reprojection;
+
+			std::vector<int> order;
+			std::vector<int> minBegin;
+			const int windowRows = this->CreateSchedule(margin, order, minBegin);
+			const int rowsCount = (r.outH > 0) ? this->GetEnd(order.back(), margin) : 0;
+
+			const size_t rowSize = static_cast<size_t>(r.inW) * ChannelsCount;
+
+			//row i is at ring slots (i % windowRows) and (i % windowRows + windowRows)
+			std::vector<DataType> ring(2 * static_cast<size_t>(windowRows) * rowSize);
+
+			auto computeRow = [&](int y) {
+				int begin = this->GetBegin(y, margin);
+				int end = this->GetEnd(y, margin);
+
+				const DataType* window = ring.data();
+				int windowH = 0;
+				T base = static_cast<T>(0);
+				if (begin < end)
+				{
+					window = ring.data() + static_cast<size_t>(begin % windowRows) * rowSize;
+					windowH = end - begin;
+					base = static_cast<T>(begin);
+				}
+
+				Reprojection<T>::ReprojectRows(r.pixels.data(), r.outW, y, y + 1, &r.validSpans,
+					output, InterleavedLayout<ChannelsCount>(), outputRowPitch, NO_VALUE,
+					[&](T x, T py, DataType* out) {
+					interpolate(window, r.inW, windowH, x, py - base, out);
+				});
+			};
+
+			auto storeRow = [&](int i) -> DataType* {
+				return ring.data() + static_cast<size_t>(i % windowRows) * rowSize;
+			};
+
+			auto duplicateRow = [&](int i) {
+				DataType* slot = storeRow(i);
+				std::copy(slot, slot + rowSize, slot + static_cast<size_t>(windowRows) * rowSize);
+			};
+
+			size_t next = 0;
+
+			if (asyncRead == false)
+			{
+				for (int i = 0; i <= rowsCount; i++)
+				{
+					//rows with windows in the first i input rows
+					while ((next < order.size()) && (this->GetEnd(order[next], margin) <= i))
+					{
+						computeRow(order[next]);
+						next++;
+					}
+
+					if (i == rowsCount)
+					{
+						break;
+					}
+
+					if (readRow(storeRow(i)) == false)
+					{
+						return false;
+					}
+					duplicateRow(i);
+				}
+				return true;
+			}
+
+			//rows are read by reader thread, ring slot of row i can be reused
+			//when the remaining output rows do not need row i
+			std::mutex m;
+			std::condition_variable cv;
+			int readCount = 0;
+			int firstNeeded = minBegin[0];
+			bool failed = false;
+			std::exception_ptr exception;
+
+			std::thread reader([&]() {
+				try
+				{
+					for (int i = 0; i < rowsCount; i++)
+					{
+						{
+							std::unique_lock<std::mutex> lock(m);
+							cv.wait(lock, [&]() { return i - windowRows < firstNeeded; });
+						}
+
+						bool ok = readRow(storeRow(i));
+						if (ok)
+						{
+							duplicateRow(i);
+						}
+
+						std::lock_guard<std::mutex> lock(m);
+						if (ok == false)
+						{
+							failed = true;
+							cv.notify_all();
+							return;
+						}
+						readCount = i + 1;
+						cv.notify_all();
+					}
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(m);
+					exception = std::current_exception();
+					failed = true;
+					cv.notify_all();
+				}
+			});
+
+			while (next < order.size())
+			{
+				int end = this->GetEnd(order[next], margin);
+				{
+					std::unique_lock<std::mutex> lock(m);
+					cv.wait(lock, [&]() { return (readCount >= end) || failed; });
+					if (readCount < end)
+					{
+						break;
+					}
+				}
+
+				computeRow(order[next]);
+				next++;
+
+				std::lock_guard<std::mutex> lock(m);
+				firstNeeded = minBegin[next];
+				cv.notify_all();
+			}
+
+			reader.join();
+
+			if (exception)
+			{
+				std::rethrow_exception(exception);
+			}
+
+			return (failed == false);
+		}
+	};
+}
+
+#endif
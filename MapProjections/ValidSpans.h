@@ -0,0 +1,155 @@
+#ifndef VALID_SPANS_H
+#define VALID_SPANS_H
+
+#include <vector>
+#include <cstdint>
+
+#include "./MapProjectionStructures.h"
+#include "./ParallelUtils.h"
+
+namespace Projections
+{
+
+	/// <summary>
+	/// Index of valid pixels of reprojection
+	/// For every output row, it holds list of [begin, end) spans
+	/// of pixels with valid mapping (not -1).
+	///
+	/// Spans of row y are spans[rowOffsets[y]] ... spans[rowOffsets[y + 1] - 1]
+	/// and they are sorted by begin.
+	/// </summary>
+	struct ValidSpans
+	{
+		struct Span
+		{
+			int begin;
+			int end;
+		};
+
+		std::vector<uint32_t> rowOffsets;
+		std::vector<Span> spans;
+
+		bool IsEmpty() const
+		{
+			return this->rowOffsets.empty();
+		}
+
+		void Clear()
+		{
+			this->rowOffsets.clear();
+			this->spans.clear();
+		}
+
+		/// <summary>
+		/// Get number of valid pixels
+		/// </summary>
+		/// <returns></returns>
+		size_t GetPixelsCount() const
+		{
+			size_t count = 0;
+			for (const auto& s : this->spans)
+			{
+				count += s.end - s.begin;
+			}
+			return count;
+		}
+
+		/// <summary>
+		/// Build index from pixels of outW x outH reprojection
+		/// Rows are processed in parallel if threadsCount != 1
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="outW"></param>
+		/// <param name="outH"></param>
+		/// <param name="threadsCount"></param>
+		template <typename T>
+		void Build(const Pixel<T>* pixels, int outW, int outH, size_t threadsCount = 1)
+		{
+			std::vector<std::vector<Span>> rows(outH);
+
+			ParallelUtils::RunRowBands(outH, 8, threadsCount, [&](int startRow, int endRow) {
+				BuildRows(pixels, outW, startRow, endRow, rows);
+			});
+
+			this->SetRows(rows);
+		}
+
+		/// <summary>
+		/// Find spans of rows [startRow, endRow) and store them to rows[y]
+		/// Used to build index by parts (eg. while pixels are created),
+		/// parts are joined with SetRows
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="outW"></param>
+		/// <param name="startRow"></param>
+		/// <param name="endRow"></param>
+		/// <param name="rows"></param>
+		template <typename T>
+		static void BuildRows(const Pixel<T>* pixels, int outW, int startRow, int endRow, std::vector<std::vector<Span>>& rows)
+		{
+			for (int y = startRow; y < endRow; y++)
+			{
+				const Pixel<T>* row = pixels + static_cast<size_t>(y) * outW;
+
+				rows[y].clear();
+
+				int x = 0;
+				while (x < outW)
+				{
+					while ((x < outW) && ((row[x].x == -1) || (row[x].y == -1))) x++;
+					if (x == outW) break;
+
+					int begin = x;
+					while ((x < outW) && (row[x].x != -1) && (row[x].y != -1)) x++;
+
+					rows[y].push_back({ begin, x });
+				}
+			}
+		}
+
+		/// <summary>
+		/// Set index from spans of every row (see BuildRows)
+		/// </summary>
+		/// <param name="rows"></param>
+		void SetRows(const std::vector<std::vector<Span>>& rows)
+		{
+			int outH = static_cast<int>(rows.size());
+
+			this->rowOffsets.resize(outH + 1);
+			this->spans.clear();
+
+			for (int y = 0; y < outH; y++)
+			{
+				this->rowOffsets[y] = static_cast<uint32_t>(this->spans.size());
+				this->spans.insert(this->spans.end(), rows[y].begin(), rows[y].end());
+			}
+			this->rowOffsets[outH] = static_cast<uint32_t>(this->spans.size());
+		}
+
+		/// <summary>
+		/// Call onInvalid(begin, end) for invalid [begin, end) spans
+		/// and onValid(begin, end) for valid [begin, end) spans of row y
+		/// in order from left to right
+		/// </summary>
+		/// <param name="y"></param>
+		/// <param name="outW"></param>
+		/// <param name="onInvalid"></param>
+		/// <param name="onValid"></param>
+		template <typename OnInvalid, typename OnValid>
+		void ForEachSpan(int y, int outW, OnInvalid onInvalid, OnValid onValid) const
+		{
+			int x = 0;
+			for (uint32_t i = this->rowOffsets[y]; i < this->rowOffsets[y + 1]; i++)
+			{
+				const Span& s = this->spans[i];
+				if (s.begin > x) onInvalid(x, s.begin);
+				onValid(s.begin, s.end);
+				x = s.end;
+			}
+			if (x < outW) onInvalid(x, outW);
+		}
+	};
+
+};
+
+#endif
@@ -370,6 +370,43 @@ void testing()
 	TestOblique();
 
 	TestWrapAround();
+	TestWrapAroundSimd();
+
+	TestParallelReprojection();
+
+	TestApproximateReprojection();
+
+	TestSeparableReprojection();
+
+	TestCompressedReprojection();
+
+	TestReprojectionFile();
+
+	TestReprojectionCache();
+
+	TestValidSpans();
+
+	TestComposeReprojection();
+
+	TestInputFootprint();
+
+	TestFixedPointReprojection();
+
+	TestInterpolationPlan();
+	TestProjectionPrecision();
+	TestParallelReprojectData();
+	TestNearestNeighborSimd();
+	TestInterpolationSimd();
+	TestDataLayout();
+	TestBatchReprojectData();
+	TestZeroAllocationReprojectData();
+	TestAreaPlan();
+	TestLanczos();
+	TestGatherPlan();
+	TestStreamingReprojection();
+	TestProjectionsAvx();
+	TestGEOSInverseAvx();
+	TestProjectionsNeon();
 
 	TestCalculations();
 }
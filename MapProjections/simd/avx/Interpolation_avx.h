@@ -0,0 +1,1062 @@
+#ifndef INTERPOLATION_SIMD_H
+#define INTERPOLATION_SIMD_H
+
+#ifdef ENABLE_SIMD
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include <immintrin.h>     //AVX2
+
+#include "../../MapProjectionStructures.h"
+#include "../../FixedPoint.h"
+#include "../../LanczosFilter.h"
+#include "../../Reprojection.h"
+
+#include "./NearestNeighbor_avx.h"
+
+namespace Projections::Avx
+{
+	/// <summary>
+	/// Bilinear, bicubic (B-spline) and Lanczos interpolation of 8 output pixels at once
+	/// with AVX2 gathers. Every lane computes one output pixel,
+	/// input taps are gathered channel by channel.
+	///
+	/// Supported data are uint8_t, uint16_t and float with 1, 3 or 4 channels.
+	///
+	/// float data are computed in float with same equations as
+	/// Projections::Reprojection::InterpolateBilinear / InterpolateBicubic (they use double).
+	///
+	/// uint8_t data and all integral data with Fixed24_8 or int positions are computed 
+	/// in fixed point. Real positions are rounded to Fixed24_8 and result is same as with 
+	/// InterpolateBilinearFixed / InterpolateBicubicFixed for Fixed24_8 positions.
+	/// uint8_t fits to 32-bit lanes, uint16_t bicubic sum is accumulated in 64 bits.
+	///
+	/// uint16_t data with real positions are computed in float (see FLOAT_MATH), 
+	/// because 1/256 pixel positions are not precise enough for 16-bit values.
+	///
+	/// Maximal difference from double version for real positions is MAX_DIFFERENCE
+	/// (checked by TestInterpolationSimd).
+	///
+	/// Integral taps are gathered as 32-bit chunks with all channels of pixel
+	/// (1 chunk for uint8_t, 2 chunks for uint16_t with 3 or 4 channels). 
+	/// Lanes, whose chunk would read after the end of input, are computed 
+	/// by single instruction version.
+	///
+	/// Lanczos weights are gathered from LanczosFilter table with the same phases 
+	/// as Projections::Reprojection::InterpolateLanczos. Integral results are same 
+	/// as the single instruction version, float data are accumulated in float.
+	/// </summary>
+	template <typename T, typename DataType, size_t ChannelsCount>
+	struct InterpolationGather
+	{
+		using Fixed = Fixed24_8;
+
+		static const bool INTEGRAL = std::is_integral<DataType>::value;
+
+		//float data and uint16_t data with real positions are interpolated in float
+		//with fractions of positions, taps of integral data are converted to float
+		//and result is truncated (same as conversion in double version)
+		static const bool FLOAT_MATH = !INTEGRAL || ((sizeof(DataType) == 2) && std::is_floating_point<T>::value);
+
+		//maximal difference of bilinear and bicubic from double version 
+		//(Projections::Reprojection::InterpolateBilinear / InterpolateBicubic) for real positions
+		//uint8_t - positions rounded to 1/256 pixel (+-0.5 for full range step between taps), 
+		//          result rounded instead of truncated (+1)
+		//uint16_t - float instead of double changes only truncation of values close to integer
+		//float - relative difference (float instead of double)
+		static constexpr double MAX_DIFFERENCE = (sizeof(DataType) == 1) ? 2.0 : (INTEGRAL) ? 1.0 : 1e-6;
+
+		//number of 32-bit chunks with all channels of integral pixel
+		static const int CHUNKS = static_cast<int>((ChannelsCount * sizeof(DataType) + 3) / 4);
+		static const int CHUNK_VALUES = static_cast<int>(4 / sizeof(DataType));
+
+		static constexpr bool IsSupported()
+		{
+			return (std::is_same<DataType, uint8_t>::value || std::is_same<DataType, uint16_t>::value ||
+				std::is_same<DataType, float>::value) &&
+				((ChannelsCount == 1) || (ChannelsCount == 3) || (ChannelsCount == 4));
+		}
+
+		static bool IsInputSupported(int inW, int inH)
+		{
+			uint64_t bytes = static_cast<uint64_t>(inW) * inH * ChannelsCount * sizeof(DataType);
+
+			//input must contain at least one gathered chunk
+			return (inW >= 2) && (inH >= 2) && (bytes >= 4) &&
+				(bytes <= static_cast<uint64_t>(std::numeric_limits<int32_t>::max()));
+		}
+
+		InterpolationGather(const DataType* inputData, int inW, int inH, const DataType NO_VALUE) :
+			input(inputData),
+			inW(inW),
+			inH(inH),
+			NO_VALUE(NO_VALUE)
+		{
+			int count = static_cast<int>(static_cast<int64_t>(inW) * inH * ChannelsCount);
+
+			//last pixel index, from which all chunks can be gathered
+			this->maxIndex = (INTEGRAL) ? count - CHUNKS * CHUNK_VALUES : count - 1;
+		}
+
+		/// <summary>
+		/// Bilinear interpolation of count pixels to out
+		/// Invalid pixels (-1) are set to NO_VALUE
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="count"></param>
+		/// <param name="out"></param>
+		void BilinearSegment(const Pixel<T>* pixels, int count, DataType* out) const
+		{
+			this->ProcessSegment(pixels, count, out, [this](const Pixel<T>* p, DataType* o) {
+				this->Bilinear8(p, o);
+			});
+		}
+
+		/// <summary>
+		/// Bicubic interpolation of count pixels to out
+		/// Invalid pixels (-1) are set to NO_VALUE
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="count"></param>
+		/// <param name="out"></param>
+		void BicubicSegment(const Pixel<T>* pixels, int count, DataType* out) const
+		{
+			this->ProcessSegment(pixels, count, out, [this](const Pixel<T>* p, DataType* o) {
+				this->Bicubic8(p, o);
+			});
+		}
+
+		/// <summary>
+		/// Lanczos interpolation of count pixels to out
+		/// Invalid pixels (-1) are set to NO_VALUE
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="count"></param>
+		/// <param name="out"></param>
+		template <int LOBES>
+		void LanczosSegment(const Pixel<T>* pixels, int count, DataType* out) const
+		{
+			this->ProcessSegment(pixels, count, out, [this](const Pixel<T>* p, DataType* o) {
+				this->template Lanczos8<LOBES>(p, o);
+			});
+		}
+
+	protected:
+
+		/// <summary>
+		/// Positions of 8 pixels
+		/// Invalid pixels have x, y = 0
+		/// </summary>
+		struct Positions
+		{
+			//integer part
+			__m256i x;
+			__m256i y;
+
+			//fractions in [0, Fixed::ONE) - integral data
+			__m256i fx;
+			__m256i fy;
+
+			//fractions in [0, 1) - float data
+			__m256 tx;
+			__m256 ty;
+
+			__m256i valid;
+		};
+
+		const DataType* input;
+		int inW;
+		int inH;
+		int maxIndex;
+		const DataType NO_VALUE;
+
+		template <typename Process8>
+		void ProcessSegment(const Pixel<T>* pixels, int count, DataType* out, Process8 process8) const
+		{
+			int count8 = count - (count % 8);
+
+			for (int i = 0; i < count8; i += 8)
+			{
+				process8(pixels + i, out + i * ChannelsCount);
+			}
+
+			if (count8 == count)
+			{
+				return;
+			}
+
+			//rest is padded with invalid pixels
+			Pixel<T> rest[8];
+			DataType restOut[8 * ChannelsCount];
+
+			for (int i = 0; i < 8; i++)
+			{
+				rest[i] = (count8 + i < count) ? pixels[count8 + i] : Pixel<T>{ T(-1), T(-1) };
+			}
+
+			process8(rest, restOut);
+
+			std::memcpy(out + count8 * ChannelsCount, restOut, (count - count8) * ChannelsCount * sizeof(DataType));
+		}
+
+		static Fixed ToFixed(T v)
+		{
+			if constexpr (std::is_same<T, Fixed>::value)
+			{
+				return v;
+			}
+			else if constexpr (std::is_integral<T>::value)
+			{
+				return Fixed(static_cast<int>(v));
+			}
+			else
+			{
+				return Fixed(static_cast<double>(v));
+			}
+		}
+
+		void LoadPositions(const Pixel<T>* pixels, Positions& p) const
+		{
+			p.fx = _mm256_setzero_si256();
+			p.fy = _mm256_setzero_si256();
+			p.tx = _mm256_setzero_ps();
+			p.ty = _mm256_setzero_ps();
+
+			if constexpr (std::is_same<T, int>::value || std::is_same<T, float>::value || std::is_same<T, Fixed>::value)
+			{
+				static_assert(sizeof(Pixel<T>) == 8, "Pixel must be 2 x 32-bit");
+
+				//x0 y0 x1 y1 x2 y2 x3 y3 | x4 y4 x5 y5 x6 y6 x7 y7
+				__m256 a = _mm256_loadu_ps(reinterpret_cast<const float*>(pixels));
+				__m256 b = _mm256_loadu_ps(reinterpret_cast<const float*>(pixels + 4));
+
+				__m256 xs = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+				__m256 ys = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+				xs = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(xs), _MM_SHUFFLE(3, 1, 2, 0)));
+				ys = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(ys), _MM_SHUFFLE(3, 1, 2, 0)));
+
+				__m256i invalid;
+
+				if constexpr (std::is_same<T, float>::value)
+				{
+					__m256 minusOne = _mm256_set1_ps(-1.0f);
+					invalid = _mm256_castps_si256(_mm256_or_ps(_mm256_cmp_ps(xs, minusOne, _CMP_EQ_OQ), _mm256_cmp_ps(ys, minusOne, _CMP_EQ_OQ)));
+
+					if constexpr (!FLOAT_MATH)
+					{
+						this->ToFixed(xs, p.x, p.fx);
+						this->ToFixed(ys, p.y, p.fy);
+					}
+					else
+					{
+						//truncation - same as static_cast<int>
+						p.x = _mm256_cvttps_epi32(xs);
+						p.y = _mm256_cvttps_epi32(ys);
+						p.tx = _mm256_sub_ps(xs, _mm256_cvtepi32_ps(p.x));
+						p.ty = _mm256_sub_ps(ys, _mm256_cvtepi32_ps(p.y));
+					}
+				}
+				else
+				{
+					__m256i x = _mm256_castps_si256(xs);
+					__m256i y = _mm256_castps_si256(ys);
+
+					//raw value of -1
+					__m256i minusOne = _mm256_set1_epi32((std::is_same<T, Fixed>::value) ? -Fixed::ONE : -1);
+					invalid = _mm256_or_si256(_mm256_cmpeq_epi32(x, minusOne), _mm256_cmpeq_epi32(y, minusOne));
+
+					if constexpr (std::is_same<T, Fixed>::value)
+					{
+						__m256i fractionMask = _mm256_set1_epi32(Fixed::FRACTION_MASK);
+
+						p.x = _mm256_srai_epi32(x, Fixed::FRACTION_BITS);
+						p.y = _mm256_srai_epi32(y, Fixed::FRACTION_BITS);
+						p.fx = _mm256_and_si256(x, fractionMask);
+						p.fy = _mm256_and_si256(y, fractionMask);
+
+						__m256 scale = _mm256_set1_ps(1.0f / Fixed::ONE);
+						p.tx = _mm256_mul_ps(_mm256_cvtepi32_ps(p.fx), scale);
+						p.ty = _mm256_mul_ps(_mm256_cvtepi32_ps(p.fy), scale);
+					}
+					else
+					{
+						p.x = x;
+						p.y = y;
+					}
+				}
+
+				p.valid = _mm256_xor_si256(invalid, _mm256_set1_epi32(-1));
+			}
+			else
+			{
+				alignas(32) int32_t xx[8];
+				alignas(32) int32_t yy[8];
+				alignas(32) int32_t fx[8];
+				alignas(32) int32_t fy[8];
+				alignas(32) float tx[8];
+				alignas(32) float ty[8];
+				alignas(32) int32_t vv[8];
+
+				for (int i = 0; i < 8; i++)
+				{
+					const Pixel<T>& px = pixels[i];
+					vv[i] = ((px.x == -1) || (px.y == -1)) ? 0 : -1;
+
+					if constexpr (!FLOAT_MATH)
+					{
+						Fixed x = ToFixed(px.x);
+						Fixed y = ToFixed(px.y);
+						xx[i] = x.GetInt();
+						yy[i] = y.GetInt();
+						fx[i] = x.GetFraction();
+						fy[i] = y.GetFraction();
+					}
+					else
+					{
+						xx[i] = static_cast<int>(px.x);
+						yy[i] = static_cast<int>(px.y);
+						tx[i] = static_cast<float>(px.x - xx[i]);
+						ty[i] = static_cast<float>(px.y - yy[i]);
+					}
+				}
+
+				p.x = _mm256_load_si256(reinterpret_cast<const __m256i*>(xx));
+				p.y = _mm256_load_si256(reinterpret_cast<const __m256i*>(yy));
+				p.valid = _mm256_load_si256(reinterpret_cast<const __m256i*>(vv));
+
+				if constexpr (!FLOAT_MATH)
+				{
+					p.fx = _mm256_load_si256(reinterpret_cast<const __m256i*>(fx));
+					p.fy = _mm256_load_si256(reinterpret_cast<const __m256i*>(fy));
+				}
+				else
+				{
+					p.tx = _mm256_load_ps(tx);
+					p.ty = _mm256_load_ps(ty);
+				}
+			}
+
+			p.x = _mm256_and_si256(p.x, p.valid);
+			p.y = _mm256_and_si256(p.y, p.valid);
+		}
+
+		/// <summary>
+		/// Convert non-negative v to Fixed - integer part and fraction
+		/// Rounding is same as Fixed(float) - half away from zero
+		/// </summary>
+		static void ToFixed(__m256 v, __m256i& intPart, __m256i& fraction)
+		{
+			__m256 s = _mm256_mul_ps(v, _mm256_set1_ps(static_cast<float>(Fixed::ONE)));
+
+			//truncation is floor for non-negative values
+			__m256i raw = _mm256_cvttps_epi32(s);
+			__m256 rest = _mm256_sub_ps(s, _mm256_cvtepi32_ps(raw));
+
+			//rest >= 0.5 => mask = -1
+			__m256i roundUp = _mm256_castps_si256(_mm256_cmp_ps(rest, _mm256_set1_ps(0.5f), _CMP_GE_OQ));
+			raw = _mm256_sub_epi32(raw, roundUp);
+
+			intPart = _mm256_srai_epi32(raw, Fixed::FRACTION_BITS);
+			fraction = _mm256_and_si256(raw, _mm256_set1_epi32(Fixed::FRACTION_MASK));
+		}
+
+		/// <summary>
+		/// Lanes with tap at element index maxTap, that cannot be gathered
+		/// as 32-bit chunks. They are computed by single instruction version.
+		/// </summary>
+		__m256i GetTailLanes(__m256i maxTap, __m256i valid) const
+		{
+			if constexpr (INTEGRAL)
+			{
+				return _mm256_and_si256(_mm256_cmpgt_epi32(maxTap, _mm256_set1_epi32(this->maxIndex)), valid);
+			}
+			else
+			{
+				return _mm256_setzero_si256();
+			}
+		}
+
+		/// <summary>
+		/// Gather all channels of integral pixels at element index
+		/// </summary>
+		void GatherChunks(__m256i index, __m256i* chunks) const
+		{
+			for (int k = 0; k < CHUNKS; k++)
+			{
+				__m256i chunkIndex = _mm256_add_epi32(index, _mm256_set1_epi32(k * CHUNK_VALUES));
+				chunks[k] = _mm256_i32gather_epi32(reinterpret_cast<const int*>(this->input), chunkIndex, sizeof(DataType));
+			}
+		}
+
+		/// <summary>
+		/// Get channel c from gathered chunks
+		/// </summary>
+		static __m256i GetChannel(const __m256i* chunks, size_t c)
+		{
+			const int BITS = static_cast<int>(8 * sizeof(DataType));
+			const int MASK = static_cast<int>(std::numeric_limits<DataType>::max());
+
+			__m256i v = _mm256_srli_epi32(chunks[c / CHUNK_VALUES], static_cast<int>(c % CHUNK_VALUES) * BITS);
+			return _mm256_and_si256(v, _mm256_set1_epi32(MASK));
+		}
+
+		__m256 GatherFloat(__m256i index) const
+		{
+			return _mm256_i32gather_ps(reinterpret_cast<const float*>(this->input), index, sizeof(float));
+		}
+
+		/// <summary>
+		/// Get channel c of pixels at element index as float
+		/// Integral data are taken from already gathered chunks
+		/// </summary>
+		__m256 GetFloat(const __m256i* chunks, __m256i index, size_t c) const
+		{
+			if constexpr (INTEGRAL)
+			{
+				return _mm256_cvtepi32_ps(GetChannel(chunks, c));
+			}
+			else
+			{
+				return this->GatherFloat(_mm256_add_epi32(index, _mm256_set1_epi32(static_cast<int>(c))));
+			}
+		}
+
+		void Bilinear8(const Pixel<T>* pixels, DataType* out) const
+		{
+			Positions p;
+			this->LoadPositions(pixels, p);
+
+			__m256i one = _mm256_set1_epi32(1);
+			__m256i w = _mm256_set1_epi32(this->inW);
+			__m256i ch = _mm256_set1_epi32(static_cast<int>(ChannelsCount));
+
+			__m256i x1p = _mm256_min_epi32(_mm256_add_epi32(p.x, one), _mm256_set1_epi32(this->inW - 1));
+			__m256i y1p = _mm256_min_epi32(_mm256_add_epi32(p.y, one), _mm256_set1_epi32(this->inH - 1));
+
+			__m256i row0 = _mm256_mullo_epi32(p.y, w);
+			__m256i row1 = _mm256_mullo_epi32(y1p, w);
+
+			__m256i i11 = _mm256_mullo_epi32(_mm256_add_epi32(x1p, row1), ch);
+
+			__m256i tail = this->GetTailLanes(i11, p.valid);
+			__m256i mask = _mm256_andnot_si256(tail, p.valid);
+
+			__m256i i00 = _mm256_and_si256(_mm256_mullo_epi32(_mm256_add_epi32(p.x, row0), ch), mask);
+			__m256i i10 = _mm256_and_si256(_mm256_mullo_epi32(_mm256_add_epi32(x1p, row0), ch), mask);
+			__m256i i01 = _mm256_and_si256(_mm256_mullo_epi32(_mm256_add_epi32(p.x, row1), ch), mask);
+			i11 = _mm256_and_si256(i11, mask);
+
+			if constexpr (!FLOAT_MATH)
+			{
+				const int SHIFT = 2 * Fixed::FRACTION_BITS;
+
+				__m256i fixedOne = _mm256_set1_epi32(Fixed::ONE);
+				__m256i sx = _mm256_sub_epi32(fixedOne, p.fx);
+				__m256i sy = _mm256_sub_epi32(fixedOne, p.fy);
+				__m256i round = _mm256_set1_epi32(1 << (SHIFT - 1));
+
+				__m256i t00[CHUNKS], t10[CHUNKS], t01[CHUNKS], t11[CHUNKS];
+				this->GatherChunks(i00, t00);
+				this->GatherChunks(i10, t10);
+				this->GatherChunks(i01, t01);
+				this->GatherChunks(i11, t11);
+
+				__m256i res[ChannelsCount];
+				for (size_t c = 0; c < ChannelsCount; c++)
+				{
+					__m256i c00 = GetChannel(t00, c);
+					__m256i c10 = GetChannel(t10, c);
+					__m256i c01 = GetChannel(t01, c);
+					__m256i c11 = GetChannel(t11, c);
+
+					__m256i a = _mm256_add_epi32(_mm256_mullo_epi32(c00, sx), _mm256_mullo_epi32(c10, p.fx));
+					__m256i b = _mm256_add_epi32(_mm256_mullo_epi32(c01, sx), _mm256_mullo_epi32(c11, p.fx));
+
+					//uint16_t sum fits to unsigned 32 bits
+					__m256i sum = _mm256_add_epi32(_mm256_mullo_epi32(a, sy), _mm256_mullo_epi32(b, p.fy));
+					res[c] = _mm256_srli_epi32(_mm256_add_epi32(sum, round), SHIFT);
+				}
+
+				this->StoreInt(res, p.valid, out);
+
+				this->ProcessTail(pixels, tail, out, [this](const Pixel<T>& px, DataType* o) {
+					Projections::Reprojection<Fixed>::template InterpolateBilinearFixed<DataType, ChannelsCount>(this->input, this->inW, this->inH, 
+						ToFixed(px.x), ToFixed(px.y), o);
+				});
+			}
+			else
+			{
+				__m256 oneF = _mm256_set1_ps(1.0f);
+				__m256 sx = _mm256_sub_ps(oneF, p.tx);
+				__m256 sy = _mm256_sub_ps(oneF, p.ty);
+
+				__m256i t00[CHUNKS], t10[CHUNKS], t01[CHUNKS], t11[CHUNKS];
+				if constexpr (INTEGRAL)
+				{
+					this->GatherChunks(i00, t00);
+					this->GatherChunks(i10, t10);
+					this->GatherChunks(i01, t01);
+					this->GatherChunks(i11, t11);
+				}
+
+				__m256 res[ChannelsCount];
+				for (size_t c = 0; c < ChannelsCount; c++)
+				{
+					__m256 c00 = this->GetFloat(t00, i00, c);
+					__m256 c10 = this->GetFloat(t10, i10, c);
+					__m256 c01 = this->GetFloat(t01, i01, c);
+					__m256 c11 = this->GetFloat(t11, i11, c);
+
+					__m256 a = _mm256_add_ps(_mm256_mul_ps(c00, sx), _mm256_mul_ps(c10, p.tx));
+					__m256 b = _mm256_add_ps(_mm256_mul_ps(c01, sx), _mm256_mul_ps(c11, p.tx));
+
+					res[c] = _mm256_add_ps(_mm256_mul_ps(a, sy), _mm256_mul_ps(b, p.ty));
+				}
+
+				if constexpr (INTEGRAL)
+				{
+					this->StoreTruncated(res, p.valid, out);
+
+					this->ProcessTail(pixels, tail, out, [this](const Pixel<T>& px, DataType* o) {
+						Projections::Reprojection<T>::template InterpolateBilinear<DataType, ChannelsCount>(this->input, this->inW, this->inH, px.x, px.y, o);
+					});
+				}
+				else
+				{
+					this->StoreFloat(res, p.valid, out);
+				}
+			}
+		}
+
+		void Bicubic8(const Pixel<T>* pixels, DataType* out) const
+		{
+			Positions p;
+			this->LoadPositions(pixels, p);
+
+			__m256i one = _mm256_set1_epi32(1);
+			__m256i two = _mm256_set1_epi32(2);
+			__m256i w = _mm256_set1_epi32(this->inW);
+			__m256i ch = _mm256_set1_epi32(static_cast<int>(ChannelsCount));
+
+			__m256i lastX = _mm256_set1_epi32(this->inW - 1);
+			__m256i lastY = _mm256_set1_epi32(this->inH - 1);
+
+			//same clamping as single instruction version
+			__m256i x2p = _mm256_add_epi32(p.x, two);
+			__m256i y2p = _mm256_add_epi32(p.y, two);
+
+			__m256i cols[4] = {
+				_mm256_max_epi32(_mm256_sub_epi32(p.x, one), _mm256_setzero_si256()),
+				p.x,
+				_mm256_min_epi32(_mm256_add_epi32(p.x, one), lastX),
+				_mm256_blendv_epi8(x2p, _mm256_set1_epi32(this->inW - 2), _mm256_cmpgt_epi32(x2p, lastX))
+			};
+
+			__m256i rows[4] = {
+				_mm256_max_epi32(_mm256_sub_epi32(p.y, one), _mm256_setzero_si256()),
+				p.y,
+				_mm256_min_epi32(_mm256_add_epi32(p.y, one), lastY),
+				_mm256_blendv_epi8(y2p, _mm256_set1_epi32(this->inH - 2), _mm256_cmpgt_epi32(y2p, lastY))
+			};
+
+			__m256i maxTap = _mm256_add_epi32(_mm256_max_epi32(cols[2], cols[3]),
+				_mm256_mullo_epi32(_mm256_max_epi32(rows[2], rows[3]), w));
+			maxTap = _mm256_mullo_epi32(maxTap, ch);
+
+			__m256i tail = this->GetTailLanes(maxTap, p.valid);
+			__m256i mask = _mm256_andnot_si256(tail, p.valid);
+
+			for (int i = 0; i < 4; i++)
+			{
+				cols[i] = _mm256_and_si256(_mm256_mullo_epi32(cols[i], ch), mask);
+				rows[i] = _mm256_and_si256(_mm256_mullo_epi32(_mm256_mullo_epi32(rows[i], w), ch), mask);
+			}
+
+			if constexpr (!FLOAT_MATH)
+			{
+				using Weights = FixedPointBicubicWeights<Fixed::FRACTION_BITS>;
+
+				const int SHIFT = 2 * Weights::BITS;
+
+				//weights of fraction f are at table[4 * f]
+				const int* table = Weights::Get().front().data();
+
+				__m256i wx[4];
+				__m256i wy[4];
+				__m256i fx4 = _mm256_slli_epi32(p.fx, 2);
+				__m256i fy4 = _mm256_slli_epi32(p.fy, 2);
+				for (int i = 0; i < 4; i++)
+				{
+					wx[i] = _mm256_i32gather_epi32(table, _mm256_add_epi32(fx4, _mm256_set1_epi32(i)), 4);
+					wy[i] = _mm256_i32gather_epi32(table, _mm256_add_epi32(fy4, _mm256_set1_epi32(i)), 4);
+				}
+
+				//uint8_t sum fits to 32 bits, uint16_t sum is accumulated
+				//in 64 bits - even and odd lanes separately
+				__m256i sum[ChannelsCount];
+				__m256i sumOdd[ChannelsCount];
+				for (size_t c = 0; c < ChannelsCount; c++)
+				{
+					sum[c] = (sizeof(DataType) == 1) ? _mm256_set1_epi32(1 << (SHIFT - 1)) : _mm256_set1_epi64x(int64_t(1) << (SHIFT - 1));
+					sumOdd[c] = sum[c];
+				}
+
+				for (int j = 0; j < 4; j++)
+				{
+					__m256i taps[4][CHUNKS];
+					for (int i = 0; i < 4; i++)
+					{
+						this->GatherChunks(_mm256_add_epi32(rows[j], cols[i]), taps[i]);
+					}
+
+					for (size_t c = 0; c < ChannelsCount; c++)
+					{
+						//horizontal sum fits to 32 bits
+						__m256i h = _mm256_mullo_epi32(GetChannel(taps[0], c), wx[0]);
+						for (int i = 1; i < 4; i++)
+						{
+							h = _mm256_add_epi32(h, _mm256_mullo_epi32(GetChannel(taps[i], c), wx[i]));
+						}
+
+						if constexpr (sizeof(DataType) == 1)
+						{
+							sum[c] = _mm256_add_epi32(sum[c], _mm256_mullo_epi32(h, wy[j]));
+						}
+						else
+						{
+							sum[c] = _mm256_add_epi64(sum[c], _mm256_mul_epu32(h, wy[j]));
+							sumOdd[c] = _mm256_add_epi64(sumOdd[c], _mm256_mul_epu32(_mm256_srli_epi64(h, 32), _mm256_srli_epi64(wy[j], 32)));
+						}
+					}
+				}
+
+				__m256i res[ChannelsCount];
+				for (size_t c = 0; c < ChannelsCount; c++)
+				{
+					if constexpr (sizeof(DataType) == 1)
+					{
+						res[c] = _mm256_srli_epi32(sum[c], SHIFT);
+					}
+					else
+					{
+						__m256i even = _mm256_srli_epi64(sum[c], SHIFT);
+						__m256i odd = _mm256_srli_epi64(sumOdd[c], SHIFT);
+						res[c] = _mm256_or_si256(even, _mm256_slli_epi64(odd, 32));
+					}
+				}
+
+				this->StoreInt(res, p.valid, out);
+
+				this->ProcessTail(pixels, tail, out, [this](const Pixel<T>& px, DataType* o) {
+					Projections::Reprojection<Fixed>::template InterpolateBicubicFixed<DataType, ChannelsCount>(this->input, this->inW, this->inH, 
+						ToFixed(px.x), ToFixed(px.y), o);
+				});
+			}
+			else
+			{
+				__m256 wx[4];
+				__m256 wy[4];
+				this->GetBicubicWeights(p.tx, wx);
+				this->GetBicubicWeights(p.ty, wy);
+
+				__m256 sum[ChannelsCount];
+				for (size_t c = 0; c < ChannelsCount; c++)
+				{
+					sum[c] = _mm256_setzero_ps();
+				}
+
+				for (int j = 0; j < 4; j++)
+				{
+					__m256i index[4];
+					__m256i taps[4][CHUNKS];
+					for (int i = 0; i < 4; i++)
+					{
+						index[i] = _mm256_add_epi32(rows[j], cols[i]);
+						if constexpr (INTEGRAL)
+						{
+							this->GatherChunks(index[i], taps[i]);
+						}
+					}
+
+					for (size_t c = 0; c < ChannelsCount; c++)
+					{
+						__m256 h = _mm256_mul_ps(this->GetFloat(taps[0], index[0], c), wx[0]);
+						for (int i = 1; i < 4; i++)
+						{
+							h = _mm256_add_ps(h, _mm256_mul_ps(this->GetFloat(taps[i], index[i], c), wx[i]));
+						}
+
+						sum[c] = _mm256_add_ps(sum[c], _mm256_mul_ps(wy[j], h));
+					}
+				}
+
+				__m256 res[ChannelsCount];
+				for (size_t c = 0; c < ChannelsCount; c++)
+				{
+					res[c] = _mm256_mul_ps(sum[c], _mm256_set1_ps(1.0f / 36.0f));
+				}
+
+				if constexpr (INTEGRAL)
+				{
+					this->StoreTruncated(res, p.valid, out);
+
+					this->ProcessTail(pixels, tail, out, [this](const Pixel<T>& px, DataType* o) {
+						Projections::Reprojection<T>::template InterpolateBicubic<DataType, ChannelsCount>(this->input, this->inW, this->inH, px.x, px.y, o);
+					});
+				}
+				else
+				{
+					this->StoreFloat(res, p.valid, out);
+				}
+			}
+		}
+
+		template <int LOBES>
+		void Lanczos8(const Pixel<T>* pixels, DataType* out) const
+		{
+			using Filter = LanczosFilter<LOBES>;
+
+			const int TAPS = Filter::TAPS;
+
+			const auto& table = Filter::Get();
+
+			Positions p;
+			this->LoadPositions(pixels, p);
+
+			//pixels and phases - same quantization as LanczosFilter::GetPhase
+			__m256i px = p.x;
+			__m256i py = p.y;
+			__m256i phaseX = p.fx;
+			__m256i phaseY = p.fy;
+
+			if constexpr (FLOAT_MATH)
+			{
+				//fraction that rounds to 1 is moved to the next pixel
+				__m256i carryX;
+				__m256i carryY;
+				ToFixed(p.tx, carryX, phaseX);
+				ToFixed(p.ty, carryY, phaseY);
+				px = _mm256_add_epi32(px, carryX);
+				py = _mm256_add_epi32(py, carryY);
+			}
+
+			//... except at the last pixel
+			__m256i lastX = _mm256_set1_epi32(this->inW - 1);
+			__m256i lastY = _mm256_set1_epi32(this->inH - 1);
+			__m256i lastPhase = _mm256_set1_epi32(Filter::PHASES_COUNT - 1);
+
+			phaseX = _mm256_blendv_epi8(phaseX, lastPhase, _mm256_cmpgt_epi32(px, lastX));
+			phaseY = _mm256_blendv_epi8(phaseY, lastPhase, _mm256_cmpgt_epi32(py, lastY));
+			px = _mm256_min_epi32(px, lastX);
+			py = _mm256_min_epi32(py, lastY);
+
+			__m256i w = _mm256_set1_epi32(this->inW);
+			__m256i ch = _mm256_set1_epi32(static_cast<int>(ChannelsCount));
+			__m256i zero = _mm256_setzero_si256();
+
+			//taps clamped to border
+			__m256i cols[TAPS];
+			__m256i rows[TAPS];
+			for (int i = 0; i < TAPS; i++)
+			{
+				__m256i o = _mm256_set1_epi32(Filter::ORIGIN + i);
+				cols[i] = _mm256_min_epi32(_mm256_max_epi32(_mm256_add_epi32(px, o), zero), lastX);
+				rows[i] = _mm256_min_epi32(_mm256_max_epi32(_mm256_add_epi32(py, o), zero), lastY);
+			}
+
+			__m256i maxTap = _mm256_mullo_epi32(_mm256_add_epi32(cols[TAPS - 1], _mm256_mullo_epi32(rows[TAPS - 1], w)), ch);
+
+			__m256i tail = this->GetTailLanes(maxTap, p.valid);
+			__m256i mask = _mm256_andnot_si256(tail, p.valid);
+
+			for (int i = 0; i < TAPS; i++)
+			{
+				cols[i] = _mm256_and_si256(_mm256_mullo_epi32(cols[i], ch), mask);
+				rows[i] = _mm256_and_si256(_mm256_mullo_epi32(_mm256_mullo_epi32(rows[i], w), ch), mask);
+			}
+
+			//weights of phase f are at table[TAPS * f]
+			__m256i taps = _mm256_set1_epi32(TAPS);
+			__m256i phaseX0 = _mm256_mullo_epi32(phaseX, taps);
+			__m256i phaseY0 = _mm256_mullo_epi32(phaseY, taps);
+
+			if constexpr (INTEGRAL)
+			{
+				const int SHIFT = 2 * Filter::WEIGHT_BITS;
+
+				//sum is non-negative with BIAS (negative lobes),
+				//so it can be shifted by 64-bit logical shift
+				const int BIAS = 1 << 20;
+
+				const int* weights = table.weights.front().data();
+
+				__m256i wx[TAPS];
+				__m256i wy[TAPS];
+				for (int i = 0; i < TAPS; i++)
+				{
+					wx[i] = _mm256_i32gather_epi32(weights, _mm256_add_epi32(phaseX0, _mm256_set1_epi32(i)), 4);
+					wy[i] = _mm256_i32gather_epi32(weights, _mm256_add_epi32(phaseY0, _mm256_set1_epi32(i)), 4);
+				}
+
+				//sum is accumulated in 64 bits - even and odd lanes separately
+				__m256i sum[ChannelsCount];
+				__m256i sumOdd[ChannelsCount];
+				for (size_t c = 0; c < ChannelsCount; c++)
+				{
+					sum[c] = _mm256_set1_epi64x((int64_t(1) << (SHIFT - 1)) + (static_cast<int64_t>(BIAS) << SHIFT));
+					sumOdd[c] = sum[c];
+				}
+
+				for (int j = 0; j < TAPS; j++)
+				{
+					__m256i t[TAPS][CHUNKS];
+					for (int i = 0; i < TAPS; i++)
+					{
+						this->GatherChunks(_mm256_add_epi32(rows[j], cols[i]), t[i]);
+					}
+
+					for (size_t c = 0; c < ChannelsCount; c++)
+					{
+						//horizontal sum fits to signed 32 bits
+						__m256i h = _mm256_mullo_epi32(GetChannel(t[0], c), wx[0]);
+						for (int i = 1; i < TAPS; i++)
+						{
+							h = _mm256_add_epi32(h, _mm256_mullo_epi32(GetChannel(t[i], c), wx[i]));
+						}
+
+						sum[c] = _mm256_add_epi64(sum[c], _mm256_mul_epi32(h, wy[j]));
+						sumOdd[c] = _mm256_add_epi64(sumOdd[c], _mm256_mul_epi32(_mm256_srli_epi64(h, 32), _mm256_srli_epi64(wy[j], 32)));
+					}
+				}
+
+				__m256i bias = _mm256_set1_epi32(BIAS);
+				__m256i maxValue = _mm256_set1_epi32(static_cast<int>(std::numeric_limits<DataType>::max()));
+
+				__m256i res[ChannelsCount];
+				for (size_t c = 0; c < ChannelsCount; c++)
+				{
+					__m256i even = _mm256_srli_epi64(sum[c], SHIFT);
+					__m256i odd = _mm256_srli_epi64(sumOdd[c], SHIFT);
+					res[c] = _mm256_sub_epi32(_mm256_or_si256(even, _mm256_slli_epi64(odd, 32)), bias);
+					res[c] = _mm256_min_epi32(_mm256_max_epi32(res[c], zero), maxValue);
+				}
+
+				this->StoreInt(res, p.valid, out);
+			}
+			else
+			{
+				const float* weights = table.weightsFloat.front().data();
+
+				__m256 wx[TAPS];
+				__m256 wy[TAPS];
+				for (int i = 0; i < TAPS; i++)
+				{
+					wx[i] = _mm256_i32gather_ps(weights, _mm256_add_epi32(phaseX0, _mm256_set1_epi32(i)), 4);
+					wy[i] = _mm256_i32gather_ps(weights, _mm256_add_epi32(phaseY0, _mm256_set1_epi32(i)), 4);
+				}
+
+				__m256 res[ChannelsCount];
+				for (size_t c = 0; c < ChannelsCount; c++)
+				{
+					__m256i ci = _mm256_set1_epi32(static_cast<int>(c));
+
+					__m256 sum = _mm256_setzero_ps();
+					for (int j = 0; j < TAPS; j++)
+					{
+						__m256i row = _mm256_add_epi32(rows[j], ci);
+
+						__m256 h = _mm256_mul_ps(this->GatherFloat(_mm256_add_epi32(row, cols[0])), wx[0]);
+						for (int i = 1; i < TAPS; i++)
+						{
+							h = _mm256_add_ps(h, _mm256_mul_ps(this->GatherFloat(_mm256_add_epi32(row, cols[i])), wx[i]));
+						}
+
+						sum = _mm256_add_ps(sum, _mm256_mul_ps(wy[j], h));
+					}
+
+					res[c] = sum;
+				}
+
+				this->StoreFloat(res, p.valid, out);
+			}
+
+			//tail lanes (integral data) - positions are not converted to Fixed,
+			//phases of single instruction version are same
+			int tailMask = _mm256_movemask_ps(_mm256_castsi256_ps(tail));
+			for (int i = 0; i < 8; i++)
+			{
+				if (tailMask & (1 << i))
+				{
+					Projections::Reprojection<T>::template InterpolateLanczos<DataType, ChannelsCount, LOBES>(this->input, this->inW, this->inH, 
+						pixels[i].x, pixels[i].y, out + i * ChannelsCount);
+				}
+			}
+		}
+
+		/// <summary>
+		/// Cubic B-spline weights (multiplied by 6) of fractions t
+		/// </summary>
+		static void GetBicubicWeights(__m256 t, __m256* w)
+		{
+			__m256 three = _mm256_set1_ps(3.0f);
+			__m256 four = _mm256_set1_ps(4.0f);
+			__m256 six = _mm256_set1_ps(6.0f);
+
+			__m256 t2 = _mm256_mul_ps(t, t);
+			__m256 t3 = _mm256_mul_ps(t2, t);
+
+			__m256 s = _mm256_sub_ps(_mm256_set1_ps(1.0f), t);
+			__m256 s2 = _mm256_mul_ps(s, s);
+			__m256 s3 = _mm256_mul_ps(s2, s);
+
+			w[0] = s3;
+			w[1] = _mm256_sub_ps(_mm256_add_ps(four, _mm256_mul_ps(three, t3)), _mm256_mul_ps(six, t2));
+			w[2] = _mm256_sub_ps(_mm256_add_ps(four, _mm256_mul_ps(three, s3)), _mm256_mul_ps(six, s2));
+			w[3] = t3;
+		}
+
+		/// <summary>
+		/// Compute tail lanes (integral data) by single instruction version
+		/// </summary>
+		template <typename Interpolate>
+		void ProcessTail(const Pixel<T>* pixels, __m256i tail, DataType* out, Interpolate interpolate) const
+		{
+			int tailMask = _mm256_movemask_ps(_mm256_castsi256_ps(tail));
+			for (int i = 0; i < 8; i++)
+			{
+				if (tailMask & (1 << i))
+				{
+					interpolate(pixels[i], out + i * ChannelsCount);
+				}
+			}
+		}
+
+		/// <summary>
+		/// Store 8 pixels of integral data computed in float
+		/// Values are truncated (same as conversion in double version)
+		/// </summary>
+		void StoreTruncated(const __m256* res, __m256i valid, DataType* out) const
+		{
+			__m256i resInt[ChannelsCount];
+			for (size_t c = 0; c < ChannelsCount; c++)
+			{
+				resInt[c] = _mm256_cvttps_epi32(res[c]);
+			}
+
+			this->StoreInt(resInt, valid, out);
+		}
+
+		/// <summary>
+		/// Store 8 pixels from channels with values in 32-bit lanes
+		/// Invalid lanes are set to NO_VALUE
+		/// </summary>
+		void StoreInt(__m256i* res, __m256i valid, DataType* out) const
+		{
+			__m256i noValue = _mm256_set1_epi32(static_cast<int>(this->NO_VALUE));
+			for (size_t c = 0; c < ChannelsCount; c++)
+			{
+				res[c] = _mm256_blendv_epi8(noValue, res[c], valid);
+			}
+
+			uint8_t* outBytes = reinterpret_cast<uint8_t*>(out);
+
+			if constexpr (sizeof(DataType) == 1)
+			{
+				__m256i v = res[0];
+				for (size_t c = 1; c < ChannelsCount; c++)
+				{
+					v = _mm256_or_si256(v, _mm256_slli_epi32(res[c], static_cast<int>(8 * c)));
+				}
+
+				PackedPixelStore<static_cast<int>(ChannelsCount)>::Store4(v, outBytes);
+			}
+			else if constexpr (ChannelsCount == 1)
+			{
+				PackedPixelStore<2>::Store4(res[0], outBytes);
+			}
+			else
+			{
+				__m256i lo = _mm256_or_si256(res[0], _mm256_slli_epi32(res[1], 16));
+				__m256i hi = res[2];
+				if constexpr (ChannelsCount == 4)
+				{
+					hi = _mm256_or_si256(hi, _mm256_slli_epi32(res[3], 16));
+				}
+
+				//pixels [0, 1 | 4, 5] and [2, 3 | 6, 7]
+				__m256i p0 = _mm256_unpacklo_epi32(lo, hi);
+				__m256i p1 = _mm256_unpackhi_epi32(lo, hi);
+
+				const int PIXEL_BYTES = static_cast<int>(2 * ChannelsCount);
+				PackedPixelStore<PIXEL_BYTES>::Store8(_mm256_permute2x128_si256(p0, p1, 0x20), outBytes);
+				PackedPixelStore<PIXEL_BYTES>::Store8(_mm256_permute2x128_si256(p0, p1, 0x31), outBytes + 4 * PIXEL_BYTES);
+			}
+		}
+
+		/// <summary>
+		/// Store 8 pixels from channels
+		/// Invalid lanes are set to NO_VALUE
+		/// </summary>
+		void StoreFloat(__m256* res, __m256i valid, DataType* out) const
+		{
+			__m256 noValue = _mm256_set1_ps(static_cast<float>(this->NO_VALUE));
+			for (size_t c = 0; c < ChannelsCount; c++)
+			{
+				res[c] = _mm256_blendv_ps(noValue, res[c], _mm256_castsi256_ps(valid));
+			}
+
+			float* outFloat = reinterpret_cast<float*>(out);
+
+			if constexpr (ChannelsCount == 1)
+			{
+				_mm256_storeu_ps(outFloat, res[0]);
+				return;
+			}
+
+			//transpose 4 channels x 8 pixels (3 channels are padded)
+			__m256 r3 = (ChannelsCount == 4) ? res[ChannelsCount - 1] : _mm256_setzero_ps();
+
+			__m256 t0 = _mm256_unpacklo_ps(res[0], res[1]);
+			__m256 t1 = _mm256_unpackhi_ps(res[0], res[1]);
+			__m256 t2 = _mm256_unpacklo_ps(res[2], r3);
+			__m256 t3 = _mm256_unpackhi_ps(res[2], r3);
+
+			//pixels [0 | 4], [1 | 5], [2 | 6], [3 | 7]
+			__m256 p04 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+			__m256 p15 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+			__m256 p26 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+			__m256 p37 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+
+			if constexpr (ChannelsCount == 4)
+			{
+				_mm256_storeu_ps(outFloat, _mm256_permute2f128_ps(p04, p15, 0x20));
+				_mm256_storeu_ps(outFloat + 8, _mm256_permute2f128_ps(p26, p37, 0x20));
+				_mm256_storeu_ps(outFloat + 16, _mm256_permute2f128_ps(p04, p15, 0x31));
+				_mm256_storeu_ps(outFloat + 24, _mm256_permute2f128_ps(p26, p37, 0x31));
+			}
+			else
+			{
+				//every store overwrites padding of previous pixel
+				//last pixel is stored without padding
+				_mm_storeu_ps(outFloat, _mm256_castps256_ps128(p04));
+				_mm_storeu_ps(outFloat + 3, _mm256_castps256_ps128(p15));
+				_mm_storeu_ps(outFloat + 6, _mm256_castps256_ps128(p26));
+				_mm_storeu_ps(outFloat + 9, _mm256_castps256_ps128(p37));
+				_mm_storeu_ps(outFloat + 12, _mm256_extractf128_ps(p04, 1));
+				_mm_storeu_ps(outFloat + 15, _mm256_extractf128_ps(p15, 1));
+				_mm_storeu_ps(outFloat + 18, _mm256_extractf128_ps(p26, 1));
+
+				__m128 p7 = _mm256_extractf128_ps(p37, 1);
+				_mm_storel_pi(reinterpret_cast<__m64*>(outFloat + 21), p7);
+				_mm_store_ss(outFloat + 23, _mm_movehl_ps(p7, p7));
+			}
+		}
+	};
+}
+
+#endif
+
+#endif
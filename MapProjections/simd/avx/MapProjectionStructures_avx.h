@@ -4,6 +4,7 @@
 #ifdef ENABLE_SIMD
 
 #include <array>
+#include <limits>
 
 #include <immintrin.h>     //AVX2
 
@@ -96,6 +97,40 @@ namespace Projections::Avx
             }
             return p;
         };
+
+        template <typename PixelType>
+        static RET_VAL_SIMD(PixelType, IsFixedPoint) ToArray(const PixelAvx & pAvx)
+        {
+            std::array<Pixel<PixelType>, 8> p;
+            
+            //scale to fixed point and round in SIMD
+            //NaN and overflow are converted to INT32_MIN
+            const __m256 one = _mm256_set1_ps(static_cast<float>(PixelType::ONE));
+            
+            std::array<int32_t, 8> resX;
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(resX.data()), _mm256_cvtps_epi32(_mm256_mul_ps(pAvx.x, one)));
+            
+            std::array<int32_t, 8> resY;
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(resY.data()), _mm256_cvtps_epi32(_mm256_mul_ps(pAvx.y, one)));
+            
+            using Storage = decltype(PixelType::raw);
+            auto toFixed = [](int32_t v) {
+                if ((v == std::numeric_limits<int32_t>::min()) ||
+                    (v < std::numeric_limits<Storage>::min()) ||
+                    (v > std::numeric_limits<Storage>::max()))
+                {
+                    return PixelType(-1);
+                }
+                return PixelType::FromRaw(static_cast<Storage>(v));
+            };
+            
+            for (size_t i = 0; i < p.size(); i++)
+            {
+                p[i].x = toFixed(resX[i]);
+                p[i].y = toFixed(resY[i]);
+            }
+            return p;
+        };
     };
     
     //=======================================================================================
@@ -0,0 +1,376 @@
+#ifndef NEAREST_NEIGHBOR_SIMD_H
+#define NEAREST_NEIGHBOR_SIMD_H
+
+#ifdef ENABLE_SIMD
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include <immintrin.h>     //AVX2
+
+#include "../../MapProjectionStructures.h"
+
+namespace Projections::Avx
+{
+	/// <summary>
+	/// Store of pixels with PIXEL_BYTES bytes (up to 8), 
+	/// that are stored at the beginning of 32-bit or 64-bit vector lanes
+	/// Exactly 8 * PIXEL_BYTES (Store4) or 4 * PIXEL_BYTES (Store8) bytes are written
+	/// </summary>
+	template <int PIXEL_BYTES>
+	struct PackedPixelStore
+	{
+		/// <summary>
+		/// Store 8 pixels from 32-bit chunks
+		/// </summary>
+		static void Store4(__m256i v, uint8_t* out)
+		{
+			if constexpr (PIXEL_BYTES == 4)
+			{
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), v);
+			}
+			else if constexpr (PIXEL_BYTES == 1)
+			{
+				v = _mm256_shuffle_epi8(v, _mm256_setr_epi8(
+					0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+					0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1));
+				v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 4, 1, 2, 3, 5, 6, 7));
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(v));
+			}
+			else if constexpr (PIXEL_BYTES == 2)
+			{
+				v = _mm256_shuffle_epi8(v, _mm256_setr_epi8(
+					0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1,
+					0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1));
+				v = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(3, 1, 2, 0));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(v));
+			}
+			else
+			{
+				v = _mm256_shuffle_epi8(v, _mm256_setr_epi8(
+					0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+					0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1));
+				Store24(v, out);
+			}
+		}
+
+		/// <summary>
+		/// Store 4 pixels from 64-bit chunks
+		/// </summary>
+		static void Store8(__m256i v, uint8_t* out)
+		{
+			if constexpr (PIXEL_BYTES == 8)
+			{
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), v);
+			}
+			else
+			{
+				v = _mm256_shuffle_epi8(v, _mm256_setr_epi8(
+					0, 1, 2, 3, 4, 5, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1,
+					0, 1, 2, 3, 4, 5, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1));
+				Store24(v, out);
+			}
+		}
+
+		/// <summary>
+		/// Store 12 bytes from the bottom of both 128-bit lanes
+		/// as 24 continuous bytes
+		/// </summary>
+		static void Store24(__m256i v, uint8_t* out)
+		{
+			v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(v));
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(out + 16), _mm256_extracti128_si256(v, 1));
+		}
+	};
+
+	/// <summary>
+	/// Nearest neighbor copy of 8 output pixels at once with AVX2 gathers
+	///
+	/// Supported data are uint8_t, uint16_t and float with 1, 3 or 4 channels.
+	/// Input pixel is loaded as 32-bit or 64-bit chunk starting at pixel address
+	/// (pixels with 12 or 16 bytes as two chunks). Invalid lanes are masked out
+	/// of the gather and get NO_VALUE from the gather source.
+	/// Chunks are then packed with byte shuffles and stored.
+	///
+	/// Chunks can be larger than pixel. Lanes, whose chunk would read
+	/// after the end of input (last input pixels), are copied per pixel.
+	///
+	/// Gather offsets are 32-bit, so input must have less than 2GB
+	/// (see IsInputSupported). Output is same as with
+	/// Projections::Reprojection::CopyNerestNeighbor.
+	/// </summary>
+	template <typename T, typename DataType, size_t ChannelsCount>
+	struct NearestNeighborGather
+	{
+		static const int PIXEL_BYTES = static_cast<int>(sizeof(DataType) * ChannelsCount);
+
+		//size of chunk loaded by one gather lane
+		static const int CHUNK_BYTES = (PIXEL_BYTES <= 4) ? 4 : 8;
+
+		static constexpr bool IsSupported()
+		{
+			return (std::is_same<DataType, uint8_t>::value || std::is_same<DataType, uint16_t>::value ||
+				std::is_same<DataType, float>::value) &&
+				((ChannelsCount == 1) || (ChannelsCount == 3) || (ChannelsCount == 4));
+		}
+
+		static bool IsInputSupported(int inW, int inH)
+		{
+			return static_cast<uint64_t>(inW) * inH * PIXEL_BYTES <= static_cast<uint64_t>(std::numeric_limits<int32_t>::max());
+		}
+
+		NearestNeighborGather(const DataType* inputData, int inW, int inH, const DataType NO_VALUE) :
+			input(reinterpret_cast<const uint8_t*>(inputData)),
+			inW(inW),
+			NO_VALUE(NO_VALUE)
+		{
+			int64_t inputBytes = static_cast<int64_t>(inW) * inH * PIXEL_BYTES;
+
+			//chunks with 12 and 16 bytes pixels are read exactly
+			int64_t maxOffset = (PIXEL_BYTES > 8) ? inputBytes : inputBytes - CHUNK_BYTES;
+			this->maxOffset = static_cast<int32_t>(std::max<int64_t>(maxOffset, -1));
+
+			DataType noValues[16 / sizeof(DataType)];
+			std::fill(noValues, noValues + 16 / sizeof(DataType), NO_VALUE);
+
+			int32_t noValue32;
+			int64_t noValue64;
+			std::memcpy(&noValue32, noValues, sizeof(noValue32));
+			std::memcpy(&noValue64, noValues, sizeof(noValue64));
+
+			this->noValue32 = _mm256_set1_epi32(noValue32);
+			this->noValue64 = _mm256_set1_epi64x(noValue64);
+		}
+
+		/// <summary>
+		/// Copy count pixels to out
+		/// Invalid pixels (-1) are set to NO_VALUE
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="count"></param>
+		/// <param name="out"></param>
+		void CopySegment(const Pixel<T>* pixels, int count, DataType* out) const
+		{
+			int count8 = count - (count % 8);
+
+			for (int i = 0; i < count8; i += 8)
+			{
+				this->Copy8(pixels + i, out + i * ChannelsCount);
+			}
+
+			for (int i = count8; i < count; i++)
+			{
+				this->CopyPixel(pixels[i], out + i * ChannelsCount);
+			}
+		}
+
+	protected:
+		const uint8_t* input;
+		int inW;
+		int32_t maxOffset;
+		const DataType NO_VALUE;
+
+		__m256i noValue32;
+		__m256i noValue64;
+
+		void CopyPixel(const Pixel<T>& p, DataType* out) const
+		{
+			if ((p.x == -1) || (p.y == -1))
+			{
+				for (size_t i = 0; i < ChannelsCount; i++)
+				{
+					out[i] = NO_VALUE;
+				}
+				return;
+			}
+
+			size_t offset = (static_cast<int>(p.x) + static_cast<size_t>(static_cast<int>(p.y)) * inW) * PIXEL_BYTES;
+			std::memcpy(out, this->input + offset, PIXEL_BYTES);
+		}
+
+		/// <summary>
+		/// Load 8 pixels and calculate byte offsets of input pixels
+		/// and mask of valid pixels (all bits set)
+		/// Offsets of invalid pixels are 0
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="offsets"></param>
+		/// <param name="valid"></param>
+		void LoadOffsets(const Pixel<T>* pixels, __m256i& offsets, __m256i& valid) const
+		{
+			__m256i x;
+			__m256i y;
+
+			if constexpr (std::is_same<T, int>::value || std::is_same<T, float>::value)
+			{
+				//x0 y0 x1 y1 x2 y2 x3 y3 | x4 y4 x5 y5 x6 y6 x7 y7
+				__m256 a = _mm256_loadu_ps(reinterpret_cast<const float*>(pixels));
+				__m256 b = _mm256_loadu_ps(reinterpret_cast<const float*>(pixels + 4));
+
+				//x0 x1 x4 x5 | x2 x3 x6 x7 => x0 ... x7
+				__m256 xs = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+				__m256 ys = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+				xs = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(xs), _MM_SHUFFLE(3, 1, 2, 0)));
+				ys = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(ys), _MM_SHUFFLE(3, 1, 2, 0)));
+
+				if constexpr (std::is_same<T, int>::value)
+				{
+					x = _mm256_castps_si256(xs);
+					y = _mm256_castps_si256(ys);
+
+					__m256i minusOne = _mm256_set1_epi32(-1);
+					__m256i invalid = _mm256_or_si256(_mm256_cmpeq_epi32(x, minusOne), _mm256_cmpeq_epi32(y, minusOne));
+					valid = _mm256_xor_si256(invalid, minusOne);
+				}
+				else
+				{
+					__m256 minusOne = _mm256_set1_ps(-1.0f);
+					__m256 invalid = _mm256_or_ps(_mm256_cmp_ps(xs, minusOne, _CMP_EQ_OQ), _mm256_cmp_ps(ys, minusOne, _CMP_EQ_OQ));
+					valid = _mm256_xor_si256(_mm256_castps_si256(invalid), _mm256_set1_epi32(-1));
+
+					//truncation - same as static_cast<int>
+					x = _mm256_cvttps_epi32(xs);
+					y = _mm256_cvttps_epi32(ys);
+				}
+			}
+			else
+			{
+				alignas(32) int32_t xx[8];
+				alignas(32) int32_t yy[8];
+				alignas(32) int32_t vv[8];
+				for (int i = 0; i < 8; i++)
+				{
+					const Pixel<T>& p = pixels[i];
+					vv[i] = ((p.x == -1) || (p.y == -1)) ? 0 : -1;
+					xx[i] = static_cast<int>(p.x);
+					yy[i] = static_cast<int>(p.y);
+				}
+				x = _mm256_load_si256(reinterpret_cast<const __m256i*>(xx));
+				y = _mm256_load_si256(reinterpret_cast<const __m256i*>(yy));
+				valid = _mm256_load_si256(reinterpret_cast<const __m256i*>(vv));
+			}
+
+			__m256i index = _mm256_add_epi32(x, _mm256_mullo_epi32(y, _mm256_set1_epi32(inW)));
+			offsets = _mm256_and_si256(_mm256_mullo_epi32(index, _mm256_set1_epi32(PIXEL_BYTES)), valid);
+		}
+
+		void Copy8(const Pixel<T>* pixels, DataType* out) const
+		{
+			__m256i offsets;
+			__m256i valid;
+			this->LoadOffsets(pixels, offsets, valid);
+
+			//lanes that would read after the end of input
+			__m256i tail = _mm256_and_si256(_mm256_cmpgt_epi32(offsets, _mm256_set1_epi32(this->maxOffset)), valid);
+			__m256i mask = _mm256_andnot_si256(tail, valid);
+
+			uint8_t* outBytes = reinterpret_cast<uint8_t*>(out);
+
+			if constexpr (PIXEL_BYTES <= 4)
+			{
+				__m256i v = _mm256_mask_i32gather_epi32(this->noValue32, reinterpret_cast<const int*>(this->input), offsets, mask, 1);
+				PackedPixelStore<PIXEL_BYTES>::Store4(v, outBytes);
+			}
+			else if constexpr (PIXEL_BYTES <= 8)
+			{
+				__m256i lo = this->Gather64(offsets, mask, 0, 0);
+				__m256i hi = this->Gather64(offsets, mask, 1, 0);
+				PackedPixelStore<PIXEL_BYTES>::Store8(lo, outBytes);
+				PackedPixelStore<PIXEL_BYTES>::Store8(hi, outBytes + 4 * PIXEL_BYTES);
+			}
+			else
+			{
+				this->Store16(offsets, mask, 0, outBytes);
+				this->Store16(offsets, mask, 1, outBytes + 4 * PIXEL_BYTES);
+			}
+
+			if (_mm256_movemask_epi8(tail) != 0)
+			{
+				alignas(32) int32_t tailLanes[8];
+				_mm256_store_si256(reinterpret_cast<__m256i*>(tailLanes), tail);
+				for (int i = 0; i < 8; i++)
+				{
+					if (tailLanes[i] != 0)
+					{
+						this->CopyPixel(pixels[i], out + i * ChannelsCount);
+					}
+				}
+			}
+		}
+
+		/// <summary>
+		/// Gather 64-bit chunks at offsets + add of 4 pixels
+		/// from half (0 - pixels 0-3, 1 - pixels 4-7)
+		/// </summary>
+		__m256i Gather64(__m256i offsets, __m256i mask, int half, int add) const
+		{
+			__m128i off = (half == 0) ? _mm256_castsi256_si128(offsets) : _mm256_extracti128_si256(offsets, 1);
+			__m128i m = (half == 0) ? _mm256_castsi256_si128(mask) : _mm256_extracti128_si256(mask, 1);
+
+			off = _mm_add_epi32(off, _mm_set1_epi32(add));
+
+			return _mm256_mask_i32gather_epi64(this->noValue64, reinterpret_cast<const long long*>(this->input),
+				off, _mm256_cvtepi32_epi64(m), 1);
+		}
+
+		/// <summary>
+		/// Gather and store 4 pixels with 12 or 16 bytes
+		/// from half (0 - pixels 0-3, 1 - pixels 4-7)
+		/// </summary>
+		void Store16(__m256i offsets, __m256i mask, int half, uint8_t* out) const
+		{
+			__m256i lo = this->Gather64(offsets, mask, half, 0);
+			__m256i hi;
+
+			if constexpr (PIXEL_BYTES == 16)
+			{
+				hi = this->Gather64(offsets, mask, half, 8);
+			}
+			else
+			{
+				//last 4 bytes of pixel - gathered exactly as 32-bit
+				__m128i off = (half == 0) ? _mm256_castsi256_si128(offsets) : _mm256_extracti128_si256(offsets, 1);
+				__m128i m = (half == 0) ? _mm256_castsi256_si128(mask) : _mm256_extracti128_si256(mask, 1);
+				off = _mm_add_epi32(off, _mm_set1_epi32(8));
+
+				__m128i h = _mm_mask_i32gather_epi32(_mm256_castsi256_si128(this->noValue32),
+					reinterpret_cast<const int*>(this->input), off, m, 1);
+				hi = _mm256_cvtepu32_epi64(h);
+			}
+
+			//[p0 | p2] and [p1 | p3]
+			__m256i p02 = _mm256_unpacklo_epi64(lo, hi);
+			__m256i p13 = _mm256_unpackhi_epi64(lo, hi);
+
+			__m256i p01 = _mm256_permute2x128_si256(p02, p13, 0x20);
+			__m256i p23 = _mm256_permute2x128_si256(p02, p13, 0x31);
+
+			if constexpr (PIXEL_BYTES == 16)
+			{
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), p01);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32), p23);
+			}
+			else
+			{
+				Store12(_mm256_castsi256_si128(p01), out);
+				Store12(_mm256_extracti128_si256(p01, 1), out + 12);
+				Store12(_mm256_castsi256_si128(p23), out + 24);
+				Store12(_mm256_extracti128_si256(p23, 1), out + 36);
+			}
+		}
+
+		static void Store12(__m128i v, uint8_t* out)
+		{
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(out), v);
+			int32_t last = _mm_extract_epi32(v, 2);
+			std::memcpy(out + 8, &last, sizeof(last));
+		}
+	};
+}
+
+#endif
+
+#endif
@@ -3,6 +3,7 @@
 
 #ifdef ENABLE_SIMD
 
+#include <limits>
 #include <immintrin.h>     //AVX2
 
 #include "../avx_math_float.h"
@@ -103,9 +104,77 @@ namespace Projections::Avx
 
 		ProjectedValueInverseAvx ProjectInverseInternal(const __m256 & x, const __m256 & y) const
 		{
+			//1.006739501 = RADIUS_EQUATOR^2 / RADIUS_POLAR^2
+			//1737122264 = (SAT_DIST^2 - RADIUS_EQUATOR^2)
+			const double SD_CONST = 1737122264.0;
+			const double SAT_DIST2 = static_cast<double>(SAT_DIST) * static_cast<double>(SAT_DIST);
+
+			__m256 scanX = _mm256_sub_ps(x, _mm256_set1_ps(static_cast<float>(sat.coff)));
+			scanX = _mm256_mul_ps(scanX, _mm256_set1_ps(static_cast<float>(1.0 / (TWO_POW_MINUS_16 * sat.cfac))));
+			scanX = ProjectionUtils::degToRad(scanX);
+
+			__m256 scanY = _mm256_sub_ps(y, _mm256_set1_ps(static_cast<float>(sat.loff)));
+			scanY = _mm256_mul_ps(scanY, _mm256_set1_ps(static_cast<float>(1.0 / (TWO_POW_MINUS_16 * sat.lfac))));
+			scanY = ProjectionUtils::degToRad(scanY);
+
+			__m256 sinX;
+			__m256 cosX;
+			_my_mm256_sincos_ps(scanX, &sinX, &cosX);
+
+			__m256 sinY;
+			__m256 cosY;
+			_my_mm256_sincos_ps(scanY, &sinY, &cosY);
+
+			__m256 sin2Y = _mm256_mul_ps(sinY, sinY);
+			__m256 cosXcosY = _mm256_mul_ps(cosX, cosY);
+
+			__m256 tmp = _mm256_mul_ps(_mm256_set1_ps(static_cast<float>(SAT_DIST)), cosXcosY);
+
+			//cos2Y + 1.006739501 * sin2Y
+			__m256 tmp2 = _mm256_fmadd_ps(sin2Y, _mm256_set1_ps(0.006739501f), _mm256_set1_ps(1.0f));
+
+			//tmp * tmp - tmp2 * 1737122264 has large cancellation in float
+			//it is rewritten with 1 - cos2X * cos2Y = sin2X + cos2X * sin2Y to
+			//(SAT_DIST^2 - 1737122264) - SAT_DIST^2 * (sin2X + cos2X * sin2Y) - 1737122264 * 0.006739501 * sin2Y
+			__m256 angle = _mm256_fmadd_ps(_mm256_mul_ps(cosX, cosX), sin2Y, _mm256_mul_ps(sinX, sinX));
+			__m256 sd2 = _mm256_fnmadd_ps(angle, _mm256_set1_ps(static_cast<float>(SAT_DIST2)), 
+				_mm256_set1_ps(static_cast<float>(SAT_DIST2 - SD_CONST)));
+			sd2 = _mm256_fnmadd_ps(sin2Y, _mm256_set1_ps(static_cast<float>(SD_CONST * 0.006739501)), sd2);
+
+			//outside of the Earth disk, ray from satellite does not hit the Earth
+			__m256 outside = _mm256_cmp_ps(sd2, _mm256_setzero_ps(), _CMP_LT_OQ);
+
+			__m256 sd = _mm256_sqrt_ps(_mm256_max_ps(sd2, _mm256_setzero_ps()));
+			__m256 sn = _mm256_div_ps(_mm256_sub_ps(tmp, sd), tmp2);
+
+			__m256 s1 = _mm256_fnmadd_ps(sn, cosXcosY, _mm256_set1_ps(static_cast<float>(SAT_DIST)));
+			__m256 s2;
+			__m256 s3;
+			if (sat.sweepY)
+			{
+				s2 = _mm256_mul_ps(_mm256_mul_ps(sn, sinX), cosY);
+				s3 = _my_mm256_swap_sign(_mm256_mul_ps(sn, sinY));
+			}
+			else
+			{
+				s2 = _mm256_mul_ps(sn, sinX);
+				s3 = _my_mm256_swap_sign(_mm256_mul_ps(_mm256_mul_ps(sn, sinY), cosX));
+			}
+
+			__m256 sxy = _mm256_sqrt_ps(_mm256_fmadd_ps(s1, s1, _mm256_mul_ps(s2, s2)));
+
 			ProjectedValueInverseAvx c;
-			
-			//todo
+			c.latRad = _mm256_div_ps(_mm256_mul_ps(_mm256_set1_ps(1.006739501f), s3), sxy);
+			c.latRad = _my_mm256_atan_ps(c.latRad);
+
+			c.lonRad = _my_mm256_atan_ps(_mm256_div_ps(s2, s1));
+			c.lonRad = _mm256_add_ps(c.lonRad, _mm256_set1_ps(static_cast<float>(sat.lon.rad())));
+
+			//same as sqrt of negative value in single instruction version
+			//NaN is not projected inside of input and pixel stays -1
+			__m256 nan = _mm256_set1_ps(std::numeric_limits<float>::quiet_NaN());
+			c.latRad = _my_mm256_select(outside, nan, c.latRad);
+			c.lonRad = _my_mm256_select(outside, nan, c.lonRad);
 
 			return c;
 		};
@@ -0,0 +1,101 @@
+#ifndef LAMBERT_AZIMUTHAL_SIMD_H
+#define LAMBERT_AZIMUTHAL_SIMD_H
+
+#ifdef ENABLE_SIMD
+
+#include <immintrin.h>     //AVX2
+
+#include "../avx_math_float.h"
+
+#include "../../../GeoCoordinate.h"
+#include "../../../MapProjectionStructures.h"
+
+#include "../ProjectionInfo_avx.h"
+
+#include "../../../Projections/LambertAzimuthal.h"
+
+namespace Projections::Avx
+{
+
+	class LambertAzimuthal : public Projections::LambertAzimuthal, public ProjectionInfoAvx<LambertAzimuthal>
+	{
+	public:
+		using Projections::LambertAzimuthal::LambertAzimuthal;
+
+		using Projections::LambertAzimuthal::ProjectInverse;
+		using ProjectionInfoAvx<LambertAzimuthal>::ProjectInverse;
+
+		using Projections::LambertAzimuthal::Project;
+		using ProjectionInfoAvx<LambertAzimuthal>::Project;
+
+
+		friend class ProjectionInfoAvx<LambertAzimuthal>;
+
+	protected:
+		ProjectedValueAvx ProjectInternal(const __m256& lonRad, const __m256& latRad) const
+		{
+			__m256 sinSP = _mm256_set1_ps(static_cast<float>(sinStanParallel));
+			__m256 cosSP = _mm256_set1_ps(static_cast<float>(cosStanParallel));
+
+			__m256 lonDif = _mm256_sub_ps(lonRad, _mm256_set1_ps(static_cast<float>(centralLon.rad())));
+
+			__m256 sinLat;
+			__m256 cosLat;
+			_my_mm256_sincos_ps(latRad, &sinLat, &cosLat);
+
+			__m256 sinLonDif;
+			__m256 cosLonDif;
+			_my_mm256_sincos_ps(lonDif, &sinLonDif, &cosLonDif);
+
+			__m256 tmp0 = _mm256_mul_ps(sinSP, sinLat);
+			__m256 tmp1 = _mm256_mul_ps(_mm256_mul_ps(cosSP, cosLat), cosLonDif);
+
+			//k = sqrt(2 / (1 + tmp0 + tmp1))
+			__m256 k = _mm256_add_ps(_mm256_set1_ps(1.0f), _mm256_add_ps(tmp0, tmp1));
+			k = _mm256_sqrt_ps(_mm256_div_ps(_mm256_set1_ps(2.0f), k));
+
+			__m256 cosLatCosLonDif = _mm256_mul_ps(cosLat, cosLonDif);
+
+			ProjectedValueAvx p;
+			p.x = _mm256_mul_ps(_mm256_mul_ps(k, cosLat), sinLonDif);
+			p.y = _mm256_fmsub_ps(cosSP, sinLat, _mm256_mul_ps(sinSP, cosLatCosLonDif));
+			p.y = _mm256_mul_ps(k, p.y);
+
+			return p;
+		};
+
+		ProjectedValueInverseAvx ProjectInverseInternal(const __m256& x, const __m256& y) const
+		{
+			__m256 sinSP = _mm256_set1_ps(static_cast<float>(sinStanParallel));
+			__m256 cosSP = _mm256_set1_ps(static_cast<float>(cosStanParallel));
+
+			__m256 ro = _mm256_sqrt_ps(_mm256_fmadd_ps(x, x, _mm256_mul_ps(y, y)));
+
+			__m256 c = _my_mm256_asin_ps(_mm256_mul_ps(ro, _mm256_set1_ps(0.5f)));
+			c = _mm256_add_ps(c, c);
+
+			__m256 sinC;
+			__m256 cosC;
+			_my_mm256_sincos_ps(c, &sinC, &cosC);
+
+			__m256 ySinC = _mm256_mul_ps(y, sinC);
+
+			__m256 tmp = _mm256_div_ps(_mm256_mul_ps(ySinC, cosSP), ro);
+			tmp = _mm256_fmadd_ps(cosC, sinSP, tmp);
+
+			__m256 numerator = _mm256_mul_ps(x, sinC);
+			__m256 denominator = _mm256_fmsub_ps(_mm256_mul_ps(ro, cosSP), cosC, _mm256_mul_ps(ySinC, sinSP));
+
+			ProjectedValueInverseAvx res;
+			res.latRad = _my_mm256_asin_ps(tmp);
+			res.lonRad = _my_mm256_atan_ps(_mm256_div_ps(numerator, denominator));
+			res.lonRad = _mm256_add_ps(res.lonRad, _mm256_set1_ps(static_cast<float>(centralLon.rad())));
+
+			return res;
+		};
+
+	};
+}
+
+#endif //ENABLE_SIMD
+#endif
@@ -0,0 +1,92 @@
+#ifndef LAMBERT_CONIC_SIMD_H
+#define LAMBERT_CONIC_SIMD_H
+
+#ifdef ENABLE_SIMD
+
+#include <immintrin.h>     //AVX2
+
+#include "../avx_math_float.h"
+
+#include "../../../GeoCoordinate.h"
+#include "../../../MapProjectionStructures.h"
+
+#include "../ProjectionInfo_avx.h"
+
+#include "../../../Projections/LambertConic.h"
+
+namespace Projections::Avx
+{
+
+	class LambertConic : public Projections::LambertConic, public ProjectionInfoAvx<LambertConic>
+	{
+	public:
+		using Projections::LambertConic::LambertConic;
+
+		using Projections::LambertConic::ProjectInverse;
+		using ProjectionInfoAvx<LambertConic>::ProjectInverse;
+
+		using Projections::LambertConic::Project;
+		using ProjectionInfoAvx<LambertConic>::Project;
+
+
+		friend class ProjectionInfoAvx<LambertConic>;
+
+	protected:
+		ProjectedValueAvx ProjectInternal(const __m256& lonRad, const __m256& latRad) const
+		{
+			__m256 nAvx = _mm256_set1_ps(static_cast<float>(n));
+
+			__m256 lonDif = _mm256_sub_ps(lonRad, _mm256_set1_ps(static_cast<float>(lonCentralMeridian.rad())));
+
+			//cot(PI_4 + 0.5 * lat)
+			__m256 angle = _mm256_fmadd_ps(latRad, _mm256_set1_ps(0.5f), _mm256_set1_ps(static_cast<float>(ProjectionConstants::PI_4)));
+			__m256 sinAngle;
+			__m256 cosAngle;
+			_my_mm256_sincos_ps(angle, &sinAngle, &cosAngle);
+			__m256 t = _mm256_div_ps(cosAngle, sinAngle);
+
+			__m256 phi = _mm256_mul_ps(_mm256_set1_ps(static_cast<float>(f)), _my_mm256_pow_ps(t, nAvx));
+
+			__m256 sinLon;
+			__m256 cosLon;
+			_my_mm256_sincos_ps(_mm256_mul_ps(nAvx, lonDif), &sinLon, &cosLon);
+
+			ProjectedValueAvx p;
+			p.x = _mm256_mul_ps(phi, sinLon);
+			p.y = _mm256_fnmadd_ps(phi, cosLon, _mm256_set1_ps(static_cast<float>(phi0)));
+
+			//Real x = phi * std::sin(n * lonDif);
+			//Real y = phi0 - phi * std::cos(n * lonDif);
+			return p;
+		};
+
+		ProjectedValueInverseAvx ProjectInverseInternal(const __m256& x, const __m256& y) const
+		{
+			__m256 dy = _mm256_sub_ps(_mm256_set1_ps(static_cast<float>(phi0)), y);
+
+			__m256 phi = _mm256_sqrt_ps(_mm256_fmadd_ps(x, x, _mm256_mul_ps(dy, dy)));
+			phi = _mm256_mul_ps(phi, _mm256_set1_ps(static_cast<float>(Projections::ProjectionUtils::sgn(n))));
+
+			__m256 delta = _my_mm256_atan_ps(_mm256_div_ps(x, dy));
+
+			__m256 t = _mm256_div_ps(_mm256_set1_ps(static_cast<float>(f)), phi);
+			t = _my_mm256_pow_ps(t, _mm256_set1_ps(static_cast<float>(1.0 / n)));
+
+			ProjectedValueInverseAvx c;
+			c.latRad = _my_mm256_atan_ps(t);
+			c.latRad = _mm256_add_ps(c.latRad, c.latRad);
+			c.latRad = _mm256_sub_ps(c.latRad, _mm256_set1_ps(static_cast<float>(ProjectionConstants::PI_2)));
+
+			c.lonRad = _mm256_div_ps(delta, _mm256_set1_ps(static_cast<float>(n)));
+			c.lonRad = _mm256_add_ps(c.lonRad, _mm256_set1_ps(static_cast<float>(lonCentralMeridian.rad())));
+
+			//Real lat = 2.0 * std::atan(t) - PI_2;
+			//Real lon = lonCentralMeridian.rad() + delta / n;
+			return c;
+		};
+
+	};
+}
+
+#endif //ENABLE_SIMD
+#endif
@@ -0,0 +1,81 @@
+#ifndef POLAR_STEREOGRAPHIC_SIMD_H
+#define POLAR_STEREOGRAPHIC_SIMD_H
+
+#ifdef ENABLE_SIMD
+
+#include <cmath>
+#include <immintrin.h>     //AVX2
+
+#include "../avx_math_float.h"
+
+#include "../../../GeoCoordinate.h"
+#include "../../../MapProjectionStructures.h"
+
+#include "../ProjectionInfo_avx.h"
+
+#include "../../../Projections/PolarSteregographic.h"
+
+namespace Projections::Avx
+{
+
+	class PolarSteregographic : public Projections::PolarSteregographic, public ProjectionInfoAvx<PolarSteregographic>
+	{
+	public:
+		using Projections::PolarSteregographic::PolarSteregographic;
+
+		using Projections::PolarSteregographic::ProjectInverse;
+		using ProjectionInfoAvx<PolarSteregographic>::ProjectInverse;
+
+		using Projections::PolarSteregographic::Project;
+		using ProjectionInfoAvx<PolarSteregographic>::Project;
+
+
+		friend class ProjectionInfoAvx<PolarSteregographic>;
+
+	protected:
+		ProjectedValueAvx ProjectInternal(const __m256& lonRad, const __m256& latRad) const
+		{
+			__m256 lonDif = _mm256_sub_ps(lonRad, _mm256_set1_ps(static_cast<float>(lonCentralMeridian.rad())));
+
+			__m256 sinLat;
+			__m256 cosLat;
+			_my_mm256_sincos_ps(latRad, &sinLat, &cosLat);
+
+			__m256 sinLonDif;
+			__m256 cosLonDif;
+			_my_mm256_sincos_ps(lonDif, &sinLonDif, &cosLonDif);
+
+			//EARTH_RADIUS * m * cosLat, m = (1 + sin(latCentral)) / (1 + sin(lat))
+			float mNum = static_cast<float>(ProjectionConstants::EARTH_RADIUS * (1.0 + std::sin(latCentral.rad())));
+			__m256 r = _mm256_div_ps(_mm256_set1_ps(mNum), _mm256_add_ps(_mm256_set1_ps(1.0f), sinLat));
+			r = _mm256_mul_ps(r, cosLat);
+
+			ProjectedValueAvx p;
+			p.x = _mm256_mul_ps(r, sinLonDif);
+			p.y = _my_mm256_swap_sign(_mm256_mul_ps(r, cosLonDif));
+
+			return p;
+		};
+
+		ProjectedValueInverseAvx ProjectInverseInternal(const __m256& x, const __m256& y) const
+		{
+			double tmpSin = 1.0 + std::sin(latCentral.rad());
+			__m256 tmp = _mm256_set1_ps(static_cast<float>(ProjectionConstants::EARTH_RADIUS * ProjectionConstants::EARTH_RADIUS * tmpSin * tmpSin));
+
+			__m256 dist2 = _mm256_fmadd_ps(x, x, _mm256_mul_ps(y, y));
+			__m256 tmp1 = _mm256_sub_ps(tmp, dist2);
+			__m256 tmp2 = _mm256_add_ps(tmp, dist2);
+
+			ProjectedValueInverseAvx c;
+			c.latRad = _my_mm256_asin_ps(_mm256_div_ps(tmp1, tmp2));
+			c.lonRad = _my_mm256_atan_ps(_mm256_div_ps(_my_mm256_swap_sign(x), y));
+			c.lonRad = _mm256_add_ps(c.lonRad, _mm256_set1_ps(static_cast<float>(lonCentralMeridian.rad())));
+
+			return c;
+		};
+
+	};
+}
+
+#endif //ENABLE_SIMD
+#endif
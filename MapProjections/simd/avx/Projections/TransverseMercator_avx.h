@@ -0,0 +1,89 @@
+#ifndef TRANSVERSE_MERCATOR_SIMD_H
+#define TRANSVERSE_MERCATOR_SIMD_H
+
+#ifdef ENABLE_SIMD
+
+#include <immintrin.h>     //AVX2
+
+#include "../avx_math_float.h"
+
+#include "../../../GeoCoordinate.h"
+#include "../../../MapProjectionStructures.h"
+
+#include "../ProjectionInfo_avx.h"
+
+#include "../../../Projections/TransverseMercator.h"
+
+namespace Projections::Avx
+{
+
+	class TransverseMercator : public Projections::TransverseMercator, public ProjectionInfoAvx<TransverseMercator>
+	{
+	public:
+		using Projections::TransverseMercator::TransverseMercator;
+
+		using Projections::TransverseMercator::ProjectInverse;
+		using ProjectionInfoAvx<TransverseMercator>::ProjectInverse;
+
+		using Projections::TransverseMercator::Project;
+		using ProjectionInfoAvx<TransverseMercator>::Project;
+
+
+		friend class ProjectionInfoAvx<TransverseMercator>;
+
+	protected:
+		ProjectedValueAvx ProjectInternal(const __m256& lonRad, const __m256& latRad) const
+		{
+			__m256 radius = _mm256_set1_ps(static_cast<float>(RADIUS_EQUATOR));
+			__m256 one = _mm256_set1_ps(1.0f);
+
+			__m256 dLon = _mm256_sub_ps(lonRad, _mm256_set1_ps(static_cast<float>(centralLon.rad())));
+
+			__m256 sinLat;
+			__m256 cosLat;
+			_my_mm256_sincos_ps(latRad, &sinLat, &cosLat);
+
+			__m256 sinLon;
+			__m256 cosLon;
+			_my_mm256_sincos_ps(dLon, &sinLon, &cosLon);
+
+			__m256 tmp = _mm256_mul_ps(sinLon, cosLat);
+			__m256 ratio = _mm256_div_ps(_mm256_add_ps(one, tmp), _mm256_sub_ps(one, tmp));
+
+			//sec(dLon) * tan(lat)
+			__m256 t = _mm256_div_ps(sinLat, _mm256_mul_ps(cosLon, cosLat));
+
+			ProjectedValueAvx p;
+			p.x = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), radius), _my_mm256_log_ps(ratio));
+			p.y = _mm256_sub_ps(_my_mm256_atan_ps(t), _mm256_set1_ps(static_cast<float>(centralLat.rad())));
+			p.y = _mm256_mul_ps(radius, p.y);
+
+			return p;
+		};
+
+		ProjectedValueInverseAvx ProjectInverseInternal(const __m256& x, const __m256& y) const
+		{
+			__m256 invRadius = _mm256_set1_ps(static_cast<float>(1.0 / RADIUS_EQUATOR));
+
+			__m256 D = _mm256_mul_ps(x, invRadius);
+			__m256 E = _mm256_fmadd_ps(y, invRadius, _mm256_set1_ps(static_cast<float>(centralLat.rad())));
+
+			__m256 sinE;
+			__m256 cosE;
+			_my_mm256_sincos_ps(E, &sinE, &cosE);
+
+			ProjectedValueInverseAvx c;
+			c.latRad = _my_mm256_asin_ps(_mm256_div_ps(sinE, _my_mm256_cosh_ps(D)));
+			c.lonRad = _my_mm256_atan2_ps(_my_mm256_sinh_ps(D), cosE);
+			c.lonRad = _mm256_add_ps(c.lonRad, _mm256_set1_ps(static_cast<float>(centralLon.rad())));
+
+			//lat = std::asin(std::sin(E) / std::cosh(D));
+			//lon = centralLon.rad() + std::atan2(std::sinh(D), std::cos(E));
+			return c;
+		};
+
+	};
+}
+
+#endif //ENABLE_SIMD
+#endif
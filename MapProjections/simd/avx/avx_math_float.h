@@ -42,7 +42,7 @@ static inline __m256 _my_mm256_select_if(const __m256 & v1, const __m256 & v2,
                                const __m256 & a, const __m256 & b)
 {
     __m256 mask = _mm256_cmp_ps(v1, v2, COMPARISON_OPERATOR);
-    return select(mask, a, b);
+    return _my_mm256_select(mask, a, b);
 }
                                                     
 static inline __m256 _my_mm256_swap_sign(const __m256 & v)
@@ -351,6 +351,34 @@ static __m256 _my_mm256_atan_ps(__m256 x)
     return _my_mm256_select(signBit, _my_mm256_swap_sign(y), y);
 }
 
+///<summary>
+/// Calculate atan2(y, x) - angle in [-PI, PI]
+/// atan2(0, 0) is 0
+///</summary>
+static __m256 _my_mm256_atan2_ps(__m256 y, __m256 x)
+{
+    const __m256 PIF = _mm256_set1_ps(3.14159265358979323846f);
+    const __m256 PIO2F = _mm256_set1_ps(1.5707963267948966192f);
+    
+    __m256 zero = _mm256_setzero_ps();
+    
+    __m256 xZero = _mm256_cmp_ps(x, zero, _CMP_EQ_OQ);
+    __m256 xNeg = _mm256_cmp_ps(x, zero, _CMP_LT_OS);
+    __m256 yNeg = _mm256_cmp_ps(y, zero, _CMP_LT_OS);
+    __m256 yZero = _mm256_cmp_ps(y, zero, _CMP_EQ_OQ);
+    
+    __m256 a = _my_mm256_atan_ps(_mm256_div_ps(y, x));
+    
+    //x < 0 => +PI for y >= 0, -PI for y < 0
+    __m256 offset = _my_mm256_select(yNeg, _my_mm256_swap_sign(PIF), PIF);
+    a = _my_mm256_select(xNeg, _mm256_add_ps(a, offset), a);
+    
+    //x == 0 => +-PI/2 by sign of y, 0 if y == 0
+    __m256 axis = _my_mm256_select(yNeg, _my_mm256_swap_sign(PIO2F), PIO2F);
+    axis = _my_mm256_select(yZero, zero, axis);
+    return _my_mm256_select(xZero, axis, a);
+}
+
                                        
 //=============================================================================
                                        
@@ -569,6 +597,43 @@ static __m256 _my_mm256_pow_ps(const __m256 & x, const __m256 & y)
     return _my_mm256_exp_ps(_mm256_mul_ps(y, tmp));
 }
 
+///<summary>
+/// Calculate sinh(x)
+/// For |x| <= 1 polynomial is used (exp(x) - exp(-x) loses precision)
+///</summary>
+static __m256 _my_mm256_sinh_ps(__m256 x)
+{
+    const __m256 c_05 = _mm256_set1_ps(0.5f);
+    const __m256 c_1 = _mm256_set1_ps(1.0f);
+    
+    __m256 ax = _my_mm256_abs_ps(x);
+    __m256 small = _mm256_cmp_ps(ax, c_1, _CMP_LE_OQ);
+    
+    //sinhf from Cephes
+    __m256 z = _mm256_mul_ps(x, x);
+    __m256 pz = _mm256_fmadd_ps(z, _mm256_set1_ps(2.03721912945E-4f), _mm256_set1_ps(8.33028376239E-3f));
+    pz = _mm256_fmadd_ps(pz, z, _mm256_set1_ps(1.66667160211E-1f));
+    pz = _mm256_mul_ps(pz, z);
+    __m256 ySmall = _mm256_fmadd_ps(pz, x, x);
+    
+    __m256 e = _my_mm256_exp_ps(x);
+    __m256 yBig = _mm256_mul_ps(c_05, _mm256_sub_ps(e, _mm256_div_ps(c_1, e)));
+    
+    return _my_mm256_select(small, ySmall, yBig);
+}
+
+///<summary>
+/// Calculate cosh(x)
+///</summary>
+static __m256 _my_mm256_cosh_ps(__m256 x)
+{
+    const __m256 c_05 = _mm256_set1_ps(0.5f);
+    const __m256 c_1 = _mm256_set1_ps(1.0f);
+    
+    __m256 e = _my_mm256_exp_ps(x);
+    return _mm256_mul_ps(c_05, _mm256_add_ps(e, _mm256_div_ps(c_1, e)));
+}
+
 #endif //ENABLE_SIMD
 
 #endif
\ No newline at end of file
@@ -0,0 +1,629 @@
+#ifndef INTERPOLATION_NEON_H
+#define INTERPOLATION_NEON_H
+
+#include "./neon_utils.h"
+
+#ifdef HAVE_NEON
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "../../MapProjectionStructures.h"
+#include "../../FixedPoint.h"
+
+#include "./NearestNeighbor_neon.h"
+
+namespace Projections::Neon
+{
+	/// <summary>
+	/// Bilinear and bicubic (B-spline) interpolation of LANES output pixels at once
+	/// (8 for uint8_t, 4 otherwise). Every lane computes one output pixel.
+	///
+	/// Supported data are uint8_t, uint16_t and float with 1, 3 or 4 channels.
+	/// Computation is same as in Avx::InterpolationGather:
+	/// float data and uint16_t data with real positions are computed in float (see FLOAT_MATH), 
+	/// other integral data in fixed point with positions rounded to Fixed24_8 
+	/// (result is same as with InterpolateBilinearFixed / InterpolateBicubicFixed).
+	/// Maximal difference from double version for real positions is MAX_DIFFERENCE.
+	///
+	/// NEON has no gather - taps are loaded to lanes from indices
+	/// calculated with vector instructions. Channels are interleaved by vst3 / vst4.
+	/// </summary>
+	template <typename T, typename DataType, size_t ChannelsCount>
+	struct InterpolationGather
+	{
+		using Fixed = Fixed24_8;
+
+		static const bool INTEGRAL = std::is_integral<DataType>::value;
+
+		//float data and uint16_t data with real positions are interpolated in float
+		//(see Avx::InterpolationGather)
+		static const bool FLOAT_MATH = !INTEGRAL || ((sizeof(DataType) == 2) && std::is_floating_point<T>::value);
+
+		//maximal difference of bilinear and bicubic from double version for real positions
+		//(see Avx::InterpolationGather)
+		static constexpr double MAX_DIFFERENCE = (sizeof(DataType) == 1) ? 2.0 : (INTEGRAL) ? 1.0 : 1e-6;
+
+		static constexpr bool IsSupported()
+		{
+			return (std::is_same<DataType, uint8_t>::value || std::is_same<DataType, uint16_t>::value ||
+				std::is_same<DataType, float>::value) &&
+				((ChannelsCount == 1) || (ChannelsCount == 3) || (ChannelsCount == 4));
+		}
+
+		static bool IsInputSupported(int inW, int inH)
+		{
+			return (inW >= 2) && (inH >= 2) &&
+				(static_cast<uint64_t>(inW) * inH * ChannelsCount <= static_cast<uint64_t>(std::numeric_limits<int32_t>::max()));
+		}
+
+		InterpolationGather(const DataType* inputData, int inW, int inH, const DataType NO_VALUE) :
+			input(inputData),
+			inW(inW),
+			inH(inH),
+			NO_VALUE(NO_VALUE)
+		{
+		}
+
+		/// <summary>
+		/// Bilinear interpolation of count pixels to out
+		/// Invalid pixels (-1) are set to NO_VALUE
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="count"></param>
+		/// <param name="out"></param>
+		void BilinearSegment(const Pixel<T>* pixels, int count, DataType* out) const
+		{
+			this->ProcessSegment(pixels, count, out, [this](const Pixel<T>* p, Value* res) {
+				return this->Bilinear4(p, res);
+			});
+		}
+
+		/// <summary>
+		/// Bicubic interpolation of count pixels to out
+		/// Invalid pixels (-1) are set to NO_VALUE
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="count"></param>
+		/// <param name="out"></param>
+		void BicubicSegment(const Pixel<T>* pixels, int count, DataType* out) const
+		{
+			this->ProcessSegment(pixels, count, out, [this](const Pixel<T>* p, Value* res) {
+				return this->Bicubic4(p, res);
+			});
+		}
+
+	protected:
+		using Lanes = NearestNeighborLanes<DataType>;
+
+		static const int LANES = Lanes::LANES;
+
+		//interpolated values of 4 pixels
+		using Value = typename std::conditional<INTEGRAL, uint32x4_t, float32x4_t>::type;
+
+		/// <summary>
+		/// Positions of 4 pixels
+		/// Invalid pixels have x, y = 0
+		/// </summary>
+		struct Positions
+		{
+			//integer part
+			int32_t x[4];
+			int32_t y[4];
+
+			//fractions in [0, Fixed::ONE) - integral data
+			int32x4_t fx;
+			int32x4_t fy;
+
+			//fractions in [0, 1) - float data
+			float32x4_t tx;
+			float32x4_t ty;
+
+			uint32x4_t valid;
+		};
+
+		const DataType* input;
+		int inW;
+		int inH;
+		const DataType NO_VALUE;
+
+		/// <summary>
+		/// Interpolate segment by LANES pixels
+		/// kernel4(pixels, res) computes 4 pixels (res[channel]) and returns mask of valid pixels
+		/// Rest is padded with invalid pixels
+		/// </summary>
+		template <typename Kernel4>
+		void ProcessSegment(const Pixel<T>* pixels, int count, DataType* out, Kernel4 kernel4) const
+		{
+			int countLanes = count - (count % LANES);
+
+			for (int i = 0; i < countLanes; i += LANES)
+			{
+				this->ProcessLanes(pixels + i, out + i * ChannelsCount, kernel4);
+			}
+
+			if (countLanes == count)
+			{
+				return;
+			}
+
+			Pixel<T> rest[LANES];
+			DataType restOut[LANES * ChannelsCount];
+
+			for (int i = 0; i < LANES; i++)
+			{
+				rest[i] = (countLanes + i < count) ? pixels[countLanes + i] : Pixel<T>{ T(-1), T(-1) };
+			}
+
+			this->ProcessLanes(rest, restOut, kernel4);
+
+			std::memcpy(out + countLanes * ChannelsCount, restOut, (count - countLanes) * ChannelsCount * sizeof(DataType));
+		}
+
+		template <typename Kernel4>
+		void ProcessLanes(const Pixel<T>* pixels, DataType* out, Kernel4 kernel4) const
+		{
+			const int GROUPS = LANES / 4;
+
+			//res[channel][group]
+			Value res[ChannelsCount][GROUPS];
+			uint32x4_t valid[GROUPS];
+
+			for (int g = 0; g < GROUPS; g++)
+			{
+				Value groupRes[ChannelsCount];
+				valid[g] = kernel4(pixels + 4 * g, groupRes);
+
+				for (size_t c = 0; c < ChannelsCount; c++)
+				{
+					res[c][g] = groupRes[c];
+				}
+			}
+
+			typename Lanes::Mask mask = Lanes::CreateMask(valid);
+			typename Lanes::Vec noValue = Lanes::Dup(NO_VALUE);
+
+			if constexpr (ChannelsCount == 1)
+			{
+				Lanes::Store1(out, Lanes::Select(mask, Lanes::Narrow(res[0]), noValue));
+			}
+			else if constexpr (ChannelsCount == 3)
+			{
+				typename Lanes::Vec3 v;
+				for (int c = 0; c < 3; c++)
+				{
+					v.val[c] = Lanes::Select(mask, Lanes::Narrow(res[c]), noValue);
+				}
+				Lanes::Store3(out, v);
+			}
+			else
+			{
+				typename Lanes::Vec4 v;
+				for (int c = 0; c < 4; c++)
+				{
+					v.val[c] = Lanes::Select(mask, Lanes::Narrow(res[c]), noValue);
+				}
+				Lanes::Store4(out, v);
+			}
+		}
+
+		/// <summary>
+		/// Convert non-negative v to Fixed - integer part and fraction
+		/// Rounding is same as Fixed(float) - half away from zero
+		/// </summary>
+		static void ToFixed(float32x4_t v, int32x4_t& intPart, int32x4_t& fraction)
+		{
+			float32x4_t s = vmulq_n_f32(v, static_cast<float>(Fixed::ONE));
+
+			//truncation is floor for non-negative values
+			int32x4_t raw = vcvtq_s32_f32(s);
+			float32x4_t rest = vsubq_f32(s, vcvtq_f32_s32(raw));
+
+			//rest >= 0.5 => mask = -1
+			uint32x4_t roundUp = vcgeq_f32(rest, vdupq_n_f32(0.5f));
+			raw = vsubq_s32(raw, vreinterpretq_s32_u32(roundUp));
+
+			intPart = vshrq_n_s32(raw, Fixed::FRACTION_BITS);
+			fraction = vandq_s32(raw, vdupq_n_s32(Fixed::FRACTION_MASK));
+		}
+
+		static Fixed ToFixed(T v)
+		{
+			if constexpr (std::is_same<T, Fixed>::value)
+			{
+				return v;
+			}
+			else if constexpr (std::is_integral<T>::value)
+			{
+				return Fixed(static_cast<int>(v));
+			}
+			else
+			{
+				return Fixed(static_cast<double>(v));
+			}
+		}
+
+		void LoadPositions(const Pixel<T>* pixels, Positions& p) const
+		{
+			int32x4_t x;
+			int32x4_t y;
+			uint32x4_t invalid;
+
+			p.fx = vdupq_n_s32(0);
+			p.fy = vdupq_n_s32(0);
+			p.tx = vdupq_n_f32(0.0f);
+			p.ty = vdupq_n_f32(0.0f);
+
+			if constexpr (std::is_same<T, float>::value)
+			{
+				float32x4x2_t v = vld2q_f32(reinterpret_cast<const float*>(pixels));
+
+				float32x4_t minusOne = vdupq_n_f32(-1.0f);
+				invalid = vorrq_u32(vceqq_f32(v.val[0], minusOne), vceqq_f32(v.val[1], minusOne));
+
+				if constexpr (!FLOAT_MATH)
+				{
+					ToFixed(v.val[0], x, p.fx);
+					ToFixed(v.val[1], y, p.fy);
+				}
+				else
+				{
+					//truncation - same as static_cast<int>
+					x = vcvtq_s32_f32(v.val[0]);
+					y = vcvtq_s32_f32(v.val[1]);
+					p.tx = vsubq_f32(v.val[0], vcvtq_f32_s32(x));
+					p.ty = vsubq_f32(v.val[1], vcvtq_f32_s32(y));
+				}
+			}
+			else if constexpr (std::is_same<T, int>::value || std::is_same<T, Fixed>::value)
+			{
+				int32x4x2_t v = vld2q_s32(reinterpret_cast<const int32_t*>(pixels));
+
+				//raw value of -1
+				int32x4_t minusOne = vdupq_n_s32((std::is_same<T, Fixed>::value) ? -Fixed::ONE : -1);
+				invalid = vorrq_u32(vceqq_s32(v.val[0], minusOne), vceqq_s32(v.val[1], minusOne));
+
+				if constexpr (std::is_same<T, Fixed>::value)
+				{
+					int32x4_t fractionMask = vdupq_n_s32(Fixed::FRACTION_MASK);
+
+					x = vshrq_n_s32(v.val[0], Fixed::FRACTION_BITS);
+					y = vshrq_n_s32(v.val[1], Fixed::FRACTION_BITS);
+					p.fx = vandq_s32(v.val[0], fractionMask);
+					p.fy = vandq_s32(v.val[1], fractionMask);
+					p.tx = vmulq_n_f32(vcvtq_f32_s32(p.fx), 1.0f / Fixed::ONE);
+					p.ty = vmulq_n_f32(vcvtq_f32_s32(p.fy), 1.0f / Fixed::ONE);
+				}
+				else
+				{
+					x = v.val[0];
+					y = v.val[1];
+				}
+			}
+			else
+			{
+				int32_t xx[4];
+				int32_t yy[4];
+				int32_t fx[4];
+				int32_t fy[4];
+				float tx[4];
+				float ty[4];
+				uint32_t ii[4];
+
+				for (int i = 0; i < 4; i++)
+				{
+					const Pixel<T>& px = pixels[i];
+					ii[i] = ((px.x == -1) || (px.y == -1)) ? 0xFFFFFFFF : 0;
+
+					if constexpr (!FLOAT_MATH)
+					{
+						Fixed fixedX = ToFixed(px.x);
+						Fixed fixedY = ToFixed(px.y);
+						xx[i] = fixedX.GetInt();
+						yy[i] = fixedY.GetInt();
+						fx[i] = fixedX.GetFraction();
+						fy[i] = fixedY.GetFraction();
+						tx[i] = 0.0f;
+						ty[i] = 0.0f;
+					}
+					else
+					{
+						xx[i] = static_cast<int>(px.x);
+						yy[i] = static_cast<int>(px.y);
+						fx[i] = 0;
+						fy[i] = 0;
+						tx[i] = static_cast<float>(px.x - xx[i]);
+						ty[i] = static_cast<float>(px.y - yy[i]);
+					}
+				}
+
+				x = vld1q_s32(xx);
+				y = vld1q_s32(yy);
+				p.fx = vld1q_s32(fx);
+				p.fy = vld1q_s32(fy);
+				p.tx = vld1q_f32(tx);
+				p.ty = vld1q_f32(ty);
+				invalid = vld1q_u32(ii);
+			}
+
+			p.valid = vmvnq_u32(invalid);
+
+			vst1q_s32(p.x, vandq_s32(x, vreinterpretq_s32_u32(p.valid)));
+			vst1q_s32(p.y, vandq_s32(y, vreinterpretq_s32_u32(p.valid)));
+		}
+
+		/// <summary>
+		/// Load value of channel c of 4 pixels at element indices
+		/// </summary>
+		Value Load(const int32_t* index, size_t c) const
+		{
+			if constexpr (INTEGRAL)
+			{
+				uint32_t v[4];
+				for (int i = 0; i < 4; i++)
+				{
+					v[i] = this->input[index[i] + c];
+				}
+				return vld1q_u32(v);
+			}
+			else
+			{
+				float v[4];
+				for (int i = 0; i < 4; i++)
+				{
+					v[i] = this->input[index[i] + c];
+				}
+				return vld1q_f32(v);
+			}
+		}
+
+		/// <summary>
+		/// Load value of channel c of 4 pixels at element indices as float
+		/// </summary>
+		float32x4_t LoadFloat(const int32_t* index, size_t c) const
+		{
+			if constexpr (INTEGRAL)
+			{
+				return vcvtq_f32_u32(this->Load(index, c));
+			}
+			else
+			{
+				return this->Load(index, c);
+			}
+		}
+
+		/// <summary>
+		/// Convert values computed in float to Value
+		/// Integral values are truncated (same as conversion in double version)
+		/// </summary>
+		static Value FromFloat(float32x4_t v)
+		{
+			if constexpr (INTEGRAL)
+			{
+				return vcvtq_u32_f32(v);
+			}
+			else
+			{
+				return v;
+			}
+		}
+
+		uint32x4_t Bilinear4(const Pixel<T>* pixels, Value* res) const
+		{
+			Positions p;
+			this->LoadPositions(pixels, p);
+
+			//element indices of taps
+			int32_t i00[4], i10[4], i01[4], i11[4];
+			for (int i = 0; i < 4; i++)
+			{
+				int x1p = (p.x[i] + 1 >= this->inW) ? this->inW - 1 : p.x[i] + 1;
+				int y1p = (p.y[i] + 1 >= this->inH) ? this->inH - 1 : p.y[i] + 1;
+
+				i00[i] = (p.x[i] + p.y[i] * this->inW) * static_cast<int>(ChannelsCount);
+				i10[i] = (x1p + p.y[i] * this->inW) * static_cast<int>(ChannelsCount);
+				i01[i] = (p.x[i] + y1p * this->inW) * static_cast<int>(ChannelsCount);
+				i11[i] = (x1p + y1p * this->inW) * static_cast<int>(ChannelsCount);
+			}
+
+			if constexpr (!FLOAT_MATH)
+			{
+				const int SHIFT = 2 * Fixed::FRACTION_BITS;
+
+				uint32x4_t fixedOne = vdupq_n_u32(Fixed::ONE);
+				uint32x4_t fx = vreinterpretq_u32_s32(p.fx);
+				uint32x4_t fy = vreinterpretq_u32_s32(p.fy);
+				uint32x4_t sx = vsubq_u32(fixedOne, fx);
+				uint32x4_t sy = vsubq_u32(fixedOne, fy);
+				uint32x4_t round = vdupq_n_u32(1 << (SHIFT - 1));
+
+				for (size_t c = 0; c < ChannelsCount; c++)
+				{
+					uint32x4_t a = vmlaq_u32(vmulq_u32(this->Load(i00, c), sx), this->Load(i10, c), fx);
+					uint32x4_t b = vmlaq_u32(vmulq_u32(this->Load(i01, c), sx), this->Load(i11, c), fx);
+
+					//uint16_t sum fits to unsigned 32 bits
+					uint32x4_t sum = vmlaq_u32(vmlaq_u32(round, a, sy), b, fy);
+					res[c] = vshrq_n_u32(sum, SHIFT);
+				}
+			}
+			else
+			{
+				float32x4_t one = vdupq_n_f32(1.0f);
+				float32x4_t sx = vsubq_f32(one, p.tx);
+				float32x4_t sy = vsubq_f32(one, p.ty);
+
+				for (size_t c = 0; c < ChannelsCount; c++)
+				{
+					float32x4_t a = vaddq_f32(vmulq_f32(this->LoadFloat(i00, c), sx), vmulq_f32(this->LoadFloat(i10, c), p.tx));
+					float32x4_t b = vaddq_f32(vmulq_f32(this->LoadFloat(i01, c), sx), vmulq_f32(this->LoadFloat(i11, c), p.tx));
+
+					res[c] = FromFloat(vaddq_f32(vmulq_f32(a, sy), vmulq_f32(b, p.ty)));
+				}
+			}
+
+			return p.valid;
+		}
+
+		uint32x4_t Bicubic4(const Pixel<T>* pixels, Value* res) const
+		{
+			Positions p;
+			this->LoadPositions(pixels, p);
+
+			//element indices of taps - same clamping as single instruction version
+			int32_t cols[4][4];
+			int32_t rows[4][4];
+			for (int i = 0; i < 4; i++)
+			{
+				int px = p.x[i];
+				int py = p.y[i];
+
+				cols[0][i] = ((px < 1) ? 0 : px - 1);
+				cols[1][i] = px;
+				cols[2][i] = ((px + 1 >= this->inW) ? this->inW - 1 : px + 1);
+				cols[3][i] = ((px + 2 >= this->inW) ? this->inW - 2 : px + 2);
+
+				rows[0][i] = ((py < 1) ? 0 : py - 1);
+				rows[1][i] = py;
+				rows[2][i] = ((py + 1 >= this->inH) ? this->inH - 1 : py + 1);
+				rows[3][i] = ((py + 2 >= this->inH) ? this->inH - 2 : py + 2);
+
+				for (int k = 0; k < 4; k++)
+				{
+					cols[k][i] *= static_cast<int>(ChannelsCount);
+					rows[k][i] *= this->inW * static_cast<int>(ChannelsCount);
+				}
+			}
+
+			int32_t taps[4][4][4];
+			for (int j = 0; j < 4; j++)
+			{
+				for (int k = 0; k < 4; k++)
+				{
+					for (int i = 0; i < 4; i++)
+					{
+						taps[j][k][i] = rows[j][i] + cols[k][i];
+					}
+				}
+			}
+
+			if constexpr (!FLOAT_MATH)
+			{
+				using Weights = FixedPointBicubicWeights<Fixed::FRACTION_BITS>;
+
+				const int SHIFT = 2 * Weights::BITS;
+				const auto& table = Weights::Get();
+
+				int32_t fx[4];
+				int32_t fy[4];
+				vst1q_s32(fx, p.fx);
+				vst1q_s32(fy, p.fy);
+
+				uint32x4_t wx[4];
+				uint32x4_t wy[4];
+				for (int k = 0; k < 4; k++)
+				{
+					uint32_t vx[4];
+					uint32_t vy[4];
+					for (int i = 0; i < 4; i++)
+					{
+						vx[i] = static_cast<uint32_t>(table[fx[i]][k]);
+						vy[i] = static_cast<uint32_t>(table[fy[i]][k]);
+					}
+					wx[k] = vld1q_u32(vx);
+					wy[k] = vld1q_u32(vy);
+				}
+
+				for (size_t c = 0; c < ChannelsCount; c++)
+				{
+					//horizontal sums fits to 32 bits
+					uint32x4_t h[4];
+					for (int j = 0; j < 4; j++)
+					{
+						h[j] = vmulq_u32(this->Load(taps[j][0], c), wx[0]);
+						for (int k = 1; k < 4; k++)
+						{
+							h[j] = vmlaq_u32(h[j], this->Load(taps[j][k], c), wx[k]);
+						}
+					}
+
+					if constexpr (sizeof(DataType) == 1)
+					{
+						uint32x4_t sum = vdupq_n_u32(1 << (SHIFT - 1));
+						for (int j = 0; j < 4; j++)
+						{
+							sum = vmlaq_u32(sum, h[j], wy[j]);
+						}
+
+						res[c] = vshrq_n_u32(sum, SHIFT);
+					}
+					else
+					{
+						//vertical sum needs 64 bits
+						uint64x2_t low = vdupq_n_u64(uint64_t(1) << (SHIFT - 1));
+						uint64x2_t high = low;
+						for (int j = 0; j < 4; j++)
+						{
+							low = vmlal_u32(low, vget_low_u32(h[j]), vget_low_u32(wy[j]));
+							high = vmlal_u32(high, vget_high_u32(h[j]), vget_high_u32(wy[j]));
+						}
+
+						res[c] = vcombine_u32(vmovn_u64(vshrq_n_u64(low, SHIFT)), vmovn_u64(vshrq_n_u64(high, SHIFT)));
+					}
+				}
+			}
+			else
+			{
+				float32x4_t wx[4];
+				float32x4_t wy[4];
+				GetBicubicWeights(p.tx, wx);
+				GetBicubicWeights(p.ty, wy);
+
+				for (size_t c = 0; c < ChannelsCount; c++)
+				{
+					float32x4_t sum = vdupq_n_f32(0.0f);
+					for (int j = 0; j < 4; j++)
+					{
+						float32x4_t h = vmulq_f32(this->LoadFloat(taps[j][0], c), wx[0]);
+						for (int k = 1; k < 4; k++)
+						{
+							h = vaddq_f32(h, vmulq_f32(this->LoadFloat(taps[j][k], c), wx[k]));
+						}
+
+						sum = vaddq_f32(sum, vmulq_f32(wy[j], h));
+					}
+
+					res[c] = FromFloat(vmulq_n_f32(sum, 1.0f / 36.0f));
+				}
+			}
+
+			return p.valid;
+		}
+
+		/// <summary>
+		/// Cubic B-spline weights (multiplied by 6) of fractions t
+		/// </summary>
+		static void GetBicubicWeights(float32x4_t t, float32x4_t* w)
+		{
+			float32x4_t four = vdupq_n_f32(4.0f);
+
+			float32x4_t t2 = vmulq_f32(t, t);
+			float32x4_t t3 = vmulq_f32(t2, t);
+
+			float32x4_t s = vsubq_f32(vdupq_n_f32(1.0f), t);
+			float32x4_t s2 = vmulq_f32(s, s);
+			float32x4_t s3 = vmulq_f32(s2, s);
+
+			w[0] = s3;
+			w[1] = vsubq_f32(vaddq_f32(four, vmulq_n_f32(t3, 3.0f)), vmulq_n_f32(t2, 6.0f));
+			w[2] = vsubq_f32(vaddq_f32(four, vmulq_n_f32(s3, 3.0f)), vmulq_n_f32(s2, 6.0f));
+			w[3] = t3;
+		}
+	};
+}
+
+#endif
+
+#endif
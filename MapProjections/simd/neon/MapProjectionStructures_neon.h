@@ -29,18 +29,20 @@ namespace Projections::Neon
         static PixelNeon FromArray(const std::array<Projections::Pixel<PixelType>, 4> & p)
         {
             PixelNeon pNeon;
-            pNeon.x = {
+            const float xValues[4] = {
                static_cast<float>(p[0].x),
                static_cast<float>(p[1].x),
                static_cast<float>(p[2].x),
                static_cast<float>(p[3].x)
             };
-            pNeon.y = {
+            pNeon.x = vld1q_f32(xValues);
+            const float yValues[4] = {
                static_cast<float>(p[0].y),
                static_cast<float>(p[1].y),
                static_cast<float>(p[2].y),
                static_cast<float>(p[3].y)
             };
+            pNeon.y = vld1q_f32(yValues);
             
             return pNeon;
         };
@@ -84,6 +86,26 @@ namespace Projections::Neon
             }
             return p;
         };
+
+        template <typename PixelType>
+        static RET_VAL_NEON(PixelType, IsFixedPoint) ToArray(const PixelNeon & pNeon)
+        {
+            std::array<Pixel<PixelType>, 4> p;
+            
+            std::array<float, 4> resX;
+            vst1q_f32(resX.data(), pNeon.x);
+            
+            std::array<float, 4> resY;
+            vst1q_f32(resY.data(), pNeon.y);
+            
+            //calculate pixel in final frame
+            for (size_t i = 0; i < p.size(); i++)
+            {
+                p[i].x = PixelType(resX[i]);
+                p[i].y = PixelType(resY[i]);
+            }
+            return p;
+        };
     };
     
     //=======================================================================================
@@ -108,18 +130,20 @@ namespace Projections::Neon
         static CoordinateNeon FromArray(const std::array<Projections::Coordinate, 4>& c)
         {
             CoordinateNeon cNeon;
-            cNeon.lonRad = {
+            const float lonRadValues[4] = {
                 static_cast<float>(c[0].lon.rad()),
                 static_cast<float>(c[1].lon.rad()),
                 static_cast<float>(c[2].lon.rad()),
                 static_cast<float>(c[3].lon.rad())
             };
-            cNeon.latRad = {
+            cNeon.lonRad = vld1q_f32(lonRadValues);
+            const float latRadValues[4] = {
                 static_cast<float>(c[0].lat.rad()),
                 static_cast<float>(c[1].lat.rad()),
                 static_cast<float>(c[2].lat.rad()),
                 static_cast<float>(c[3].lat.rad())
             };
+            cNeon.latRad = vld1q_f32(latRadValues);
 
             return cNeon;
         };
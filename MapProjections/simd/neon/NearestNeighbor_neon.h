@@ -0,0 +1,293 @@
+#ifndef NEAREST_NEIGHBOR_NEON_H
+#define NEAREST_NEIGHBOR_NEON_H
+
+#include "./neon_utils.h"
+
+#ifdef HAVE_NEON
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "../../MapProjectionStructures.h"
+
+namespace Projections::Neon
+{
+	/// <summary>
+	/// NEON vectors for nearest neighbor copy of DataType pixels
+	/// LANES pixels are processed at once
+	/// Narrow converts LANES / 4 vectors with 32-bit values to vector of DataType
+	/// </summary>
+	template <typename DataType>
+	struct NearestNeighborLanes;
+
+	template <>
+	struct NearestNeighborLanes<uint8_t>
+	{
+		static const int LANES = 8;
+
+		using Vec = uint8x8_t;
+		using Vec3 = uint8x8x3_t;
+		using Vec4 = uint8x8x4_t;
+		using Mask = uint8x8_t;
+
+		static Mask CreateMask(const uint32x4_t* valid) { return Narrow(valid); }
+		static Vec Narrow(const uint32x4_t* v) { return vmovn_u16(vcombine_u16(vmovn_u32(v[0]), vmovn_u32(v[1]))); }
+		static Vec Dup(uint8_t v) { return vdup_n_u8(v); }
+		static Vec Select(Mask m, Vec a, Vec b) { return vbsl_u8(m, a, b); }
+
+		template <int Lane> static Vec Load1(const uint8_t* ptr, Vec v) { return vld1_lane_u8(ptr, v, Lane); }
+		template <int Lane> static Vec3 Load3(const uint8_t* ptr, Vec3 v) { return vld3_lane_u8(ptr, v, Lane); }
+		template <int Lane> static Vec4 Load4(const uint8_t* ptr, Vec4 v) { return vld4_lane_u8(ptr, v, Lane); }
+
+		static void Store1(uint8_t* ptr, Vec v) { vst1_u8(ptr, v); }
+		static void Store3(uint8_t* ptr, Vec3 v) { vst3_u8(ptr, v); }
+		static void Store4(uint8_t* ptr, Vec4 v) { vst4_u8(ptr, v); }
+	};
+
+	template <>
+	struct NearestNeighborLanes<uint16_t>
+	{
+		static const int LANES = 4;
+
+		using Vec = uint16x4_t;
+		using Vec3 = uint16x4x3_t;
+		using Vec4 = uint16x4x4_t;
+		using Mask = uint16x4_t;
+
+		static Mask CreateMask(const uint32x4_t* valid) { return Narrow(valid); }
+		static Vec Narrow(const uint32x4_t* v) { return vmovn_u32(v[0]); }
+		static Vec Dup(uint16_t v) { return vdup_n_u16(v); }
+		static Vec Select(Mask m, Vec a, Vec b) { return vbsl_u16(m, a, b); }
+
+		template <int Lane> static Vec Load1(const uint16_t* ptr, Vec v) { return vld1_lane_u16(ptr, v, Lane); }
+		template <int Lane> static Vec3 Load3(const uint16_t* ptr, Vec3 v) { return vld3_lane_u16(ptr, v, Lane); }
+		template <int Lane> static Vec4 Load4(const uint16_t* ptr, Vec4 v) { return vld4_lane_u16(ptr, v, Lane); }
+
+		static void Store1(uint16_t* ptr, Vec v) { vst1_u16(ptr, v); }
+		static void Store3(uint16_t* ptr, Vec3 v) { vst3_u16(ptr, v); }
+		static void Store4(uint16_t* ptr, Vec4 v) { vst4_u16(ptr, v); }
+	};
+
+	template <>
+	struct NearestNeighborLanes<float>
+	{
+		static const int LANES = 4;
+
+		using Vec = float32x4_t;
+		using Vec3 = float32x4x3_t;
+		using Vec4 = float32x4x4_t;
+		using Mask = uint32x4_t;
+
+		static Mask CreateMask(const uint32x4_t* valid) { return valid[0]; }
+		static Vec Narrow(const float32x4_t* v) { return v[0]; }
+		static Vec Dup(float v) { return vdupq_n_f32(v); }
+		static Vec Select(Mask m, Vec a, Vec b) { return vbslq_f32(m, a, b); }
+
+		template <int Lane> static Vec Load1(const float* ptr, Vec v) { return vld1q_lane_f32(ptr, v, Lane); }
+		template <int Lane> static Vec3 Load3(const float* ptr, Vec3 v) { return vld3q_lane_f32(ptr, v, Lane); }
+		template <int Lane> static Vec4 Load4(const float* ptr, Vec4 v) { return vld4q_lane_f32(ptr, v, Lane); }
+
+		static void Store1(float* ptr, Vec v) { vst1q_f32(ptr, v); }
+		static void Store3(float* ptr, Vec3 v) { vst3q_f32(ptr, v); }
+		static void Store4(float* ptr, Vec4 v) { vst4q_f32(ptr, v); }
+	};
+
+	/// <summary>
+	/// Nearest neighbor copy of LANES output pixels at once
+	///
+	/// NEON has no gather - input pixels are loaded with lane loads
+	/// (vld1 / vld3 / vld4 lane, channels are de-interleaved),
+	/// invalid lanes are replaced with NO_VALUE by select and
+	/// pixels are stored with interleaving vst1 / vst3 / vst4.
+	/// Input indices and validity are calculated with vector instructions.
+	///
+	/// Supported data are uint8_t, uint16_t and float with 1, 3 or 4 channels.
+	/// Indices are 32-bit, so input must have less than 2^31 values
+	/// (see IsInputSupported). Output is same as with
+	/// Projections::Reprojection::CopyNerestNeighbor.
+	/// </summary>
+	template <typename T, typename DataType, size_t ChannelsCount>
+	struct NearestNeighborGather
+	{
+		static constexpr bool IsSupported()
+		{
+			return (std::is_same<DataType, uint8_t>::value || std::is_same<DataType, uint16_t>::value ||
+				std::is_same<DataType, float>::value) &&
+				((ChannelsCount == 1) || (ChannelsCount == 3) || (ChannelsCount == 4));
+		}
+
+		static bool IsInputSupported(int inW, int inH)
+		{
+			return static_cast<uint64_t>(inW) * inH * ChannelsCount <= static_cast<uint64_t>(std::numeric_limits<int32_t>::max());
+		}
+
+		NearestNeighborGather(const DataType* inputData, int inW, int inH, const DataType NO_VALUE) :
+			input(inputData),
+			inW(inW),
+			NO_VALUE(NO_VALUE)
+		{
+		}
+
+		/// <summary>
+		/// Copy count pixels to out
+		/// Invalid pixels (-1) are set to NO_VALUE
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="count"></param>
+		/// <param name="out"></param>
+		void CopySegment(const Pixel<T>* pixels, int count, DataType* out) const
+		{
+			int countLanes = count - (count % LANES);
+
+			for (int i = 0; i < countLanes; i += LANES)
+			{
+				this->CopyLanes(pixels + i, out + i * ChannelsCount, std::make_integer_sequence<int, LANES>());
+			}
+
+			for (int i = countLanes; i < count; i++)
+			{
+				this->CopyPixel(pixels[i], out + i * ChannelsCount);
+			}
+		}
+
+	protected:
+		using Lanes = NearestNeighborLanes<DataType>;
+
+		static const int LANES = Lanes::LANES;
+
+		const DataType* input;
+		int inW;
+		const DataType NO_VALUE;
+
+		void CopyPixel(const Pixel<T>& p, DataType* out) const
+		{
+			if ((p.x == -1) || (p.y == -1))
+			{
+				for (size_t i = 0; i < ChannelsCount; i++)
+				{
+					out[i] = NO_VALUE;
+				}
+				return;
+			}
+
+			size_t index = (static_cast<int>(p.x) + static_cast<size_t>(static_cast<int>(p.y)) * inW) * ChannelsCount;
+			for (size_t i = 0; i < ChannelsCount; i++)
+			{
+				out[i] = this->input[index + i];
+			}
+		}
+
+		/// <summary>
+		/// Calculate indices of first values of 4 input pixels
+		/// and mask of valid pixels (all bits set)
+		/// Indices of invalid pixels are 0
+		/// </summary>
+		/// <param name="pixels"></param>
+		/// <param name="indices"></param>
+		/// <returns></returns>
+		uint32x4_t LoadIndices(const Pixel<T>* pixels, int32_t* indices) const
+		{
+			int32x4_t x;
+			int32x4_t y;
+			uint32x4_t invalid;
+
+			if constexpr (std::is_same<T, int>::value)
+			{
+				int32x4x2_t p = vld2q_s32(reinterpret_cast<const int32_t*>(pixels));
+				x = p.val[0];
+				y = p.val[1];
+
+				int32x4_t minusOne = vdupq_n_s32(-1);
+				invalid = vorrq_u32(vceqq_s32(x, minusOne), vceqq_s32(y, minusOne));
+			}
+			else if constexpr (std::is_same<T, float>::value)
+			{
+				float32x4x2_t p = vld2q_f32(reinterpret_cast<const float*>(pixels));
+
+				float32x4_t minusOne = vdupq_n_f32(-1.0f);
+				invalid = vorrq_u32(vceqq_f32(p.val[0], minusOne), vceqq_f32(p.val[1], minusOne));
+
+				//truncation - same as static_cast<int>
+				x = vcvtq_s32_f32(p.val[0]);
+				y = vcvtq_s32_f32(p.val[1]);
+			}
+			else
+			{
+				int32_t xx[4];
+				int32_t yy[4];
+				uint32_t ii[4];
+				for (int i = 0; i < 4; i++)
+				{
+					const Pixel<T>& p = pixels[i];
+					ii[i] = ((p.x == -1) || (p.y == -1)) ? 0xFFFFFFFF : 0;
+					xx[i] = static_cast<int>(p.x);
+					yy[i] = static_cast<int>(p.y);
+				}
+				x = vld1q_s32(xx);
+				y = vld1q_s32(yy);
+				invalid = vld1q_u32(ii);
+			}
+
+			uint32x4_t valid = vmvnq_u32(invalid);
+
+			int32x4_t index = vmulq_n_s32(vmlaq_s32(x, y, vdupq_n_s32(inW)), static_cast<int32_t>(ChannelsCount));
+			index = vandq_s32(index, vreinterpretq_s32_u32(valid));
+
+			vst1q_s32(indices, index);
+
+			return valid;
+		}
+
+		template <int... Lane>
+		void CopyLanes(const Pixel<T>* pixels, DataType* out, std::integer_sequence<int, Lane...>) const
+		{
+			int32_t indices[LANES];
+			uint32x4_t valid[LANES / 4];
+			for (int i = 0; i < LANES / 4; i++)
+			{
+				valid[i] = this->LoadIndices(pixels + i * 4, indices + i * 4);
+			}
+
+			typename Lanes::Mask mask = Lanes::CreateMask(valid);
+			typename Lanes::Vec noValue = Lanes::Dup(NO_VALUE);
+
+			//invalid lanes have index 0 - load first input pixel
+			//and it is replaced by NO_VALUE
+			if constexpr (ChannelsCount == 1)
+			{
+				typename Lanes::Vec v = noValue;
+				((v = Lanes::template Load1<Lane>(this->input + indices[Lane], v)), ...);
+
+				Lanes::Store1(out, Lanes::Select(mask, v, noValue));
+			}
+			else if constexpr (ChannelsCount == 3)
+			{
+				typename Lanes::Vec3 v = { { noValue, noValue, noValue } };
+				((v = Lanes::template Load3<Lane>(this->input + indices[Lane], v)), ...);
+
+				for (int i = 0; i < 3; i++)
+				{
+					v.val[i] = Lanes::Select(mask, v.val[i], noValue);
+				}
+				Lanes::Store3(out, v);
+			}
+			else
+			{
+				typename Lanes::Vec4 v = { { noValue, noValue, noValue, noValue } };
+				((v = Lanes::template Load4<Lane>(this->input + indices[Lane], v)), ...);
+
+				for (int i = 0; i < 4; i++)
+				{
+					v.val[i] = Lanes::Select(mask, v.val[i], noValue);
+				}
+				Lanes::Store4(out, v);
+			}
+		}
+	};
+}
+
+#endif
+
+#endif
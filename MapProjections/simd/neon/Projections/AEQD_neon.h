@@ -0,0 +1,130 @@
+#ifndef AEQD_NEON_H
+#define AEQD_NEON_H
+
+#ifdef HAVE_NEON
+
+
+#include "../neon_math_float.h"
+
+#include "../../../GeoCoordinate.h"
+#include "../../../MapProjectionStructures.h"
+
+#include "../ProjectionInfo_neon.h"
+
+#include "../../../Projections/AEQD.h"
+
+namespace Projections::Neon
+{
+
+	class AEQD : public Projections::AEQD, public ProjectionInfoNeon<AEQD>
+	{
+	public:
+		using Projections::AEQD::AEQD;
+
+		using Projections::AEQD::ProjectInverse;
+		using ProjectionInfoNeon<AEQD>::ProjectInverse;
+
+		using Projections::AEQD::Project;
+		using ProjectionInfoNeon<AEQD>::Project;
+
+
+		friend class ProjectionInfoNeon<AEQD>;
+
+	protected:
+		ProjectedValueNeon ProjectInternal(const float32x4_t& lonRad, const float32x4_t& latRad) const
+		{
+			float32x4_t cLon = vdupq_n_f32(static_cast<float>(centerLon.rad()));
+			float32x4_t cLat = vdupq_n_f32(static_cast<float>(centerLat.rad()));
+			float32x4_t earthRad = vdupq_n_f32(static_cast<float>(ProjectionConstants::EARTH_RADIUS));
+			float32x4_t sinCLat = vdupq_n_f32(static_cast<float>(sinCenterLat));
+			float32x4_t cosCLat = vdupq_n_f32(static_cast<float>(cosCenterLat));
+
+			float32x4_t cosLat;
+			float32x4_t sinLat;
+			my_sincos_f32(latRad, &sinLat, &cosLat);
+
+			float32x4_t lonDif = vsubq_f32(lonRad, cLon);
+
+			float32x4_t cosDifLon;
+			float32x4_t sinDifLon;
+			my_sincos_f32(lonDif, &sinDifLon, &cosDifLon);
+
+			//acos(sinCLat * sinLat + cosCLat * cosLat * cosDifLon) loses precision 
+			//in float near the center, haversine form is used instead
+			//hav = sin^2(0.5 * latDif) + cosCLat * cosLat * sin^2(0.5 * lonDif)
+			float32x4_t sinHalfLatDif = my_sin_f32(vmulq_f32(vsubq_f32(latRad, cLat), vdupq_n_f32(0.5f)));
+			float32x4_t sinHalfLonDif = my_sin_f32(vmulq_f32(lonDif, vdupq_n_f32(0.5f)));
+
+			float32x4_t hav = vmulq_f32(vmulq_f32(cosCLat, cosLat), vmulq_f32(sinHalfLonDif, sinHalfLonDif));
+			hav = vmlaq_f32(hav, sinHalfLatDif, sinHalfLatDif);
+			hav = vminq_f32(hav, vdupq_n_f32(1.0f));
+
+			float32x4_t phiR = my_asin_f32(my_sqrt_f32(hav));
+			float32x4_t phi = vmulq_f32(vaddq_f32(phiR, phiR), earthRad);
+
+			float32x4_t cosLatCosDifLon = vmulq_f32(cosLat, cosDifLon);
+
+			//delta = atan2(cosLat * sinDifLon, cosCLat * sinLat - sinCLat * cosLat * cosDifLon)
+			float32x4_t tmp0 = vmulq_f32(cosLat, sinDifLon);
+			float32x4_t tmp1 = vmlsq_f32(vmulq_f32(cosCLat, sinLat), sinCLat, cosLatCosDifLon);
+
+			float32x4_t delta = my_atan2_f32(tmp0, tmp1);
+
+			float32x4_t sinDelta;
+			float32x4_t cosDelta;
+			my_sincos_f32(delta, &sinDelta, &cosDelta);
+
+			ProjectedValueNeon p;
+			p.x = vmulq_f32(phi, sinDelta);
+			p.y = vmulq_f32(phi, cosDelta);
+
+			return p;
+		};
+
+		ProjectedValueInverseNeon ProjectInverseInternal(const float32x4_t& x, const float32x4_t& y) const
+		{
+			float32x4_t cLon = vdupq_n_f32(static_cast<float>(centerLon.rad()));
+			float32x4_t cLat = vdupq_n_f32(static_cast<float>(centerLat.rad()));
+			float32x4_t sinCLat = vdupq_n_f32(static_cast<float>(sinCenterLat));
+			float32x4_t cosCLat = vdupq_n_f32(static_cast<float>(cosCenterLat));
+			float32x4_t earthRad = vdupq_n_f32(static_cast<float>(ProjectionConstants::EARTH_RADIUS));
+
+			float32x4_t p = my_sqrt_f32(vmlaq_f32(vmulq_f32(x, x), y, y));
+
+			//center of projection - division by p is undefined
+			uint32x4_t center = vcltq_f32(p, vdupq_n_f32(1e-12f));
+
+			float32x4_t c = my_div_f32(p, earthRad);
+
+			float32x4_t sinC;
+			float32x4_t cosC;
+			my_sincos_f32(c, &sinC, &cosC);
+
+			float32x4_t ySinC = vmulq_f32(y, sinC);
+
+			float32x4_t sinPhi = vmulq_f32(cosC, sinCLat);
+			sinPhi = vaddq_f32(sinPhi, my_div_f32(vmulq_f32(ySinC, cosCLat), p));
+
+			// Clamp for numeric safety
+			sinPhi = vminq_f32(sinPhi, vdupq_n_f32(1.0f));
+			sinPhi = vmaxq_f32(sinPhi, vdupq_n_f32(-1.0f));
+
+			float32x4_t lat = my_asin_f32(sinPhi);
+
+			float32x4_t numerator = vmulq_f32(x, sinC);
+			float32x4_t denominator = vmulq_f32(vmulq_f32(p, cosCLat), cosC);
+			denominator = vmlsq_f32(denominator, ySinC, sinCLat);
+			float32x4_t lon = vaddq_f32(cLon, my_atan2_f32(numerator, denominator));
+
+			ProjectedValueInverseNeon res;
+			res.lonRad = my_select_f32(center, cLon, lon);
+			res.latRad = my_select_f32(center, cLat, lat);
+
+			return res;
+		};
+
+	};
+}
+
+#endif //ENABLE_SIMD
+#endif
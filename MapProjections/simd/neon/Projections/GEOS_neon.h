@@ -0,0 +1,177 @@
+#ifndef GEOS_NEON_H
+#define GEOS_NEON_H
+
+#ifdef HAVE_NEON
+
+#include <limits>
+
+#include "../neon_math_float.h"
+
+#include "../../../GeoCoordinate.h"
+#include "../../../MapProjectionStructures.h"
+
+#include "../ProjectionInfo_neon.h"
+
+#include "../../../Projections/GEOS.h"
+
+namespace Projections::Neon
+{
+
+	class GEOS : public Projections::GEOS, public ProjectionInfoNeon<GEOS>
+	{
+	public:
+		using Projections::GEOS::ProjectInverse;
+		using ProjectionInfoNeon<GEOS>::ProjectInverse;
+
+		using Projections::GEOS::Project;
+		using ProjectionInfoNeon<GEOS>::Project;
+
+
+		GEOS(const SatelliteSettings & sets) :
+			Projections::GEOS(sets)
+		{}
+
+		friend class ProjectionInfoNeon<GEOS>;
+
+	protected:
+		ProjectedValueNeon ProjectInternal(const float32x4_t& lonRad, const float32x4_t& latRad) const
+		{
+			float32x4_t lonDif = vsubq_f32(lonRad, vdupq_n_f32(static_cast<float>(sat.lon.rad())));
+
+			float32x4_t tanLat = my_tan_f32(latRad);
+			float32x4_t cLat = my_atan_f32(vmulq_f32(tanLat, vdupq_n_f32(0.993305616f)));
+
+			float32x4_t cosCLat;
+			float32x4_t sinCLat;
+			my_sincos_f32(cLat, &sinCLat, &cosCLat);
+
+			float32x4_t tmp1 = vmulq_f32(cosCLat, cosCLat);
+			tmp1 = vmlsq_f32(vdupq_n_f32(1.0f), tmp1, vdupq_n_f32(0.00669438444f));
+			tmp1 = my_sqrt_f32(tmp1);
+
+			float32x4_t r = my_div_f32(vdupq_n_f32(static_cast<float>(RADIUS_POLAR)), tmp1);
+
+			float32x4_t cosDifLon;
+			float32x4_t sinDifLon;
+			my_sincos_f32(lonDif, &sinDifLon, &cosDifLon);
+
+			float32x4_t rCosCLat = vmulq_f32(r, cosCLat);
+
+			float32x4_t r1 = vmlsq_f32(vdupq_n_f32(static_cast<float>(SAT_DIST)), rCosCLat, cosDifLon);
+			float32x4_t r2 = vmulq_f32(rCosCLat, sinDifLon);
+			float32x4_t r3 = vmulq_f32(r, sinCLat);
+
+
+			ProjectedValueNeon p;
+
+			if (sat.sweepY)
+			{
+				tmp1 = vmulq_f32(r1, r1);
+				tmp1 = vmlaq_f32(tmp1, r2, r2);
+				tmp1 = vmlaq_f32(tmp1, r3, r3);
+
+				float32x4_t rn = my_sqrt_f32(tmp1);
+
+				p.x = my_atan_f32(my_div_f32(r2, r1));
+				p.y = my_asin_f32(my_swap_sign_f32(my_div_f32(r3, rn)));
+			}
+			else
+			{
+				tmp1 = vmulq_f32(r1, r1);
+				tmp1 = vmlaq_f32(tmp1, r3, r3);
+
+				float32x4_t rn = my_sqrt_f32(tmp1);
+
+				p.x = my_atan_f32(my_div_f32(r2, rn));
+				p.y = my_atan_f32(my_swap_sign_f32(my_div_f32(r3, r1)));
+			}
+
+			p.x = vmlaq_f32(vdupq_n_f32(static_cast<float>(sat.coff)),
+				ProjectionUtils::radToDeg(p.x), vdupq_n_f32(static_cast<float>(TWO_POW_MINUS_16 * sat.cfac)));
+
+			p.y = vmlaq_f32(vdupq_n_f32(static_cast<float>(sat.loff)),
+				ProjectionUtils::radToDeg(p.y), vdupq_n_f32(static_cast<float>(TWO_POW_MINUS_16 * sat.lfac)));
+
+			return p;
+		};
+
+		ProjectedValueInverseNeon ProjectInverseInternal(const float32x4_t& x, const float32x4_t& y) const
+		{
+			//1.006739501 = RADIUS_EQUATOR^2 / RADIUS_POLAR^2
+			//1737122264 = (SAT_DIST^2 - RADIUS_EQUATOR^2)
+			const double SD_CONST = 1737122264.0;
+			const double SAT_DIST2 = static_cast<double>(SAT_DIST) * static_cast<double>(SAT_DIST);
+
+			float32x4_t scanX = vsubq_f32(x, vdupq_n_f32(static_cast<float>(sat.coff)));
+			scanX = vmulq_f32(scanX, vdupq_n_f32(static_cast<float>(1.0 / (TWO_POW_MINUS_16 * sat.cfac))));
+			scanX = ProjectionUtils::degToRad(scanX);
+
+			float32x4_t scanY = vsubq_f32(y, vdupq_n_f32(static_cast<float>(sat.loff)));
+			scanY = vmulq_f32(scanY, vdupq_n_f32(static_cast<float>(1.0 / (TWO_POW_MINUS_16 * sat.lfac))));
+			scanY = ProjectionUtils::degToRad(scanY);
+
+			float32x4_t sinX;
+			float32x4_t cosX;
+			my_sincos_f32(scanX, &sinX, &cosX);
+
+			float32x4_t sinY;
+			float32x4_t cosY;
+			my_sincos_f32(scanY, &sinY, &cosY);
+
+			float32x4_t sin2Y = vmulq_f32(sinY, sinY);
+			float32x4_t cosXcosY = vmulq_f32(cosX, cosY);
+
+			float32x4_t tmp = vmulq_f32(vdupq_n_f32(static_cast<float>(SAT_DIST)), cosXcosY);
+
+			//cos2Y + 1.006739501 * sin2Y
+			float32x4_t tmp2 = vmlaq_f32(vdupq_n_f32(1.0f), sin2Y, vdupq_n_f32(0.006739501f));
+
+			//same rewrite of the discriminant as in AVX version (avoids cancellation in float)
+			//(SAT_DIST^2 - 1737122264) - SAT_DIST^2 * (sin2X + cos2X * sin2Y) - 1737122264 * 0.006739501 * sin2Y
+			float32x4_t angle = vmlaq_f32(vmulq_f32(sinX, sinX), vmulq_f32(cosX, cosX), sin2Y);
+			float32x4_t sd2 = vmlsq_f32(vdupq_n_f32(static_cast<float>(SAT_DIST2 - SD_CONST)),
+				angle, vdupq_n_f32(static_cast<float>(SAT_DIST2)));
+			sd2 = vmlsq_f32(sd2, sin2Y, vdupq_n_f32(static_cast<float>(SD_CONST * 0.006739501)));
+
+			//outside of the Earth disk, ray from satellite does not hit the Earth
+			uint32x4_t outside = vcltq_f32(sd2, vdupq_n_f32(0.0f));
+
+			float32x4_t sd = my_sqrt_f32(vmaxq_f32(sd2, vdupq_n_f32(0.0f)));
+			float32x4_t sn = my_div_f32(vsubq_f32(tmp, sd), tmp2);
+
+			float32x4_t s1 = vmlsq_f32(vdupq_n_f32(static_cast<float>(SAT_DIST)), sn, cosXcosY);
+			float32x4_t s2;
+			float32x4_t s3;
+			if (sat.sweepY)
+			{
+				s2 = vmulq_f32(vmulq_f32(sn, sinX), cosY);
+				s3 = my_swap_sign_f32(vmulq_f32(sn, sinY));
+			}
+			else
+			{
+				s2 = vmulq_f32(sn, sinX);
+				s3 = my_swap_sign_f32(vmulq_f32(vmulq_f32(sn, sinY), cosX));
+			}
+
+			float32x4_t sxy = my_sqrt_f32(vmlaq_f32(vmulq_f32(s2, s2), s1, s1));
+
+			ProjectedValueInverseNeon c;
+			c.latRad = my_div_f32(vmulq_f32(vdupq_n_f32(1.006739501f), s3), sxy);
+			c.latRad = my_atan_f32(c.latRad);
+
+			c.lonRad = my_atan_f32(my_div_f32(s2, s1));
+			c.lonRad = vaddq_f32(c.lonRad, vdupq_n_f32(static_cast<float>(sat.lon.rad())));
+
+			//NaN is not projected inside of input and pixel stays -1
+			float32x4_t nan = vdupq_n_f32(std::numeric_limits<float>::quiet_NaN());
+			c.latRad = my_select_f32(outside, nan, c.latRad);
+			c.lonRad = my_select_f32(outside, nan, c.lonRad);
+
+			return c;
+		};
+
+	};
+}
+
+#endif //ENABLE_SIMD
+#endif
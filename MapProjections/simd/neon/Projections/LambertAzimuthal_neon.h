@@ -0,0 +1,99 @@
+#ifndef LAMBERT_AZIMUTHAL_NEON_H
+#define LAMBERT_AZIMUTHAL_NEON_H
+
+#ifdef HAVE_NEON
+
+
+#include "../neon_math_float.h"
+
+#include "../../../GeoCoordinate.h"
+#include "../../../MapProjectionStructures.h"
+
+#include "../ProjectionInfo_neon.h"
+
+#include "../../../Projections/LambertAzimuthal.h"
+
+namespace Projections::Neon
+{
+
+	class LambertAzimuthal : public Projections::LambertAzimuthal, public ProjectionInfoNeon<LambertAzimuthal>
+	{
+	public:
+		using Projections::LambertAzimuthal::LambertAzimuthal;
+
+		using Projections::LambertAzimuthal::ProjectInverse;
+		using ProjectionInfoNeon<LambertAzimuthal>::ProjectInverse;
+
+		using Projections::LambertAzimuthal::Project;
+		using ProjectionInfoNeon<LambertAzimuthal>::Project;
+
+
+		friend class ProjectionInfoNeon<LambertAzimuthal>;
+
+	protected:
+		ProjectedValueNeon ProjectInternal(const float32x4_t& lonRad, const float32x4_t& latRad) const
+		{
+			float32x4_t sinSP = vdupq_n_f32(static_cast<float>(sinStanParallel));
+			float32x4_t cosSP = vdupq_n_f32(static_cast<float>(cosStanParallel));
+
+			float32x4_t lonDif = vsubq_f32(lonRad, vdupq_n_f32(static_cast<float>(centralLon.rad())));
+
+			float32x4_t sinLat;
+			float32x4_t cosLat;
+			my_sincos_f32(latRad, &sinLat, &cosLat);
+
+			float32x4_t sinLonDif;
+			float32x4_t cosLonDif;
+			my_sincos_f32(lonDif, &sinLonDif, &cosLonDif);
+
+			float32x4_t cosLatCosLonDif = vmulq_f32(cosLat, cosLonDif);
+
+			//k = sqrt(2 / (1 + sinSP * sinLat + cosSP * cosLat * cosLonDif))
+			float32x4_t k = vmlaq_f32(vdupq_n_f32(1.0f), sinSP, sinLat);
+			k = vmlaq_f32(k, cosSP, cosLatCosLonDif);
+			k = my_sqrt_f32(my_div_f32(vdupq_n_f32(2.0f), k));
+
+			ProjectedValueNeon p;
+			p.x = vmulq_f32(vmulq_f32(k, cosLat), sinLonDif);
+			p.y = vmlsq_f32(vmulq_f32(cosSP, sinLat), sinSP, cosLatCosLonDif);
+			p.y = vmulq_f32(k, p.y);
+
+			return p;
+		};
+
+		ProjectedValueInverseNeon ProjectInverseInternal(const float32x4_t& x, const float32x4_t& y) const
+		{
+			float32x4_t sinSP = vdupq_n_f32(static_cast<float>(sinStanParallel));
+			float32x4_t cosSP = vdupq_n_f32(static_cast<float>(cosStanParallel));
+
+			float32x4_t ro = my_sqrt_f32(vmlaq_f32(vmulq_f32(y, y), x, x));
+
+			float32x4_t c = my_asin_f32(vmulq_f32(ro, vdupq_n_f32(0.5f)));
+			c = vaddq_f32(c, c);
+
+			float32x4_t sinC;
+			float32x4_t cosC;
+			my_sincos_f32(c, &sinC, &cosC);
+
+			float32x4_t ySinC = vmulq_f32(y, sinC);
+
+			float32x4_t tmp = my_div_f32(vmulq_f32(ySinC, cosSP), ro);
+			tmp = vmlaq_f32(tmp, cosC, sinSP);
+
+			float32x4_t numerator = vmulq_f32(x, sinC);
+			float32x4_t denominator = vmulq_f32(vmulq_f32(ro, cosSP), cosC);
+			denominator = vmlsq_f32(denominator, ySinC, sinSP);
+
+			ProjectedValueInverseNeon res;
+			res.latRad = my_asin_f32(tmp);
+			res.lonRad = my_atan_f32(my_div_f32(numerator, denominator));
+			res.lonRad = vaddq_f32(res.lonRad, vdupq_n_f32(static_cast<float>(centralLon.rad())));
+
+			return res;
+		};
+
+	};
+}
+
+#endif //ENABLE_SIMD
+#endif
@@ -0,0 +1,91 @@
+#ifndef LAMBERT_CONIC_NEON_H
+#define LAMBERT_CONIC_NEON_H
+
+#ifdef HAVE_NEON
+
+
+#include "../neon_math_float.h"
+
+#include "../../../GeoCoordinate.h"
+#include "../../../MapProjectionStructures.h"
+
+#include "../ProjectionInfo_neon.h"
+
+#include "../../../Projections/LambertConic.h"
+
+namespace Projections::Neon
+{
+
+	class LambertConic : public Projections::LambertConic, public ProjectionInfoNeon<LambertConic>
+	{
+	public:
+		using Projections::LambertConic::LambertConic;
+
+		using Projections::LambertConic::ProjectInverse;
+		using ProjectionInfoNeon<LambertConic>::ProjectInverse;
+
+		using Projections::LambertConic::Project;
+		using ProjectionInfoNeon<LambertConic>::Project;
+
+
+		friend class ProjectionInfoNeon<LambertConic>;
+
+	protected:
+		ProjectedValueNeon ProjectInternal(const float32x4_t& lonRad, const float32x4_t& latRad) const
+		{
+			float32x4_t nNeon = vdupq_n_f32(static_cast<float>(n));
+
+			float32x4_t lonDif = vsubq_f32(lonRad, vdupq_n_f32(static_cast<float>(lonCentralMeridian.rad())));
+
+			//cot(PI_4 + 0.5 * lat)
+			float32x4_t angle = vmlaq_f32(vdupq_n_f32(static_cast<float>(ProjectionConstants::PI_4)), latRad, vdupq_n_f32(0.5f));
+			float32x4_t sinAngle;
+			float32x4_t cosAngle;
+			my_sincos_f32(angle, &sinAngle, &cosAngle);
+			float32x4_t t = my_div_f32(cosAngle, sinAngle);
+
+			float32x4_t phi = vmulq_f32(vdupq_n_f32(static_cast<float>(f)), my_pow_f32(t, nNeon));
+
+			float32x4_t sinLon;
+			float32x4_t cosLon;
+			my_sincos_f32(vmulq_f32(nNeon, lonDif), &sinLon, &cosLon);
+
+			ProjectedValueNeon p;
+			p.x = vmulq_f32(phi, sinLon);
+			p.y = vmlsq_f32(vdupq_n_f32(static_cast<float>(phi0)), phi, cosLon);
+
+			//Real x = phi * std::sin(n * lonDif);
+			//Real y = phi0 - phi * std::cos(n * lonDif);
+			return p;
+		};
+
+		ProjectedValueInverseNeon ProjectInverseInternal(const float32x4_t& x, const float32x4_t& y) const
+		{
+			float32x4_t dy = vsubq_f32(vdupq_n_f32(static_cast<float>(phi0)), y);
+
+			float32x4_t phi = my_sqrt_f32(vmlaq_f32(vmulq_f32(dy, dy), x, x));
+			phi = vmulq_f32(phi, vdupq_n_f32(static_cast<float>(Projections::ProjectionUtils::sgn(n))));
+
+			float32x4_t delta = my_atan_f32(my_div_f32(x, dy));
+
+			float32x4_t t = my_div_f32(vdupq_n_f32(static_cast<float>(f)), phi);
+			t = my_pow_f32(t, vdupq_n_f32(static_cast<float>(1.0 / n)));
+
+			ProjectedValueInverseNeon c;
+			c.latRad = my_atan_f32(t);
+			c.latRad = vaddq_f32(c.latRad, c.latRad);
+			c.latRad = vsubq_f32(c.latRad, vdupq_n_f32(static_cast<float>(ProjectionConstants::PI_2)));
+
+			c.lonRad = vmulq_f32(delta, vdupq_n_f32(static_cast<float>(1.0 / n)));
+			c.lonRad = vaddq_f32(c.lonRad, vdupq_n_f32(static_cast<float>(lonCentralMeridian.rad())));
+
+			//Real lat = 2.0 * std::atan(t) - PI_2;
+			//Real lon = lonCentralMeridian.rad() + delta / n;
+			return c;
+		};
+
+	};
+}
+
+#endif //ENABLE_SIMD
+#endif
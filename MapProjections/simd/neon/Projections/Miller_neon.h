@@ -0,0 +1,67 @@
+#ifndef MILLER_NEON_H
+#define MILLER_NEON_H
+
+#ifdef HAVE_NEON
+
+
+#include "../neon_math_float.h"
+
+#include "../../../GeoCoordinate.h"
+#include "../../../MapProjectionStructures.h"
+
+#include "../ProjectionInfo_neon.h"
+
+#include "../../../Projections/Miller.h"
+
+namespace Projections::Neon
+{
+
+	class Miller : public Projections::Miller, public ProjectionInfoNeon<Miller>
+	{
+	public:
+		using Projections::Miller::ProjectInverse;
+		using ProjectionInfoNeon<Miller>::ProjectInverse;
+
+		using Projections::Miller::Project;
+		using ProjectionInfoNeon<Miller>::Project;
+
+
+		friend class ProjectionInfoNeon<Miller>;
+
+	protected:
+		ProjectedValueNeon ProjectInternal(const float32x4_t& lonRad, const float32x4_t& latRad) const
+		{
+			ProjectedValueNeon p;
+			p.x = lonRad;
+
+			p.y = vmulq_f32(latRad, vdupq_n_f32(0.4f));
+			p.y = vaddq_f32(p.y, vdupq_n_f32(static_cast<float>(ProjectionConstants::PI_4)));
+			p.y = my_tan_f32(p.y);
+			p.y = my_log_f32(p.y);
+			p.y = vmulq_f32(p.y, vdupq_n_f32(1.25f));
+
+			//p.x = c.lon.rad();
+			//p.y = 1.25 * std::log(std::tan(ProjectionConstants::PI_4 + 0.4 * c.lat.rad()));
+			return p;
+		};
+
+		ProjectedValueInverseNeon ProjectInverseInternal(const float32x4_t& x, const float32x4_t& y) const
+		{
+			ProjectedValueInverseNeon c;
+			c.lonRad = x;
+
+			c.latRad = my_exp_f32(vmulq_f32(y, vdupq_n_f32(0.8f)));
+			c.latRad = my_atan_f32(c.latRad);
+			c.latRad = vmulq_f32(c.latRad, vdupq_n_f32(2.5f));
+			c.latRad = vsubq_f32(c.latRad, vdupq_n_f32(static_cast<float>(0.625 * ProjectionConstants::PI)));
+
+			//c.lon = Longitude::rad(x);
+			//c.lat = Latitude::rad(2.5 * std::atan(std::pow(ProjectionConstants::E, 0.8 * y)) - 0.625 * ProjectionConstants::PI);
+			return c;
+		};
+
+	};
+}
+
+#endif //ENABLE_SIMD
+#endif
@@ -0,0 +1,80 @@
+#ifndef POLAR_STEREOGRAPHIC_NEON_H
+#define POLAR_STEREOGRAPHIC_NEON_H
+
+#ifdef HAVE_NEON
+
+#include <cmath>
+
+#include "../neon_math_float.h"
+
+#include "../../../GeoCoordinate.h"
+#include "../../../MapProjectionStructures.h"
+
+#include "../ProjectionInfo_neon.h"
+
+#include "../../../Projections/PolarSteregographic.h"
+
+namespace Projections::Neon
+{
+
+	class PolarSteregographic : public Projections::PolarSteregographic, public ProjectionInfoNeon<PolarSteregographic>
+	{
+	public:
+		using Projections::PolarSteregographic::PolarSteregographic;
+
+		using Projections::PolarSteregographic::ProjectInverse;
+		using ProjectionInfoNeon<PolarSteregographic>::ProjectInverse;
+
+		using Projections::PolarSteregographic::Project;
+		using ProjectionInfoNeon<PolarSteregographic>::Project;
+
+
+		friend class ProjectionInfoNeon<PolarSteregographic>;
+
+	protected:
+		ProjectedValueNeon ProjectInternal(const float32x4_t& lonRad, const float32x4_t& latRad) const
+		{
+			float32x4_t lonDif = vsubq_f32(lonRad, vdupq_n_f32(static_cast<float>(lonCentralMeridian.rad())));
+
+			float32x4_t sinLat;
+			float32x4_t cosLat;
+			my_sincos_f32(latRad, &sinLat, &cosLat);
+
+			float32x4_t sinLonDif;
+			float32x4_t cosLonDif;
+			my_sincos_f32(lonDif, &sinLonDif, &cosLonDif);
+
+			//EARTH_RADIUS * m * cosLat, m = (1 + sin(latCentral)) / (1 + sin(lat))
+			float mNum = static_cast<float>(ProjectionConstants::EARTH_RADIUS * (1.0 + std::sin(latCentral.rad())));
+			float32x4_t r = my_div_f32(vdupq_n_f32(mNum), vaddq_f32(vdupq_n_f32(1.0f), sinLat));
+			r = vmulq_f32(r, cosLat);
+
+			ProjectedValueNeon p;
+			p.x = vmulq_f32(r, sinLonDif);
+			p.y = my_swap_sign_f32(vmulq_f32(r, cosLonDif));
+
+			return p;
+		};
+
+		ProjectedValueInverseNeon ProjectInverseInternal(const float32x4_t& x, const float32x4_t& y) const
+		{
+			double tmpSin = 1.0 + std::sin(latCentral.rad());
+			float32x4_t tmp = vdupq_n_f32(static_cast<float>(ProjectionConstants::EARTH_RADIUS * ProjectionConstants::EARTH_RADIUS * tmpSin * tmpSin));
+
+			float32x4_t dist2 = vmlaq_f32(vmulq_f32(y, y), x, x);
+			float32x4_t tmp1 = vsubq_f32(tmp, dist2);
+			float32x4_t tmp2 = vaddq_f32(tmp, dist2);
+
+			ProjectedValueInverseNeon c;
+			c.latRad = my_asin_f32(my_div_f32(tmp1, tmp2));
+			c.lonRad = my_atan_f32(my_div_f32(my_swap_sign_f32(x), y));
+			c.lonRad = vaddq_f32(c.lonRad, vdupq_n_f32(static_cast<float>(lonCentralMeridian.rad())));
+
+			return c;
+		};
+
+	};
+}
+
+#endif //ENABLE_SIMD
+#endif
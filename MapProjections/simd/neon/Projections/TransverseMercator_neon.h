@@ -0,0 +1,88 @@
+#ifndef TRANSVERSE_MERCATOR_NEON_H
+#define TRANSVERSE_MERCATOR_NEON_H
+
+#ifdef HAVE_NEON
+
+
+#include "../neon_math_float.h"
+
+#include "../../../GeoCoordinate.h"
+#include "../../../MapProjectionStructures.h"
+
+#include "../ProjectionInfo_neon.h"
+
+#include "../../../Projections/TransverseMercator.h"
+
+namespace Projections::Neon
+{
+
+	class TransverseMercator : public Projections::TransverseMercator, public ProjectionInfoNeon<TransverseMercator>
+	{
+	public:
+		using Projections::TransverseMercator::TransverseMercator;
+
+		using Projections::TransverseMercator::ProjectInverse;
+		using ProjectionInfoNeon<TransverseMercator>::ProjectInverse;
+
+		using Projections::TransverseMercator::Project;
+		using ProjectionInfoNeon<TransverseMercator>::Project;
+
+
+		friend class ProjectionInfoNeon<TransverseMercator>;
+
+	protected:
+		ProjectedValueNeon ProjectInternal(const float32x4_t& lonRad, const float32x4_t& latRad) const
+		{
+			float32x4_t radius = vdupq_n_f32(static_cast<float>(RADIUS_EQUATOR));
+			float32x4_t one = vdupq_n_f32(1.0f);
+
+			float32x4_t dLon = vsubq_f32(lonRad, vdupq_n_f32(static_cast<float>(centralLon.rad())));
+
+			float32x4_t sinLat;
+			float32x4_t cosLat;
+			my_sincos_f32(latRad, &sinLat, &cosLat);
+
+			float32x4_t sinLon;
+			float32x4_t cosLon;
+			my_sincos_f32(dLon, &sinLon, &cosLon);
+
+			float32x4_t tmp = vmulq_f32(sinLon, cosLat);
+			float32x4_t ratio = my_div_f32(vaddq_f32(one, tmp), vsubq_f32(one, tmp));
+
+			//sec(dLon) * tan(lat)
+			float32x4_t t = my_div_f32(sinLat, vmulq_f32(cosLon, cosLat));
+
+			ProjectedValueNeon p;
+			p.x = vmulq_f32(vmulq_f32(vdupq_n_f32(0.5f), radius), my_log_f32(ratio));
+			p.y = vsubq_f32(my_atan_f32(t), vdupq_n_f32(static_cast<float>(centralLat.rad())));
+			p.y = vmulq_f32(radius, p.y);
+
+			return p;
+		};
+
+		ProjectedValueInverseNeon ProjectInverseInternal(const float32x4_t& x, const float32x4_t& y) const
+		{
+			float32x4_t invRadius = vdupq_n_f32(static_cast<float>(1.0 / RADIUS_EQUATOR));
+
+			float32x4_t D = vmulq_f32(x, invRadius);
+			float32x4_t E = vmlaq_f32(vdupq_n_f32(static_cast<float>(centralLat.rad())), y, invRadius);
+
+			float32x4_t sinE;
+			float32x4_t cosE;
+			my_sincos_f32(E, &sinE, &cosE);
+
+			ProjectedValueInverseNeon c;
+			c.latRad = my_asin_f32(my_div_f32(sinE, my_cosh_f32(D)));
+			c.lonRad = my_atan2_f32(my_sinh_f32(D), cosE);
+			c.lonRad = vaddq_f32(c.lonRad, vdupq_n_f32(static_cast<float>(centralLon.rad())));
+
+			//lat = std::asin(std::sin(E) / std::cosh(D));
+			//lon = centralLon.rad() + std::atan2(std::sinh(D), std::cos(E));
+			return c;
+		};
+
+	};
+}
+
+#endif //ENABLE_SIMD
+#endif
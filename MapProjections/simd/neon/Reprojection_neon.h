@@ -7,6 +7,8 @@
 
 #include "../../MapProjectionStructures.h"
 #include "./ProjectionInfo_neon.h"
+#include "./NearestNeighbor_neon.h"
+#include "./Interpolation_neon.h"
 
 #include "../../Reprojection.h"
 
@@ -18,40 +20,59 @@ namespace Projections::Neon
 		/// <summary>
 		/// Re-project data from -> to
 		/// Calculates mapping: toData[index] = fromData[reprojection[index]]
+		/// Input footprint is collected while rows are created (see ReprojectionOptions)
 		/// </summary>
 		/// <param name="imProj"></param>
+		/// <param name="options"></param>
 		/// <returns></returns>
 		template <typename FromProjection, typename ToProjection>
-		static Reprojection<T> CreateReprojection(FromProjection* from, ToProjection* to)
+		static Reprojection<T> CreateReprojection(FromProjection* from, ToProjection* to,
+			const Projections::ReprojectionOptions& options = Projections::ReprojectionOptions())
 		{
 			//Latitude (y) is usually more complex to calculate
 
 			Reprojection<T> reprojection;
 			reprojection.pixels.resize(to->GetFrameHeight() * to->GetFrameWidth(), { -1, -1 });
 
+			reprojection.inW = from->GetFrameWidth();
+			reprojection.inH = from->GetFrameHeight();
+			reprojection.outW = to->GetFrameWidth();
+			reprojection.outH = to->GetFrameHeight();
+
+			const auto& f = to->GetFrame();
+
+			bool wrapAround = (f.repeatNegCount != 0) || (f.repeatPosCount != 0);
+
 			int wRest4 = to->GetFrameWidth() % 4;
 			int w4 = to->GetFrameWidth() - wRest4;
 
-			int hRest4 = to->GetFrameHeight() % 4;
-			int h4 = to->GetFrameHeight() - hRest4;
-
 			//if x and y are independent, simplify
+			//with wrap around, only one world period of columns is computed
+			//and the rest is replicated
 			if ((from->IsIndependentLatLon()) && (to->IsIndependentLatLon()))
 			{
+				int periodW = (wrapAround) ? Projections::Reprojection<T>::GetWrapAroundPeriod(f, reprojection.outW) : reprojection.outW;
+
+				int periodRest4 = periodW % 4;
+				int period4 = periodW - periodRest4;
+
+				int hRest4 = to->GetFrameHeight() % 4;
+				int h4 = to->GetFrameHeight() - hRest4;
+
 				std::vector<T> cacheX;
 				cacheX.resize(to->GetFrameWidth());
 
 				std::vector<T> cacheY;
 				cacheY.resize(to->GetFrameHeight());
 
-				for (int x = 0; x < w4; x += 4)
+				for (int x = 0; x < period4; x += 4)
 				{
 					std::array<Projections::Pixel<int>, 4> p;
 					p[0] = { x, 0 };
 					p[1] = { x + 1, 0 };
 					p[2] = { x + 2, 0 };
 					p[3] = { x + 3, 0 };
-					
+
 					std::array<Projections::Pixel<T>, 4> o = ReProject<int, T>(p, from, to);
 					for (size_t i = 0; i < o.size(); i++)
 					{
@@ -59,9 +80,9 @@ namespace Projections::Neon
 					}
 				}
 
-				for (int x = w4; x < to->GetFrameWidth(); x++)
+				for (int x = period4; x < periodW; x++)
 				{
-					Projections::Pixel<T> p = Projections::Reprojection<T>::ReProject<int, T>({ x, 0 }, from, to);
+					Projections::Pixel<T> p = Projections::Reprojection<T>::template ReProject<int, T>({ x, 0 }, from, to);
 					cacheX[x] = p.x;
 				}
 
@@ -73,7 +94,7 @@ namespace Projections::Neon
 					p[1] = { 0, y + 1 };
 					p[2] = { 0, y + 2 };
 					p[3] = { 0, y + 3 };
-					
+
 					std::array<Projections::Pixel<T>, 4> o = ReProject<int, T>(p, from, to);
 					for (size_t i = 0; i < o.size(); i++)
 					{
@@ -83,34 +104,42 @@ namespace Projections::Neon
 
 				for (int y = h4; y < to->GetFrameHeight(); y++)
 				{
-					Projections::Pixel<T> p = Projections::Reprojection<T>::ReProject<int, T>({ 0, y }, from, to);
+					Projections::Pixel<T> p = Projections::Reprojection<T>::template ReProject<int, T>({ 0, y }, from, to);
 					cacheY[y] = p.y;
 
 				}
 
-
-				for (int y = 0; y < to->GetFrameHeight(); y++)
+				if (wrapAround)
 				{
-					for (int x = 0; x < to->GetFrameWidth(); x++)
-					{
-						Pixel<T> p;
-						p.x = cacheX[x];
-						p.y = cacheY[y];
-
-						if (p.x < 0) continue;
-						if (p.y < 0) continue;
-						if (p.x >= from->GetFrameWidth()) continue;
-						if (p.y >= from->GetFrameHeight()) continue;
-
-						reprojection.pixels[x + y * to->GetFrameWidth()] = p;
-
-					}
+					reprojection.ResolveWrapAroundColumns(cacheX, periodW, 
+						Projections::Reprojection<T>::GetWrapAroundOffset(from), f, reprojection.inW);
 				}
+
+				reprojection.FillFromSeparableCache(cacheX, cacheY, 1, options.buildValidSpans);
 			}
 			else
 			{
-				for (int y = 0; y < to->GetFrameHeight(); y++)
-				{
+				//offset is used only with wrap around
+				int offset = (wrapAround) ? Projections::Reprojection<T>::GetWrapAroundOffset(from) : 0;
+
+				//comparisons are written so that NaN positions 
+				//(eg. outside of GEOS disk) are skipped
+				auto setPixel = [&](int index, Projections::Pixel<T> p) {
+					if ((p.y >= 0) == false) return;
+					if ((p.y < from->GetFrameHeight()) == false) return;
+
+					if (wrapAround)
+					{
+						p.x = Projections::Reprojection<T>::ResolveWrapAroundX(p.x, offset, f, reprojection.inW);
+					}
+
+					if ((p.x >= 0) == false) return;
+					if ((p.x < from->GetFrameWidth()) == false) return;
+
+					reprojection.pixels[index] = p;
+				};
+
+				reprojection.CreateRows(1, options.buildValidSpans, [&](int y) {
 					for (int x = 0; x < w4; x += 4)
 					{
 						std::array<Projections::Pixel<int>, 4> p;
@@ -118,39 +147,25 @@ namespace Projections::Neon
 						p[1] = { x + 1,y };
 						p[2] = { x + 2,y };
 						p[3] = { x + 3,y };
-						
+
 						std::array<Projections::Pixel<T>, 4> o = ReProject<int, T>(p, from, to);
 
 						for (size_t i = 0; i < o.size(); i++)
 						{
-							if (o[i].x < 0) continue;
-							if (o[i].y < 0) continue;
-							if (o[i].x >= from->GetFrameWidth()) continue;
-							if (o[i].y >= from->GetFrameHeight()) continue;
-
-							reprojection.pixels[(x + i) + y * to->GetFrameWidth()] = o[i];
+							setPixel(static_cast<int>(x + i) + y * to->GetFrameWidth(), o[i]);
 						}
 					}
 
 					for (int x = w4; x < to->GetFrameWidth(); x++)
 					{
-						Projections::Pixel<T> p = Projections::Reprojection<T>::ReProject<int, T>({ x, y }, from, to);
-
-						if (p.x < 0) continue;
-						if (p.y < 0) continue;
-						if (p.x >= from->GetFrameWidth()) continue;
-						if (p.y >= from->GetFrameHeight()) continue;
-
-						reprojection.pixels[x + y * to->GetFrameWidth()] = p;
+						Projections::Pixel<T> p = Projections::Reprojection<T>::template ReProject<int, T>({ x, y }, from, to);
 
+						setPixel(x + y * to->GetFrameWidth(), p);
 					}
-				}
+				});
 			}
 
-			reprojection.inW = from->GetFrameWidth();
-			reprojection.inH = from->GetFrameHeight();
-			reprojection.outW = to->GetFrameWidth();
-			reprojection.outH = to->GetFrameHeight();
+			reprojection.FinishCreation(options, 1);
 
 			return reprojection;
 		};
@@ -170,6 +185,338 @@ namespace Projections::Neon
 			return PixelNeon::ToArray<OutPixelType>(tmp);
 		};
 
+		//methods with runtime channels count and layout (see DataLayout) 
+		//are not vectorized, batched methods are overridden below
+		using Projections::Reprojection<T>::ReprojectDataNerestNeighbor;
+		using Projections::Reprojection<T>::ReprojectDataBilinear;
+		using Projections::Reprojection<T>::ReprojectDataBicubic;
+
+		/// <summary>
+		/// Reproject inputData based on reproj with Nerest Neighbor interpolation.
+		/// Same as Projections::Reprojection::ReprojectDataNerestNeighbor,
+		/// but pixels are copied with NEON lane loads (see NearestNeighborGather).
+		/// Unsupported DataType / ChannelsCount combinations and too large
+		/// inputs use scalar version.
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out = DataType*, size_t ChannelsCount = 1>
+		Out ReprojectDataNerestNeighbor(const DataType* inputData, const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			size_t count = static_cast<size_t>(this->outW) * this->outH;
+
+			Out output = Projections::Reprojection<T>::template AllocateOutput<DataType, Out, ChannelsCount>(count);
+
+			this->template ReprojectDataNerestNeighbor<DataType, ChannelsCount>(inputData, 
+				Projections::Reprojection<T>::template GetOutputData<DataType>(output), 
+				static_cast<size_t>(this->outW) * ChannelsCount, NO_VALUE, threadsCount);
+
+			return output;
+		}
+
+		/// <summary>
+		/// Same as ReprojectDataNerestNeighbor above, but output is written to caller-provided 
+		/// memory with row pitch (see Projections::Reprojection::ReprojectDataNerestNeighbor)
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="outputData"></param>
+		/// <param name="outputRowPitch"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, size_t ChannelsCount = 1>
+		void ReprojectDataNerestNeighbor(const DataType* inputData, DataType* outputData, size_t outputRowPitch,
+			const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			using Gather = NearestNeighborGather<T, DataType, ChannelsCount>;
+
+			if constexpr (Gather::IsSupported())
+			{
+				if (Gather::IsInputSupported(this->inW, this->inH))
+				{
+					Gather gather(inputData, this->inW, this->inH, NO_VALUE);
+
+					if (this->gatherPlan.IsEmpty() == false)
+					{
+						Projections::Reprojection<T>::template ReprojectDataTilesTo<DataType, ChannelsCount>(
+							this->pixels.data(), this->outW, &this->validSpans, this->gatherPlan,
+							outputData, outputRowPitch, NO_VALUE,
+							[&](const Projections::Pixel<T>* pixels, int count, DataType* out) {
+							gather.CopySegment(pixels, count, out);
+						},
+							[&](const Projections::Pixel<T>& p) {
+							Projections::Reprojection<T>::template PrefetchNearestNeighbor<DataType, ChannelsCount>(inputData, this->inW, p);
+						}, threadsCount);
+						return;
+					}
+
+					Projections::Reprojection<T>::template ReprojectDataSegmentsTo<DataType, ChannelsCount>(
+						this->pixels.data(), this->outW, this->outH, &this->validSpans, 
+						outputData, outputRowPitch, NO_VALUE,
+						[&](const Projections::Pixel<T>* pixels, int count, DataType* out) {
+						gather.CopySegment(pixels, count, out);
+					}, threadsCount);
+					return;
+				}
+			}
+
+			Projections::Reprojection<T>::template ReprojectDataNerestNeighbor<DataType, ChannelsCount>(inputData, outputData, outputRowPitch, NO_VALUE, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject inputData based on reproj with Bilinear interpolation.
+		/// Same as Projections::Reprojection::ReprojectDataBilinear,
+		/// but pixels are interpolated in NEON lanes (see InterpolationGather).
+		/// float data and uint16_t data with real positions are computed in float, 
+		/// other integral data in fixed point with Fixed24_8 positions.
+		/// Unsupported DataType / ChannelsCount combinations and too large
+		/// inputs use scalar version.
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out = DataType*, size_t ChannelsCount = 1>
+		Out ReprojectDataBilinear(const DataType* inputData, const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			size_t count = static_cast<size_t>(this->outW) * this->outH;
+
+			Out output = Projections::Reprojection<T>::template AllocateOutput<DataType, Out, ChannelsCount>(count);
+
+			this->template ReprojectDataBilinear<DataType, ChannelsCount>(inputData, 
+				Projections::Reprojection<T>::template GetOutputData<DataType>(output), 
+				static_cast<size_t>(this->outW) * ChannelsCount, NO_VALUE, threadsCount);
+
+			return output;
+		}
+
+		/// <summary>
+		/// Same as ReprojectDataBilinear above, but output is written to caller-provided 
+		/// memory with row pitch (see Projections::Reprojection::ReprojectDataBilinear)
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="outputData"></param>
+		/// <param name="outputRowPitch"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, size_t ChannelsCount = 1>
+		void ReprojectDataBilinear(const DataType* inputData, DataType* outputData, size_t outputRowPitch,
+			const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			using Gather = InterpolationGather<T, DataType, ChannelsCount>;
+
+			if constexpr (Gather::IsSupported())
+			{
+				if (Gather::IsInputSupported(this->inW, this->inH))
+				{
+					Gather gather(inputData, this->inW, this->inH, NO_VALUE);
+
+					if (this->gatherPlan.IsEmpty() == false)
+					{
+						Projections::Reprojection<T>::template ReprojectDataTilesTo<DataType, ChannelsCount>(
+							this->pixels.data(), this->outW, &this->validSpans, this->gatherPlan,
+							outputData, outputRowPitch, NO_VALUE,
+							[&](const Projections::Pixel<T>* pixels, int count, DataType* out) {
+							gather.BilinearSegment(pixels, count, out);
+						},
+							[&](const Projections::Pixel<T>& p) {
+							Projections::Reprojection<T>::template PrefetchBilinear<DataType, ChannelsCount>(inputData, this->inW, this->inH, p);
+						}, threadsCount);
+						return;
+					}
+
+					Projections::Reprojection<T>::template ReprojectDataSegmentsTo<DataType, ChannelsCount>(
+						this->pixels.data(), this->outW, this->outH, &this->validSpans, 
+						outputData, outputRowPitch, NO_VALUE,
+						[&](const Projections::Pixel<T>* pixels, int count, DataType* out) {
+						gather.BilinearSegment(pixels, count, out);
+					}, threadsCount);
+					return;
+				}
+			}
+
+			Projections::Reprojection<T>::template ReprojectDataBilinear<DataType, ChannelsCount>(inputData, outputData, outputRowPitch, NO_VALUE, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject inputData based on reproj with Bicubic interpolation.
+		/// Same as Projections::Reprojection::ReprojectDataBicubic,
+		/// but pixels are interpolated in NEON lanes (see InterpolationGather).
+		/// float data and uint16_t data with real positions are computed in float, 
+		/// other integral data in fixed point with Fixed24_8 positions.
+		/// Unsupported DataType / ChannelsCount combinations and too large
+		/// inputs use scalar version.
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		/// <returns></returns>
+		template <typename DataType, typename Out = DataType*, size_t ChannelsCount = 1>
+		Out ReprojectDataBicubic(const DataType* inputData, const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			size_t count = static_cast<size_t>(this->outW) * this->outH;
+
+			Out output = Projections::Reprojection<T>::template AllocateOutput<DataType, Out, ChannelsCount>(count);
+
+			this->template ReprojectDataBicubic<DataType, ChannelsCount>(inputData, 
+				Projections::Reprojection<T>::template GetOutputData<DataType>(output), 
+				static_cast<size_t>(this->outW) * ChannelsCount, NO_VALUE, threadsCount);
+
+			return output;
+		}
+
+		/// <summary>
+		/// Same as ReprojectDataBicubic above, but output is written to caller-provided 
+		/// memory with row pitch (see Projections::Reprojection::ReprojectDataBicubic)
+		/// </summary>
+		/// <param name="inputData"></param>
+		/// <param name="outputData"></param>
+		/// <param name="outputRowPitch"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, size_t ChannelsCount = 1>
+		void ReprojectDataBicubic(const DataType* inputData, DataType* outputData, size_t outputRowPitch,
+			const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			using Gather = InterpolationGather<T, DataType, ChannelsCount>;
+
+			if constexpr (Gather::IsSupported())
+			{
+				if (Gather::IsInputSupported(this->inW, this->inH))
+				{
+					Gather gather(inputData, this->inW, this->inH, NO_VALUE);
+
+					Projections::Reprojection<T>::template ReprojectDataSegmentsTo<DataType, ChannelsCount>(
+						this->pixels.data(), this->outW, this->outH, &this->validSpans, 
+						outputData, outputRowPitch, NO_VALUE,
+						[&](const Projections::Pixel<T>* pixels, int count, DataType* out) {
+						gather.BicubicSegment(pixels, count, out);
+					}, threadsCount);
+					return;
+				}
+			}
+
+			Projections::Reprojection<T>::template ReprojectDataBicubic<DataType, ChannelsCount>(inputData, outputData, outputRowPitch, NO_VALUE, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject framesCount inputs with the same geometry with Nerest Neighbor interpolation.
+		/// Same as batched Projections::Reprojection::ReprojectDataNerestNeighbor, 
+		/// but inputs are processed with the same kernels as single input
+		/// </summary>
+		/// <param name="inputs"></param>
+		/// <param name="outputs"></param>
+		/// <param name="framesCount"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, size_t ChannelsCount = 1>
+		void ReprojectDataNerestNeighbor(const DataType* const* inputs, DataType* const* outputs, size_t framesCount,
+			const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			using Gather = NearestNeighborGather<T, DataType, ChannelsCount>;
+
+			if constexpr (Gather::IsSupported())
+			{
+				if (Gather::IsInputSupported(this->inW, this->inH))
+				{
+					std::vector<Gather> gathers;
+					gathers.reserve(framesCount);
+					for (size_t i = 0; i < framesCount; i++)
+					{
+						gathers.emplace_back(inputs[i], this->inW, this->inH, NO_VALUE);
+					}
+
+					Projections::Reprojection<T>::template ReprojectDataSegmentsBatch<DataType, ChannelsCount>(
+						this->pixels.data(), this->outW, this->outH, &this->validSpans, outputs, framesCount, NO_VALUE,
+						[&](size_t frame, const Projections::Pixel<T>* pixels, int count, DataType* out) {
+						gathers[frame].CopySegment(pixels, count, out);
+					}, threadsCount);
+					return;
+				}
+			}
+
+			Projections::Reprojection<T>::template ReprojectDataNerestNeighbor<DataType, ChannelsCount>(inputs, outputs, framesCount, NO_VALUE, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject framesCount inputs with the same geometry with Bilinear interpolation.
+		/// Same as batched Projections::Reprojection::ReprojectDataBilinear, 
+		/// but inputs are processed with the same kernels as single input
+		/// </summary>
+		/// <param name="inputs"></param>
+		/// <param name="outputs"></param>
+		/// <param name="framesCount"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, size_t ChannelsCount = 1>
+		void ReprojectDataBilinear(const DataType* const* inputs, DataType* const* outputs, size_t framesCount,
+			const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			using Gather = InterpolationGather<T, DataType, ChannelsCount>;
+
+			if constexpr (Gather::IsSupported())
+			{
+				if (Gather::IsInputSupported(this->inW, this->inH))
+				{
+					std::vector<Gather> gathers;
+					gathers.reserve(framesCount);
+					for (size_t i = 0; i < framesCount; i++)
+					{
+						gathers.emplace_back(inputs[i], this->inW, this->inH, NO_VALUE);
+					}
+
+					Projections::Reprojection<T>::template ReprojectDataSegmentsBatch<DataType, ChannelsCount>(
+						this->pixels.data(), this->outW, this->outH, &this->validSpans, outputs, framesCount, NO_VALUE,
+						[&](size_t frame, const Projections::Pixel<T>* pixels, int count, DataType* out) {
+						gathers[frame].BilinearSegment(pixels, count, out);
+					}, threadsCount);
+					return;
+				}
+			}
+
+			Projections::Reprojection<T>::template ReprojectDataBilinear<DataType, ChannelsCount>(inputs, outputs, framesCount, NO_VALUE, threadsCount);
+		}
+
+		/// <summary>
+		/// Reproject framesCount inputs with the same geometry with Bicubic interpolation.
+		/// Same as batched Projections::Reprojection::ReprojectDataBicubic, 
+		/// but inputs are processed with the same kernels as single input
+		/// </summary>
+		/// <param name="inputs"></param>
+		/// <param name="outputs"></param>
+		/// <param name="framesCount"></param>
+		/// <param name="NO_VALUE"></param>
+		/// <param name="threadsCount"></param>
+		template <typename DataType, size_t ChannelsCount = 1>
+		void ReprojectDataBicubic(const DataType* const* inputs, DataType* const* outputs, size_t framesCount,
+			const DataType NO_VALUE, size_t threadsCount = 1) const
+		{
+			using Gather = InterpolationGather<T, DataType, ChannelsCount>;
+
+			if constexpr (Gather::IsSupported())
+			{
+				if (Gather::IsInputSupported(this->inW, this->inH))
+				{
+					std::vector<Gather> gathers;
+					gathers.reserve(framesCount);
+					for (size_t i = 0; i < framesCount; i++)
+					{
+						gathers.emplace_back(inputs[i], this->inW, this->inH, NO_VALUE);
+					}
+
+					Projections::Reprojection<T>::template ReprojectDataSegmentsBatch<DataType, ChannelsCount>(
+						this->pixels.data(), this->outW, this->outH, &this->validSpans, outputs, framesCount, NO_VALUE,
+						[&](size_t frame, const Projections::Pixel<T>* pixels, int count, DataType* out) {
+						gathers[frame].BicubicSegment(pixels, count, out);
+					}, threadsCount);
+					return;
+				}
+			}
+
+			Projections::Reprojection<T>::template ReprojectDataBicubic<DataType, ChannelsCount>(inputs, outputs, framesCount, NO_VALUE, threadsCount);
+		}
+
 	};
 }
 
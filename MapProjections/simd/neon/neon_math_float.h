@@ -35,6 +35,40 @@
 
 
 
+//=============================================================================
+
+/* a / b computed for 4 float at once
+   ARMv7 has no division, reciprocal estimate is refined by two Newton steps
+*/
+static inline float32x4_t my_div_f32(const float32x4_t & a, const float32x4_t & b)
+{
+#if defined(__aarch64__) || defined(__arm64__) || defined(vdivq_f32)
+	return vdivq_f32(a, b);
+#else
+	float32x4_t r = vrecpeq_f32(b);
+	r = vmulq_f32(vrecpsq_f32(b, r), r);
+	r = vmulq_f32(vrecpsq_f32(b, r), r);
+	return vmulq_f32(a, r);
+#endif
+}
+
+/* sqrt() computed for 4 float at once
+   ARMv7 has no square root, reciprocal sqrt estimate is refined by two Newton steps
+*/
+static inline float32x4_t my_sqrt_f32(const float32x4_t & x)
+{
+#if defined(__aarch64__) || defined(__arm64__) || defined(vsqrtq_f32)
+	return vsqrtq_f32(x);
+#else
+	float32x4_t r = vrsqrteq_f32(x);
+	r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(x, r), r), r);
+	r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(x, r), r), r);
+	
+	//estimate of 1 / sqrt(0) is inf
+	return my_select_f32(vceqq_f32(x, vdupq_n_f32(0.0f)), x, vmulq_f32(x, r));
+#endif
+}
+
 //=============================================================================
 
 
@@ -209,6 +243,38 @@ static float32x4_t my_pow_f32(const float32x4_t & x, const float32x4_t & y)
 	return my_exp_f32(vmulq_f32(y, tmp));
 }
 
+/* sinh() computed for 4 float at once
+   for |x| <= 1 polynomial from cephes is used (exp(x) - exp(-x) loses precision)
+*/
+static float32x4_t my_sinh_f32(float32x4_t x)
+{
+	const float32x4_t c_05 = vdupq_n_f32(0.5f);
+	const float32x4_t c_1 = vdupq_n_f32(1.0f);
+
+	uint32x4_t small = vcleq_f32(vabsq_f32(x), c_1);
+
+	float32x4_t z = vmulq_f32(x, x);
+	float32x4_t pz = vmlaq_f32(vdupq_n_f32(8.33028376239E-3f), z, vdupq_n_f32(2.03721912945E-4f));
+	pz = vmlaq_f32(vdupq_n_f32(1.66667160211E-1f), pz, z);
+	pz = vmulq_f32(pz, z);
+	float32x4_t ySmall = vmlaq_f32(x, pz, x);
+
+	float32x4_t e = my_exp_f32(x);
+	float32x4_t yBig = vmulq_f32(c_05, vsubq_f32(e, my_div_f32(c_1, e)));
+
+	return my_select_f32(small, ySmall, yBig);
+}
+
+/* cosh() computed for 4 float at once */
+static float32x4_t my_cosh_f32(float32x4_t x)
+{
+	const float32x4_t c_05 = vdupq_n_f32(0.5f);
+	const float32x4_t c_1 = vdupq_n_f32(1.0f);
+
+	float32x4_t e = my_exp_f32(x);
+	return vmulq_f32(c_05, vaddq_f32(e, my_div_f32(c_1, e)));
+}
+
 //=============================================================================
 
 enum class NeonSinCos {
@@ -525,9 +591,11 @@ static float32x4_t my_atan2_f32(float32x4_t y, float32x4_t x)
 	s = my_select_f32(swapxy, vsubq_f32(vdupq_n_f32(PIO2F), s), s);
 	s = my_select_f32(signBitX, vsubq_f32(vdupq_n_f32(PIF), s), s);
 
-	//re = select((x | y) == 0.f, 0.f, re);    // atan2(0,0) = 0 by convention
+	s = my_select_f32(signBitY, my_swap_sign_f32(s), s);
 
-	return my_select_f32(signBitY, my_swap_sign_f32(s), s);
+	// atan2(0,0) = 0 by convention
+	uint32x4_t zero = vandq_u32(vceqq_f32(x, c_0), vceqq_f32(y, c_0));
+	return my_select_f32(zero, c_0, s);
 }
 
 
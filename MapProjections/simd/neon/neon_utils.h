@@ -3,7 +3,7 @@
 
 
 #ifdef HAVE_NEON
-#	if defined(_WIN32) || defined(__i386__) || defined(__AVX__)
+#	if defined(_WIN32) || defined(__i386__) || defined(__x86_64__) || defined(__AVX__)
 #		if __has_include("./NEON_2_SSE.h")
 #			include "./NEON_2_SSE.h"
 #		else
@@ -2,6 +2,12 @@
 
 #include <vector>
 #include <iostream>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <filesystem>
 
 //================================================================
 // Standard
@@ -27,6 +33,10 @@
 #include "./simd/avx/Projections/GEOS_avx.h"
 #include "./simd/avx/Projections/Equirectangular_avx.h"
 #include "./simd/avx/Projections/AEQD_avx.h"
+#include "./simd/avx/Projections/LambertConic_avx.h"
+#include "./simd/avx/Projections/LambertAzimuthal_avx.h"
+#include "./simd/avx/Projections/PolarSteregographic_avx.h"
+#include "./simd/avx/Projections/TransverseMercator_avx.h"
 #include "./simd/avx/MapProjectionUtils_avx.h"
 #include "./simd/avx/Reprojection_avx.h"
 
@@ -37,12 +47,28 @@
 #include "./simd/neon/ProjectionInfo_neon.h"
 #include "./simd/neon/Projections/Mercator_neon.h"
 #include "./simd/neon/Projections/Equirectangular_neon.h"
+#include "./simd/neon/Projections/Miller_neon.h"
+#include "./simd/neon/Projections/GEOS_neon.h"
+#include "./simd/neon/Projections/AEQD_neon.h"
+#include "./simd/neon/Projections/LambertConic_neon.h"
+#include "./simd/neon/Projections/LambertAzimuthal_neon.h"
+#include "./simd/neon/Projections/PolarSteregographic_neon.h"
+#include "./simd/neon/Projections/TransverseMercator_neon.h"
 #include "./simd/neon/MapProjectionUtils_neon.h"
 #include "./simd/neon/Reprojection_neon.h"
 
 //================================================================
 
 #include "./PoleRotationTransform.h"
+#include "./SeparableReprojection.h"
+#include "./InterpolationPlan.h"
+#include "./AreaPlan.h"
+#include "./BufferPool.h"
+#include "./CompressedReprojection.h"
+#include "./MappedReprojection.h"
+#include "./ReprojectionCache.h"
+#include "./StreamingReprojection.h"
+#include "./PngStreamDecoder.h"
 #include "./ProjectionRenderer.h"
 #include "./MapProjectionUtils.h"
 #include "./CountriesUtils.h"
@@ -149,7 +175,7 @@ void TestGEOS_Neon()
 {
 	std::cout << "TestGEOS_Neon" << std::endl;
 
-	TestGeos<GEOS, nsNeon::Mercator, Reprojection>("D://goes16_to_mercator_neon.png");
+	TestGeos<nsNeon::GEOS, nsNeon::Mercator, nsNeon::Reprojection>("D://goes16_to_mercator_neon.png");
 }
 
 //================================================================
@@ -524,6 +550,2411 @@ void TestWrapAround()
 
 //================================================================
 
+template <typename Input, typename Output, template <class> class Reproj>
+void TestWrapAroundSimd(const char* name)
+{
+	Projections::Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	Input eq;
+	eq.SetRawFrame(bbMin, bbMax, 2048, 1024, Projections::STEP_TYPE::PIXEL_BORDER, false);
+
+	//world is repeated 5 times
+	bbMin.lat = -80.0_deg; bbMin.lon = -900.0_deg;
+	bbMax.lat = 80.0_deg; bbMax.lon = 900.0_deg;
+
+	Output merc;
+	merc.SetRawFrame(bbMin, bbMax, 3600, 800, Projections::STEP_TYPE::PIXEL_BORDER, false);
+
+	auto reference = Reprojection<int>::CreateReprojection(&eq, &merc);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	auto reproj = Reproj<int>::template CreateReprojection<Input, Output>(&eq, &merc);
+	auto end = std::chrono::high_resolution_clock::now();
+
+	size_t diffCount = 0;
+	for (size_t i = 0; i < reference.pixels.size(); i++)
+	{
+		if ((reference.pixels[i].x != reproj.pixels[i].x) || (reference.pixels[i].y != reproj.pixels[i].y))
+		{
+			diffCount++;
+		}
+	}
+
+	std::cout << name << ": " << std::chrono::duration<double, std::milli>(end - start).count() << "ms, "
+		<< "different pixels: " << diffCount << std::endl;
+}
+
+void TestWrapAroundSimd()
+{
+	std::cout << "TestWrapAroundSimd" << std::endl;
+
+	TestWrapAroundSimd<Equirectangular, Mercator, Reprojection>("CPU");
+	TestWrapAroundSimd<nsAvx::Equirectangular, nsAvx::Mercator, nsAvx::Reprojection>("AVX");
+	TestWrapAroundSimd<nsNeon::Equirectangular, nsNeon::Mercator, nsNeon::Reprojection>("Neon");
+}
+
+//================================================================
+
+template <typename T>
+bool IsSameReprojection(const Reprojection<T>& a, const Reprojection<T>& b)
+{
+	if ((a.inW != b.inW) || (a.inH != b.inH) || (a.outW != b.outW) || (a.outH != b.outH))
+	{
+		return false;
+	}
+
+	if (a.pixels.size() != b.pixels.size())
+	{
+		return false;
+	}
+
+	return std::memcmp(a.pixels.data(), b.pixels.data(), a.pixels.size() * sizeof(Pixel<T>)) == 0;
+}
+
+void TestParallelReprojection()
+{
+	std::cout << "TestParallelReprojection" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	GEOS geos(GEOS::SatelliteSettings::Goes16());
+	geos.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	bbMin.lat = -45.0_deg; bbMin.lon = -135.0_deg;
+	bbMax.lat = 45.0_deg; bbMax.lon = -10.0_deg;
+
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 2100, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	auto serial = Reprojection<short>::CreateReprojection(&geos, &mercator);
+	auto end = std::chrono::high_resolution_clock::now();
+	std::cout << "Serial: " << std::chrono::duration<double, std::milli>(end - start).count() << "ms" << std::endl;
+
+	start = std::chrono::high_resolution_clock::now();
+	auto parallel = Reprojection<short>::CreateReprojection(&geos, &mercator, 0);
+	end = std::chrono::high_resolution_clock::now();
+	std::cout << "Parallel: " << std::chrono::duration<double, std::milli>(end - start).count() << "ms" << std::endl;
+
+	std::cout << "GEOS -> Mercator same: " << (IsSameReprojection(serial, parallel) ? "OK" : "FAILED") << std::endl;
+
+	//wrap around frame
+	bbMin.lat = -80.93_deg; bbMin.lon = -650.0_deg;
+	bbMax.lat = 80.06_deg; bbMax.lon = -150.0_deg;
+
+	Mercator merc;
+	merc.SetRawFrame(bbMin, bbMax, 2880, 1441, STEP_TYPE::PIXEL_BORDER, true);
+
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	Equirectangular eq;
+	eq.SetRawFrame(bbMin, bbMax, 2048, 1024, STEP_TYPE::PIXEL_BORDER, false);
+
+	auto serialWrap = Reprojection<int>::CreateReprojection(&eq, &merc);
+	auto parallelWrap = Reprojection<int>::CreateReprojection(&eq, &merc, 3);
+
+	std::cout << "Wrap around same: " << (IsSameReprojection(serialWrap, parallelWrap) ? "OK" : "FAILED") << std::endl;
+}
+
+//================================================================
+
+template <typename T, typename Input, typename Output>
+void CompareApproximation(const char* name, Input* in, Output* out)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	auto exact = Reprojection<T>::CreateReprojection(in, out);
+	auto end = std::chrono::high_resolution_clock::now();
+	double exactTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	auto approx = Reprojection<T>::CreateReprojectionApproximate(in, out, 0.125);
+	end = std::chrono::high_resolution_clock::now();
+	double approxTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+	double maxError = 0;
+	size_t validityDiff = 0;
+	for (size_t i = 0; i < exact.pixels.size(); i++)
+	{
+		bool ve = (exact.pixels[i].x != -1);
+		bool va = (approx.pixels[i].x != -1);
+		if (ve != va)
+		{
+			validityDiff++;
+			continue;
+		}
+		if (!ve) continue;
+		maxError = std::max<double>(maxError, std::abs(exact.pixels[i].x - approx.pixels[i].x));
+		maxError = std::max<double>(maxError, std::abs(exact.pixels[i].y - approx.pixels[i].y));
+	}
+
+	std::cout << name << ": exact " << exactTime << "ms, approximate " << approxTime << "ms, max error: " 
+		<< maxError << " px, validity differs: " << validityDiff << " px" << std::endl;
+}
+
+void TestApproximateReprojection()
+{
+	std::cout << "TestApproximateReprojection" << std::endl;
+
+	Projections::Coordinate bbMin, bbMax;
+	bbMin.lat = 21.140547_deg; bbMin.lon = -134.09548_deg;
+	bbMax.lat = 52.6132742_deg; bbMax.lon = -60.9365_deg;
+
+	LambertConic lam(38.5_deg, -97.5_deg, 38.5_deg);
+	lam.SetFrameWithAdjustment(bbMin, bbMax, 1799, 1059, Projections::STEP_TYPE::PIXEL_CENTER, false);
+
+	Equirectangular eq;
+	eq.SetFrame(&lam, false);
+
+	CompareApproximation<float>("LambertConic -> Equirectangular", &lam, &eq);
+
+	AEQD aeqd(30.4375_deg, 36.266389_deg, 370);
+	aeqd.CalcBounds(bbMin, bbMax);
+	aeqd.SetFrameWithAdjustment(bbMin, bbMax, 720, 720, Projections::STEP_TYPE::PIXEL_CENTER, false);
+
+	Mercator mercator;
+	mercator.SetFrame(&aeqd, false);
+
+	CompareApproximation<float>("AEQD -> Mercator", &aeqd, &mercator);
+
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	GEOS geos(GEOS::SatelliteSettings::Goes16());
+	geos.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+	
+	bbMin.lat = -45.0_deg; bbMin.lon = -135.0_deg;
+	bbMax.lat = 45.0_deg; bbMax.lon = -10.0_deg;
+
+	Mercator mercator2;
+	mercator2.SetRawFrame(bbMin, bbMax, 2100, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	CompareApproximation<int>("GEOS -> Mercator", &geos, &mercator2);
+	CompareApproximation<int>("Mercator -> GEOS", &mercator2, &geos);
+}
+
+//================================================================
+
+template <typename T, typename Input, typename Output>
+void CompareSeparable(const char* name, Input* in, Output* out)
+{
+	auto dense = Reprojection<T>::CreateReprojection(in, out);
+	auto separable = SeparableReprojection<T>::CreateReprojection(in, out);
+
+	std::vector<float> inputData(static_cast<size_t>(dense.inW) * dense.inH);
+	for (size_t i = 0; i < inputData.size(); i++)
+	{
+		inputData[i] = static_cast<float>(i % 1021);
+	}
+
+	auto nnDense = dense.template ReprojectDataNerestNeighbor<float, std::vector<float>>(inputData.data(), -1.0f);
+	auto nnSep = separable.template ReprojectDataNerestNeighbor<float, std::vector<float>>(inputData.data(), -1.0f);
+
+	auto bilDense = dense.template ReprojectDataBilinear<float, std::vector<float>>(inputData.data(), -1.0f);
+	auto bilSep = separable.template ReprojectDataBilinear<float, std::vector<float>>(inputData.data(), -1.0f);
+
+	auto bicDense = dense.template ReprojectDataBicubic<float, std::vector<float>>(inputData.data(), -1.0f);
+	auto bicSep = separable.template ReprojectDataBicubic<float, std::vector<float>>(inputData.data(), -1.0f);
+
+	separable.SaveToFile("separable_test.bin");
+	auto loaded = SeparableReprojection<T>::CreateFromFile("separable_test.bin");
+	auto nnLoaded = loaded.template ReprojectDataNerestNeighbor<float, std::vector<float>>(inputData.data(), -1.0f);
+
+	std::cout << name << ": dense " << dense.pixels.size() * sizeof(Pixel<T>) << " B, separable "
+		<< (separable.pixelsX.size() + separable.pixelsY.size()) * sizeof(T) << " B" << std::endl;
+	std::cout << "NN same: " << ((nnDense == nnSep) ? "OK" : "FAILED") << std::endl;
+	std::cout << "Bilinear same: " << ((bilDense == bilSep) ? "OK" : "FAILED") << std::endl;
+	std::cout << "Bicubic same: " << ((bicDense == bicSep) ? "OK" : "FAILED") << std::endl;
+	std::cout << "Save / load same: " << ((nnDense == nnLoaded) ? "OK" : "FAILED") << std::endl;
+}
+
+void TestSeparableReprojection()
+{
+	std::cout << "TestSeparableReprojection" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	Equirectangular eq;
+	eq.SetRawFrame(bbMin, bbMax, 2048, 1024, STEP_TYPE::PIXEL_BORDER, false);
+
+	bbMin.lat = -85.0_deg; bbMin.lon = -100.0_deg;
+	bbMax.lat = 85.0_deg; bbMax.lon = 200.0_deg;
+
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 1800, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	CompareSeparable<float>("Equirectangular -> Mercator", &eq, &mercator);
+
+	//wrap around frame
+	bbMin.lat = -80.93_deg; bbMin.lon = -650.0_deg;
+	bbMax.lat = 80.06_deg; bbMax.lon = -150.0_deg;
+
+	Miller miller;
+	miller.SetRawFrame(bbMin, bbMax, 2880, 1441, STEP_TYPE::PIXEL_BORDER, true);
+
+	CompareSeparable<int>("Equirectangular -> Miller (wrap around)", &eq, &miller);
+}
+
+//================================================================
+
+template <typename T, typename Input, typename Output>
+void CompareCompressed(const char* name, Input* in, Output* out)
+{
+	auto dense = Reprojection<T>::CreateReprojection(in, out);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	auto compressed = CompressedReprojection<T>::Compress(dense);
+	auto end = std::chrono::high_resolution_clock::now();
+	double compressTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+	std::vector<uint8_t> inputData(static_cast<size_t>(dense.inW) * dense.inH * 3);
+	for (size_t i = 0; i < inputData.size(); i++)
+	{
+		inputData[i] = static_cast<uint8_t>(i % 251);
+	}
+
+	start = std::chrono::high_resolution_clock::now();
+	auto nnDense = dense.template ReprojectDataNerestNeighbor<uint8_t, std::vector<uint8_t>, 3>(inputData.data(), 0);
+	end = std::chrono::high_resolution_clock::now();
+	double denseTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	auto nnCompressed = compressed.template ReprojectDataNerestNeighbor<uint8_t, std::vector<uint8_t>, 3>(inputData.data(), 0);
+	end = std::chrono::high_resolution_clock::now();
+	double compressedTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+	compressed.SaveToFile("compressed_test.bin");
+	auto loaded = CompressedReprojection<T>::CreateFromFile("compressed_test.bin");
+
+	std::cout << name << ": dense " << dense.pixels.size() * sizeof(Pixel<T>) << " B, compressed "
+		<< compressed.GetCompressedSize() << " B (" << compressTime << "ms)" << std::endl;
+	std::cout << "NN dense " << denseTime << "ms, compressed " << compressedTime << "ms" << std::endl;
+	std::cout << "Decompress same: " << (IsSameReprojection(dense, compressed.Decompress()) ? "OK" : "FAILED") << std::endl;
+	std::cout << "NN same: " << ((nnDense == nnCompressed) ? "OK" : "FAILED") << std::endl;
+	std::cout << "Save / load same: " << (IsSameReprojection(dense, loaded.Decompress()) ? "OK" : "FAILED") << std::endl;
+}
+
+void TestCompressedReprojection()
+{
+	std::cout << "TestCompressedReprojection" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	GEOS geos(GEOS::SatelliteSettings::Goes16());
+	geos.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	bbMin.lat = -45.0_deg; bbMin.lon = -135.0_deg;
+	bbMax.lat = 45.0_deg; bbMax.lon = -10.0_deg;
+
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 2100, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	CompareCompressed<int>("GEOS -> Mercator", &geos, &mercator);
+	CompareCompressed<short>("Mercator -> GEOS", &mercator, &geos);
+
+	//upsampling
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	Equirectangular eq;
+	eq.SetRawFrame(bbMin, bbMax, 512, 256, STEP_TYPE::PIXEL_BORDER, false);
+
+	bbMin.lat = -80.0_deg; bbMin.lon = -100.0_deg;
+	bbMax.lat = 80.0_deg; bbMax.lon = 100.0_deg;
+
+	Mercator mercator2;
+	mercator2.SetRawFrame(bbMin, bbMax, 2400, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	CompareCompressed<int>("Equirectangular -> Mercator (upsampling)", &eq, &mercator2);
+
+	//offset of row 1 behind the end of data must be rejected
+	FILE* f = nullptr;
+	my_fopen(&f, "compressed_test.bin", "r+b");
+	uint64_t badOffset = std::numeric_limits<uint64_t>::max();
+	fseek(f, 4 * sizeof(int) + 2 * sizeof(uint64_t), SEEK_SET);
+	fwrite(&badOffset, sizeof(uint64_t), 1, f);
+	fclose(f);
+
+	auto corrupted = CompressedReprojection<int>::CreateFromFile("compressed_test.bin");
+	std::cout << "Corrupted row offsets rejected: " << ((corrupted.rowOffsets.empty()) ? "OK" : "FAILED") << std::endl;
+}
+
+//================================================================
+
+void TestReprojectionFile()
+{
+	std::cout << "TestReprojectionFile" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	GEOS geos(GEOS::SatelliteSettings::Goes16());
+	geos.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	bbMin.lat = -45.0_deg; bbMin.lon = -135.0_deg;
+	bbMax.lat = 45.0_deg; bbMax.lon = -10.0_deg;
+
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 2100, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	auto reproj = Reprojection<float>::CreateReprojection(&geos, &mercator);
+	reproj.SaveToFile("reprojection_test.bin", &geos, &mercator);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	auto loaded = Reprojection<float>::CreateFromFile("reprojection_test.bin");
+	auto end = std::chrono::high_resolution_clock::now();
+	std::cout << "Load: " << std::chrono::duration<double, std::milli>(end - start).count() << "ms" << std::endl;
+
+	start = std::chrono::high_resolution_clock::now();
+	auto mapped = MappedReprojection<float>::CreateFromFile("reprojection_test.bin");
+	end = std::chrono::high_resolution_clock::now();
+	std::cout << "Map: " << std::chrono::duration<double, std::milli>(end - start).count() << "ms" << std::endl;
+
+	std::cout << "Header: " << mapped.header.fromName << " (" << mapped.header.fromFrameId << ") -> "
+		<< mapped.header.toName << " (" << mapped.header.toFrameId << ")" << std::endl;
+
+	std::cout << "Load same: " << (IsSameReprojection(reproj, loaded) ? "OK" : "FAILED") << std::endl;
+	std::cout << "Map same: " << (IsSameReprojection(reproj, mapped.ToReprojection()) ? "OK" : "FAILED") << std::endl;
+	std::cout << "Checksum: " << (mapped.VerifyChecksum() ? "OK" : "FAILED") << std::endl;
+
+	std::vector<float> inputData(static_cast<size_t>(reproj.inW) * reproj.inH);
+	for (size_t i = 0; i < inputData.size(); i++)
+	{
+		inputData[i] = static_cast<float>(i % 1021);
+	}
+
+	auto a = reproj.ReprojectDataBilinear<float, std::vector<float>>(inputData.data(), -1.0f);
+	auto b = mapped.ReprojectDataBilinear<float, std::vector<float>>(inputData.data(), -1.0f);
+	std::cout << "Mapped bilinear same: " << ((a == b) ? "OK" : "FAILED") << std::endl;
+
+	//wrong pixel type must be rejected
+	auto wrongType = Reprojection<int>::CreateFromFile("reprojection_test.bin");
+	std::cout << "Wrong type rejected: " << ((wrongType.pixels.empty()) ? "OK" : "FAILED") << std::endl;
+
+	//damaged header must be rejected, not loaded as older format
+	//(copy is damaged, reprojection_test.bin is still mapped)
+	reproj.SaveToFile("reprojection_damaged.bin", &geos, &mercator);
+
+	FILE* f = nullptr;
+	my_fopen(&f, "reprojection_damaged.bin", "r+b");
+	uint64_t badCount = loaded.pixels.size() + 1;
+	fseek(f, offsetof(ReprojectionFileHeader, pixelsCount), SEEK_SET);
+	fwrite(&badCount, sizeof(uint64_t), 1, f);
+	fclose(f);
+
+	auto corrupted = Reprojection<float>::CreateFromFile("reprojection_damaged.bin");
+	std::cout << "Damaged header rejected: " << ((corrupted.pixels.empty()) ? "OK" : "FAILED") << std::endl;
+
+	uint32_t badVersion = ReprojectionFileHeader::VERSION + 1;
+	my_fopen(&f, "reprojection_damaged.bin", "r+b");
+	fseek(f, offsetof(ReprojectionFileHeader, version), SEEK_SET);
+	fwrite(&badVersion, sizeof(uint32_t), 1, f);
+	fclose(f);
+
+	auto newerVersion = Reprojection<float>::CreateFromFile("reprojection_damaged.bin");
+	std::cout << "Unknown version rejected: " << ((newerVersion.pixels.empty()) ? "OK" : "FAILED") << std::endl;
+}
+
+//================================================================
+
+void TestReprojectionCache()
+{
+	std::cout << "TestReprojectionCache" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = 21.140547_deg; bbMin.lon = -134.09548_deg;
+	bbMax.lat = 52.6132742_deg; bbMax.lon = -60.9365_deg;
+
+	LambertConic lam(38.5_deg, -97.5_deg, 38.5_deg);
+	lam.SetFrameWithAdjustment(bbMin, bbMax, 800, 600, STEP_TYPE::PIXEL_CENTER, false);
+
+	LambertConic lam2(38.5_deg, -97.5_deg, 38.5_deg, 40.0_deg);
+	lam2.SetFrameWithAdjustment(bbMin, bbMax, 800, 600, STEP_TYPE::PIXEL_CENTER, false);
+
+	LambertConic lam3(lam);
+
+	Equirectangular eq;
+	eq.SetFrame(&lam, false);
+
+	Equirectangular eqRotated;
+	eqRotated.SetFrame(&lam, false);
+	PoleRotationTransform rot({ Longitude::deg(10.0), Latitude::deg(-40.0) });
+	eqRotated.SetLatLonTransform(&rot);
+
+	uint64_t key = ReprojectionCache<int>::CreateKey(&lam, &eq);
+	std::cout << "Same parameters same key: " << ((key == ReprojectionCache<int>::CreateKey(&lam3, &eq)) ? "OK" : "FAILED") << std::endl;
+	std::cout << "Different parallel different key: " << ((key != ReprojectionCache<int>::CreateKey(&lam2, &eq)) ? "OK" : "FAILED") << std::endl;
+	std::cout << "Transform different key: " << ((key != ReprojectionCache<int>::CreateKey(&lam, &eqRotated)) ? "OK" : "FAILED") << std::endl;
+	std::cout << "Pixel type different key: " << ((key != ReprojectionCache<float>::CreateKey(&lam, &eq)) ? "OK" : "FAILED") << std::endl;
+
+	std::string cacheDir = "reprojection_cache_test";
+	std::filesystem::remove_all(cacheDir);
+
+	size_t tableBytes = std::max(Reprojection<int>::CreateReprojection(&lam, &eq).GetBytes(),
+		Reprojection<int>::CreateReprojection(&lam2, &eq).GetBytes());
+
+	{
+		//budget for a single table
+		ReprojectionCache<int> cache(tableBytes, cacheDir);
+
+		//single flight - concurrent requests create table only once
+		std::vector<std::thread> threads;
+		std::vector<ReprojectionCache<int>::ReprojectionPtr> results(4);
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			threads.emplace_back([&, i]() {
+				results[i] = cache.Get(&lam, &eq);
+			});
+		}
+		for (auto& t : threads) t.join();
+
+		bool same = true;
+		for (auto& r : results) same &= (r == results[0]);
+
+		std::cout << "Single flight: " << ((cache.GetStatistics().created == 1) && same ? "OK" : "FAILED") << std::endl;
+		std::cout << "Same as direct: " << (IsSameReprojection(*results[0], Reprojection<int>::CreateReprojection(&lam, &eq)) ? "OK" : "FAILED") << std::endl;
+
+		cache.Get(&lam2, &eq);
+		cache.Get(&lam, &eq);
+
+		auto stats = cache.GetStatistics();
+		std::cout << "LRU eviction: " << ((stats.evicted == 2) && (cache.GetCount() == 1) ? "OK" : "FAILED") << std::endl;
+		std::cout << "Disk tier: " << ((stats.diskHits == 1) ? "OK" : "FAILED") << std::endl;
+
+		size_t tmpFiles = 0;
+		for (const auto& e : std::filesystem::directory_iterator(cacheDir))
+		{
+			if (e.path().filename().string().find(".tmp.") != std::string::npos) tmpFiles++;
+		}
+		std::cout << "No temporary files: " << ((tmpFiles == 0) ? "OK" : "FAILED") << std::endl;
+	}
+
+	{
+		//partially written file is rejected and replaced
+		std::string fileName = ReprojectionCache<int>(0, cacheDir).GetFileName(ReprojectionCache<int>::CreateKey(&lam2, &eq));
+		std::filesystem::resize_file(fileName, std::filesystem::file_size(fileName) / 2);
+
+		ReprojectionCache<int> cache(tableBytes, cacheDir);
+		cache.Get(&lam2, &eq);
+		
+		auto r = Reprojection<int>::CreateFromFile(fileName);
+		std::cout << "Partial file replaced: " << ((cache.GetStatistics().created == 1) && (r.pixels.empty() == false) ? "OK" : "FAILED") << std::endl;
+	}
+
+	ReprojectionCache<int> cache(2 * tableBytes, cacheDir);
+	size_t loaded = cache.WarmUp();
+	cache.Get(&lam, &eq);
+	cache.Get(&lam2, &eq);
+	auto stats = cache.GetStatistics();
+	std::cout << "Warm up: " << ((loaded == 2) && (stats.memoryHits == 2) ? "OK" : "FAILED") << std::endl;
+
+	std::filesystem::remove_all(cacheDir);
+}
+
+//================================================================
+
+void TestValidSpans()
+{
+	std::cout << "TestValidSpans" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 2000, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	GEOS geos(GEOS::SatelliteSettings::Goes16());
+	geos.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	//GEOS full disk - large part of output is outside of the disk
+	auto withSpans = Reprojection<float>::CreateReprojection(&mercator, &geos, 4);
+
+	ReprojectionOptions options;
+	options.buildValidSpans = false;
+	auto withoutSpans = Reprojection<float>::CreateReprojection(&mercator, &geos, 4, options);
+
+	std::cout << "Spans: " << withSpans.validSpans.spans.size() << " in " << withSpans.outH << " rows" << std::endl;
+	std::cout << "Spans skipped: " << (withoutSpans.validSpans.IsEmpty() ? "OK" : "FAILED") << std::endl;
+
+	//spans collected while created must be the same as built from pixels
+	auto isSameSpans = [](const ValidSpans& a, const ValidSpans& b) {
+		if ((a.rowOffsets != b.rowOffsets) || (a.spans.size() != b.spans.size())) return false;
+		for (size_t i = 0; i < a.spans.size(); i++)
+		{
+			if ((a.spans[i].begin != b.spans[i].begin) || (a.spans[i].end != b.spans[i].end)) return false;
+		}
+		return true;
+	};
+
+	auto approximate = Reprojection<float>::CreateReprojectionApproximate(&mercator, &geos, 0.125, 4);
+
+	auto rebuilt = withSpans;
+	rebuilt.BuildValidSpans();
+	auto rebuiltApproximate = approximate;
+	rebuiltApproximate.BuildValidSpans();
+
+	std::cout << "Collected while created: " << ((isSameSpans(withSpans.validSpans, rebuilt.validSpans) &&
+		isSameSpans(approximate.validSpans, rebuiltApproximate.validSpans)) ? "OK" : "FAILED") << std::endl;
+
+	std::vector<uint8_t> inputData(static_cast<size_t>(withSpans.inW) * withSpans.inH * 3);
+	for (size_t i = 0; i < inputData.size(); i++)
+	{
+		inputData[i] = static_cast<uint8_t>(i % 251);
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+	auto a = withoutSpans.ReprojectDataBilinear<uint8_t, std::vector<uint8_t>, 3>(inputData.data(), 0);
+	auto end = std::chrono::high_resolution_clock::now();
+	std::cout << "Bilinear without spans: " << std::chrono::duration<double, std::milli>(end - start).count() << "ms" << std::endl;
+
+	start = std::chrono::high_resolution_clock::now();
+	auto b = withSpans.ReprojectDataBilinear<uint8_t, std::vector<uint8_t>, 3>(inputData.data(), 0);
+	end = std::chrono::high_resolution_clock::now();
+	std::cout << "Bilinear with spans: " << std::chrono::duration<double, std::milli>(end - start).count() << "ms" << std::endl;
+
+	start = std::chrono::high_resolution_clock::now();
+	auto c = withoutSpans.ReprojectDataNerestNeighbor<uint8_t, std::vector<uint8_t>, 3>(inputData.data(), 0);
+	end = std::chrono::high_resolution_clock::now();
+	std::cout << "NN without spans: " << std::chrono::duration<double, std::milli>(end - start).count() << "ms" << std::endl;
+
+	start = std::chrono::high_resolution_clock::now();
+	auto d = withSpans.ReprojectDataNerestNeighbor<uint8_t, std::vector<uint8_t>, 3>(inputData.data(), 0);
+	end = std::chrono::high_resolution_clock::now();
+	std::cout << "NN with spans: " << std::chrono::duration<double, std::milli>(end - start).count() << "ms" << std::endl;
+
+	auto e = withoutSpans.ReprojectDataBicubic<uint8_t, std::vector<uint8_t>, 3>(inputData.data(), 0);
+	auto f = withSpans.ReprojectDataBicubic<uint8_t, std::vector<uint8_t>, 3>(inputData.data(), 0);
+
+	std::cout << "Bilinear same: " << ((a == b) ? "OK" : "FAILED") << std::endl;
+	std::cout << "NN same: " << ((c == d) ? "OK" : "FAILED") << std::endl;
+	std::cout << "Bicubic same: " << ((e == f) ? "OK" : "FAILED") << std::endl;
+}
+
+template <typename T, typename A, typename B, typename C>
+void CompareComposition(const char* name, A* a, B* b, C* c)
+{
+	auto ab = Reprojection<T>::CreateReprojection(a, b);
+	auto bc = Reprojection<T>::CreateReprojection(b, c);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	auto direct = Reprojection<T>::CreateReprojection(a, c);
+	auto end = std::chrono::high_resolution_clock::now();
+	double directTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	auto composed = Reprojection<T>::Compose(ab, bc);
+	end = std::chrono::high_resolution_clock::now();
+	double composedTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+	double maxError = 0;
+	double sumError = 0;
+	size_t validCount = 0;
+	size_t validityDiff = 0;
+	for (size_t i = 0; i < direct.pixels.size(); i++)
+	{
+		bool vd = (direct.pixels[i].x != -1);
+		bool vc = (composed.pixels[i].x != -1);
+		if (vd != vc)
+		{
+			validityDiff++;
+			continue;
+		}
+		if (!vd) continue;
+
+		double err = std::max<double>(std::abs(direct.pixels[i].x - composed.pixels[i].x),
+			std::abs(direct.pixels[i].y - composed.pixels[i].y));
+		maxError = std::max(maxError, err);
+		sumError += err;
+		validCount++;
+	}
+
+	//validity differs only where the intermediate projection does not cover the output
+	std::cout << name << ": direct " << directTime << "ms, composed " << composedTime << "ms, max error: "
+		<< maxError << " px, avg error: " << (sumError / std::max<size_t>(validCount, 1))
+		<< " px, validity differs: " << validityDiff << " px" << std::endl;
+}
+
+void TestComposeReprojection()
+{
+	std::cout << "TestComposeReprojection" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	GEOS geos(GEOS::SatelliteSettings::Goes16());
+	geos.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	//archived product
+	bbMin.lat = -80.0_deg; bbMin.lon = -160.0_deg;
+	bbMax.lat = 80.0_deg; bbMax.lon = 10.0_deg;
+
+	Equirectangular eq;
+	eq.SetRawFrame(bbMin, bbMax, 3000, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	//downstream product
+	bbMin.lat = -45.0_deg; bbMin.lon = -135.0_deg;
+	bbMax.lat = 45.0_deg; bbMax.lon = -10.0_deg;
+
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 2100, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	CompareComposition<float>("GEOS -> Equirectangular -> Mercator (float)", &geos, &eq, &mercator);
+	CompareComposition<int>("GEOS -> Equirectangular -> Mercator (int)", &geos, &eq, &mercator);
+}
+
+void TestInputFootprint()
+{
+	std::cout << "TestInputFootprint" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	//large input - full disk
+	GEOS geos(GEOS::SatelliteSettings::Goes16());
+	geos.SetRawFrame(bbMin, bbMax, 5424, 5424, STEP_TYPE::PIXEL_CENTER, false);
+
+	//small output region
+	bbMin.lat = 25.0_deg; bbMin.lon = -100.0_deg;
+	bbMax.lat = 45.0_deg; bbMax.lon = -70.0_deg;
+
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 1000, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	auto isSameFootprint = [](const InputFootprint& a, const InputFootprint& b) {
+		if ((a.startX != b.startX) || (a.startY != b.startY) || (a.endX != b.endX) || (a.endY != b.endY) ||
+			(a.rows.size() != b.rows.size()))
+		{
+			return false;
+		}
+		for (size_t i = 0; i < a.rows.size(); i++)
+		{
+			if ((a.rows[i].begin != b.rows[i].begin) || (a.rows[i].end != b.rows[i].end)) return false;
+		}
+		return true;
+	};
+
+	//footprint is collected by bands of rows in parallel
+	auto reprojection = Reprojection<float>::CreateReprojection(&geos, &mercator, 4);
+	InputFootprint collected = reprojection.inputFootprint;
+
+	reprojection.BuildInputFootprint();
+	const InputFootprint& fp = reprojection.inputFootprint;
+
+	//input remapped to footprint at the end of creation
+	InputFootprint region;
+	ReprojectionOptions options;
+	options.cropRegion = &region;
+	options.cropMargin = 2; //bicubic reads 2 neighbours
+
+	auto cropped = Reprojection<float>::CreateReprojection(&geos, &mercator, 1, options);
+
+	std::cout << "Footprint: [" << fp.startX << ", " << fp.startY << "] - [" << fp.endX << ", " << fp.endY << "], "
+		<< fp.GetPixelsCount() << " used of " << (static_cast<size_t>(reprojection.inW) * reprojection.inH) << " input pixels" << std::endl;
+
+	std::vector<uint8_t> inputData(static_cast<size_t>(reprojection.inW) * reprojection.inH);
+	for (size_t i = 0; i < inputData.size(); i++)
+	{
+		inputData[i] = static_cast<uint8_t>((i * 7) % 251);
+	}
+
+	auto a = reprojection.ReprojectDataNerestNeighbor<uint8_t, std::vector<uint8_t>>(inputData.data(), 0);
+	auto b = reprojection.ReprojectDataBilinear<uint8_t, std::vector<uint8_t>>(inputData.data(), 0);
+	auto c = reprojection.ReprojectDataBicubic<uint8_t, std::vector<uint8_t>>(inputData.data(), 0);
+
+	int inW = reprojection.inW;
+
+	InputFootprint expected = fp.Expand(2, reprojection.inW, reprojection.inH);
+	bool sameRegion = isSameFootprint(region, expected);
+
+	//crop of reprojection created without options
+	auto croppedLater = reprojection;
+	croppedLater.CropInputToFootprint(2);
+	bool samePixels = IsSameReprojection(croppedLater, cropped) &&
+		isSameFootprint(croppedLater.inputFootprint, cropped.inputFootprint);
+
+	//only the region of input is "decoded"
+	std::vector<uint8_t> regionData(static_cast<size_t>(region.GetWidth()) * region.GetHeight());
+	for (int y = 0; y < region.GetHeight(); y++)
+	{
+		std::copy_n(inputData.data() + region.startX + static_cast<size_t>(y + region.startY) * inW,
+			region.GetWidth(), regionData.data() + static_cast<size_t>(y) * region.GetWidth());
+	}
+
+	std::cout << "Cropped input: " << cropped.inW << "x" << cropped.inH << std::endl;
+
+	auto d = cropped.ReprojectDataNerestNeighbor<uint8_t, std::vector<uint8_t>>(regionData.data(), 0);
+	auto e = cropped.ReprojectDataBilinear<uint8_t, std::vector<uint8_t>>(regionData.data(), 0);
+	auto f = cropped.ReprojectDataBicubic<uint8_t, std::vector<uint8_t>>(regionData.data(), 0);
+
+	bool rowsInside = true;
+	for (int y = 0; y < cropped.outH; y++)
+	{
+		for (int x = 0; x < cropped.outW; x++)
+		{
+			const auto& p = cropped.pixels[x + y * cropped.outW];
+			if (p.x == -1) continue;
+
+			auto r = cropped.inputFootprint.GetRow(static_cast<int>(p.y));
+			if ((p.x < r.begin) || (p.x >= r.end)) rowsInside = false;
+		}
+	}
+
+	std::cout << "Collected while created: " << (isSameFootprint(collected, fp) ? "OK" : "FAILED") << std::endl;
+	std::cout << "Cropped while created: " << ((sameRegion && samePixels) ? "OK" : "FAILED") << std::endl;
+	std::cout << "Row ranges: " << (rowsInside ? "OK" : "FAILED") << std::endl;
+	std::cout << "NN same: " << ((a == d) ? "OK" : "FAILED") << std::endl;
+	std::cout << "Bilinear same: " << ((b == e) ? "OK" : "FAILED") << std::endl;
+	std::cout << "Bicubic same: " << ((c == f) ? "OK" : "FAILED") << std::endl;
+}
+
+template <typename DataType>
+void CompareFixedOutput(const char* name, const std::vector<DataType>& a, const std::vector<DataType>& b, double timeA, double timeB)
+{
+	int maxDiff = 0;
+	for (size_t i = 0; i < a.size(); i++)
+	{
+		maxDiff = std::max(maxDiff, std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i])));
+	}
+
+	std::cout << name << ": float " << timeA << "ms, fixed " << timeB << "ms, max difference: " << maxDiff << std::endl;
+}
+
+void TestFixedPointReprojection()
+{
+	std::cout << "TestFixedPointReprojection" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	GEOS geos(GEOS::SatelliteSettings::Goes16());
+	geos.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	bbMin.lat = -80.0_deg;
+	bbMax.lat = 80.0_deg;
+
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 2000, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	auto reprojFloat = Reprojection<float>::CreateReprojection(&geos, &mercator);
+	auto reprojFixed = Reprojection<Fixed24_8>::CreateReprojection(&geos, &mercator);
+
+	//positions differ only by rounding to 1/256 of pixel
+	double maxError = 0;
+	size_t validityDiff = 0;
+	for (size_t i = 0; i < reprojFloat.pixels.size(); i++)
+	{
+		const auto& a = reprojFloat.pixels[i];
+		const auto& b = reprojFixed.pixels[i];
+		if ((a.x == -1) != (b.x == -1))
+		{
+			validityDiff++;
+			continue;
+		}
+		if (a.x == -1) continue;
+
+		maxError = std::max(maxError, std::abs(a.x - static_cast<double>(b.x)));
+		maxError = std::max(maxError, std::abs(a.y - static_cast<double>(b.y)));
+	}
+
+	std::cout << "Max position error: " << maxError << " px, validity differs: " << validityDiff << " px" << std::endl;
+
+	nsAvx::GEOS geosAvx(GEOS::SatelliteSettings::Goes16());
+	geosAvx.SetFrame(&geos, false);
+
+	nsAvx::Mercator mercatorAvx;
+	mercatorAvx.SetRawFrame(bbMin, bbMax, 2000, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	//fixed point is rounded from AVX float positions
+	auto reprojFloatAvx = nsAvx::Reprojection<float>::CreateReprojection(&geosAvx, &mercatorAvx);
+	auto reprojFixedAvx = nsAvx::Reprojection<Fixed24_8>::CreateReprojection(&geosAvx, &mercatorAvx);
+
+	double maxErrorAvx = 0;
+	size_t validityDiffAvx = 0;
+	for (size_t i = 0; i < reprojFloatAvx.pixels.size(); i++)
+	{
+		const auto& a = reprojFloatAvx.pixels[i];
+		const auto& b = reprojFixedAvx.pixels[i];
+		if ((a.x == -1) != (b.x == -1))
+		{
+			validityDiffAvx++;
+			continue;
+		}
+		if (a.x == -1) continue;
+
+		maxErrorAvx = std::max(maxErrorAvx, std::abs(a.x - static_cast<double>(b.x)));
+		maxErrorAvx = std::max(maxErrorAvx, std::abs(a.y - static_cast<double>(b.y)));
+	}
+
+	std::cout << "AVX max position error: " << maxErrorAvx << " px, validity differs: " << validityDiffAvx << " px" << std::endl;
+
+	reprojFixed.SaveToFile("fixed_test.bin");
+	auto loaded = Reprojection<Fixed24_8>::CreateFromFile("fixed_test.bin");
+	auto loadedWrongType = Reprojection<float>::CreateFromFile("fixed_test.bin");
+
+	bool sameLoaded = (loaded.pixels.size() == reprojFixed.pixels.size()) &&
+		(std::memcmp(loaded.pixels.data(), reprojFixed.pixels.data(), loaded.pixels.size() * sizeof(Pixel<Fixed24_8>)) == 0);
+
+	std::cout << "Save / load: " << (sameLoaded ? "OK" : "FAILED") << std::endl;
+	std::cout << "Load as float rejected: " << (loadedWrongType.pixels.empty() ? "OK" : "FAILED") << std::endl;
+
+	std::remove("fixed_test.bin");
+
+	std::vector<uint8_t> inputData(static_cast<size_t>(reprojFloat.inW) * reprojFloat.inH * 3);
+	for (size_t i = 0; i < inputData.size(); i++)
+	{
+		inputData[i] = static_cast<uint8_t>((i * 7) % 251);
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+	auto a = reprojFloat.ReprojectDataBilinear<uint8_t, std::vector<uint8_t>, 3>(inputData.data(), 0);
+	auto end = std::chrono::high_resolution_clock::now();
+	double timeA = std::chrono::duration<double, std::milli>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	auto b = reprojFixed.ReprojectDataBilinear<uint8_t, std::vector<uint8_t>, 3>(inputData.data(), 0);
+	end = std::chrono::high_resolution_clock::now();
+	double timeB = std::chrono::duration<double, std::milli>(end - start).count();
+
+	CompareFixedOutput("Bilinear", a, b, timeA, timeB);
+
+	start = std::chrono::high_resolution_clock::now();
+	a = reprojFloat.ReprojectDataBicubic<uint8_t, std::vector<uint8_t>, 3>(inputData.data(), 0);
+	end = std::chrono::high_resolution_clock::now();
+	timeA = std::chrono::duration<double, std::milli>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	b = reprojFixed.ReprojectDataBicubic<uint8_t, std::vector<uint8_t>, 3>(inputData.data(), 0);
+	end = std::chrono::high_resolution_clock::now();
+	timeB = std::chrono::duration<double, std::milli>(end - start).count();
+
+	CompareFixedOutput("Bicubic", a, b, timeA, timeB);
+
+	a = reprojFloat.ReprojectDataNerestNeighbor<uint8_t, std::vector<uint8_t>, 3>(inputData.data(), 0);
+	b = reprojFixed.ReprojectDataNerestNeighbor<uint8_t, std::vector<uint8_t>, 3>(inputData.data(), 0);
+
+	size_t nnDiff = 0;
+	for (size_t i = 0; i < a.size(); i++) if (a[i] != b[i]) nnDiff++;
+	std::cout << "NN different values: " << nnDiff << std::endl;
+}
+
+template <typename Plan, typename Kernel>
+void CompareInterpolationPlan(const char* name, const Reprojection<float>& reprojection, 
+	const std::vector<uint8_t>& inputData, int stepsCount, Kernel kernel)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	std::vector<uint8_t> a;
+	for (int i = 0; i < stepsCount; i++)
+	{
+		a = kernel(inputData.data());
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	double kernelTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	Plan plan = Plan::Create(reprojection);
+	end = std::chrono::high_resolution_clock::now();
+	double createTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	std::vector<uint8_t> b;
+	for (int i = 0; i < stepsCount; i++)
+	{
+		b = plan.template Apply<uint8_t, std::vector<uint8_t>, 3>(inputData.data(), 0);
+	}
+	end = std::chrono::high_resolution_clock::now();
+	double planTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+	int maxDiff = 0;
+	for (size_t i = 0; i < a.size(); i++)
+	{
+		maxDiff = std::max(maxDiff, std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i])));
+	}
+
+	std::cout << name << " (" << stepsCount << " steps): kernel " << kernelTime << "ms, plan " << planTime 
+		<< "ms (+ " << createTime << "ms creation, " << (plan.GetBytes() / (1024 * 1024)) << " MB), max difference: " << maxDiff << std::endl;
+}
+
+void TestInterpolationPlan()
+{
+	std::cout << "TestInterpolationPlan" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	GEOS geos(GEOS::SatelliteSettings::Goes16());
+	geos.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	bbMin.lat = -80.0_deg;
+	bbMax.lat = 80.0_deg;
+
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 2000, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	auto reprojection = Reprojection<float>::CreateReprojection(&geos, &mercator);
+
+	std::vector<uint8_t> inputData(static_cast<size_t>(reprojection.inW) * reprojection.inH * 3);
+	for (size_t i = 0; i < inputData.size(); i++)
+	{
+		inputData[i] = static_cast<uint8_t>((i * 7) % 251);
+	}
+
+	const int stepsCount = 10;
+
+	//bilinear is not worth the plan, only for comparison
+	CompareInterpolationPlan<InterpolationPlan<BilinearFilter>>("Bilinear", reprojection, inputData, stepsCount, [&](const uint8_t* data) {
+		return reprojection.ReprojectDataBilinear<uint8_t, std::vector<uint8_t>, 3>(data, 0);
+	});
+
+	CompareInterpolationPlan<BicubicPlan>("Bicubic", reprojection, inputData, stepsCount, [&](const uint8_t* data) {
+		return reprojection.ReprojectDataBicubic<uint8_t, std::vector<uint8_t>, 3>(data, 0);
+	});
+
+	//float data - plan keeps exact fractions, so results differ only by rounding
+	std::vector<float> inputDataFloat(static_cast<size_t>(reprojection.inW) * reprojection.inH);
+	for (size_t i = 0; i < inputDataFloat.size(); i++)
+	{
+		inputDataFloat[i] = static_cast<float>(i % 1000) * 0.1f;
+	}
+
+	auto c = reprojection.ReprojectDataBicubic<float, std::vector<float>>(inputDataFloat.data(), -1.0f);
+	auto d = BicubicPlan::Create(reprojection).Apply<float, std::vector<float>>(inputDataFloat.data(), -1.0f);
+
+	double maxDiff = 0;
+	for (size_t i = 0; i < c.size(); i++)
+	{
+		maxDiff = std::max(maxDiff, static_cast<double>(std::abs(c[i] - d[i])));
+	}
+	std::cout << "Bicubic float max difference: " << maxDiff << std::endl;
+}
+
+template <typename FromProj, typename ToProj, typename FromProjF, typename ToProjF>
+void ComparePrecision(const char* name, FromProj* from, ToProj* to, FromProjF* fromF, ToProjF* toF)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	auto reprojDouble = Reprojection<float>::CreateReprojection(from, to);
+	auto end = std::chrono::high_resolution_clock::now();
+	auto elapsedDouble = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	auto reprojFloat = Reprojection<float>::CreateReprojection(fromF, toF);
+	end = std::chrono::high_resolution_clock::now();
+	auto elapsedFloat = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	double maxError = 0;
+	size_t validityDiff = 0;
+	for (size_t i = 0; i < reprojDouble.pixels.size(); i++)
+	{
+		const auto& a = reprojDouble.pixels[i];
+		const auto& b = reprojFloat.pixels[i];
+		if ((a.x == -1) != (b.x == -1))
+		{
+			validityDiff++;
+			continue;
+		}
+		if (a.x == -1) continue;
+
+		maxError = std::max(maxError, static_cast<double>(std::abs(a.x - b.x)));
+		maxError = std::max(maxError, static_cast<double>(std::abs(a.y - b.y)));
+	}
+
+	std::cout << name << " - double: " << elapsedDouble << "ms, float: " << elapsedFloat << "ms, ";
+	std::cout << "max position error: " << maxError << " px, validity differs: " << validityDiff << " px" << std::endl;
+}
+
+void TestProjectionPrecision()
+{
+	std::cout << "TestProjectionPrecision" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -80.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 80.0_deg; bbMax.lon = 180.0_deg;
+
+	Equirectangular eq;
+	eq.SetRawFrame(bbMin, bbMax, 2000, 1000, STEP_TYPE::PIXEL_CENTER, false);
+
+	EquirectangularT<float> eqFloat;
+	eqFloat.SetRawFrame(bbMin, bbMax, 2000, 1000, STEP_TYPE::PIXEL_CENTER, false);
+
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 2000, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	MercatorT<float> mercatorFloat;
+	mercatorFloat.SetRawFrame(bbMin, bbMax, 2000, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	//same parameters, but other numeric type => other pixels
+	if (mercator.GetFingerprint() == mercatorFloat.GetFingerprint())
+	{
+		std::cout << "Fingerprint of float projection is same as double" << std::endl;
+	}
+
+	ComparePrecision("Equirectangular -> Mercator", &eq, &mercator, &eqFloat, &mercatorFloat);
+
+	bbMin.lat = -90.0_deg;
+	bbMax.lat = 90.0_deg;
+
+	GEOS geos(GEOS::SatelliteSettings::Goes16());
+	geos.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	GEOST<float> geosFloat(GEOS::SatelliteSettings::Goes16());
+	geosFloat.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	//precision is lost near the limb of the disk
+	ComparePrecision("GEOS -> Equirectangular", &geos, &eq, &geosFloat, &eqFloat);
+	ComparePrecision("Equirectangular -> GEOS", &eq, &geos, &eqFloat, &geosFloat);
+}
+
+template <typename Method>
+void CompareParallelReprojectData(const char* name, size_t count, Method method)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	auto serial = method(1);
+	auto end = std::chrono::high_resolution_clock::now();
+	auto elapsedSerial = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	auto parallel = method(0);
+	end = std::chrono::high_resolution_clock::now();
+	auto elapsedParallel = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	//more threads than bands of small outputs - bands are stolen
+	auto stolen = method(7);
+
+	bool same = (std::memcmp(serial, parallel, count * sizeof(*serial)) == 0) &&
+		(std::memcmp(serial, stolen, count * sizeof(*serial)) == 0);
+
+	delete[] serial;
+	delete[] parallel;
+	delete[] stolen;
+
+	std::cout << name << " - serial: " << elapsedSerial << "ms, " << ParallelUtils::GetThreadsCount(0) 
+		<< " threads: " << elapsedParallel << "ms, same: " << same << std::endl;
+}
+
+void TestParallelReprojectData()
+{
+	std::cout << "TestParallelReprojectData" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	GEOS geos(GEOS::SatelliteSettings::Goes16());
+	geos.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	bbMin.lat = -80.0_deg;
+	bbMax.lat = 80.0_deg;
+
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 2000, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	auto reprojection = Reprojection<float>::CreateReprojection(&geos, &mercator);
+	size_t outCount = static_cast<size_t>(reprojection.outW) * reprojection.outH;
+
+	std::vector<uint8_t> inputData(static_cast<size_t>(reprojection.inW) * reprojection.inH * 3);
+	for (size_t i = 0; i < inputData.size(); i++)
+	{
+		inputData[i] = static_cast<uint8_t>((i * 7) % 251);
+	}
+
+	CompareParallelReprojectData("Nearest neighbor", outCount * 3, [&](size_t threadsCount) {
+		return reprojection.ReprojectDataNerestNeighbor<uint8_t, uint8_t*, 3>(inputData.data(), 0, threadsCount);
+	});
+
+	CompareParallelReprojectData("Bilinear", outCount * 3, [&](size_t threadsCount) {
+		return reprojection.ReprojectDataBilinear<uint8_t, uint8_t*, 3>(inputData.data(), 0, threadsCount);
+	});
+
+	CompareParallelReprojectData("Bicubic", outCount * 3, [&](size_t threadsCount) {
+		return reprojection.ReprojectDataBicubic<uint8_t, uint8_t*, 3>(inputData.data(), 0, threadsCount);
+	});
+
+	//without valid spans
+	auto reprojectionInt = Reprojection<int>::CreateReprojection(&geos, &mercator);
+	
+	CompareParallelReprojectData("Image", outCount * 3, [&](size_t threadsCount) {
+		uint8_t* output = new uint8_t[outCount * 3];
+		std::fill(output, output + outCount * 3, 0);
+		ProjectionRenderer::ReprojectImage(inputData.data(), ProjectionRenderer::RenderImageType::RGB,
+			output, ProjectionRenderer::RenderImageType::RGB, reprojectionInt, threadsCount);
+		return output;
+	});
+}
+
+//================================================================
+
+template <template <class> class SimdReproj, typename T, typename DataType, size_t ChannelsCount>
+void CompareNearestNeighborSimd(const char* name, const Reprojection<T>& reprojection)
+{
+	size_t outCount = static_cast<size_t>(reprojection.outW) * reprojection.outH * ChannelsCount;
+
+	std::vector<DataType> inputData(static_cast<size_t>(reprojection.inW) * reprojection.inH * ChannelsCount);
+	for (size_t i = 0; i < inputData.size(); i++)
+	{
+		inputData[i] = static_cast<DataType>((i * 7) % 251);
+	}
+
+	const DataType NO_VALUE = static_cast<DataType>(255);
+
+	SimdReproj<T> simd;
+	static_cast<Reprojection<T>&>(simd) = reprojection;
+
+	auto start = std::chrono::high_resolution_clock::now();
+	DataType* reference = reprojection.template ReprojectDataNerestNeighbor<DataType, DataType*, ChannelsCount>(inputData.data(), NO_VALUE);
+	auto end = std::chrono::high_resolution_clock::now();
+	double elapsedReference = std::chrono::duration<double, std::milli>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	DataType* output = simd.template ReprojectDataNerestNeighbor<DataType, DataType*, ChannelsCount>(inputData.data(), NO_VALUE);
+	end = std::chrono::high_resolution_clock::now();
+	double elapsedSimd = std::chrono::duration<double, std::milli>(end - start).count();
+
+	bool same = std::memcmp(reference, output, outCount * sizeof(DataType)) == 0;
+	delete[] output;
+
+	//whole rows with invalid pixels
+	simd.validSpans.Clear();
+	output = simd.template ReprojectDataNerestNeighbor<DataType, DataType*, ChannelsCount>(inputData.data(), NO_VALUE, 0);
+
+	bool sameRows = std::memcmp(reference, output, outCount * sizeof(DataType)) == 0;
+	delete[] output;
+	delete[] reference;
+
+	std::cout << name << " " << sizeof(DataType) << "B x " << ChannelsCount << " - CPU: " << elapsedReference << "ms, SIMD: " << elapsedSimd
+		<< "ms, same: " << same << ", same without spans: " << sameRows << std::endl;
+}
+
+template <template <class> class SimdReproj, typename T>
+void CompareNearestNeighborSimd(const char* name, const Reprojection<T>& reprojection)
+{
+	CompareNearestNeighborSimd<SimdReproj, T, uint8_t, 1>(name, reprojection);
+	CompareNearestNeighborSimd<SimdReproj, T, uint8_t, 3>(name, reprojection);
+	CompareNearestNeighborSimd<SimdReproj, T, uint8_t, 4>(name, reprojection);
+	CompareNearestNeighborSimd<SimdReproj, T, uint16_t, 1>(name, reprojection);
+	CompareNearestNeighborSimd<SimdReproj, T, uint16_t, 3>(name, reprojection);
+	CompareNearestNeighborSimd<SimdReproj, T, uint16_t, 4>(name, reprojection);
+	CompareNearestNeighborSimd<SimdReproj, T, float, 1>(name, reprojection);
+	CompareNearestNeighborSimd<SimdReproj, T, float, 3>(name, reprojection);
+	CompareNearestNeighborSimd<SimdReproj, T, float, 4>(name, reprojection);
+}
+
+void TestNearestNeighborSimd()
+{
+	std::cout << "TestNearestNeighborSimd" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	GEOS geos(GEOS::SatelliteSettings::Goes16());
+	geos.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	bbMin.lat = -80.0_deg;
+	bbMax.lat = 80.0_deg;
+
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 2003, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	//last input pixels are used - chunks after the end of input are not read
+	auto reprojection = Reprojection<int>::CreateReprojection(&geos, &mercator);
+	reprojection.pixels[0] = { reprojection.inW - 1, reprojection.inH - 1 };
+	reprojection.pixels[1] = { reprojection.inW - 2, reprojection.inH - 1 };
+	reprojection.BuildValidSpans();
+
+	auto reprojectionFloat = Reprojection<float>::CreateReprojection(&geos, &mercator);
+
+	CompareNearestNeighborSimd<nsAvx::Reprojection, int>("AVX int", reprojection);
+	CompareNearestNeighborSimd<nsAvx::Reprojection, float>("AVX float", reprojectionFloat);
+	CompareNearestNeighborSimd<nsNeon::Reprojection, int>("Neon int", reprojection);
+	CompareNearestNeighborSimd<nsNeon::Reprojection, float>("Neon float", reprojectionFloat);
+}
+
+//================================================================
+
+template <typename DataType, size_t ChannelsCount, typename Reproj>
+DataType* InterpolateSimdTest(const Reproj& reprojection, bool bicubic, const DataType* inputData, double& elapsed)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	DataType* output = (bicubic) ?
+		reprojection.template ReprojectDataBicubic<DataType, DataType*, ChannelsCount>(inputData, 0) :
+		reprojection.template ReprojectDataBilinear<DataType, DataType*, ChannelsCount>(inputData, 0);
+	auto end = std::chrono::high_resolution_clock::now();
+
+	elapsed = std::chrono::duration<double, std::milli>(end - start).count();
+	return output;
+}
+
+template <template <class> class SimdReproj, template <class, class, size_t> class Gather, typename DataType, size_t ChannelsCount>
+void CompareInterpolationSimd(const char* name, const Reprojection<float>& reprojection)
+{
+	size_t outCount = static_cast<size_t>(reprojection.outW) * reprojection.outH * ChannelsCount;
+
+	std::vector<DataType> inputData(static_cast<size_t>(reprojection.inW) * reprojection.inH * ChannelsCount);
+	for (size_t i = 0; i < inputData.size(); i++)
+	{
+		double v = static_cast<double>((i * 7) % 251);
+		inputData[i] = static_cast<DataType>((sizeof(DataType) == 2) ? v * 257 : (std::is_integral<DataType>::value) ? v : v * 0.5);
+	}
+
+	SimdReproj<float> simd;
+	static_cast<Reprojection<float>&>(simd) = reprojection;
+
+	//bound of difference from double version, relative for float data
+	const double MAX_DIFFERENCE = Gather<float, DataType, ChannelsCount>::MAX_DIFFERENCE;
+
+	//Fixed24_8 positions are interpolated in fixed point, same as single instruction version
+	Reprojection<Fixed24_8> reprojectionFixed;
+	reprojectionFixed.inW = reprojection.inW;
+	reprojectionFixed.inH = reprojection.inH;
+	reprojectionFixed.outW = reprojection.outW;
+	reprojectionFixed.outH = reprojection.outH;
+	for (const auto& p : reprojection.pixels)
+	{
+		reprojectionFixed.pixels.push_back({ Fixed24_8(p.x), Fixed24_8(p.y) });
+	}
+	reprojectionFixed.BuildValidSpans();
+
+	SimdReproj<Fixed24_8> simdFixed;
+	static_cast<Reprojection<Fixed24_8>&>(simdFixed) = reprojectionFixed;
+
+	for (bool bicubic : { false, true })
+	{
+		double elapsedReference, elapsedSimd, elapsedFixed, elapsedSimdFixed;
+		DataType* reference = InterpolateSimdTest<DataType, ChannelsCount>(reprojection, bicubic, inputData.data(), elapsedReference);
+		DataType* output = InterpolateSimdTest<DataType, ChannelsCount>(simd, bicubic, inputData.data(), elapsedSimd);
+		DataType* outputFixed = InterpolateSimdTest<DataType, ChannelsCount>(reprojectionFixed, bicubic, inputData.data(), elapsedFixed);
+		DataType* outputSimdFixed = InterpolateSimdTest<DataType, ChannelsCount>(simdFixed, bicubic, inputData.data(), elapsedSimdFixed);
+
+		double maxDiff = 0;
+		for (size_t i = 0; i < outCount; i++)
+		{
+			double diff = std::abs(static_cast<double>(reference[i]) - static_cast<double>(output[i]));
+			if constexpr (std::is_floating_point<DataType>::value)
+			{
+				diff /= std::max(1.0, std::abs(static_cast<double>(reference[i])));
+			}
+			maxDiff = std::max(maxDiff, diff);
+		}
+
+		std::cout << name << " " << ((bicubic) ? "bicubic" : "bilinear") << " " << sizeof(DataType) << "B x " << ChannelsCount
+			<< " - CPU: " << elapsedReference << "ms, SIMD: " << elapsedSimd << "ms, max difference: " << maxDiff
+			<< " (bound " << MAX_DIFFERENCE << "): " << ((maxDiff <= MAX_DIFFERENCE) ? "OK" : "FAILED");
+
+		if constexpr (std::is_integral<DataType>::value)
+		{
+			bool sameFixed = std::memcmp(outputFixed, outputSimdFixed, outCount * sizeof(DataType)) == 0;
+			std::cout << ", Fixed24_8 same as single instruction: " << ((sameFixed) ? "OK" : "FAILED");
+		}
+		std::cout << std::endl;
+
+		delete[] reference;
+		delete[] output;
+		delete[] outputFixed;
+		delete[] outputSimdFixed;
+	}
+}
+
+template <template <class> class SimdReproj, template <class, class, size_t> class Gather>
+void CompareInterpolationSimd(const char* name, const Reprojection<float>& reprojection)
+{
+	CompareInterpolationSimd<SimdReproj, Gather, uint8_t, 1>(name, reprojection);
+	CompareInterpolationSimd<SimdReproj, Gather, uint8_t, 3>(name, reprojection);
+	CompareInterpolationSimd<SimdReproj, Gather, uint8_t, 4>(name, reprojection);
+	CompareInterpolationSimd<SimdReproj, Gather, uint16_t, 1>(name, reprojection);
+	CompareInterpolationSimd<SimdReproj, Gather, uint16_t, 3>(name, reprojection);
+	CompareInterpolationSimd<SimdReproj, Gather, uint16_t, 4>(name, reprojection);
+	CompareInterpolationSimd<SimdReproj, Gather, float, 1>(name, reprojection);
+	CompareInterpolationSimd<SimdReproj, Gather, float, 3>(name, reprojection);
+	CompareInterpolationSimd<SimdReproj, Gather, float, 4>(name, reprojection);
+}
+
+void TestInterpolationSimd()
+{
+	std::cout << "TestInterpolationSimd" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	GEOS geos(GEOS::SatelliteSettings::Goes16());
+	geos.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	bbMin.lat = -80.0_deg;
+	bbMax.lat = 80.0_deg;
+
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 2003, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	//taps at the end of input are not gathered after the end of input
+	auto reprojection = Reprojection<float>::CreateReprojection(&geos, &mercator);
+	reprojection.pixels[0] = { reprojection.inW - 1.5f, reprojection.inH - 1.25f };
+	reprojection.pixels[1] = { reprojection.inW - 1.0f, reprojection.inH - 1.0f };
+	reprojection.BuildValidSpans();
+
+	CompareInterpolationSimd<nsAvx::Reprojection, nsAvx::InterpolationGather>("AVX", reprojection);
+	CompareInterpolationSimd<nsNeon::Reprojection, nsNeon::InterpolationGather>("Neon", reprojection);
+}
+
+//================================================================
+
+template <typename T, typename DataType>
+void ReprojectDataLayoutTest(const Reprojection<T>& reprojection, int method, 
+	const DataType* inputData, const DataLayout& inputLayout, DataType* outputData, const DataLayout& outputLayout)
+{
+	if (method == 0) reprojection.ReprojectDataNerestNeighbor(inputData, inputLayout, outputData, outputLayout, DataType(0));
+	else if (method == 1) reprojection.ReprojectDataBilinear(inputData, inputLayout, outputData, outputLayout, DataType(0));
+	else reprojection.ReprojectDataBicubic(inputData, inputLayout, outputData, outputLayout, DataType(0));
+}
+
+template <typename T, typename DataType>
+void CompareDataLayout(const char* name, const Reprojection<T>& reprojection, size_t bandsCount)
+{
+	const char* methods[] = { "nearest neighbor", "bilinear", "bicubic" };
+
+	size_t inCount = static_cast<size_t>(reprojection.inW) * reprojection.inH;
+	size_t outCount = static_cast<size_t>(reprojection.outW) * reprojection.outH;
+
+	//planes are padded
+	DataLayout planarIn = DataLayout::Planar(bandsCount, inCount + 64);
+	DataLayout interleavedIn = DataLayout::Interleaved(bandsCount);
+	DataLayout planarOut = DataLayout::Planar(bandsCount, outCount + 32);
+	DataLayout interleavedOut = DataLayout::Interleaved(bandsCount);
+
+	std::vector<DataType> planar(planarIn.GetBufferSize(inCount));
+	std::vector<DataType> interleaved(interleavedIn.GetBufferSize(inCount));
+	for (size_t b = 0; b < bandsCount; b++)
+	{
+		for (size_t i = 0; i < inCount; i++)
+		{
+			DataType v = static_cast<DataType>(((i + b * 31) * 7) % 251);
+			planar[planarIn.GetPixelOffset(i) + planarIn.GetChannelOffset(b)] = v;
+			interleaved[interleavedIn.GetPixelOffset(i) + interleavedIn.GetChannelOffset(b)] = v;
+		}
+	}
+
+	std::vector<DataType> output(planarOut.GetBufferSize(outCount));
+	std::vector<DataType> outputInterleaved(interleavedOut.GetBufferSize(outCount));
+
+	for (int method = 0; method < 3; method++)
+	{
+		//reference - band by band with compile time channels count
+		auto start = std::chrono::high_resolution_clock::now();
+		std::vector<DataType*> reference;
+		for (size_t b = 0; b < bandsCount; b++)
+		{
+			const DataType* band = planar.data() + planarIn.GetChannelOffset(b);
+			reference.push_back((method == 0) ? reprojection.template ReprojectDataNerestNeighbor<DataType, DataType*, 1>(band, 0) :
+				(method == 1) ? reprojection.template ReprojectDataBilinear<DataType, DataType*, 1>(band, 0) :
+				reprojection.template ReprojectDataBicubic<DataType, DataType*, 1>(band, 0));
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+		double elapsedBands = std::chrono::duration<double, std::milli>(end - start).count();
+
+		start = std::chrono::high_resolution_clock::now();
+		ReprojectDataLayoutTest(reprojection, method, planar.data(), planarIn, output.data(), planarOut);
+		end = std::chrono::high_resolution_clock::now();
+		double elapsedPlanar = std::chrono::duration<double, std::milli>(end - start).count();
+
+		//interleaved input -> interleaved output
+		ReprojectDataLayoutTest(reprojection, method, interleaved.data(), interleavedIn, outputInterleaved.data(), interleavedOut);
+
+		bool same = true;
+		bool sameInterleaved = true;
+		for (size_t b = 0; b < bandsCount; b++)
+		{
+			same &= std::memcmp(reference[b], output.data() + planarOut.GetChannelOffset(b), outCount * sizeof(DataType)) == 0;
+			for (size_t i = 0; i < outCount; i++)
+			{
+				sameInterleaved &= (reference[b][i] == outputInterleaved[interleavedOut.GetPixelOffset(i) + b]);
+			}
+			delete[] reference[b];
+		}
+
+		std::cout << name << " " << methods[method] << " " << bandsCount << " bands - band by band: " << elapsedBands
+			<< "ms, planar: " << elapsedPlanar << "ms, same: " << same << ", interleaved same: " << sameInterleaved << std::endl;
+	}
+}
+
+void TestDataLayout()
+{
+	std::cout << "TestDataLayout" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	GEOS geos(GEOS::SatelliteSettings::Goes16());
+	geos.SetRawFrame(bbMin, bbMax, 1000, 1000, STEP_TYPE::PIXEL_CENTER, false);
+
+	bbMin.lat = -80.0_deg;
+	bbMax.lat = 80.0_deg;
+
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 1000, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	auto reprojection = Reprojection<float>::CreateReprojection(&geos, &mercator);
+	CompareDataLayout<float, uint16_t>("float", reprojection, 10);
+	CompareDataLayout<float, float>("float", reprojection, 3);
+
+	//integral data with fixed point positions
+	Reprojection<Fixed24_8> reprojectionFixed;
+	reprojectionFixed.inW = reprojection.inW;
+	reprojectionFixed.inH = reprojection.inH;
+	reprojectionFixed.outW = reprojection.outW;
+	reprojectionFixed.outH = reprojection.outH;
+	for (const auto& p : reprojection.pixels)
+	{
+		reprojectionFixed.pixels.push_back({ Fixed24_8(p.x), Fixed24_8(p.y) });
+	}
+	CompareDataLayout<Fixed24_8, uint8_t>("Fixed24_8", reprojectionFixed, 16);
+}
+
+//================================================================
+
+template <size_t ChannelsCount, typename Reproj, typename DataType>
+DataType* ReprojectDataBatchTest(const Reproj& reprojection, int method, const DataType* inputData)
+{
+	if (method == 0) return reprojection.template ReprojectDataNerestNeighbor<DataType, DataType*, ChannelsCount>(inputData, 0);
+	if (method == 1) return reprojection.template ReprojectDataBilinear<DataType, DataType*, ChannelsCount>(inputData, 0);
+	return reprojection.template ReprojectDataBicubic<DataType, DataType*, ChannelsCount>(inputData, 0);
+}
+
+template <size_t ChannelsCount, typename Reproj, typename DataType>
+void ReprojectDataBatchTest(const Reproj& reprojection, int method, const DataType* inputData, DataType* outputData)
+{
+	size_t rowPitch = static_cast<size_t>(reprojection.outW) * ChannelsCount;
+
+	if (method == 0) reprojection.template ReprojectDataNerestNeighbor<DataType, ChannelsCount>(inputData, outputData, rowPitch, 0);
+	else if (method == 1) reprojection.template ReprojectDataBilinear<DataType, ChannelsCount>(inputData, outputData, rowPitch, 0);
+	else reprojection.template ReprojectDataBicubic<DataType, ChannelsCount>(inputData, outputData, rowPitch, 0);
+}
+
+template <size_t ChannelsCount, typename Reproj, typename DataType>
+void ReprojectDataBatchTest(const Reproj& reprojection, int method, 
+	const std::vector<const DataType*>& inputs, const std::vector<DataType*>& outputs)
+{
+	if (method == 0) reprojection.template ReprojectDataNerestNeighbor<DataType, ChannelsCount>(inputs.data(), outputs.data(), inputs.size(), 0);
+	else if (method == 1) reprojection.template ReprojectDataBilinear<DataType, ChannelsCount>(inputs.data(), outputs.data(), inputs.size(), 0);
+	else reprojection.template ReprojectDataBicubic<DataType, ChannelsCount>(inputs.data(), outputs.data(), inputs.size(), 0);
+}
+
+template <typename DataType, size_t ChannelsCount, typename Reproj>
+void CompareBatchReprojectData(const char* name, const Reproj& reprojection, size_t framesCount)
+{
+	const char* methods[] = { "nearest neighbor", "bilinear", "bicubic" };
+
+	size_t inCount = static_cast<size_t>(reprojection.inW) * reprojection.inH * ChannelsCount;
+	size_t outCount = static_cast<size_t>(reprojection.outW) * reprojection.outH * ChannelsCount;
+
+	std::vector<std::vector<DataType>> inputData(framesCount);
+	std::vector<std::vector<DataType>> outputData(framesCount);
+	std::vector<const DataType*> inputs;
+	std::vector<DataType*> outputs;
+	for (size_t f = 0; f < framesCount; f++)
+	{
+		inputData[f].resize(inCount);
+		for (size_t i = 0; i < inCount; i++)
+		{
+			inputData[f][i] = static_cast<DataType>(((i + f * 13) * 7) % 251);
+		}
+		outputData[f].resize(outCount);
+
+		inputs.push_back(inputData[f].data());
+		outputs.push_back(outputData[f].data());
+	}
+
+	//both versions write to already allocated outputs, best of RUNS is reported
+	const int RUNS = 5;
+
+	for (int method = 0; method < 3; method++)
+	{
+		std::vector<DataType*> reference;
+		for (size_t f = 0; f < framesCount; f++)
+		{
+			reference.push_back(ReprojectDataBatchTest<ChannelsCount>(reprojection, method, inputs[f]));
+		}
+
+		double elapsedFrames = std::numeric_limits<double>::max();
+		double elapsedBatch = std::numeric_limits<double>::max();
+		for (int run = 0; run < RUNS; run++)
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+			for (size_t f = 0; f < framesCount; f++)
+			{
+				ReprojectDataBatchTest<ChannelsCount>(reprojection, method, inputs[f], outputs[f]);
+			}
+			auto end = std::chrono::high_resolution_clock::now();
+			elapsedFrames = std::min(elapsedFrames, std::chrono::duration<double, std::milli>(end - start).count());
+
+			start = std::chrono::high_resolution_clock::now();
+			ReprojectDataBatchTest<ChannelsCount>(reprojection, method, inputs, outputs);
+			end = std::chrono::high_resolution_clock::now();
+			elapsedBatch = std::min(elapsedBatch, std::chrono::duration<double, std::milli>(end - start).count());
+		}
+
+		bool same = true;
+		for (size_t f = 0; f < framesCount; f++)
+		{
+			same &= std::memcmp(reference[f], outputs[f], outCount * sizeof(DataType)) == 0;
+			delete[] reference[f];
+		}
+
+		std::cout << name << " " << methods[method] << " " << framesCount << " frames - frame by frame: " << elapsedFrames
+			<< "ms, batch: " << elapsedBatch << "ms, same: " << same << std::endl;
+	}
+}
+
+void TestBatchReprojectData()
+{
+	std::cout << "TestBatchReprojectData" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	GEOS geos(GEOS::SatelliteSettings::Goes16());
+	geos.SetRawFrame(bbMin, bbMax, 1000, 1000, STEP_TYPE::PIXEL_CENTER, false);
+
+	bbMin.lat = -80.0_deg;
+	bbMax.lat = 80.0_deg;
+
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 2000, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	auto reprojection = Reprojection<float>::CreateReprojection(&geos, &mercator);
+	CompareBatchReprojectData<uint8_t, 1>("CPU", reprojection, 8);
+	CompareBatchReprojectData<float, 3>("CPU", reprojection, 4);
+
+	nsAvx::Reprojection<float> avx;
+	static_cast<Reprojection<float>&>(avx) = reprojection;
+	CompareBatchReprojectData<uint8_t, 1>("AVX", avx, 8);
+	CompareBatchReprojectData<float, 3>("AVX", avx, 4);
+
+	nsNeon::Reprojection<float> neon;
+	static_cast<Reprojection<float>&>(neon) = reprojection;
+	CompareBatchReprojectData<uint8_t, 1>("Neon", neon, 8);
+	CompareBatchReprojectData<float, 3>("Neon", neon, 4);
+}
+
+//================================================================
+
+template <typename Reproj>
+void CompareRowPitchReprojectData(const char* name, const Reproj& reprojection, const std::vector<uint8_t>& inputData)
+{
+	const size_t CHANNELS = 3;
+	const size_t PADDING = 13;
+	const uint8_t PADDING_VALUE = 77;
+
+	size_t rowSize = static_cast<size_t>(reprojection.outW) * CHANNELS;
+	size_t rowPitch = rowSize + PADDING;
+
+	BufferPool<uint8_t> pool;
+
+	bool same = true;
+	bool paddingKept = true;
+	for (int i = 0; i < 5; i++)
+	{
+		auto buffer = pool.Acquire(rowPitch * reprojection.outH);
+		std::fill(buffer.Get(), buffer.Get() + buffer.GetCount(), PADDING_VALUE);
+
+		reprojection.template ReprojectDataBilinear<uint8_t, CHANNELS>(inputData.data(), buffer.Get(), rowPitch, 0);
+
+		uint8_t* reference = reprojection.template ReprojectDataBilinear<uint8_t, uint8_t*, CHANNELS>(inputData.data(), 0);
+		for (int y = 0; y < reprojection.outH; y++)
+		{
+			const uint8_t* row = buffer.Get() + y * rowPitch;
+			same &= std::memcmp(reference + y * rowSize, row, rowSize) == 0;
+			paddingKept &= std::all_of(row + rowSize, row + rowPitch, [&](uint8_t v) { return v == PADDING_VALUE; });
+		}
+		delete[] reference;
+	}
+
+	std::cout << name << " row pitch - same: " << same << ", padding kept: " << paddingKept
+		<< ", buffers allocated: " << pool.GetAllocationsCount() << std::endl;
+}
+
+void TestZeroAllocationReprojectData()
+{
+	std::cout << "TestZeroAllocationReprojectData" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	GEOS geos(GEOS::SatelliteSettings::Goes16());
+	geos.SetRawFrame(bbMin, bbMax, 1000, 1000, STEP_TYPE::PIXEL_CENTER, false);
+
+	bbMin.lat = -80.0_deg;
+	bbMax.lat = 80.0_deg;
+
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 1001, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	std::vector<uint8_t> inputData(1000 * 1000 * 3);
+	for (size_t i = 0; i < inputData.size(); i++)
+	{
+		inputData[i] = static_cast<uint8_t>((i * 7) % 251);
+	}
+
+	//pixels allocated from memory resource
+	std::pmr::unsynchronized_pool_resource resource;
+	Reprojection<float> reprojection(&resource);
+	reprojection = Reprojection<float>::CreateReprojection(&geos, &mercator);
+	
+	std::cout << "Pixels from memory resource: " << (reprojection.pixels.get_allocator().resource() == &resource) << std::endl;
+
+	CompareRowPitchReprojectData("CPU", reprojection, inputData);
+
+	nsAvx::Reprojection<float> avx;
+	static_cast<Reprojection<float>&>(avx) = reprojection;
+	CompareRowPitchReprojectData("AVX", avx, inputData);
+
+	nsNeon::Reprojection<float> neon;
+	static_cast<Reprojection<float>&>(neon) = reprojection;
+	CompareRowPitchReprojectData("Neon", neon, inputData);
+}
+
+//================================================================
+
+void TestAreaPlan()
+{
+	std::cout << "TestAreaPlan" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	GEOS geos(GEOS::SatelliteSettings::Goes16());
+	geos.SetRawFrame(bbMin, bbMax, 4000, 4000, STEP_TYPE::PIXEL_CENTER, false);
+
+	bbMin.lat = -70.0_deg;
+	bbMax.lat = 70.0_deg;
+
+	//overview - output is much coarser than input
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 400, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	auto reprojection = Reprojection<float>::CreateReprojection(&geos, &mercator);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	AreaPlan plan = AreaPlan::Create(reprojection);
+	auto end = std::chrono::high_resolution_clock::now();
+	std::cout << "Plan created: " << std::chrono::duration<double, std::milli>(end - start).count() << "ms, "
+		<< plan.GetBytes() / 1024 << "kB" << std::endl;
+
+	//checkerboard - every average over more pixels is close to 127.5
+	size_t inCount = static_cast<size_t>(reprojection.inW) * reprojection.inH;
+	std::vector<uint8_t> inputData(inCount);
+	for (int y = 0; y < reprojection.inH; y++)
+	{
+		for (int x = 0; x < reprojection.inW; x++)
+		{
+			inputData[x + static_cast<size_t>(y) * reprojection.inW] = ((x + y) % 2) ? 255 : 0;
+		}
+	}
+
+	start = std::chrono::high_resolution_clock::now();
+	uint8_t* area = plan.Apply<uint8_t>(inputData.data(), 0);
+	end = std::chrono::high_resolution_clock::now();
+	double elapsedArea = std::chrono::duration<double, std::milli>(end - start).count();
+
+	uint8_t* nearest = reprojection.ReprojectDataNerestNeighbor<uint8_t>(inputData.data(), 0);
+
+	//box averages computed directly
+	bool same = true;
+	double errorArea = 0;
+	double errorNearest = 0;
+	const AreaPlan::Box* b = plan.boxes.data();
+	for (int y = 0; y < plan.outH; y++)
+	{
+		plan.validSpans.ForEachSpan(y, plan.outW,
+			[&](int, int) {},
+			[&](int begin, int endX) {
+				for (int x = begin; x < endX; x++, b++)
+				{
+					uint64_t sum = 0;
+					for (int yy = b->y0; yy < b->y1; yy++)
+					{
+						for (int xx = b->x0; xx < b->x1; xx++)
+						{
+							sum += inputData[xx + static_cast<size_t>(yy) * reprojection.inW];
+						}
+					}
+					uint64_t count = static_cast<uint64_t>(b->x1 - b->x0) * (b->y1 - b->y0);
+
+					size_t index = x + static_cast<size_t>(y) * plan.outW;
+					same &= (area[index] == (sum + count / 2) / count);
+
+					errorArea = std::max(errorArea, std::abs(area[index] - 127.5));
+					errorNearest = std::max(errorNearest, std::abs(nearest[index] - 127.5));
+				}
+			});
+	}
+
+	std::cout << "Area: " << elapsedArea << "ms, same as direct average: " << same
+		<< ", max error - area: " << errorArea << ", nearest neighbor: " << errorNearest << std::endl;
+
+	delete[] area;
+	delete[] nearest;
+
+	//table reused for next inputs
+	std::vector<float> inputFloat(inCount * 3, 1.5f);
+	std::vector<float> outputFloat(static_cast<size_t>(plan.outW) * plan.outH * 3);
+
+	SummedAreaTable<float, 3> table;
+	for (int i = 0; i < 3; i++)
+	{
+		table.Build(inputFloat.data(), plan.inW, plan.inH);
+		plan.Apply<float, 3>(table, outputFloat.data(), static_cast<size_t>(plan.outW) * 3, -1.0f);
+	}
+
+	bool constant = true;
+	for (size_t i = 0; i < outputFloat.size(); i++)
+	{
+		constant &= (outputFloat[i] == -1.0f) || (std::abs(outputFloat[i] - 1.5f) < 1e-4f);
+	}
+	std::cout << "Constant input: " << constant << std::endl;
+}
+
+//================================================================
+
+template <typename DataType, size_t ChannelsCount, int LOBES, typename T>
+void CompareLanczos(const char* name, const Reprojection<T>& reprojection, const nsAvx::Reprojection<T>& avx)
+{
+	size_t inCount = static_cast<size_t>(reprojection.inW) * reprojection.inH * ChannelsCount;
+	size_t outCount = static_cast<size_t>(reprojection.outW) * reprojection.outH * ChannelsCount;
+
+	std::vector<DataType> inputData(inCount);
+	for (size_t i = 0; i < inCount; i++)
+	{
+		double v = 0.5 + 0.4 * std::sin(0.01 * static_cast<double>(i % 7919)) + 0.1 * ((i * 2654435761u) % 1000) / 1000.0;
+		inputData[i] = static_cast<DataType>((std::is_integral<DataType>::value) ? v * std::numeric_limits<DataType>::max() : v);
+	}
+
+	const DataType NO_VALUE = 0;
+
+	auto start = std::chrono::high_resolution_clock::now();
+	auto bicubic = reprojection.template ReprojectDataBicubic<DataType, std::vector<DataType>, ChannelsCount>(inputData.data(), NO_VALUE);
+	auto end = std::chrono::high_resolution_clock::now();
+	double elapsedBicubic = std::chrono::duration<double, std::milli>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	auto scalar = reprojection.template ReprojectDataLanczos<DataType, std::vector<DataType>, ChannelsCount, LOBES>(inputData.data(), NO_VALUE);
+	end = std::chrono::high_resolution_clock::now();
+	double elapsedScalar = std::chrono::duration<double, std::milli>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	auto simd = avx.template ReprojectDataLanczos<DataType, std::vector<DataType>, ChannelsCount, LOBES>(inputData.data(), NO_VALUE);
+	end = std::chrono::high_resolution_clock::now();
+	double elapsedAvx = std::chrono::duration<double, std::milli>(end - start).count();
+
+	auto plan = InterpolationPlan<LanczosFilter<LOBES>>::Create(reprojection);
+	auto planned = plan.template Apply<DataType, std::vector<DataType>, ChannelsCount>(inputData.data(), NO_VALUE);
+
+	double maxDiff = 0;
+	for (size_t i = 0; i < outCount; i++)
+	{
+		maxDiff = std::max(maxDiff, std::abs(static_cast<double>(scalar[i]) - static_cast<double>(simd[i])));
+	}
+
+	std::cout << name << " Lanczos-" << LOBES << " - bicubic: " << elapsedBicubic << "ms, scalar: " << elapsedScalar 
+		<< "ms, AVX: " << elapsedAvx << "ms, same as plan: " << (scalar == planned)
+		<< ", AVX max difference: " << maxDiff << std::endl;
+}
+
+void TestLanczos()
+{
+	std::cout << "TestLanczos" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	GEOS geos(GEOS::SatelliteSettings::Goes16());
+	geos.SetRawFrame(bbMin, bbMax, 1000, 1000, STEP_TYPE::PIXEL_CENTER, false);
+
+	bbMin.lat = -80.0_deg;
+	bbMax.lat = 80.0_deg;
+
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 1500, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	auto reprojection = Reprojection<float>::CreateReprojection(&geos, &mercator);
+
+	nsAvx::Reprojection<float> avx;
+	static_cast<Reprojection<float>&>(avx) = reprojection;
+
+	CompareLanczos<uint8_t, 1, 3>("uint8_t x 1", reprojection, avx);
+	CompareLanczos<uint8_t, 3, 3>("uint8_t x 3", reprojection, avx);
+	CompareLanczos<uint16_t, 1, 3>("uint16_t x 1", reprojection, avx);
+	CompareLanczos<float, 1, 3>("float x 1", reprojection, avx);
+	CompareLanczos<float, 3, 3>("float x 3", reprojection, avx);
+	CompareLanczos<uint8_t, 4, 2>("uint8_t x 4", reprojection, avx);
+	CompareLanczos<float, 4, 2>("float x 4", reprojection, avx);
+
+	auto reprojectionFixed = Reprojection<Fixed24_8>::CreateReprojection(&geos, &mercator);
+
+	nsAvx::Reprojection<Fixed24_8> avxFixed;
+	static_cast<Reprojection<Fixed24_8>&>(avxFixed) = reprojectionFixed;
+
+	CompareLanczos<uint16_t, 3, 3>("Fixed24_8 uint16_t x 3", reprojectionFixed, avxFixed);
+
+	//integral positions - weights of phase 0 are 1 at the pixel only
+	auto reprojectionInt = Reprojection<int>::CreateReprojection(&geos, &mercator);
+
+	std::vector<uint8_t> inputData(1000 * 1000);
+	for (size_t i = 0; i < inputData.size(); i++)
+	{
+		inputData[i] = static_cast<uint8_t>(i * 13);
+	}
+
+	auto nearest = reprojectionInt.ReprojectDataNerestNeighbor<uint8_t, std::vector<uint8_t>>(inputData.data(), 0);
+	auto lanczos = reprojectionInt.ReprojectDataLanczos<uint8_t, std::vector<uint8_t>>(inputData.data(), 0);
+	std::cout << "Integral positions same as nearest neighbor: " << (nearest == lanczos) << std::endl;
+
+	//planar 3 bands - same as band by band
+	size_t planeSize = inputData.size();
+	std::vector<uint8_t> planar(3 * planeSize);
+	for (size_t i = 0; i < planar.size(); i++)
+	{
+		planar[i] = static_cast<uint8_t>(i * 7);
+	}
+
+	size_t outPlaneSize = static_cast<size_t>(reprojection.outW) * reprojection.outH;
+	std::vector<uint8_t> planarOut(3 * outPlaneSize);
+	reprojection.ReprojectDataLanczos(planar.data(), DataLayout::Planar(3, planeSize), 
+		planarOut.data(), DataLayout::Planar(3, outPlaneSize), uint8_t(0));
+
+	bool same = true;
+	for (size_t c = 0; c < 3; c++)
+	{
+		auto band = reprojection.ReprojectDataLanczos<uint8_t, std::vector<uint8_t>>(planar.data() + c * planeSize, 0);
+		same &= std::equal(band.begin(), band.end(), planarOut.begin() + c * outPlaneSize);
+	}
+	std::cout << "Planar same as band by band: " << same << std::endl;
+}
+
+//================================================================
+
+template <template <typename> class ReprojectionType, typename DataType, size_t ChannelsCount, typename T>
+void CompareGatherPlan(const char* name, const Reprojection<T>& reprojection)
+{
+	size_t inCount = static_cast<size_t>(reprojection.inW) * reprojection.inH * ChannelsCount;
+
+	std::vector<DataType> inputData(inCount);
+	for (size_t i = 0; i < inCount; i++)
+	{
+		inputData[i] = static_cast<DataType>((i * 2654435761u) % 251);
+	}
+
+	const DataType NO_VALUE = 0;
+
+	ReprojectionType<T> tiles;
+	static_cast<Reprojection<T>&>(tiles) = reprojection;
+
+	ReprojectionType<T> rowMajor;
+	static_cast<Reprojection<T>&>(rowMajor) = reprojection;
+	rowMajor.gatherPlan.Clear();
+
+	auto start = std::chrono::high_resolution_clock::now();
+	auto nn = rowMajor.template ReprojectDataNerestNeighbor<DataType, std::vector<DataType>, ChannelsCount>(inputData.data(), NO_VALUE);
+	auto end = std::chrono::high_resolution_clock::now();
+	double elapsedNN = std::chrono::duration<double, std::milli>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	auto nnTiles = tiles.template ReprojectDataNerestNeighbor<DataType, std::vector<DataType>, ChannelsCount>(inputData.data(), NO_VALUE);
+	end = std::chrono::high_resolution_clock::now();
+	double elapsedNNTiles = std::chrono::duration<double, std::milli>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	auto bilinear = rowMajor.template ReprojectDataBilinear<DataType, std::vector<DataType>, ChannelsCount>(inputData.data(), NO_VALUE);
+	end = std::chrono::high_resolution_clock::now();
+	double elapsedBilinear = std::chrono::duration<double, std::milli>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	auto bilinearTiles = tiles.template ReprojectDataBilinear<DataType, std::vector<DataType>, ChannelsCount>(inputData.data(), NO_VALUE);
+	end = std::chrono::high_resolution_clock::now();
+	double elapsedBilinearTiles = std::chrono::duration<double, std::milli>(end - start).count();
+
+	std::cout << name << " - NN row-major: " << elapsedNN << "ms, tiles: " << elapsedNNTiles << "ms, same: " << (nn == nnTiles)
+		<< " | bilinear row-major: " << elapsedBilinear << "ms, tiles: " << elapsedBilinearTiles << "ms, same: " << (bilinear == bilinearTiles) << std::endl;
+}
+
+void TestGatherPlan()
+{
+	std::cout << "TestGatherPlan" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	Equirectangular input;
+	input.SetRawFrame(bbMin, bbMax, 8000, 4000, STEP_TYPE::PIXEL_CENTER, false);
+
+	bbMin.lat = 30.0_deg; bbMin.lon = -45.0_deg;
+	bbMax.lat = 30.0_deg; bbMax.lon = 135.0_deg;
+
+	PolarSteregographic polar(0.0_deg, 90.0_deg);
+	polar.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	auto reprojection = Reprojection<float>::CreateReprojection(&input, &polar);
+
+	//output rows read less input rows than fit to cache - row-major order is kept
+	reprojection.BuildGatherPlan();
+	std::cout << "Polar stereographic - plan is empty: " << (reprojection.gatherPlan.IsEmpty() ? "OK" : "FAILED") << std::endl;
+
+	//forced tiles - results are same
+	reprojection.BuildGatherPlan(32);
+	CompareGatherPlan<Reprojection, uint8_t, 3>("CPU polar uint8_t x 3", reprojection);
+	CompareGatherPlan<Reprojection, float, 1>("CPU polar float x 1", reprojection);
+	CompareGatherPlan<nsAvx::Reprojection, uint8_t, 3>("AVX polar uint8_t x 3", reprojection);
+	CompareGatherPlan<nsAvx::Reprojection, float, 1>("AVX polar float x 1", reprojection);
+	CompareGatherPlan<nsNeon::Reprojection, uint8_t, 3>("Neon polar uint8_t x 3", reprojection);
+
+	//output rotated by 90 degrees - output row reads input column
+	//and touches new cache line and memory page for every pixel
+	Reprojection<float> rotated;
+	rotated.inW = 16000;
+	rotated.inH = 16000;
+	rotated.outW = 4000;
+	rotated.outH = 4000;
+	rotated.pixels.resize(static_cast<size_t>(rotated.outW) * rotated.outH);
+	for (int y = 0; y < rotated.outH; y++)
+	{
+		for (int x = 0; x < rotated.outW; x++)
+		{
+			rotated.pixels[x + static_cast<size_t>(y) * rotated.outW] = { 4.0f * y + 0.25f, 4.0f * x + 0.5f };
+		}
+	}
+
+	rotated.BuildGatherPlan();
+	std::cout << "Rotated - tile size: " << rotated.gatherPlan.tileSize << ", tiles: " << rotated.gatherPlan.tiles.size() << std::endl;
+
+	CompareGatherPlan<Reprojection, uint8_t, 1>("CPU rotated uint8_t x 1", rotated);
+	CompareGatherPlan<nsAvx::Reprojection, uint8_t, 1>("AVX rotated uint8_t x 1", rotated);
+	CompareGatherPlan<nsNeon::Reprojection, uint8_t, 1>("Neon rotated uint8_t x 1", rotated);
+}
+
+template <typename DataType, size_t Ch>
+void CompareStreaming(const char* name, const Reprojection<float>& reprojection,
+	const std::vector<uint8_t>& png, const std::vector<DataType>& inputData)
+{
+	StreamingReprojection<float> streaming(reprojection);
+
+	auto decodeRows = [&](bool asyncRead, int filter, std::vector<DataType>& out) {
+		PngStreamDecoder decoder;
+		decoder.Open(png.data(), png.size());
+
+		auto readRow = [&](DataType* row) { return decoder.ReadRow(row); };
+
+		out.assign(static_cast<size_t>(reprojection.outW) * reprojection.outH * Ch, 0);
+		size_t pitch = static_cast<size_t>(reprojection.outW) * Ch;
+
+		if (filter == 0) return streaming.ReprojectDataNerestNeighbor<DataType, Ch>(readRow, out.data(), pitch, 0, asyncRead);
+		if (filter == 1) return streaming.ReprojectDataBilinear<DataType, Ch>(readRow, out.data(), pitch, 0, asyncRead);
+		return streaming.ReprojectDataBicubic<DataType, Ch>(readRow, out.data(), pitch, 0, asyncRead);
+	};
+
+	std::cout << name << " - input rows: " << reprojection.inH
+		<< ", window rows NN: " << streaming.GetWindowRows(StreamingReprojection<float>::NEAREST_NEIGHBOR_MARGIN)
+		<< ", bicubic: " << streaming.GetWindowRows(StreamingReprojection<float>::BICUBIC_MARGIN)
+		<< ", read rows: " << streaming.GetReadRowsCount(StreamingReprojection<float>::BICUBIC_MARGIN) << std::endl;
+
+	const char* filters[] = { "NN", "bilinear", "bicubic" };
+	for (int filter = 0; filter < 3; filter++)
+	{
+		std::vector<DataType> ref;
+		if (filter == 0) ref = reprojection.ReprojectDataNerestNeighbor<DataType, std::vector<DataType>, Ch>(inputData.data(), 0);
+		if (filter == 1) ref = reprojection.ReprojectDataBilinear<DataType, std::vector<DataType>, Ch>(inputData.data(), 0);
+		if (filter == 2) ref = reprojection.ReprojectDataBicubic<DataType, std::vector<DataType>, Ch>(inputData.data(), 0);
+
+		for (bool asyncRead : { false, true })
+		{
+			std::vector<DataType> out;
+			auto start = std::chrono::high_resolution_clock::now();
+			bool ok = decodeRows(asyncRead, filter, out);
+			auto end = std::chrono::high_resolution_clock::now();
+			std::chrono::duration<double, std::milli> elapsed = end - start;
+
+			std::cout << "  " << filters[filter] << (asyncRead ? " (async)" : "") << ": " << elapsed.count() << "ms, "
+				<< ((ok && (out == ref)) ? "OK" : "FAILED") << std::endl;
+		}
+	}
+}
+
+void TestStreamingReprojection()
+{
+	std::cout << "TestStreamingReprojection" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -80.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 80.0_deg; bbMax.lon = 180.0_deg;
+
+	Equirectangular input;
+	input.SetRawFrame(bbMin, bbMax, 3000, 1500, STEP_TYPE::PIXEL_CENTER, false);
+
+	//synthetic RGB input encoded to PNG in memory
+	std::vector<uint8_t> inputData(static_cast<size_t>(input.GetFrameWidth()) * input.GetFrameHeight() * 3);
+	for (int y = 0; y < input.GetFrameHeight(); y++)
+	{
+		for (int x = 0; x < input.GetFrameWidth(); x++)
+		{
+			uint8_t* p = inputData.data() + (x + static_cast<size_t>(y) * input.GetFrameWidth()) * 3;
+			p[0] = static_cast<uint8_t>(x ^ y);
+			p[1] = static_cast<uint8_t>((x * 7 + y * 3) >> 2);
+			p[2] = static_cast<uint8_t>(((x / 32 + y / 32) % 2) * 200);
+		}
+	}
+
+	std::vector<uint8_t> png;
+	lodepng::encode(png, inputData, input.GetFrameWidth(), input.GetFrameHeight(), LodePNGColorType::LCT_RGB);
+
+	//decoded rows are same as lodepng::decode
+	{
+		PngStreamDecoder decoder;
+		bool ok = decoder.Open(png.data(), png.size());
+		std::vector<uint8_t> row(decoder.GetRowSize());
+		for (unsigned y = 0; ok && (y < decoder.GetHeight()); y++)
+		{
+			ok = decoder.ReadRow(row.data()) &&
+				std::equal(row.begin(), row.end(), inputData.begin() + y * decoder.GetRowSize());
+		}
+		std::cout << "PngStreamDecoder rows: " << (ok ? "OK" : "FAILED") << std::endl;
+	}
+
+	//output covers only part of input - rows after its bottom are not decoded
+	bbMin.lat = 20.0_deg; bbMin.lon = -30.0_deg;
+	bbMax.lat = 70.0_deg; bbMax.lon = 60.0_deg;
+
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 1200, 1000, STEP_TYPE::PIXEL_CENTER, false);
+
+	auto reprojection = Reprojection<float>::CreateReprojection(&input, &mercator);
+	CompareStreaming<uint8_t, 3>("Mercator", reprojection, png, inputData);
+
+	bbMin.lat = 30.0_deg; bbMin.lon = -45.0_deg;
+	bbMax.lat = 30.0_deg; bbMax.lon = 135.0_deg;
+
+	PolarSteregographic polar(0.0_deg, 90.0_deg);
+	polar.SetRawFrame(bbMin, bbMax, 1000, 1000, STEP_TYPE::PIXEL_CENTER, false);
+
+	auto reprojectionPolar = Reprojection<float>::CreateReprojection(&input, &polar);
+	CompareStreaming<uint8_t, 3>("Polar stereographic", reprojectionPolar, png, inputData);
+
+	//truncated file - reprojection fails
+	std::vector<uint8_t> truncated(png.begin(), png.begin() + png.size() / 4);
+	StreamingReprojection<float> streaming(reprojectionPolar);
+	std::vector<uint8_t> out(static_cast<size_t>(polar.GetFrameWidth()) * polar.GetFrameHeight() * 3);
+	for (bool asyncRead : { false, true })
+	{
+		PngStreamDecoder decoder;
+		decoder.Open(truncated.data(), truncated.size());
+		bool ok = streaming.ReprojectDataBilinear<uint8_t, 3>([&](uint8_t* row) { return decoder.ReadRow(row); },
+			out.data(), static_cast<size_t>(polar.GetFrameWidth()) * 3, 0, asyncRead);
+		std::cout << "Truncated PNG" << (asyncRead ? " (async)" : "") << ": " << (ok ? "FAILED" : "OK") << std::endl;
+	}
+}
+
+template <template <class> class SimdReproj, typename From, typename To, typename FromSimd, typename ToSimd>
+void CompareProjectionSimd(const char* name, From* from, To* to, FromSimd* fromSimd, ToSimd* toSimd)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	auto reproj = Reprojection<float>::CreateReprojection(from, to);
+	auto end = std::chrono::high_resolution_clock::now();
+	auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	auto reprojSimd = SimdReproj<float>::CreateReprojection(fromSimd, toSimd);
+	end = std::chrono::high_resolution_clock::now();
+	auto elapsedSimd = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	double maxError = 0;
+	size_t validityDiff = 0;
+	size_t validCount = 0;
+	for (size_t i = 0; i < reproj.pixels.size(); i++)
+	{
+		const auto& a = reproj.pixels[i];
+		const auto& b = reprojSimd.pixels[i];
+		if ((a.x == -1) != (b.x == -1))
+		{
+			validityDiff++;
+			continue;
+		}
+		if (a.x == -1) continue;
+
+		validCount++;
+		maxError = std::max(maxError, static_cast<double>(std::abs(a.x - b.x)));
+		maxError = std::max(maxError, static_cast<double>(std::abs(a.y - b.y)));
+	}
+
+	std::cout << name << " - CPU: " << elapsed << "ms, SIMD: " << elapsedSimd << "ms, valid: " << validCount;
+	std::cout << ", max position error: " << maxError << " px, validity differs: " << validityDiff << " px" << std::endl;
+}
+
+void TestProjectionsAvx()
+{
+	std::cout << "TestProjectionsAvx" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -80.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 80.0_deg; bbMax.lon = 180.0_deg;
+
+	Equirectangular eq;
+	eq.SetRawFrame(bbMin, bbMax, 2000, 1000, STEP_TYPE::PIXEL_CENTER, false);
+
+	nsAvx::Equirectangular eqAvx;
+	eqAvx.SetRawFrame(bbMin, bbMax, 2000, 1000, STEP_TYPE::PIXEL_CENTER, false);
+
+	//HRRR grid
+	bbMin.lat = 21.140547_deg; bbMin.lon = -134.09548_deg;
+	bbMax.lat = 52.6132742_deg; bbMax.lon = -60.9365_deg;
+
+	LambertConic lam(38.5_deg, -97.5_deg, 38.5_deg);
+	lam.SetFrameWithAdjustment(bbMin, bbMax, 1799, 1059, STEP_TYPE::PIXEL_CENTER, false);
+
+	nsAvx::LambertConic lamAvx(38.5_deg, -97.5_deg, 38.5_deg);
+	lamAvx.SetFrameWithAdjustment(bbMin, bbMax, 1799, 1059, STEP_TYPE::PIXEL_CENTER, false);
+
+	CompareProjectionSimd<nsAvx::Reprojection>("LambertConic -> Equirectangular", &lam, &eq, &lamAvx, &eqAvx);
+	CompareProjectionSimd<nsAvx::Reprojection>("Equirectangular -> LambertConic", &eq, &lam, &eqAvx, &lamAvx);
+
+	//two standard parallels, southern hemisphere
+	bbMin.lat = -45.0_deg; bbMin.lon = 110.0_deg;
+	bbMax.lat = -10.0_deg; bbMax.lon = 155.0_deg;
+
+	LambertConic lamSouth(-30.0_deg, 134.0_deg, -10.0_deg, -40.0_deg);
+	lamSouth.SetFrameWithAdjustment(bbMin, bbMax, 1200, 1000, STEP_TYPE::PIXEL_CENTER, false);
+
+	nsAvx::LambertConic lamSouthAvx(-30.0_deg, 134.0_deg, -10.0_deg, -40.0_deg);
+	lamSouthAvx.SetFrameWithAdjustment(bbMin, bbMax, 1200, 1000, STEP_TYPE::PIXEL_CENTER, false);
+
+	CompareProjectionSimd<nsAvx::Reprojection>("LambertConic (south) -> Equirectangular", &lamSouth, &eq, &lamSouthAvx, &eqAvx);
+	CompareProjectionSimd<nsAvx::Reprojection>("Equirectangular -> LambertConic (south)", &eq, &lamSouth, &eqAvx, &lamSouthAvx);
+
+	//Europe
+	bbMin.lat = 30.0_deg; bbMin.lon = -20.0_deg;
+	bbMax.lat = 70.0_deg; bbMax.lon = 40.0_deg;
+
+	LambertAzimuthal laea(10.0_deg, 52.0_deg);
+	laea.SetFrameWithAdjustment(bbMin, bbMax, 1500, 1200, STEP_TYPE::PIXEL_CENTER, false);
+
+	nsAvx::LambertAzimuthal laeaAvx(10.0_deg, 52.0_deg);
+	laeaAvx.SetFrameWithAdjustment(bbMin, bbMax, 1500, 1200, STEP_TYPE::PIXEL_CENTER, false);
+
+	CompareProjectionSimd<nsAvx::Reprojection>("LambertAzimuthal -> Equirectangular", &laea, &eq, &laeaAvx, &eqAvx);
+	CompareProjectionSimd<nsAvx::Reprojection>("Equirectangular -> LambertAzimuthal", &eq, &laea, &eqAvx, &laeaAvx);
+
+	//sea-ice
+	bbMin.lat = 30.0_deg; bbMin.lon = -45.0_deg;
+	bbMax.lat = 30.0_deg; bbMax.lon = 135.0_deg;
+
+	PolarSteregographic polar(0.0_deg, 90.0_deg);
+	polar.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	nsAvx::PolarSteregographic polarAvx(0.0_deg, 90.0_deg);
+	polarAvx.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	CompareProjectionSimd<nsAvx::Reprojection>("PolarSteregographic -> Equirectangular", &polar, &eq, &polarAvx, &eqAvx);
+	CompareProjectionSimd<nsAvx::Reprojection>("Equirectangular -> PolarSteregographic", &eq, &polar, &eqAvx, &polarAvx);
+
+	//Italy radar
+	bbMin.lat = 35.063_deg; bbMin.lon = 5.926_deg;
+	bbMax.lat = 47.541_deg; bbMax.lon = 20.420_deg;
+
+	TransverseMercator tme(12.5_deg, 42.0_deg);
+	tme.SetFrameWithAdjustment(bbMin, bbMax, 1200, 1400, STEP_TYPE::PIXEL_CENTER, false);
+
+	nsAvx::TransverseMercator tmeAvx(12.5_deg, 42.0_deg);
+	tmeAvx.SetFrameWithAdjustment(bbMin, bbMax, 1200, 1400, STEP_TYPE::PIXEL_CENTER, false);
+
+	CompareProjectionSimd<nsAvx::Reprojection>("TransverseMercator -> Equirectangular", &tme, &eq, &tmeAvx, &eqAvx);
+	CompareProjectionSimd<nsAvx::Reprojection>("Equirectangular -> TransverseMercator", &eq, &tme, &eqAvx, &tmeAvx);
+}
+
+void TestGEOSInverseAvx()
+{
+	std::cout << "TestGEOSInverseAvx" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	Equirectangular eq;
+	eq.SetRawFrame(bbMin, bbMax, 4000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	nsAvx::Equirectangular eqAvx;
+	eqAvx.SetRawFrame(bbMin, bbMax, 4000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	//GOES - sweep x, Himawari - sweep y
+	for (auto sets : { GEOS::SatelliteSettings::Goes16(), GEOS::SatelliteSettings::Himawari8() })
+	{
+		GEOS geos(sets);
+		geos.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+		nsAvx::GEOS geosAvx(sets);
+		geosAvx.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+		std::string name = std::string("Equirectangular -> GEOS (sweep ") + (sets.sweepY ? "y)" : "x)");
+		CompareProjectionSimd<nsAvx::Reprojection>(name.c_str(), &eq, &geos, &eqAvx, &geosAvx);
+
+		//pixels outside of the Earth disk are -1
+		auto reprojAvx = nsAvx::Reprojection<float>::CreateReprojection(&eqAvx, &geosAvx);
+		size_t invalid = 0;
+		size_t nan = 0;
+		for (const auto& p : reprojAvx.pixels)
+		{
+			if (std::isnan(p.x) || std::isnan(p.y)) nan++;
+			else if (p.x == -1) invalid++;
+		}
+		std::cout << "  outside disk: " << invalid << " px, NaN: " << nan << " px" << std::endl;
+	}
+}
+
+void TestProjectionsNeon()
+{
+	std::cout << "TestProjectionsNeon" << std::endl;
+
+	Coordinate bbMin, bbMax;
+	bbMin.lat = -80.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 80.0_deg; bbMax.lon = 180.0_deg;
+
+	Equirectangular eq;
+	eq.SetRawFrame(bbMin, bbMax, 2000, 1000, STEP_TYPE::PIXEL_CENTER, false);
+
+	nsNeon::Equirectangular eqNeon;
+	eqNeon.SetRawFrame(bbMin, bbMax, 2000, 1000, STEP_TYPE::PIXEL_CENTER, false);
+
+	Mercator mercator;
+	mercator.SetRawFrame(bbMin, bbMax, 2000, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	nsNeon::Mercator mercatorNeon;
+	mercatorNeon.SetRawFrame(bbMin, bbMax, 2000, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	CompareProjectionSimd<nsNeon::Reprojection>("Mercator -> Equirectangular", &mercator, &eq, &mercatorNeon, &eqNeon);
+	CompareProjectionSimd<nsNeon::Reprojection>("Equirectangular -> Mercator", &eq, &mercator, &eqNeon, &mercatorNeon);
+
+	Miller miller;
+	miller.SetRawFrame(bbMin, bbMax, 2000, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	nsNeon::Miller millerNeon;
+	millerNeon.SetRawFrame(bbMin, bbMax, 2000, 0, STEP_TYPE::PIXEL_CENTER, false);
+
+	CompareProjectionSimd<nsNeon::Reprojection>("Miller -> Equirectangular", &miller, &eq, &millerNeon, &eqNeon);
+	CompareProjectionSimd<nsNeon::Reprojection>("Equirectangular -> Miller", &eq, &miller, &eqNeon, &millerNeon);
+
+	//HRRR grid
+	bbMin.lat = 21.140547_deg; bbMin.lon = -134.09548_deg;
+	bbMax.lat = 52.6132742_deg; bbMax.lon = -60.9365_deg;
+
+	LambertConic lam(38.5_deg, -97.5_deg, 38.5_deg);
+	lam.SetFrameWithAdjustment(bbMin, bbMax, 1799, 1059, STEP_TYPE::PIXEL_CENTER, false);
+
+	nsNeon::LambertConic lamNeon(38.5_deg, -97.5_deg, 38.5_deg);
+	lamNeon.SetFrameWithAdjustment(bbMin, bbMax, 1799, 1059, STEP_TYPE::PIXEL_CENTER, false);
+
+	CompareProjectionSimd<nsNeon::Reprojection>("LambertConic -> Equirectangular", &lam, &eq, &lamNeon, &eqNeon);
+	CompareProjectionSimd<nsNeon::Reprojection>("Equirectangular -> LambertConic", &eq, &lam, &eqNeon, &lamNeon);
+
+	//Europe
+	bbMin.lat = 30.0_deg; bbMin.lon = -20.0_deg;
+	bbMax.lat = 70.0_deg; bbMax.lon = 40.0_deg;
+
+	LambertAzimuthal laea(10.0_deg, 52.0_deg);
+	laea.SetFrameWithAdjustment(bbMin, bbMax, 1500, 1200, STEP_TYPE::PIXEL_CENTER, false);
+
+	nsNeon::LambertAzimuthal laeaNeon(10.0_deg, 52.0_deg);
+	laeaNeon.SetFrameWithAdjustment(bbMin, bbMax, 1500, 1200, STEP_TYPE::PIXEL_CENTER, false);
+
+	CompareProjectionSimd<nsNeon::Reprojection>("LambertAzimuthal -> Equirectangular", &laea, &eq, &laeaNeon, &eqNeon);
+	CompareProjectionSimd<nsNeon::Reprojection>("Equirectangular -> LambertAzimuthal", &eq, &laea, &eqNeon, &laeaNeon);
+
+	//sea-ice
+	bbMin.lat = 30.0_deg; bbMin.lon = -45.0_deg;
+	bbMax.lat = 30.0_deg; bbMax.lon = 135.0_deg;
+
+	PolarSteregographic polar(0.0_deg, 90.0_deg);
+	polar.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	nsNeon::PolarSteregographic polarNeon(0.0_deg, 90.0_deg);
+	polarNeon.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	CompareProjectionSimd<nsNeon::Reprojection>("PolarSteregographic -> Equirectangular", &polar, &eq, &polarNeon, &eqNeon);
+	CompareProjectionSimd<nsNeon::Reprojection>("Equirectangular -> PolarSteregographic", &eq, &polar, &eqNeon, &polarNeon);
+
+	//Italy radar
+	bbMin.lat = 35.063_deg; bbMin.lon = 5.926_deg;
+	bbMax.lat = 47.541_deg; bbMax.lon = 20.420_deg;
+
+	TransverseMercator tme(12.5_deg, 42.0_deg);
+	tme.SetFrameWithAdjustment(bbMin, bbMax, 1200, 1400, STEP_TYPE::PIXEL_CENTER, false);
+
+	nsNeon::TransverseMercator tmeNeon(12.5_deg, 42.0_deg);
+	tmeNeon.SetFrameWithAdjustment(bbMin, bbMax, 1200, 1400, STEP_TYPE::PIXEL_CENTER, false);
+
+	CompareProjectionSimd<nsNeon::Reprojection>("TransverseMercator -> Equirectangular", &tme, &eq, &tmeNeon, &eqNeon);
+	CompareProjectionSimd<nsNeon::Reprojection>("Equirectangular -> TransverseMercator", &eq, &tme, &eqNeon, &tmeNeon);
+
+	//radar range
+	AEQD aeqd(30.4375_deg, 36.266389_deg, 370);
+	aeqd.CalcBounds(bbMin, bbMax);
+	aeqd.SetFrameWithAdjustment(bbMin, bbMax, 720, 720, STEP_TYPE::PIXEL_CENTER, false);
+
+	nsNeon::AEQD aeqdNeon(30.4375_deg, 36.266389_deg, 370);
+	aeqdNeon.SetFrameWithAdjustment(bbMin, bbMax, 720, 720, STEP_TYPE::PIXEL_CENTER, false);
+
+	CompareProjectionSimd<nsNeon::Reprojection>("AEQD -> Equirectangular", &aeqd, &eq, &aeqdNeon, &eqNeon);
+	CompareProjectionSimd<nsNeon::Reprojection>("Equirectangular -> AEQD", &eq, &aeqd, &eqNeon, &aeqdNeon);
+
+	//GOES - sweep x, Himawari - sweep y
+	bbMin.lat = -90.0_deg; bbMin.lon = -180.0_deg;
+	bbMax.lat = 90.0_deg; bbMax.lon = 180.0_deg;
+
+	Equirectangular eqWorld;
+	eqWorld.SetRawFrame(bbMin, bbMax, 4000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	nsNeon::Equirectangular eqWorldNeon;
+	eqWorldNeon.SetRawFrame(bbMin, bbMax, 4000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+	for (auto sets : { GEOS::SatelliteSettings::Goes16(), GEOS::SatelliteSettings::Himawari8() })
+	{
+		GEOS geos(sets);
+		geos.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+		nsNeon::GEOS geosNeon(sets);
+		geosNeon.SetRawFrame(bbMin, bbMax, 2000, 2000, STEP_TYPE::PIXEL_CENTER, false);
+
+		//only visible part of the Earth, positions behind the disk are not defined
+		Coordinate diskMin, diskMax;
+		diskMin.lat = -70.0_deg; diskMin.lon = Longitude::deg(sets.lon.deg() - 70.0);
+		diskMax.lat = 70.0_deg; diskMax.lon = Longitude::deg(sets.lon.deg() + 70.0);
+
+		Equirectangular eqDisk;
+		eqDisk.SetRawFrame(diskMin, diskMax, 1400, 1400, STEP_TYPE::PIXEL_CENTER, false);
+
+		nsNeon::Equirectangular eqDiskNeon;
+		eqDiskNeon.SetRawFrame(diskMin, diskMax, 1400, 1400, STEP_TYPE::PIXEL_CENTER, false);
+
+		std::string sweep = (sets.sweepY ? " (sweep y)" : " (sweep x)");
+		CompareProjectionSimd<nsNeon::Reprojection>(("GEOS" + sweep + " -> Equirectangular").c_str(), &geos, &eqDisk, &geosNeon, &eqDiskNeon);
+		CompareProjectionSimd<nsNeon::Reprojection>(("Equirectangular -> GEOS" + sweep).c_str(), &eqWorld, &geos, &eqWorldNeon, &geosNeon);
+	}
+}
+
+//================================================================
+
 void TestCalculations()
 {
 	std::cout << "TestCalculations" << std::endl;
@@ -22,6 +22,43 @@ void TestReprojectionMercToPolar();
 void TestOblique();
 
 void TestWrapAround();
+void TestWrapAroundSimd();
+
+void TestParallelReprojection();
+
+void TestApproximateReprojection();
+
+void TestSeparableReprojection();
+
+void TestCompressedReprojection();
+
+void TestReprojectionFile();
+
+void TestReprojectionCache();
+
+void TestValidSpans();
+
+void TestComposeReprojection();
+
+void TestInputFootprint();
+
+void TestFixedPointReprojection();
+
+void TestInterpolationPlan();
+void TestProjectionPrecision();
+void TestParallelReprojectData();
+void TestNearestNeighborSimd();
+void TestInterpolationSimd();
+void TestDataLayout();
+void TestBatchReprojectData();
+void TestZeroAllocationReprojectData();
+void TestAreaPlan();
+void TestLanczos();
+void TestGatherPlan();
+void TestStreamingReprojection();
+void TestProjectionsAvx();
+void TestGEOSInverseAvx();
+void TestProjectionsNeon();
 
 void TestCalculations();
 